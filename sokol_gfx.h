@@ -51,6 +51,17 @@
     SOKOL_EXTERNAL_GL_LOADER    - indicates that you're using your own GL loader, in this case
                                   sokol_gfx.h will not include any platform GL headers and disable
                                   the integrated Win32 GL loader
+    SOKOL_GLCORE_4X             - with SOKOL_GLCORE33, indicates that the GL headers or loader
+                                  declare the GL 4.x functions used by optional features, which
+                                  are still only enabled if the GL context supports them
+                                  (implied by the integrated Win32 GL loader):
+                                    - GL 4.1: the shader cache
+                                    - GL 4.4: persistent buffers
+                                    - GL 4.3: compute shaders
+                                    - GL 4.3: framebuffer invalidation
+    SOKOL_GFX_SLOT_BITS         - number of resource id bits used for the pool slot index, the
+                                  remaining bits are the slot's generation counter (default: 16,
+                                  allowed range 8..24, e.g. 20 for a 20/12 or 24 for a 24/8 split)
 
     If sokol_gfx.h is compiled as a DLL, define the following before
     including the declaration or implementation:
@@ -99,6 +110,22 @@
             sg_shader sg_make_shader(const sg_shader_desc*)
             sg_pipeline sg_make_pipeline(const sg_pipeline_desc*)
             sg_pass sg_make_pass(const sg_pass_desc*)
+            sg_sampler sg_make_sampler(const sg_sampler_desc*)
+
+        ...or create many resources of the same type in one call (for instance
+        at level load time), backends may use this to coalesce work (the GL
+        backend generates all GL buffer or texture names with a single call):
+
+            sg_make_buffers(const sg_buffer_desc* descs, int count, sg_buffer* out_bufs)
+            sg_make_images(const sg_image_desc* descs, int count, sg_image* out_imgs)
+            sg_make_shaders(const sg_shader_desc* descs, int count, sg_shader* out_shds)
+            sg_make_pipelines(const sg_pipeline_desc* descs, int count, sg_pipeline* out_pips)
+            sg_make_passes(const sg_pass_desc* descs, int count, sg_pass* out_passes)
+            sg_make_samplers(const sg_sampler_desc* descs, int count, sg_sampler* out_smps)
+
+        Each item is created, validated and reported to the trace hooks
+        exactly as with the sg_make_*() functions, a failed item doesn't
+        affect the other items of the same batch.
 
     --- start rendering to the default frame buffer with:
 
@@ -127,6 +154,33 @@
 
         to update the resource bindings
 
+    --- to sample the same image with different filtering or wrapping modes
+        without duplicating the image, create sampler objects with:
+
+            sg_sampler sg_make_sampler(const sg_sampler_desc* desc)
+
+        ...and put them into the sg_bindings.vs_samplers[] and
+        sg_bindings.fs_samplers[] slots next to the images, a sampler
+        overrides the sampler state of the image in the same slot. Image
+        slots without a sampler use the sampler state from sg_image_desc.
+        On GLES2/WebGL (sg_features.sampler_objects is false), sampler
+        objects can be created, but not bound.
+
+    --- if the same resource bindings are applied many times with the same
+        pipeline (for instance once per frame), the bindings can be validated
+        and resolved once upfront with:
+
+            sg_prepared_bindings sg_prepare_bindings(sg_pipeline pip, const sg_bindings* bindings)
+
+        ...and then be applied with much less overhead than sg_apply_bindings()
+        after sg_apply_pipeline() has been called with the same pipeline:
+
+            sg_apply_prepared_bindings(const sg_prepared_bindings* bindings)
+
+        When a resource referenced by prepared bindings is destroyed, the
+        next draw call will be dropped, the bindings must then be prepared
+        again with the new resource handles.
+
     --- optionally update shader uniform data with:
 
             sg_apply_uniforms(sg_shader_stage stage, int ub_index, const void* data, int num_bytes)
@@ -145,10 +199,64 @@
         containing per-instance data must be bound, and the num_instances parameter
         must be > 1.
 
+    --- to draw a mesh which lives somewhere inside a shared vertex buffer
+        without rebinding the vertex buffer at a different offset, call:
+
+            sg_draw_ex(int base_element, int num_elements, int num_instances, int base_vertex)
+
+        ...base_vertex is added to each index read from the index buffer
+        before the vertex is fetched. This requires sg_features.base_vertex
+        for indexed rendering (indexed draws with a non-zero base_vertex
+        are dropped otherwise). In non-indexed rendering, base_vertex is
+        simply added to base_element.
+
+    --- to issue many draw calls which share the same pipeline, bindings and
+        uniforms in one go, call:
+
+            sg_draw_batch(const sg_draw_range* ranges, int count)
+
+        ...each sg_draw_range item has the same meaning as the arguments
+        of sg_draw(). The validation and state checks only happen once
+        for the whole batch. On GLCORE33, the draw calls are submitted with
+        glMultiDrawArrays() or glMultiDrawElements(), on all other backends
+        (and for instanced ranges) sg_draw_batch() is a simple loop.
+
     --- finish the current rendering pass with:
 
             sg_end_pass()
 
+        ...what happens to the attachment content at the end of the pass is
+        defined by the store_action in sg_pass_action (by default the content
+        is stored, and MSAA color attachments are only resolved). Use
+        SG_STOREACTION_DONTCARE for attachments which aren't needed after
+        the pass (typically depth-stencil buffers), and create images which
+        only live during a single pass with sg_image_desc.transient = true,
+        this avoids writing the attachments back to memory on tile-based GPUs.
+
+    --- to run compute shaders (requires sg_features.compute), create a
+        compute shader (only sg_shader_desc.cs is provided), a compute
+        pipeline, and one or more storage buffers:
+
+            sg_make_compute_pipeline(const sg_compute_pipeline_desc* desc)
+            sg_make_buffer(&(sg_buffer_desc){ .type = SG_BUFFERTYPE_STORAGEBUFFER, ... })
+
+        ...then outside of render passes start a compute pass, apply the
+        compute pipeline, storage buffer bindings (sg_bindings.cs_storage_buffers)
+        and uniforms (SG_SHADERSTAGE_CS), and dispatch workgroups:
+
+            sg_begin_compute_pass()
+            sg_apply_pipeline(sg_pipeline pip)
+            sg_apply_bindings(const sg_bindings* bindings)
+            sg_apply_uniforms(SG_SHADERSTAGE_CS, int ub_index, const sg_range* data)
+            sg_dispatch(int num_groups_x, int num_groups_y, int num_groups_z)
+            sg_end_pass()
+
+        ...storage buffer writes of a dispatch are visible to following
+        dispatches, and after sg_end_pass() also to vertex fetches, index
+        fetches and buffer updates (so a storage buffer which has been written
+        by a compute shader can be rendered as vertex buffer right away).
+        Render pipelines can't be applied in compute passes and vice versa.
+
     --- when done with the current frame, call
 
             sg_commit()
@@ -164,6 +272,16 @@
             sg_destroy_shader(sg_shader shd)
             sg_destroy_pipeline(sg_pipeline pip)
             sg_destroy_pass(sg_pass pass)
+            sg_destroy_sampler(sg_sampler smp)
+
+        ...or the batched versions:
+
+            sg_destroy_buffers(const sg_buffer* bufs, int count)
+            sg_destroy_images(const sg_image* imgs, int count)
+            sg_destroy_shaders(const sg_shader* shds, int count)
+            sg_destroy_pipelines(const sg_pipeline* pips, int count)
+            sg_destroy_passes(const sg_pass* passes, int count)
+            sg_destroy_samplers(const sg_sampler* smps, int count)
 
     --- to set a new viewport rectangle, call
 
@@ -204,6 +322,60 @@
         operation only references the valid (updated) data in the
         buffer or image.
 
+        To overwrite a rectangular area in one mipmap and slice of a
+        dynamic or stream image without touching the rest of the image,
+        call:
+
+            sg_update_image_region(sg_image img, int mip_level, int slice, int x, int y, int width, int height, const sg_range* data)
+
+        The pixel data must be tightly packed (without row padding) in the
+        image's pixel format, compressed pixel formats are not supported.
+        'slice' is the cube face for cube images, the layer for array images
+        and the depth slice for 3D images. Any number of region updates is
+        allowed per image and frame as long as the regions don't overlap
+        (this is checked in debug mode). Region updates are written into the
+        image in place, instead of cycling through the SG_NUM_INFLIGHT_FRAMES
+        copies like sg_update_image() does. This means that a region which
+        is still accessed by the GPU in a previous frame must not be
+        overwritten on Metal (where the update happens immediately on the
+        CPU side), the GL and WebGPU backends order the update with the
+        rendering commands. Since sg_update_image() switches to the next
+        copy, it must not be called after sg_update_image_region() on the
+        same image in the same frame, because the region update would be
+        lost (this is checked in debug mode), the other order is fine.
+        Region updates are not supported on D3D11 (see
+        sg_features.image_region_update).
+
+        On GLCORE33 and GLES3 (but not WebGL), image data can be uploaded
+        asynchronously through a pool of pixel buffer objects by setting
+        sg_desc.image_upload_buffers to a value > 0, in that case
+        sg_make_image() and sg_update_image() only copy the image data into
+        a pixel buffer object and return without waiting for the driver
+        to copy the texels into the texture. To check if the last upload
+        into an image has been completed by the GPU, call:
+
+            bool sg_query_image_upload_done(sg_image img)
+
+        ...on all other backends (or with asynchronous uploads disabled)
+        this always returns true.
+
+    --- to read the content of an image back into CPU memory without stalling
+        the rendering pipeline, call:
+
+            bool sg_read_image_async(sg_image img, const sg_image_region* region, sg_read_image_callback callback, void* user_data)
+
+        ...or to read back a color attachment of a pass object after
+        the pass has been rendered:
+
+            bool sg_read_pass_attachment_async(sg_pass pass, int color_index, const sg_image_region* region, sg_read_image_callback callback, void* user_data)
+
+        The callback is called from inside a later sg_commit() once the
+        pixel data has arrived in CPU memory (usually one or two frames later),
+        callbacks are called in the order the readbacks have been started. The
+        functions return false if the readback couldn't be started (for instance
+        because too many readbacks are pending, or the backend doesn't support
+        readbacks, see sg_features.image_readback).
+
     --- to append a chunk of data to a buffer resource, call:
 
             int sg_append_buffer(sg_buffer buf, const sg_range* data)
@@ -254,6 +426,134 @@
         is associated with one draw call, but will be problematic when
         a single indexed draw call spans several appended chunks of indices.
 
+    --- instead of managing your own stream buffers for per-frame geometry,
+        you can also suballocate from the shared transient vertex- and
+        index-buffers owned by sokol-gfx (these must be enabled with
+        sg_desc.transient_vertex_buffer_size and transient_index_buffer_size):
+
+            sg_transient_range sg_alloc_transient(sg_buffer_type type, const sg_range* data)
+
+        The type must be SG_BUFFERTYPE_VERTEXBUFFER or SG_BUFFERTYPE_INDEXBUFFER.
+        This copies the data into the transient buffer and returns the
+        buffer handle and byte offset for sg_bindings, the range is valid
+        until the end of the frame:
+
+            sg_transient_range vtx = sg_alloc_transient(SG_BUFFERTYPE_VERTEXBUFFER, SG_RANGE_REF(vertices));
+            if (vtx.buffer.id != SG_INVALID_ID) {
+                sg_bindings bind = {
+                    .vertex_buffers[0] = vtx.buffer,
+                    .vertex_buffer_offsets[0] = vtx.offset,
+                    ...
+                };
+                sg_apply_bindings(&bind);
+                sg_draw(...);
+            }
+
+        If the transient buffer is exhausted, the returned buffer handle
+        is invalid, unlike sg_append_buffer() the transient buffer doesn't
+        go into the overflow state, so that smaller allocations may still
+        succeed. The same 4-byte alignment rule applies as with
+        sg_append_buffer().
+
+    --- to record rendering commands on worker threads and replay them later
+        on the render thread, initialize one sg_command_list per worker
+        with a chunk of memory owned by the caller:
+
+            sg_init_command_list(sg_command_list* cl, void* ptr, size_t size)
+
+        ...record commands with the sg_cmd_* functions, these mirror the
+        regular rendering functions but don't touch any sokol-gfx state:
+
+            sg_cmd_apply_viewport(sg_command_list* cl, int x, int y, int width, int height, bool origin_top_left)
+            sg_cmd_apply_scissor_rect(sg_command_list* cl, int x, int y, int width, int height, bool origin_top_left)
+            sg_cmd_apply_pipeline(sg_command_list* cl, sg_pipeline pip)
+            sg_cmd_apply_bindings(sg_command_list* cl, const sg_bindings* bindings)
+            sg_cmd_apply_uniforms(sg_command_list* cl, sg_shader_stage stage, int ub_index, const sg_range* data)
+            sg_cmd_draw(sg_command_list* cl, int base_element, int num_elements, int num_instances)
+            sg_cmd_draw_ex(sg_command_list* cl, int base_element, int num_elements, int num_instances, int base_vertex)
+            sg_cmd_draw_batch(sg_command_list* cl, const sg_draw_range* ranges, int count)
+            sg_cmd_apply_prepared_bindings(sg_command_list* cl, const sg_prepared_bindings* bindings)
+            sg_cmd_dispatch(sg_command_list* cl, int num_groups_x, int num_groups_y, int num_groups_z)
+            sg_cmd_update_image_region(sg_command_list* cl, sg_image img, int mip_level, int slice, int x, int y, int width, int height, const sg_range* data)
+
+        ...and finally, after all workers have finished recording, replay the
+        command lists in order inside a rendering pass on the render thread
+        (or inside a compute pass for command lists which record
+        sg_cmd_dispatch() calls):
+
+            sg_submit_command_lists(const sg_command_list* lists, int num_lists)
+
+        Uniform data, draw ranges, prepared bindings and image region
+        data are copied into the command list, so the data pointed to by
+        the sg_cmd_* arguments doesn't need to remain valid after the call.
+        Resource handles are only validated when the commands are replayed,
+        so the usual validation and error-handling rules apply at that point.
+        Each command list starts with an undefined pipeline and binding
+        state, so always record an sg_cmd_apply_pipeline() and
+        sg_cmd_apply_bindings() before the first draw.
+
+        Submitting doesn't reset a command list, so the same recorded commands
+        can be replayed several times. Call sg_reset_command_list() to rewind
+        a command list before recording new commands into it.
+
+        If the memory of a command list is exhausted, the command list goes
+        into the overflow state and drops all further commands, this can be
+        checked with:
+
+            bool sg_command_list_overflow(const sg_command_list* cl)
+
+    --- to move the cost of resource creation off the render thread and
+        spread it over several frames, initialize one sg_async_queue per
+        worker thread on the render thread:
+
+            sg_init_async_queue(sg_async_queue* q, const sg_async_queue_desc* desc)
+
+        ...on the worker thread, allocate a handle and copy the creation
+        parameters (including the initial content) into the queue, this
+        doesn't touch any sokol-gfx state and doesn't block:
+
+            sg_buffer sg_async_make_buffer(sg_async_queue* q, const sg_buffer_desc* desc)
+            sg_image sg_async_make_image(sg_async_queue* q, const sg_image_desc* desc)
+
+        ...and once per frame on the render thread, create the queued
+        resources until a time budget in milliseconds has been used up:
+
+            int sg_drain_async_queue(sg_async_queue* q, double budget_ms)
+
+        At least one resource is created per call, a budget of zero
+        creates all queued resources. On Linux, when compiling in strict
+        ISO C mode (e.g. -std=c99), define _POSIX_C_SOURCE=199309L so that
+        the time budget is measured with a monotonic wall clock instead of
+        the process CPU time.
+
+        The returned handles are in the SG_RESOURCESTATE_ALLOC state until
+        the resource has been created by sg_drain_async_queue(), and then
+        go into the VALID or FAILED state (validation happens on the render
+        thread, because it reads sokol-gfx state which is owned by the render
+        thread, like the supported features and pixel formats). Resources in
+        the ALLOC state can safely be used for rendering, but draw calls using
+        them will be skipped.
+
+        A pending handle may also be destroyed with sg_destroy_buffer() or
+        sg_destroy_image() on the render thread before it has been created
+        (e.g. when a streamed level is unloaded while it is still loading),
+        sg_drain_async_queue() and sg_discard_async_queue() then simply drop
+        the creation request.
+
+        The worker thread may free or reuse the data pointed to by the
+        desc right after the sg_async_make_*() call returns. If the queue
+        is full, or the queue has run out of pre-allocated handles (they
+        are replenished in sg_drain_async_queue()), sg_async_make_*()
+        returns an invalid handle and the worker should try again later.
+
+        Each queue has exactly one producer (worker) thread and is drained
+        on the render thread, no locks are involved. SOKOL_MALLOC() and
+        SOKOL_FREE() must be thread-safe when sg_async_queue is used. After
+        all workers have stopped, discard the queue on the render thread,
+        this releases all pending and pre-allocated handles:
+
+            sg_discard_async_queue(sg_async_queue* q)
+
     --- to check at runtime for optional features, limits and pixelformat support,
         call:
 
@@ -271,6 +571,15 @@
         by calling sg_query_desc(). This will return an sg_desc struct with
         the default values patched in instead of any zero-initialized values
 
+    --- to map resource ids to pool slot indices (e.g. for debugging UIs which
+        keep per-resource data in arrays), call:
+
+            sg_pool_info sg_query_pool_info()
+
+        ...this returns the slot index mask of resource ids and the current
+        capacity of each resource pool (which changes at runtime when
+        sg_desc.growable_pools is true)
+
     --- you can inspect various internal resource attributes via:
 
             sg_buffer_info sg_query_buffer_info(sg_buffer buf)
@@ -278,11 +587,79 @@
             sg_shader_info sg_query_shader_info(sg_shader shd)
             sg_pipeline_info sg_query_pipeline_info(sg_pipeline pip)
             sg_pass_info sg_query_pass_info(sg_pass pass)
+            sg_sampler_info sg_query_sampler_info(sg_sampler smp)
 
         ...please note that the returned info-structs are tied quite closely
         to sokol_gfx.h internals, and may change more often than other
         public API functions and structs.
 
+    --- to get the number of draw calls, state changes and uploaded bytes
+        of the previous frame, call:
+
+            sg_frame_stats sg_query_frame_stats(void)
+
+        ...and the number of redundant state changes that were dropped
+        by the state filter (see sg_desc.enable_state_filter) in the
+        previous frame:
+
+            sg_state_filter_stats sg_query_state_filter_stats(void)
+
+        If sg_desc.frame_stats_history has been set to N > 0, the per-frame
+        stats of the last N frames can be copied into an array (most recent
+        frame first) with:
+
+            int sg_query_frame_stats_history(sg_frame_stats* stats, int max_frames)
+
+        ...which returns the number of frames that have been copied.
+
+    --- to measure GPU execution times, set sg_desc.enable_gpu_timing to true
+        (currently supported by the GLCORE33 backend via GL_ARB_timer_query
+        and by the dummy backend which reports zero durations, check
+        sg_features.gpu_timing). Each rendering pass is timed automatically,
+        additional (nestable) timers can be placed anywhere between
+        sg_commit() calls with:
+
+            sg_begin_timer(const char* label)
+            sg_end_timer()
+
+        ...the label string must remain valid until the results have been
+        read back (usually it's a string literal). The GPU timings are
+        read back without blocking a few frames later, the most recent
+        available results can be inspected with:
+
+            sg_gpu_timings sg_query_gpu_timings(void)
+
+    --- to destroy buffers and images in the middle of a frame without
+        forcing the 3D API driver to wait for the GPU, set
+        sg_desc.enable_deferred_destroy to true. The handles become invalid
+        right away, but the backend objects are only released in sg_commit()
+        SG_NUM_INFLIGHT_FRAMES frames later, the number and size of queued
+        objects is reported in sg_frame_stats.
+
+    --- to inspect the approximate GPU memory used by buffers and images
+        (overall, by usage and by resource type), call:
+
+            sg_memory_stats sg_query_memory_stats(void)
+
+        ...to get notified when the memory exceeds a soft limit, provide
+        sg_desc.memory_budget and sg_desc.memory_budget_cb, the callback
+        is called in sg_commit() (see sg_desc for details).
+
+    --- to avoid compiling and linking the same shaders on each application
+        start, enable the shader cache with sg_desc.enable_shader_cache
+        (currently only supported by the GL backends on desktop GL with
+        GL_ARB_get_program_binary, and on GLES3 outside of WebGL, check
+        sg_features.shader_cache). At shutdown (or whenever it makes sense),
+        serialize the cache into a memory chunk owned by the caller:
+
+            size_t sg_query_shader_cache_size(void)
+            size_t sg_save_shader_cache(void* ptr, size_t size)
+
+        ...store the memory chunk somewhere (e.g. in a file), and pass it
+        back in sg_desc.shader_cache_data on the next start, sg_make_shader()
+        will then skip compiling and linking for each shader found in the
+        cache (see sg_desc for details).
+
     --- you can ask at runtime what backend sokol_gfx.h has been compiled
         for, or whether the GLES3 backend had to fall back to GLES2 with:
 
@@ -316,7 +693,8 @@
                   updated per frame, including a worst-case alignment
                   per uniform update (this worst-case alignment is 256 bytes)
                 - the max size of all dynamic resource updates (sg_update_buffer,
-                  sg_append_buffer and sg_update_image) per frame
+                  sg_append_buffer, sg_update_image and sg_update_image_region)
+                  per frame
                 - the max number of entries in the texture sampler cache
                   (how many unique texture sampler can exist at the same time)
             Not all of those limit values are used by all backends, but it is
@@ -364,6 +742,50 @@
                 ...
             };
 
+    --- on GLCORE33 and GLES3, a uniform block can instead be backed by a
+        uniform buffer object (which is much cheaper to update than
+        setting each member through glUniform*) by providing the name of
+        the GLSL uniform block, the GLSL block must use the std140 layout,
+        and the uniform data passed into sg_apply_uniforms() must match
+        the std140 memory layout (e.g. a vec3 member occupies 16 bytes,
+        array items are padded to 16 bytes, and the block size is rounded
+        up to a multiple of 16 bytes):
+
+            // GLSL:
+            layout(std140) uniform vs_params {
+                mat4 mvp;
+                vec2 offset0;
+            };
+
+            // C:
+            typedef struct {
+                float mvp[16];
+                float offset0[2];
+                float _pad[2];
+            } vs_params_t;
+
+            sg_shader_desc desc = {
+                .vs.uniform_blocks[0] = {
+                    .size = sizeof(vs_params_t),
+                    .name = "vs_params",
+                    .uniforms = {
+                        [0] = { .name="mvp", .type=SG_UNIFORMTYPE_MAT4 },
+                        [1] = { .name="offset0", .type=SG_UNIFORMTYPE_FLOAT2 },
+                    }
+                },
+                ...
+            };
+
+        The uniform block members are optional in this case, if provided
+        they are used to validate the std140 layout against the uniform
+        block size, and as fallback if the GLES3 backend had to fall back
+        to GLES2 (where the members are set with glUniform* using the
+        std140 member offsets). The member names are only required for
+        this GLES2 fallback, if only the member types are provided the
+        std140 layout is still validated. The uniform data is copied
+        into a per-frame uniform buffer of size
+        sg_desc.uniform_buffer_size.
+
     --- the Metal and D3D11 backends only need to know the size of uniform blocks,
         not their internal member structure, and they only need to know
         the type of a texture sampler, not its name:
@@ -611,6 +1033,7 @@ extern "C" {
     sg_shader:      vertex- and fragment-shaders, uniform blocks
     sg_pipeline:    associated shader and vertex-layouts, and render states
     sg_pass:        a bundle of render targets and actions on them
+    sg_sampler:     texture sampling state (filtering, wrapping, ...)
     sg_context:     a 'context handle' for switching between 3D-API contexts
 
     Instead of pointers, resource creation functions return a 32-bit
@@ -631,6 +1054,7 @@ typedef struct sg_shader   { uint32_t id; } sg_shader;
 typedef struct sg_pipeline { uint32_t id; } sg_pipeline;
 typedef struct sg_pass     { uint32_t id; } sg_pass;
 typedef struct sg_context  { uint32_t id; } sg_context;
+typedef struct sg_sampler  { uint32_t id; } sg_sampler;
 
 /*
     sg_range is a pointer-size-pair struct used to pass memory blobs into
@@ -666,10 +1090,12 @@ enum {
     SG_MAX_SHADERSTAGE_BUFFERS = 8,
     SG_MAX_SHADERSTAGE_IMAGES = 12,
     SG_MAX_SHADERSTAGE_UBS = 4,
+    SG_MAX_SHADERSTAGE_STORAGE_BUFFERS = 8,
     SG_MAX_UB_MEMBERS = 16,
     SG_MAX_VERTEX_ATTRIBUTES = 16,      /* NOTE: actual max vertex attrs can be less on GLES2, see sg_limits! */
     SG_MAX_MIPMAPS = 16,
-    SG_MAX_TEXTUREARRAY_LAYERS = 128
+    SG_MAX_TEXTUREARRAY_LAYERS = 128,
+    SG_MAX_GPU_TIMINGS = 32
 };
 
 /*
@@ -857,6 +1283,14 @@ typedef struct sg_features {
     bool image_clamp_to_border;         // border color and clamp-to-border UV-wrap mode is supported
     bool mrt_independent_blend_state;   // multiple-render-target rendering can use per-render-target blend state
     bool mrt_independent_write_mask;    // multiple-render-target rendering can use per-render-target color write masks
+    bool shader_cache;                  // compiled shaders can be cached across application runs (see sg_desc.enable_shader_cache)
+    bool persistent_buffers;            // dynamic and stream buffers can use persistently mapped storage (see sg_desc.enable_persistent_buffers)
+    bool gpu_timing;                    // GPU timer queries are supported (see sg_desc.enable_gpu_timing)
+    bool image_readback;                // image content can be read back with sg_read_image_async()
+    bool base_vertex;                   // indexed draws can use a base vertex (see sg_draw_ex())
+    bool sampler_objects;               // sg_sampler objects can be bound in sg_bindings (not on GLES2)
+    bool image_region_update;           // sg_update_image_region() is supported (not on D3D11)
+    bool compute;                       // compute shaders and storage buffers are supported (currently GL 4.3 with SOKOL_GLCORE_4X only, see sg_dispatch())
     #if defined(SOKOL_ZIG_BINDINGS)
     uint32_t __pad[3];
     #endif
@@ -874,6 +1308,24 @@ typedef struct sg_limits {
     int max_vertex_attrs;           // <= SG_MAX_VERTEX_ATTRIBUTES (only on some GLES2 impls)
 } sg_limits;
 
+/*
+    Runtime information about the resource pools, returned by
+    sg_query_pool_info(). The pool slot index of a resource id is
+    (id & slot_mask), and is always smaller than the capacity of its pool
+    (the capacity includes the reserved slot 0). With sg_desc.growable_pools
+    the capacities grow at runtime.
+*/
+typedef struct sg_pool_info {
+    uint32_t slot_mask;             // mask to extract the pool slot index from a resource id (see SOKOL_GFX_SLOT_BITS)
+    int buffer_pool_capacity;       // current number of slots in the buffer pool
+    int image_pool_capacity;        // current number of slots in the image pool
+    int sampler_pool_capacity;      // current number of slots in the sampler pool
+    int shader_pool_capacity;       // current number of slots in the shader pool
+    int pipeline_pool_capacity;     // current number of slots in the pipeline pool
+    int pass_pool_capacity;         // current number of slots in the pass pool
+    int context_pool_capacity;      // current number of slots in the context pool
+} sg_pool_info;
+
 /*
     sg_resource_state
 
@@ -950,12 +1402,20 @@ typedef enum sg_usage {
     This indicates whether a buffer contains vertex- or index-data,
     used in the sg_buffer_desc.type member when creating a buffer.
 
+    Storage buffers can be read and written by compute shaders, and
+    can also be bound as vertex buffers in render passes (for instance
+    to render the particles which have been updated by a compute
+    shader). Storage buffers require sg_features.compute, and are
+    never multi-buffered, sg_update_buffer() overwrites the buffer
+    content in place.
+
     The default value is SG_BUFFERTYPE_VERTEXBUFFER.
 */
 typedef enum sg_buffer_type {
     _SG_BUFFERTYPE_DEFAULT,         /* value 0 reserved for default-init */
     SG_BUFFERTYPE_VERTEXBUFFER,
     SG_BUFFERTYPE_INDEXBUFFER,
+    SG_BUFFERTYPE_STORAGEBUFFER,
     _SG_BUFFERTYPE_NUM,
     _SG_BUFFERTYPE_FORCE_U32 = 0x7FFFFFFF
 } sg_buffer_type;
@@ -1038,17 +1498,24 @@ typedef enum sg_cube_face {
 /*
     sg_shader_stage
 
-    There are 2 shader stages: vertex- and fragment-shader-stage.
+    There are 2 render shader stages: vertex- and fragment-shader-stage,
+    and the compute shader stage which is used on its own in compute
+    shaders (see sg_features.compute).
     Each shader stage consists of:
 
     - one slot for a shader function (provided as source- or byte-code)
     - SG_MAX_SHADERSTAGE_UBS slots for uniform blocks
     - SG_MAX_SHADERSTAGE_IMAGES slots for images used as textures by
-      the shader function
+      the shader function (vertex- and fragment-shader-stage only)
+    - SG_MAX_SHADERSTAGE_STORAGE_BUFFERS slots for storage buffers
+      (compute shader stage only)
+
+    NOTE: SG_NUM_SHADER_STAGES only counts the render shader stages.
 */
 typedef enum sg_shader_stage {
     SG_SHADERSTAGE_VS,
     SG_SHADERSTAGE_FS,
+    SG_SHADERSTAGE_CS,
     _SG_SHADERSTAGE_FORCE_U32 = 0x7FFFFFFF
 } sg_shader_stage;
 
@@ -1434,15 +1901,59 @@ typedef enum sg_action {
     _SG_ACTION_FORCE_U32 = 0x7FFFFFFF
 } sg_action;
 
+/*
+    sg_store_action
+
+    Defines what happens to the content of a render target image at the
+    end of a render pass:
+
+    SG_STOREACTION_STORE:       preserve the rendered content, MSAA render
+                                targets are additionally resolved into
+                                their resolve texture
+    SG_STOREACTION_DONTCARE:    the rendered content isn't needed after
+                                the pass and may be discarded, MSAA render
+                                targets are *not* resolved
+    SG_STOREACTION_RESOLVE:     only valid for MSAA color attachments, resolve
+                                the MSAA surface into the resolve texture and
+                                discard the MSAA surface content
+
+    The default store action is SG_STOREACTION_RESOLVE for MSAA color
+    attachments of offscreen passes, and SG_STOREACTION_STORE for everything
+    else. Set SG_STOREACTION_STORE explicitly if the MSAA surface content
+    must be preserved (e.g. to continue rendering with SG_ACTION_LOAD in a
+    later pass).
+
+    On tile-based GPUs, discarding attachments which are only needed during
+    a pass (most importantly depth-stencil and MSAA surfaces) avoids writing
+    the entire attachment content back to memory at the end of the pass.
+    How this is implemented depends on the backend:
+
+    - GL: glInvalidateFramebuffer() is called at the end of the pass
+      (only on GLES3, WebGL2 or GL 4.3 and up with SOKOL_GLCORE_4X, otherwise store actions are
+      only used to skip the MSAA resolve)
+    - Metal: the store action is mapped to the MTLRenderPassAttachmentDescriptor
+      storeAction
+    - D3D11: store actions are only used to skip the MSAA resolve
+    - WebGPU: the store action is mapped to the WGPUStoreOp of the attachment
+*/
+typedef enum sg_store_action {
+    _SG_STOREACTION_DEFAULT,
+    SG_STOREACTION_STORE,
+    SG_STOREACTION_DONTCARE,
+    SG_STOREACTION_RESOLVE,
+    _SG_STOREACTION_NUM,
+    _SG_STOREACTION_FORCE_U32 = 0x7FFFFFFF
+} sg_store_action;
+
 /*
     sg_pass_action
 
     The sg_pass_action struct defines the actions to be performed
-    at the start of a rendering pass in the functions sg_begin_pass()
+    at the start and end of a rendering pass in the functions sg_begin_pass()
     and sg_begin_default_pass().
 
-    A separate action and clear values can be defined for each
-    color attachment, and for the depth-stencil attachment.
+    A separate action, store action and clear values can be defined for
+    each color attachment, and for the depth-stencil attachment.
 
     The default clear values are defined by the macros:
 
@@ -1455,16 +1966,19 @@ typedef enum sg_action {
 */
 typedef struct sg_color_attachment_action {
     sg_action action;
+    sg_store_action store_action;
     sg_color value;
 } sg_color_attachment_action;
 
 typedef struct sg_depth_attachment_action {
     sg_action action;
+    sg_store_action store_action;
     float value;
 } sg_depth_attachment_action;
 
 typedef struct sg_stencil_attachment_action {
     sg_action action;
+    sg_store_action store_action;
     uint8_t value;
 } sg_stencil_attachment_action;
 
@@ -1491,6 +2005,9 @@ typedef struct sg_pass_action {
     - 0..1 index buffer offsets
     - 0..N vertex shader stage images
     - 0..N fragment shader stage images
+    - 0..N vertex shader stage samplers
+    - 0..N fragment shader stage samplers
+    - 0..N compute shader stage storage buffers
 
     The max number of vertex buffer and shader stage images
     are defined by the SG_MAX_SHADERSTAGE_BUFFERS and
@@ -1498,6 +2015,19 @@ typedef struct sg_pass_action {
 
     The optional buffer offsets can be used to put different unrelated
     chunks of vertex- and/or index-data into the same buffer objects.
+
+    The optional samplers are associated with the image in the same
+    slot index and override the sampler state which has been baked
+    into the image at creation time, an image slot without a sampler
+    uses the image's own sampler state. A sampler can't be bound to
+    a slot without an image, and binding samplers requires
+    sg_features.sampler_objects.
+
+    The compute shader stage storage buffers are only used with compute
+    pipelines (see sg_make_compute_pipeline()), all other bind slots must
+    be empty when applying bindings to a compute pipeline, and the
+    storage buffer slots must be empty for render pipelines. The max
+    number of storage buffers is defined by SG_MAX_SHADERSTAGE_STORAGE_BUFFERS.
 */
 typedef struct sg_bindings {
     uint32_t _start_canary;
@@ -1507,9 +2037,65 @@ typedef struct sg_bindings {
     int index_buffer_offset;
     sg_image vs_images[SG_MAX_SHADERSTAGE_IMAGES];
     sg_image fs_images[SG_MAX_SHADERSTAGE_IMAGES];
+    sg_sampler vs_samplers[SG_MAX_SHADERSTAGE_IMAGES];
+    sg_sampler fs_samplers[SG_MAX_SHADERSTAGE_IMAGES];
+    sg_buffer cs_storage_buffers[SG_MAX_SHADERSTAGE_STORAGE_BUFFERS];
     uint32_t _end_canary;
 } sg_bindings;
 
+/*
+    sg_prepared_bindings
+
+    An sg_bindings struct which has been validated against a specific
+    pipeline object and has its resource handles resolved ahead of time,
+    created with sg_prepare_bindings() and applied with
+    sg_apply_prepared_bindings().
+
+    Applying prepared bindings skips the validation layer and the
+    per-handle pool lookups of sg_apply_bindings(), instead only
+    a cheap check whether the referenced resources are still alive
+    is performed.
+
+    Prepared bindings don't own any resources and don't need to be
+    destroyed, but they must be prepared again when any of the
+    referenced resources has been destroyed and recreated.
+
+    The 'bindings' and 'pipeline' members are copies of the arguments to
+    sg_prepare_bindings(), 'valid' is false if the bindings didn't pass
+    validation. All members starting with an underscore are opaque
+    internal state and must not be accessed or modified.
+*/
+typedef struct sg_prepared_bindings {
+    sg_bindings bindings;
+    sg_pipeline pipeline;
+    bool valid;
+    int _num_vbs;
+    int _num_vs_imgs;
+    int _num_fs_imgs;
+    void* _pip;
+    void* _vbs[SG_MAX_SHADERSTAGE_BUFFERS];
+    void* _ib;
+    void* _vs_imgs[SG_MAX_SHADERSTAGE_IMAGES];
+    void* _fs_imgs[SG_MAX_SHADERSTAGE_IMAGES];
+    void* _vs_smps[SG_MAX_SHADERSTAGE_IMAGES];
+    void* _fs_smps[SG_MAX_SHADERSTAGE_IMAGES];
+} sg_prepared_bindings;
+
+/*
+    sg_draw_range
+
+    One draw call in a batch of draw calls submitted with sg_draw_batch(),
+    the members have the same meaning as the arguments of sg_draw_ex(),
+    except that a num_instances of 0 is treated as 1. Ranges with
+    zero elements are skipped.
+*/
+typedef struct sg_draw_range {
+    int base_element;
+    int num_elements;
+    int num_instances;
+    int base_vertex;
+} sg_draw_range;
+
 /*
     sg_buffer_desc
 
@@ -1602,6 +2188,7 @@ typedef struct sg_image_data {
 
     .type:              SG_IMAGETYPE_2D
     .render_target:     false
+    .transient:         false
     .width              0 (must be set to >0)
     .height             0 (must be set to >0)
     .num_slices         1 (3D textures: depth; array textures: number of layers)
@@ -1640,6 +2227,21 @@ typedef struct sg_image_data {
     Images with usage SG_USAGE_IMMUTABLE must be fully initialized by
     providing a valid .data member which points to initialization data.
 
+    TRANSIENT RENDER TARGETS:
+
+    Render targets which are only needed during a single render pass (for
+    instance depth-stencil buffers, or MSAA color buffers which are resolved
+    at the end of the pass) can be created with .transient = true. The
+    content of a transient image never survives the end of a pass, so it
+    will always be discarded (even if the pass store action is
+    SG_STOREACTION_STORE), it can't be used with SG_ACTION_LOAD, and it
+    cannot be bound as texture or read back. Where the backend allows it,
+    no persistent memory is reserved for transient images (on iOS the
+    Metal texture uses memoryless storage, and on GL and Metal no separate
+    resolve texture is created for MSAA color images).
+
+    Transient images must be 2D render targets with a single mipmap.
+
     ADVANCED TOPIC: Injecting native 3D-API textures:
 
     The following struct members allow to inject your own GL, Metal or D3D11
@@ -1661,11 +2263,16 @@ typedef struct sg_image_data {
 
     The same rules apply as for injecting native buffers (see sg_buffer_desc
     documentation for more details).
+
+    The sampler state in sg_image_desc (filters, wrap modes, border color,
+    anisotropy and LOD range) is used when the image is bound without
+    a separate sampler object (see sg_sampler_desc).
 */
 typedef struct sg_image_desc {
     uint32_t _start_canary;
     sg_image_type type;
     bool render_target;
+    bool transient;
     int width;
     int height;
     int num_slices;
@@ -1697,6 +2304,52 @@ typedef struct sg_image_desc {
     uint32_t _end_canary;
 } sg_image_desc;
 
+/*
+    sg_sampler_desc
+
+    Creation parameters for sg_sampler objects, used in the sg_make_sampler()
+    call. A sampler object holds the texture sampling state which is
+    otherwise baked into images, and is bound next to an image in
+    sg_bindings, so that the same image can be sampled in different
+    ways without having to create a copy of the image.
+
+    The default configuration is:
+
+    .min_filter:        SG_FILTER_NEAREST
+    .mag_filter:        SG_FILTER_NEAREST
+    .wrap_u:            SG_WRAP_REPEAT
+    .wrap_v:            SG_WRAP_REPEAT
+    .wrap_w:            SG_WRAP_REPEAT
+    .border_color       SG_BORDERCOLOR_OPAQUE_BLACK
+    .max_anisotropy     1 (must be 1..16)
+    .min_lod            0.0f
+    .max_lod            FLT_MAX
+    .label              0       (optional string label for trace hooks)
+
+    The members have the same meaning as the sampler state members
+    in sg_image_desc.
+
+    On the GLCORE33 and GLES3 backends, a sampler is a GL sampler object,
+    on D3D11 an ID3D11SamplerState, on Metal an MTLSamplerState and
+    on WebGPU a WGPUSampler. GLES2/WebGL has no sampler objects, so
+    sampler objects can be created there, but binding them is
+    a validation error (check sg_features.sampler_objects).
+*/
+typedef struct sg_sampler_desc {
+    uint32_t _start_canary;
+    sg_filter min_filter;
+    sg_filter mag_filter;
+    sg_wrap wrap_u;
+    sg_wrap wrap_v;
+    sg_wrap wrap_w;
+    sg_border_color border_color;
+    uint32_t max_anisotropy;
+    float min_lod;
+    float max_lod;
+    const char* label;
+    uint32_t _end_canary;
+} sg_sampler_desc;
+
 /*
     sg_shader_desc
 
@@ -1713,6 +2366,9 @@ typedef struct sg_image_desc {
           defaults are "vs_4_0" and "ps_4_0")
         - reflection info for each uniform block used by the shader stage:
             - the size of the uniform block in bytes
+            - an optional GLSL uniform block name (GLCORE33 and GLES3 only), if
+              provided, the uniform block is backed by a uniform buffer object
+              and the uniform data must be in std140 layout
             - reflection info for each uniform block member (only required for GL backends):
                 - member name
                 - member type (SG_UNIFORMTYPE_xxx)
@@ -1722,6 +2378,25 @@ typedef struct sg_image_desc {
             - the sampler type (SG_SAMPLERTYPE_xxx, default is SG_SAMPLERTYPE_FLOAT)
             - the name of the texture sampler (required for GLES2, optional everywhere else)
 
+    - optional auto-instancing information (see sg_shader_instancing_desc)
+
+    Compute shaders only provide the compute shader stage (.cs), the vertex-
+    and fragment-shader-stages and vertex attributes must be left empty.
+    Compute shader stages don't use images, but instead provide reflection
+    info for the storage buffers which are read and written by the shader
+    function:
+
+        - .used must be true for each storage buffer bind slot used by the
+          shader, the bind slots must be contiguous starting at slot 0
+        - .readonly is true if the shader only reads from the storage buffer
+
+    On GL the storage buffer bind slot is the shader storage block binding
+    point, so the storage blocks must be declared with an explicit
+    layout(std430, binding=N) qualifier in the GLSL source.
+
+    Compute shaders can only be used with compute pipelines
+    (see sg_make_compute_pipeline()) and require sg_features.compute.
+
     For all GL backends, shader source-code must be provided. For D3D11 and Metal,
     either shader source-code or byte-code can be provided.
 
@@ -1745,6 +2420,7 @@ typedef struct sg_shader_uniform_desc {
 
 typedef struct sg_shader_uniform_block_desc {
     size_t size;
+    const char* name;           // GLSL uniform block name (GLCORE33 and GLES3 only, see above)
     sg_shader_uniform_desc uniforms[SG_MAX_UB_MEMBERS];
 } sg_shader_uniform_block_desc;
 
@@ -1754,6 +2430,11 @@ typedef struct sg_shader_image_desc {
     sg_sampler_type sampler_type;
 } sg_shader_image_desc;
 
+typedef struct sg_shader_storage_buffer_desc {
+    bool used;
+    bool readonly;
+} sg_shader_storage_buffer_desc;
+
 typedef struct sg_shader_stage_desc {
     const char* source;
     sg_range bytecode;
@@ -1761,13 +2442,57 @@ typedef struct sg_shader_stage_desc {
     const char* d3d11_target;
     sg_shader_uniform_block_desc uniform_blocks[SG_MAX_SHADERSTAGE_UBS];
     sg_shader_image_desc images[SG_MAX_SHADERSTAGE_IMAGES];
+    sg_shader_storage_buffer_desc storage_buffers[SG_MAX_SHADERSTAGE_STORAGE_BUFFERS];
 } sg_shader_stage_desc;
 
+/*
+    sg_shader_instancing_desc
+
+    Opt-in auto-instancing: when enabled, sokol-gfx collects consecutive
+    sg_apply_uniforms() + sg_draw() calls with the same pipeline, bindings
+    and draw range, packs the data of one vertex shader uniform block
+    into a per-instance vertex buffer, and issues a single instanced draw
+    call. This requires a transient vertex buffer (see
+    sg_desc.transient_vertex_buffer_size), the instance data is copied
+    into it.
+
+    The shader must read the uniform block as per-instance vertex
+    attributes instead of an actual uniform block:
+
+    - .uniform_block is the vertex shader uniform block index which
+      provides the per-instance data, its size must be a multiple
+      of 4 and not exceed 256 bytes (on GL, the uniform block doesn't
+      need member reflection info)
+    - .buffer_index is the vertex buffer bind slot of the per-instance
+      data, this must be the last vertex buffer in the pipeline's
+      vertex layout, with step_func SG_VERTEXSTEP_PER_INSTANCE and a
+      stride equal to the uniform block size
+
+    The application leaves the vertex buffer slot .buffer_index empty
+    in sg_bindings and calls sg_apply_uniforms() on the uniform block
+    as usual. The uniform data is sticky, a draw without a preceding
+    sg_apply_uniforms() reuses the previous data, and a draw with
+    num_instances > 1 produces that many instances with the same data.
+
+    Collected draws are flushed when a different pipeline, bindings,
+    draw range or any other uniform block is applied, on viewport and
+    scissor changes, resource updates and destruction, and at the end
+    of the pass. The number of emitted instanced draw calls is counted
+    in sg_frame_stats.num_instancing_batches.
+*/
+typedef struct sg_shader_instancing_desc {
+    bool enabled;
+    int uniform_block;          // vertex shader uniform block which is provided as per-instance vertex data
+    int buffer_index;           // vertex buffer bind slot of the per-instance vertex data
+} sg_shader_instancing_desc;
+
 typedef struct sg_shader_desc {
     uint32_t _start_canary;
     sg_shader_attr_desc attrs[SG_MAX_VERTEX_ATTRIBUTES];
     sg_shader_stage_desc vs;
     sg_shader_stage_desc fs;
+    sg_shader_stage_desc cs;
+    sg_shader_instancing_desc instancing;
     const char* label;
     uint32_t _end_canary;
 } sg_shader_desc;
@@ -1924,6 +2649,25 @@ typedef struct sg_pipeline_desc {
     uint32_t _end_canary;
 } sg_pipeline_desc;
 
+/*
+    sg_compute_pipeline_desc
+
+    The sg_compute_pipeline_desc struct defines the creation parameters
+    for a compute pipeline object, used as argument to the
+    sg_make_compute_pipeline() function. Compute pipelines are regular
+    sg_pipeline objects which can only be applied inside a compute pass
+    (see sg_begin_compute_pass()).
+
+    .shader:    0 (must be initialized with a valid compute sg_shader id!)
+    .label      0 (optional string label for trace hooks)
+*/
+typedef struct sg_compute_pipeline_desc {
+    uint32_t _start_canary;
+    sg_shader shader;
+    const char* label;
+    uint32_t _end_canary;
+} sg_compute_pipeline_desc;
+
 /*
     sg_pass_desc
 
@@ -1960,6 +2704,75 @@ typedef struct sg_pass_desc {
     uint32_t _end_canary;
 } sg_pass_desc;
 
+/*
+    sg_command_list
+
+    A command list records rendering commands into caller-provided
+    memory for later replay on the render thread via
+    sg_submit_command_lists(). Initialize a command list with
+    sg_init_command_list() and a chunk of memory which must remain
+    valid until the command list has been submitted.
+
+    Recording functions (sg_cmd_*) don't access any global sokol-gfx
+    state, so different command lists can be recorded on different
+    threads at the same time without locking (but a single command list
+    must only be recorded by one thread at a time).
+
+    If a command doesn't fit into the remaining memory, the command list
+    goes into the overflow state, the command is dropped, and all
+    following commands until the next sg_reset_command_list() are
+    dropped too.
+
+    Please treat the struct members as private.
+*/
+typedef struct sg_command_list {
+    uint8_t* ptr;
+    size_t size;
+    size_t pos;
+    int num_commands;
+    bool overflow;
+} sg_command_list;
+
+/*
+    sg_async_queue_desc
+
+    The creation parameters of an asynchronous resource creation queue
+    (see sg_init_async_queue()). All values are rounded up to the next
+    power of two.
+
+    .max_packets            64  (max number of queued resource creation requests)
+    .num_reserved_buffers   16  (number of pre-allocated buffer handles)
+    .num_reserved_images    16  (number of pre-allocated image handles)
+*/
+typedef struct sg_async_queue_desc {
+    int max_packets;
+    int num_reserved_buffers;
+    int num_reserved_images;
+} sg_async_queue_desc;
+
+/*
+    sg_async_queue
+
+    A lock-free queue which passes resource creation requests from one
+    worker thread to the render thread, and pre-allocated resource handles
+    from the render thread back to the worker thread. The creation
+    requests are executed on the render thread with sg_drain_async_queue().
+
+    Please treat the struct members as private, they must only be
+    accessed through the sg_async_* functions.
+*/
+typedef struct sg_async_queue {
+    bool valid;
+    void* packets;
+    uint32_t num_packets;
+    uint32_t packet_head;   /* written by the render thread */
+    uint32_t packet_tail;   /* written by the worker thread */
+    uint32_t* reserved[2];  /* pre-allocated buffer ([0]) and image ([1]) ids */
+    uint32_t num_reserved[2];
+    uint32_t reserved_head[2];  /* written by the worker thread */
+    uint32_t reserved_tail[2];  /* written by the render thread */
+} sg_async_queue;
+
 /*
     sg_trace_hooks
 
@@ -1979,23 +2792,29 @@ typedef struct sg_trace_hooks {
     void (*make_image)(const sg_image_desc* desc, sg_image result, void* user_data);
     void (*make_shader)(const sg_shader_desc* desc, sg_shader result, void* user_data);
     void (*make_pipeline)(const sg_pipeline_desc* desc, sg_pipeline result, void* user_data);
+    void (*make_compute_pipeline)(const sg_compute_pipeline_desc* desc, sg_pipeline result, void* user_data);
     void (*make_pass)(const sg_pass_desc* desc, sg_pass result, void* user_data);
+    void (*make_sampler)(const sg_sampler_desc* desc, sg_sampler result, void* user_data);
     void (*destroy_buffer)(sg_buffer buf, void* user_data);
     void (*destroy_image)(sg_image img, void* user_data);
     void (*destroy_shader)(sg_shader shd, void* user_data);
     void (*destroy_pipeline)(sg_pipeline pip, void* user_data);
     void (*destroy_pass)(sg_pass pass, void* user_data);
+    void (*destroy_sampler)(sg_sampler smp, void* user_data);
     void (*update_buffer)(sg_buffer buf, const sg_range* data, void* user_data);
     void (*update_image)(sg_image img, const sg_image_data* data, void* user_data);
+    void (*update_image_region)(sg_image img, int mip_level, int slice, int x, int y, int width, int height, const sg_range* data, void* user_data);
     void (*append_buffer)(sg_buffer buf, const sg_range* data, int result, void* user_data);
     void (*begin_default_pass)(const sg_pass_action* pass_action, int width, int height, void* user_data);
     void (*begin_pass)(sg_pass pass, const sg_pass_action* pass_action, void* user_data);
+    void (*begin_compute_pass)(void* user_data);
     void (*apply_viewport)(int x, int y, int width, int height, bool origin_top_left, void* user_data);
     void (*apply_scissor_rect)(int x, int y, int width, int height, bool origin_top_left, void* user_data);
     void (*apply_pipeline)(sg_pipeline pip, void* user_data);
     void (*apply_bindings)(const sg_bindings* bindings, void* user_data);
     void (*apply_uniforms)(sg_shader_stage stage, int ub_index, const sg_range* data, void* user_data);
     void (*draw)(int base_element, int num_elements, int num_instances, void* user_data);
+    void (*dispatch)(int num_groups_x, int num_groups_y, int num_groups_z, void* user_data);
     void (*end_pass)(void* user_data);
     void (*commit)(void* user_data);
     void (*alloc_buffer)(sg_buffer result, void* user_data);
@@ -2003,26 +2822,32 @@ typedef struct sg_trace_hooks {
     void (*alloc_shader)(sg_shader result, void* user_data);
     void (*alloc_pipeline)(sg_pipeline result, void* user_data);
     void (*alloc_pass)(sg_pass result, void* user_data);
+    void (*alloc_sampler)(sg_sampler result, void* user_data);
     void (*dealloc_buffer)(sg_buffer buf_id, void* user_data);
     void (*dealloc_image)(sg_image img_id, void* user_data);
     void (*dealloc_shader)(sg_shader shd_id, void* user_data);
     void (*dealloc_pipeline)(sg_pipeline pip_id, void* user_data);
     void (*dealloc_pass)(sg_pass pass_id, void* user_data);
+    void (*dealloc_sampler)(sg_sampler smp_id, void* user_data);
     void (*init_buffer)(sg_buffer buf_id, const sg_buffer_desc* desc, void* user_data);
     void (*init_image)(sg_image img_id, const sg_image_desc* desc, void* user_data);
     void (*init_shader)(sg_shader shd_id, const sg_shader_desc* desc, void* user_data);
     void (*init_pipeline)(sg_pipeline pip_id, const sg_pipeline_desc* desc, void* user_data);
+    void (*init_compute_pipeline)(sg_pipeline pip_id, const sg_compute_pipeline_desc* desc, void* user_data);
     void (*init_pass)(sg_pass pass_id, const sg_pass_desc* desc, void* user_data);
+    void (*init_sampler)(sg_sampler smp_id, const sg_sampler_desc* desc, void* user_data);
     void (*uninit_buffer)(sg_buffer buf_id, void* user_data);
     void (*uninit_image)(sg_image img_id, void* user_data);
     void (*uninit_shader)(sg_shader shd_id, void* user_data);
     void (*uninit_pipeline)(sg_pipeline pip_id, void* user_data);
     void (*uninit_pass)(sg_pass pass_id, void* user_data);
+    void (*uninit_sampler)(sg_sampler smp_id, void* user_data);
     void (*fail_buffer)(sg_buffer buf_id, void* user_data);
     void (*fail_image)(sg_image img_id, void* user_data);
     void (*fail_shader)(sg_shader shd_id, void* user_data);
     void (*fail_pipeline)(sg_pipeline pip_id, void* user_data);
     void (*fail_pass)(sg_pass pass_id, void* user_data);
+    void (*fail_sampler)(sg_sampler smp_id, void* user_data);
     void (*push_debug_group)(const char* name, void* user_data);
     void (*pop_debug_group)(void* user_data);
     void (*err_buffer_pool_exhausted)(void* user_data);
@@ -2030,6 +2855,7 @@ typedef struct sg_trace_hooks {
     void (*err_shader_pool_exhausted)(void* user_data);
     void (*err_pipeline_pool_exhausted)(void* user_data);
     void (*err_pass_pool_exhausted)(void* user_data);
+    void (*err_sampler_pool_exhausted)(void* user_data);
     void (*err_context_mismatch)(void* user_data);
     void (*err_pass_invalid)(void* user_data);
     void (*err_draw_invalid)(void* user_data);
@@ -2042,6 +2868,7 @@ typedef struct sg_trace_hooks {
     sg_shader_info
     sg_pipeline_info
     sg_pass_info
+    sg_sampler_info
 
     These structs contain various internal resource attributes which
     might be useful for debug-inspection. Please don't rely on the
@@ -2056,6 +2883,7 @@ typedef struct sg_trace_hooks {
     sg_query_shader_info()
     sg_query_pipeline_info()
     sg_query_pass_info()
+    sg_query_sampler_info()
 */
 typedef struct sg_slot_info {
     sg_resource_state state;    /* the current state of this resource slot */
@@ -2071,6 +2899,7 @@ typedef struct sg_buffer_info {
     bool append_overflow;           /* is buffer in overflow state (due to sg_append_buffer) */
     int num_slots;                  /* number of renaming-slots for dynamically updated buffers */
     int active_slot;                /* currently active write-slot for dynamically updated buffers */
+    size_t num_bytes;               /* approximate GPU memory size including all slots (see sg_memory_stats) */
 } sg_buffer_info;
 
 typedef struct sg_image_info {
@@ -2080,6 +2909,7 @@ typedef struct sg_image_info {
     int active_slot;                /* currently active write-slot for dynamically updated images */
     int width;                      /* image width */
     int height;                     /* image height */
+    size_t num_bytes;               /* approximate GPU memory size including all slots (see sg_memory_stats) */
 } sg_image_info;
 
 typedef struct sg_shader_info {
@@ -2094,6 +2924,226 @@ typedef struct sg_pass_info {
     sg_slot_info slot;              /* resource pool slot info */
 } sg_pass_info;
 
+typedef struct sg_sampler_info {
+    sg_slot_info slot;              /* resource pool slot info */
+} sg_sampler_info;
+
+/*
+    sg_state_filter_stats
+
+    The number of redundant sg_apply_pipeline(), sg_apply_bindings() and
+    sg_apply_uniforms() calls which have been dropped by the state filter
+    in the previous frame (see the sg_desc documentation below), returned
+    by sg_query_state_filter_stats().
+*/
+typedef struct sg_state_filter_stats {
+    uint32_t frame_index;           /* frame index the counters belong to */
+    int num_dropped_pipelines;
+    int num_dropped_bindings;
+    int num_dropped_uniforms;
+} sg_state_filter_stats;
+
+/*
+    sg_frame_stats
+
+    Per-frame counters of rendering and resource update calls, the
+    counters are reset in sg_commit(). sg_query_frame_stats() returns
+    the counters of the previous frame.
+
+    Optionally, sokol-gfx keeps a history of the counters for the last
+    N frames when sg_desc.frame_stats_history is > 0, this history
+    can be copied out with sg_query_frame_stats_history().
+
+    Only successful calls are counted (e.g. draw calls which are
+    dropped because of invalid resources are not counted). Calls which
+    are dropped by the redundant state filter are counted, since they
+    are valid calls (see sg_state_filter_stats).
+
+    The uniform buffer counters are only updated by backends which copy
+    uniform data into a per-frame uniform buffer (Metal, WebGPU, and GL
+    for uniform blocks backed by uniform buffer objects), use
+    them to choose sg_desc.uniform_buffer_size, or to detect frames in
+    which uniform buffer chaining kicked in (see sg_desc).
+*/
+typedef struct sg_frame_stats {
+    uint32_t frame_index;           /* frame index the counters belong to */
+    int num_passes;                 /* number of rendering passes */
+    int num_apply_pipeline;         /* number of sg_apply_pipeline() calls */
+    int num_apply_bindings;         /* number of sg_apply_bindings() and sg_apply_prepared_bindings() calls */
+    int num_apply_uniforms;         /* number of sg_apply_uniforms() calls */
+    int num_draw;                   /* number of sg_draw() calls */
+    uint64_t num_elements;          /* sum of num_elements*num_instances of all draw calls */
+    int num_dispatch;               /* number of sg_dispatch() calls */
+    int num_update_buffer;          /* number of sg_update_buffer() calls */
+    int num_append_buffer;          /* number of sg_append_buffer() calls */
+    int num_update_image;           /* number of sg_update_image() calls */
+    int num_update_image_region;    /* number of sg_update_image_region() calls */
+    size_t size_apply_uniforms;     /* overall number of uniform bytes */
+    size_t size_update_buffer;      /* overall number of bytes written by sg_update_buffer() */
+    size_t size_append_buffer;      /* overall number of bytes written by sg_append_buffer() */
+    size_t size_update_image;       /* overall number of bytes written by sg_update_image() */
+    size_t size_update_image_region;    /* overall number of bytes written by sg_update_image_region() */
+    size_t size_uniform_buffer;     /* high-water mark of the backend's per-frame uniform buffer (incl. alignment padding) */
+    int num_uniform_buffer_chains;  /* number of additional uniform buffers chained in the frame (GL: number of times the uniform buffer grew) */
+    int num_uniform_buffer_overflows;   /* number of sg_apply_uniforms() calls dropped because the uniform buffer was exhausted */
+    int num_instancing_batches;     /* number of instanced draw calls emitted by auto-instancing (see sg_shader_instancing_desc) */
+    int num_async_created;          /* number of resources created by sg_drain_async_queue() */
+    int num_destroy_deferred;       /* number of buffers and images queued for deferred destruction (see sg_desc.enable_deferred_destroy) */
+    int num_destroy_released;       /* number of queued buffers and images released in sg_commit() */
+    size_t size_destroy_deferred;   /* overall number of bytes queued for deferred destruction */
+    size_t size_destroy_released;   /* overall number of bytes released in sg_commit() */
+    size_t size_destroy_queue;      /* number of bytes still in the deferred destruction queue at the end of the frame */
+} sg_frame_stats;
+
+/*
+    sg_memory_stats
+
+    The approximate GPU memory used by all buffers and images which
+    currently exist in sokol-gfx, returned by sg_query_memory_stats().
+    Unlike sg_frame_stats, the counters are updated immediately
+    when a buffer or image is created or destroyed.
+
+    The size of a resource is computed from its creation parameters:
+    all mipmaps, slices and cube faces, the MSAA surface of MSAA render
+    targets, and the SG_NUM_INFLIGHT_FRAMES copies of dynamic and stream
+    resources (except on D3D11 where the driver manages those copies).
+    Row and size alignment, compression overhead of the driver and the
+    backend's internal buffers (e.g. uniform buffers) are not included.
+    The same size is reported per resource in sg_buffer_info.num_bytes and
+    sg_image_info.num_bytes.
+
+    Buffers and images waiting in the deferred destruction queue (see
+    sg_desc.enable_deferred_destroy) still occupy memory, they are included
+    in all counters and additionally counted in .deferred.
+
+    .over_budget is true if one of the soft budgets in
+    sg_desc.memory_budget is exceeded.
+*/
+typedef struct sg_memory_counter {
+    int num;                        /* number of resources */
+    size_t bytes;                   /* overall size in bytes */
+} sg_memory_counter;
+
+typedef struct sg_memory_stats {
+    sg_memory_counter total;        /* all buffers and images */
+    sg_memory_counter buffers;
+    sg_memory_counter images;
+    sg_memory_counter immutable;    /* buffers and images by usage */
+    sg_memory_counter dynamic;
+    sg_memory_counter stream;
+    sg_memory_counter vertex_buffers;   /* buffers by type */
+    sg_memory_counter index_buffers;
+    sg_memory_counter storage_buffers;
+    sg_memory_counter images_2d;    /* images by type */
+    sg_memory_counter images_cube;
+    sg_memory_counter images_3d;
+    sg_memory_counter images_array;
+    sg_memory_counter render_targets;   /* render target images (also counted by type) */
+    sg_memory_counter deferred;     /* destroyed buffers and images waiting for deferred destruction */
+    bool over_budget;
+} sg_memory_stats;
+
+/*
+    sg_memory_budget
+
+    Optional soft limits for the GPU memory used by buffers and images
+    (see sg_desc), a zero value means 'no budget'. Exceeding a budget
+    doesn't cause resource creation to fail.
+*/
+typedef struct sg_memory_budget {
+    size_t total;
+    size_t buffers;
+    size_t images;
+} sg_memory_budget;
+
+/*
+    sg_gpu_timings
+
+    The GPU execution times of one frame, returned by sg_query_gpu_timings()
+    when sg_desc.enable_gpu_timing is true. Each rendering pass, and each
+    sg_begin_timer()/sg_end_timer() pair results in one sg_gpu_timing item
+    (in the order of the begin calls), up to SG_MAX_GPU_TIMINGS items
+    per frame, any further timers in the same frame are ignored.
+
+    The results lag a few frames behind the current frame (.frame_index is
+    the frame index at which the timings were recorded, 0 if no results are
+    available yet). The timings of a frame are read back at the earliest in
+    the sg_commit() call of the next frame (the dummy backend always reports
+    them exactly then). The readback never blocks, if the GPU is still not
+    done with a frame 3 frames later, the timings of that frame are dropped.
+
+    .frame_duration_ns is the GPU time between the start of the first and
+    the end of the last timer in the frame.
+*/
+typedef struct sg_gpu_timing {
+    const char* label;      /* label from sg_begin_timer(), or 0 for a pass */
+    sg_pass pass;           /* the timed pass (SG_INVALID_ID for the default pass and for sg_begin_timer()) */
+    int depth;              /* nesting depth (0 for top-level timers) */
+    uint64_t duration_ns;   /* GPU execution time in nanoseconds */
+} sg_gpu_timing;
+
+typedef struct sg_gpu_timings {
+    uint32_t frame_index;
+    uint64_t frame_duration_ns;
+    int num_timings;
+    sg_gpu_timing timings[SG_MAX_GPU_TIMINGS];
+} sg_gpu_timings;
+
+/*
+    sg_image_region
+
+    A rectangular area in one mipmap and slice of an image, used as
+    argument to sg_read_image_async() and sg_read_pass_attachment_async().
+    A zero width or height means 'up to the right or bottom border of the
+    mipmap'. A null pointer instead of an sg_image_region reads the whole
+    first mipmap of the first slice.
+
+    Only images with a renderable color pixel format can be read back.
+    The pixel data is returned tightly packed in the image's pixel format,
+    with the same row order that sg_update_image() expects.
+*/
+typedef struct sg_image_region {
+    int mip_level;
+    int slice;      /* cube texture: face; array texture: layer; 3D texture: slice */
+    int x;
+    int y;
+    int width;
+    int height;
+} sg_image_region;
+
+/*
+    sg_image_readback
+
+    The result of an asynchronous image readback, passed to the
+    sg_read_image_callback. The pixel data is only valid until the
+    callback returns.
+*/
+typedef struct sg_image_readback {
+    sg_image image;
+    sg_image_region region;     /* the region with zero width and height resolved */
+    sg_range data;
+    void* user_data;
+} sg_image_readback;
+
+typedef void (*sg_read_image_callback)(const sg_image_readback* readback);
+
+/*
+    sg_transient_range
+
+    A suballocation in one of the transient vertex or index buffers
+    owned by sokol-gfx, returned by sg_alloc_transient(). Put the
+    buffer and offset into the vertex_buffers[] / vertex_buffer_offsets[]
+    or index_buffer / index_buffer_offset items of sg_bindings.
+
+    A transient range is only valid until the next sg_commit(). If the
+    transient buffer is exhausted (or wasn't enabled in sg_desc),
+    .buffer will be SG_INVALID_ID.
+*/
+typedef struct sg_transient_range {
+    sg_buffer buffer;
+    int offset;
+} sg_transient_range;
+
 /*
     sg_desc
 
@@ -2115,9 +3165,155 @@ typedef struct sg_pass_info {
     .pipeline_pool_size     64
     .pass_pool_size         16
     .context_pool_size      16
+    .sampler_pool_size      64
+    .growable_pools         false
     .sampler_cache_size     64
     .uniform_buffer_size    4 MB (4*1024*1024)
+    .uniform_buffer_chaining    false
     .staging_buffer_size    8 MB (8*1024*1024)
+    .enable_state_filter    false
+    .frame_stats_history    0
+    .transient_vertex_buffer_size   0
+    .transient_index_buffer_size    0
+    .enable_shader_cache    false
+    .shader_cache_data      { 0, 0 }
+    .vao_cache_size         0
+    .enable_persistent_buffers  false
+    .image_upload_buffers   0
+    .enable_gpu_timing      false
+    .enable_deferred_destroy    false
+    .memory_budget          { 0, 0, 0 } (no budgets)
+
+    If .growable_pools is true, the resource pools no longer fail
+    resource creation when they run out of free slots, but instead
+    grow by adding a chunk which doubles the pool's capacity. The
+    initial capacity is exactly the requested pool size (plus the
+    reserved slot 0), so a .buffer_pool_size of 128 results in
+    129 slots, which grow to 258, 516 and so on. Existing resource
+    handles and resource pointers remain valid when a pool grows.
+    The maximum size of a pool is defined by the number of bits in
+    a resource id reserved for the slot index
+    (SOKOL_GFX_SLOT_BITS, default 16, so a pool can hold at most
+    65535 items). The remaining bits of a resource id are a generation
+    counter which is used to detect dangling handles, a 24/8 split
+    allows for much bigger pools but a dangling handle will match a
+    new resource after 256 reuses of the same slot.
+
+    If .transient_vertex_buffer_size and/or .transient_index_buffer_size
+    is > 0, sokol-gfx creates a shared stream buffer of that size (per
+    frame) from which any code can suballocate per-frame geometry with
+    sg_alloc_transient(), instead of each system managing its own
+    dynamic buffers. Like all stream buffers, the transient buffers are
+    multi-buffered internally so that data written in the current
+    frame doesn't overwrite data still in use by the GPU. The transient
+    buffers belong to the default context.
+
+    On Metal and WebGPU (and on GLCORE33/GLES3 for uniform blocks which
+    are backed by a uniform buffer object, see sg_shader_desc), the uniform
+    data of sg_apply_uniforms() is copied into a per-frame uniform buffer
+    of size .uniform_buffer_size. If this buffer is exhausted, further
+    sg_apply_uniforms() calls in the same frame are dropped (and counted
+    in sg_frame_stats.num_uniform_buffer_overflows).
+    Setting .uniform_buffer_chaining to true (Metal and GLCORE33/GLES3
+    only) will instead continue writing uniform data: on Metal in an
+    additional uniform buffer of the same size (up to 7 additional buffers
+    per frame), those are created on demand and kept around for later
+    frames. On GLCORE33/GLES3, the exhausted uniform buffer is replaced by
+    a buffer of twice the size (up to 8 times per frame), the bigger buffer
+    is kept for later frames. On GLCORE33/GLES3 the uniform buffer is only
+    created with the first shader which uses a uniform buffer object.
+    The per-frame high-water mark (including the bytes written into chained
+    or outgrown buffers) is reported in sg_frame_stats.size_uniform_buffer.
+
+    If .enable_state_filter is true, a state filter drops redundant calls
+    to sg_apply_pipeline(), sg_apply_bindings() and sg_apply_uniforms()
+    before they reach the 3D backend (applying the same pipeline again,
+    applying identical bindings, or applying byte-identical uniform data
+    to the same uniform block slot). The validation layer and trace hooks
+    still see all calls. The number of dropped calls can be
+    inspected with sg_query_state_filter_stats(). When the state filter
+    is enabled, sg_reset_state_cache() must be called after calling into
+    the underlying 3D-API directly on all backends (including D3D11),
+    otherwise sokol-gfx may drop a call which would restore the state.
+
+    If .enable_shader_cache is true (and sg_features.shader_cache is
+    supported), sokol-gfx keeps the backend's compiled representation
+    of each shader created with sg_make_shader() (on GL the linked
+    program binary, desktop GL needs SOKOL_GLCORE_4X), keyed by a hash of the shader sources and
+    attribute names. The cache can be serialized with
+    sg_save_shader_cache(), and passed back into the next sg_setup()
+    call via .shader_cache_data to warm-start the cache, the data is
+    copied and can be freed after sg_setup() returns. Cached binaries
+    are only valid for the same GPU and driver version, if the driver
+    rejects a cached binary, sokol-gfx silently falls back to compiling
+    the shader and replaces the cache entry. A .shader_cache_data blob
+    which doesn't look like a shader cache is ignored.
+
+    If .vao_cache_size is > 0 (GLCORE33 and GLES3 only, ignored on GLES2),
+    the GL backend keeps up to .vao_cache_size vertex array objects per
+    context, keyed by the vertex layout of the current pipeline, the vertex
+    buffers and the index buffer. A cache hit in sg_apply_bindings() binds
+    the cached vertex array object with a single glBindVertexArray() call
+    instead of re-specifying the vertex attributes. Vertex buffer offsets
+    are not part of the key, if they differ from the previous use of the
+    vertex array object (e.g. with sg_append_buffer() or transient
+    buffers), only the attribute pointers of the affected attributes are
+    re-specified. When the cache is full, the least recently used vertex
+    array object is replaced. Vertex array objects referencing a buffer are
+    deleted when the buffer is destroyed.
+
+    If .enable_persistent_buffers is true (and sg_features.persistent_buffers
+    is supported, currently only on desktop GL 4.4 or GL_ARB_buffer_storage
+    with SOKOL_GLCORE_4X),
+    the GL backend allocates each dynamic and stream buffer as a single
+    persistently mapped buffer which holds one region per in-flight frame
+    (instead of one GL buffer object per in-flight frame).
+    sg_update_buffer() and sg_append_buffer() copy the data directly into the
+    mapped region. Before a region is overwritten, the CPU waits on a fence
+    for the frame which last used the region, so for best results, update a
+    buffer either every frame or rarely. Buffers injected with
+    sg_buffer_desc.gl_buffers are not affected.
+
+    If .image_upload_buffers is > 0 (GLCORE33 and GLES3 only, not on WebGL),
+    the GL backend uploads image data of sg_make_image() and sg_update_image()
+    through a ring of .image_upload_buffers pixel buffer objects instead of
+    directly from client memory, each pixel buffer object grows on demand to
+    the largest upload it has seen. The CPU only waits if all pixel buffer
+    objects are still in use by the GPU. Use sg_query_image_upload_done()
+    to check whether the last upload into an image has been completed.
+
+    If .enable_gpu_timing is true (and sg_features.gpu_timing is supported),
+    the GPU execution time of each rendering pass and each
+    sg_begin_timer()/sg_end_timer() pair is measured with timestamp queries
+    and can be inspected with sg_query_gpu_timings() a few frames later.
+
+    If .enable_deferred_destroy is true, sg_destroy_buffer() and
+    sg_destroy_image() (and sg_uninit_buffer()/sg_uninit_image()) invalidate
+    the handle and free the pool slot immediately, but the backend objects are only released in the
+    sg_commit() call SG_NUM_INFLIGHT_FRAMES frames later, when the GPU
+    is done with the frames which might still use them. This avoids
+    implicit synchronization in the 3D API driver, and makes it safe to
+    destroy buffers and images anywhere in a frame. The queued objects
+    are only released while the context which created them is active,
+    sg_discard_context() and sg_shutdown() release them immediately. The
+    number and size of the queued objects is reported in sg_frame_stats.
+    Shaders, pipelines, passes and samplers are always destroyed immediately.
+
+    The .memory_budget items are soft limits in bytes for the overall GPU
+    memory of buffers and images, and for buffers and images separately
+    (see sg_memory_stats). At the end of each sg_commit() in which one
+    of the budgets is exceeded, the callback .memory_budget_cb or
+    .memory_budget_userdata_cb is called with the current memory stats,
+    this is the place to evict resources (e.g. in a texture streaming
+    system). The callback is called from inside sg_commit(), it may
+    destroy and create resources, but must not call any rendering
+    functions. .memory_budget_user_data is passed to
+    .memory_budget_userdata_cb.
+
+    If .frame_stats_history is > 0, sokol-gfx keeps the per-frame counters
+    (see sg_frame_stats) of the last .frame_stats_history frames
+    in a ring buffer, these can be inspected with
+    sg_query_frame_stats_history().
 
     .context.color_format: default value depends on selected backend:
         all GL backends:    SG_PIXELFORMAT_RGBA8
@@ -2257,9 +3453,27 @@ typedef struct sg_desc {
     int pipeline_pool_size;
     int pass_pool_size;
     int context_pool_size;
+    int sampler_pool_size;
+    bool growable_pools;
     int uniform_buffer_size;
+    bool uniform_buffer_chaining;
     int staging_buffer_size;
     int sampler_cache_size;
+    bool enable_state_filter;
+    int frame_stats_history;
+    int transient_vertex_buffer_size;
+    int transient_index_buffer_size;
+    bool enable_shader_cache;
+    sg_range shader_cache_data;
+    int vao_cache_size;
+    bool enable_persistent_buffers;
+    int image_upload_buffers;
+    bool enable_gpu_timing;
+    bool enable_deferred_destroy;
+    sg_memory_budget memory_budget;
+    void (*memory_budget_cb)(const sg_memory_stats* stats);
+    void (*memory_budget_userdata_cb)(const sg_memory_stats* stats, void* user_data);
+    void* memory_budget_user_data;
     sg_context_desc context;
     uint32_t _end_canary;
 } sg_desc;
@@ -2272,43 +3486,95 @@ SOKOL_GFX_API_DECL void sg_reset_state_cache(void);
 SOKOL_GFX_API_DECL sg_trace_hooks sg_install_trace_hooks(const sg_trace_hooks* trace_hooks);
 SOKOL_GFX_API_DECL void sg_push_debug_group(const char* name);
 SOKOL_GFX_API_DECL void sg_pop_debug_group(void);
+SOKOL_GFX_API_DECL void sg_begin_timer(const char* label);
+SOKOL_GFX_API_DECL void sg_end_timer(void);
 
 /* resource creation, destruction and updating */
 SOKOL_GFX_API_DECL sg_buffer sg_make_buffer(const sg_buffer_desc* desc);
 SOKOL_GFX_API_DECL sg_image sg_make_image(const sg_image_desc* desc);
 SOKOL_GFX_API_DECL sg_shader sg_make_shader(const sg_shader_desc* desc);
 SOKOL_GFX_API_DECL sg_pipeline sg_make_pipeline(const sg_pipeline_desc* desc);
+SOKOL_GFX_API_DECL sg_pipeline sg_make_compute_pipeline(const sg_compute_pipeline_desc* desc);
 SOKOL_GFX_API_DECL sg_pass sg_make_pass(const sg_pass_desc* desc);
+SOKOL_GFX_API_DECL sg_sampler sg_make_sampler(const sg_sampler_desc* desc);
 SOKOL_GFX_API_DECL void sg_destroy_buffer(sg_buffer buf);
 SOKOL_GFX_API_DECL void sg_destroy_image(sg_image img);
 SOKOL_GFX_API_DECL void sg_destroy_shader(sg_shader shd);
 SOKOL_GFX_API_DECL void sg_destroy_pipeline(sg_pipeline pip);
 SOKOL_GFX_API_DECL void sg_destroy_pass(sg_pass pass);
+SOKOL_GFX_API_DECL void sg_destroy_sampler(sg_sampler smp);
+SOKOL_GFX_API_DECL void sg_make_buffers(const sg_buffer_desc* descs, int count, sg_buffer* out_bufs);
+SOKOL_GFX_API_DECL void sg_make_images(const sg_image_desc* descs, int count, sg_image* out_imgs);
+SOKOL_GFX_API_DECL void sg_make_shaders(const sg_shader_desc* descs, int count, sg_shader* out_shds);
+SOKOL_GFX_API_DECL void sg_make_pipelines(const sg_pipeline_desc* descs, int count, sg_pipeline* out_pips);
+SOKOL_GFX_API_DECL void sg_make_passes(const sg_pass_desc* descs, int count, sg_pass* out_passes);
+SOKOL_GFX_API_DECL void sg_make_samplers(const sg_sampler_desc* descs, int count, sg_sampler* out_smps);
+SOKOL_GFX_API_DECL void sg_destroy_buffers(const sg_buffer* bufs, int count);
+SOKOL_GFX_API_DECL void sg_destroy_images(const sg_image* imgs, int count);
+SOKOL_GFX_API_DECL void sg_destroy_shaders(const sg_shader* shds, int count);
+SOKOL_GFX_API_DECL void sg_destroy_pipelines(const sg_pipeline* pips, int count);
+SOKOL_GFX_API_DECL void sg_destroy_passes(const sg_pass* passes, int count);
+SOKOL_GFX_API_DECL void sg_destroy_samplers(const sg_sampler* smps, int count);
 SOKOL_GFX_API_DECL void sg_update_buffer(sg_buffer buf, const sg_range* data);
 SOKOL_GFX_API_DECL void sg_update_image(sg_image img, const sg_image_data* data);
+SOKOL_GFX_API_DECL void sg_update_image_region(sg_image img, int mip_level, int slice, int x, int y, int width, int height, const sg_range* data);
 SOKOL_GFX_API_DECL int sg_append_buffer(sg_buffer buf, const sg_range* data);
 SOKOL_GFX_API_DECL bool sg_query_buffer_overflow(sg_buffer buf);
+SOKOL_GFX_API_DECL sg_transient_range sg_alloc_transient(sg_buffer_type type, const sg_range* data);
+SOKOL_GFX_API_DECL bool sg_read_image_async(sg_image img, const sg_image_region* region, sg_read_image_callback callback, void* user_data);
+SOKOL_GFX_API_DECL bool sg_read_pass_attachment_async(sg_pass pass, int color_index, const sg_image_region* region, sg_read_image_callback callback, void* user_data);
 
 /* rendering functions */
 SOKOL_GFX_API_DECL void sg_begin_default_pass(const sg_pass_action* pass_action, int width, int height);
 SOKOL_GFX_API_DECL void sg_begin_default_passf(const sg_pass_action* pass_action, float width, float height);
 SOKOL_GFX_API_DECL void sg_begin_pass(sg_pass pass, const sg_pass_action* pass_action);
+SOKOL_GFX_API_DECL void sg_begin_compute_pass(void);
 SOKOL_GFX_API_DECL void sg_apply_viewport(int x, int y, int width, int height, bool origin_top_left);
 SOKOL_GFX_API_DECL void sg_apply_viewportf(float x, float y, float width, float height, bool origin_top_left);
 SOKOL_GFX_API_DECL void sg_apply_scissor_rect(int x, int y, int width, int height, bool origin_top_left);
 SOKOL_GFX_API_DECL void sg_apply_scissor_rectf(float x, float y, float width, float height, bool origin_top_left);
 SOKOL_GFX_API_DECL void sg_apply_pipeline(sg_pipeline pip);
 SOKOL_GFX_API_DECL void sg_apply_bindings(const sg_bindings* bindings);
+SOKOL_GFX_API_DECL sg_prepared_bindings sg_prepare_bindings(sg_pipeline pip, const sg_bindings* bindings);
+SOKOL_GFX_API_DECL void sg_apply_prepared_bindings(const sg_prepared_bindings* bindings);
 SOKOL_GFX_API_DECL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data);
 SOKOL_GFX_API_DECL void sg_draw(int base_element, int num_elements, int num_instances);
+SOKOL_GFX_API_DECL void sg_draw_ex(int base_element, int num_elements, int num_instances, int base_vertex);
+SOKOL_GFX_API_DECL void sg_draw_batch(const sg_draw_range* ranges, int count);
+SOKOL_GFX_API_DECL void sg_dispatch(int num_groups_x, int num_groups_y, int num_groups_z);
 SOKOL_GFX_API_DECL void sg_end_pass(void);
 SOKOL_GFX_API_DECL void sg_commit(void);
 
+/* deferred command recording (recording functions are thread-safe per command list) */
+SOKOL_GFX_API_DECL void sg_init_command_list(sg_command_list* cl, void* ptr, size_t size);
+SOKOL_GFX_API_DECL void sg_reset_command_list(sg_command_list* cl);
+SOKOL_GFX_API_DECL bool sg_command_list_overflow(const sg_command_list* cl);
+SOKOL_GFX_API_DECL void sg_cmd_apply_viewport(sg_command_list* cl, int x, int y, int width, int height, bool origin_top_left);
+SOKOL_GFX_API_DECL void sg_cmd_apply_scissor_rect(sg_command_list* cl, int x, int y, int width, int height, bool origin_top_left);
+SOKOL_GFX_API_DECL void sg_cmd_apply_pipeline(sg_command_list* cl, sg_pipeline pip);
+SOKOL_GFX_API_DECL void sg_cmd_apply_bindings(sg_command_list* cl, const sg_bindings* bindings);
+SOKOL_GFX_API_DECL void sg_cmd_apply_uniforms(sg_command_list* cl, sg_shader_stage stage, int ub_index, const sg_range* data);
+SOKOL_GFX_API_DECL void sg_cmd_draw(sg_command_list* cl, int base_element, int num_elements, int num_instances);
+SOKOL_GFX_API_DECL void sg_cmd_draw_ex(sg_command_list* cl, int base_element, int num_elements, int num_instances, int base_vertex);
+SOKOL_GFX_API_DECL void sg_cmd_draw_batch(sg_command_list* cl, const sg_draw_range* ranges, int count);
+SOKOL_GFX_API_DECL void sg_cmd_apply_prepared_bindings(sg_command_list* cl, const sg_prepared_bindings* bindings);
+SOKOL_GFX_API_DECL void sg_cmd_dispatch(sg_command_list* cl, int num_groups_x, int num_groups_y, int num_groups_z);
+SOKOL_GFX_API_DECL void sg_cmd_update_image_region(sg_command_list* cl, sg_image img, int mip_level, int slice, int x, int y, int width, int height, const sg_range* data);
+SOKOL_GFX_API_DECL void sg_submit_command_lists(const sg_command_list* lists, int num_lists);
+
+/* asynchronous resource creation (sg_async_make_* can be called on one worker thread per queue) */
+SOKOL_GFX_API_DECL void sg_init_async_queue(sg_async_queue* q, const sg_async_queue_desc* desc);
+SOKOL_GFX_API_DECL void sg_discard_async_queue(sg_async_queue* q);
+SOKOL_GFX_API_DECL sg_buffer sg_async_make_buffer(sg_async_queue* q, const sg_buffer_desc* desc);
+SOKOL_GFX_API_DECL sg_image sg_async_make_image(sg_async_queue* q, const sg_image_desc* desc);
+SOKOL_GFX_API_DECL int sg_drain_async_queue(sg_async_queue* q, double budget_ms);
+
 /* getting information */
 SOKOL_GFX_API_DECL sg_desc sg_query_desc(void);
 SOKOL_GFX_API_DECL sg_backend sg_query_backend(void);
 SOKOL_GFX_API_DECL sg_features sg_query_features(void);
 SOKOL_GFX_API_DECL sg_limits sg_query_limits(void);
+SOKOL_GFX_API_DECL sg_pool_info sg_query_pool_info(void);
 SOKOL_GFX_API_DECL sg_pixelformat_info sg_query_pixelformat(sg_pixel_format fmt);
 /* get current state of a resource (INITIAL, ALLOC, VALID, FAILED, INVALID) */
 SOKOL_GFX_API_DECL sg_resource_state sg_query_buffer_state(sg_buffer buf);
@@ -2316,18 +3582,36 @@ SOKOL_GFX_API_DECL sg_resource_state sg_query_image_state(sg_image img);
 SOKOL_GFX_API_DECL sg_resource_state sg_query_shader_state(sg_shader shd);
 SOKOL_GFX_API_DECL sg_resource_state sg_query_pipeline_state(sg_pipeline pip);
 SOKOL_GFX_API_DECL sg_resource_state sg_query_pass_state(sg_pass pass);
+SOKOL_GFX_API_DECL sg_resource_state sg_query_sampler_state(sg_sampler smp);
+/* check if the last asynchronous image upload has been completed (see sg_desc.image_upload_buffers) */
+SOKOL_GFX_API_DECL bool sg_query_image_upload_done(sg_image img);
 /* get runtime information about a resource */
 SOKOL_GFX_API_DECL sg_buffer_info sg_query_buffer_info(sg_buffer buf);
 SOKOL_GFX_API_DECL sg_image_info sg_query_image_info(sg_image img);
 SOKOL_GFX_API_DECL sg_shader_info sg_query_shader_info(sg_shader shd);
 SOKOL_GFX_API_DECL sg_pipeline_info sg_query_pipeline_info(sg_pipeline pip);
 SOKOL_GFX_API_DECL sg_pass_info sg_query_pass_info(sg_pass pass);
+SOKOL_GFX_API_DECL sg_sampler_info sg_query_sampler_info(sg_sampler smp);
+/* get number of redundant state changes dropped in the previous frame */
+SOKOL_GFX_API_DECL sg_state_filter_stats sg_query_state_filter_stats(void);
+/* get per-frame counters of the previous frame, or the last N frames (newest first) */
+SOKOL_GFX_API_DECL sg_frame_stats sg_query_frame_stats(void);
+SOKOL_GFX_API_DECL int sg_query_frame_stats_history(sg_frame_stats* stats, int max_frames);
+/* get the approximate GPU memory used by buffers and images */
+SOKOL_GFX_API_DECL sg_memory_stats sg_query_memory_stats(void);
+/* get the GPU execution times of the most recent frame with available results */
+SOKOL_GFX_API_DECL sg_gpu_timings sg_query_gpu_timings(void);
+/* serialize the shader cache into a memory chunk, for sg_desc.shader_cache_data */
+SOKOL_GFX_API_DECL size_t sg_query_shader_cache_size(void);
+SOKOL_GFX_API_DECL size_t sg_save_shader_cache(void* ptr, size_t size);
 /* get resource creation desc struct with their default values replaced */
 SOKOL_GFX_API_DECL sg_buffer_desc sg_query_buffer_defaults(const sg_buffer_desc* desc);
 SOKOL_GFX_API_DECL sg_image_desc sg_query_image_defaults(const sg_image_desc* desc);
 SOKOL_GFX_API_DECL sg_shader_desc sg_query_shader_defaults(const sg_shader_desc* desc);
 SOKOL_GFX_API_DECL sg_pipeline_desc sg_query_pipeline_defaults(const sg_pipeline_desc* desc);
+SOKOL_GFX_API_DECL sg_compute_pipeline_desc sg_query_compute_pipeline_defaults(const sg_compute_pipeline_desc* desc);
 SOKOL_GFX_API_DECL sg_pass_desc sg_query_pass_defaults(const sg_pass_desc* desc);
+SOKOL_GFX_API_DECL sg_sampler_desc sg_query_sampler_defaults(const sg_sampler_desc* desc);
 
 /* separate resource allocation and initialization (for async setup) */
 SOKOL_GFX_API_DECL sg_buffer sg_alloc_buffer(void);
@@ -2335,26 +3619,32 @@ SOKOL_GFX_API_DECL sg_image sg_alloc_image(void);
 SOKOL_GFX_API_DECL sg_shader sg_alloc_shader(void);
 SOKOL_GFX_API_DECL sg_pipeline sg_alloc_pipeline(void);
 SOKOL_GFX_API_DECL sg_pass sg_alloc_pass(void);
+SOKOL_GFX_API_DECL sg_sampler sg_alloc_sampler(void);
 SOKOL_GFX_API_DECL void sg_dealloc_buffer(sg_buffer buf_id);
 SOKOL_GFX_API_DECL void sg_dealloc_image(sg_image img_id);
 SOKOL_GFX_API_DECL void sg_dealloc_shader(sg_shader shd_id);
 SOKOL_GFX_API_DECL void sg_dealloc_pipeline(sg_pipeline pip_id);
 SOKOL_GFX_API_DECL void sg_dealloc_pass(sg_pass pass_id);
+SOKOL_GFX_API_DECL void sg_dealloc_sampler(sg_sampler smp_id);
 SOKOL_GFX_API_DECL void sg_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc);
 SOKOL_GFX_API_DECL void sg_init_image(sg_image img_id, const sg_image_desc* desc);
 SOKOL_GFX_API_DECL void sg_init_shader(sg_shader shd_id, const sg_shader_desc* desc);
 SOKOL_GFX_API_DECL void sg_init_pipeline(sg_pipeline pip_id, const sg_pipeline_desc* desc);
+SOKOL_GFX_API_DECL void sg_init_compute_pipeline(sg_pipeline pip_id, const sg_compute_pipeline_desc* desc);
 SOKOL_GFX_API_DECL void sg_init_pass(sg_pass pass_id, const sg_pass_desc* desc);
+SOKOL_GFX_API_DECL void sg_init_sampler(sg_sampler smp_id, const sg_sampler_desc* desc);
 SOKOL_GFX_API_DECL bool sg_uninit_buffer(sg_buffer buf_id);
 SOKOL_GFX_API_DECL bool sg_uninit_image(sg_image img_id);
 SOKOL_GFX_API_DECL bool sg_uninit_shader(sg_shader shd_id);
 SOKOL_GFX_API_DECL bool sg_uninit_pipeline(sg_pipeline pip_id);
 SOKOL_GFX_API_DECL bool sg_uninit_pass(sg_pass pass_id);
+SOKOL_GFX_API_DECL bool sg_uninit_sampler(sg_sampler smp_id);
 SOKOL_GFX_API_DECL void sg_fail_buffer(sg_buffer buf_id);
 SOKOL_GFX_API_DECL void sg_fail_image(sg_image img_id);
 SOKOL_GFX_API_DECL void sg_fail_shader(sg_shader shd_id);
 SOKOL_GFX_API_DECL void sg_fail_pipeline(sg_pipeline pip_id);
 SOKOL_GFX_API_DECL void sg_fail_pass(sg_pass pass_id);
+SOKOL_GFX_API_DECL void sg_fail_sampler(sg_sampler smp_id);
 
 /* rendering contexts (optional) */
 SOKOL_GFX_API_DECL sg_context sg_setup_context(void);
@@ -2386,29 +3676,46 @@ inline sg_buffer sg_make_buffer(const sg_buffer_desc& desc) { return sg_make_buf
 inline sg_image sg_make_image(const sg_image_desc& desc) { return sg_make_image(&desc); }
 inline sg_shader sg_make_shader(const sg_shader_desc& desc) { return sg_make_shader(&desc); }
 inline sg_pipeline sg_make_pipeline(const sg_pipeline_desc& desc) { return sg_make_pipeline(&desc); }
+inline sg_pipeline sg_make_compute_pipeline(const sg_compute_pipeline_desc& desc) { return sg_make_compute_pipeline(&desc); }
 inline sg_pass sg_make_pass(const sg_pass_desc& desc) { return sg_make_pass(&desc); }
+inline sg_sampler sg_make_sampler(const sg_sampler_desc& desc) { return sg_make_sampler(&desc); }
 inline void sg_update_image(sg_image img, const sg_image_data& data) { return sg_update_image(img, &data); }
+inline void sg_update_image_region(sg_image img, int mip_level, int slice, int x, int y, int width, int height, const sg_range& data) { return sg_update_image_region(img, mip_level, slice, x, y, width, height, &data); }
 
 inline void sg_begin_default_pass(const sg_pass_action& pass_action, int width, int height) { return sg_begin_default_pass(&pass_action, width, height); }
 inline void sg_begin_default_passf(const sg_pass_action& pass_action, float width, float height) { return sg_begin_default_passf(&pass_action, width, height); }
 inline void sg_begin_pass(sg_pass pass, const sg_pass_action& pass_action) { return sg_begin_pass(pass, &pass_action); }
 inline void sg_apply_bindings(const sg_bindings& bindings) { return sg_apply_bindings(&bindings); }
+inline sg_prepared_bindings sg_prepare_bindings(sg_pipeline pip, const sg_bindings& bindings) { return sg_prepare_bindings(pip, &bindings); }
+inline void sg_apply_prepared_bindings(const sg_prepared_bindings& bindings) { return sg_apply_prepared_bindings(&bindings); }
 inline void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range& data) { return sg_apply_uniforms(stage, ub_index, &data); }
+inline void sg_cmd_apply_bindings(sg_command_list* cl, const sg_bindings& bindings) { return sg_cmd_apply_bindings(cl, &bindings); }
+inline void sg_cmd_apply_uniforms(sg_command_list* cl, sg_shader_stage stage, int ub_index, const sg_range& data) { return sg_cmd_apply_uniforms(cl, stage, ub_index, &data); }
+inline void sg_cmd_apply_prepared_bindings(sg_command_list* cl, const sg_prepared_bindings& bindings) { return sg_cmd_apply_prepared_bindings(cl, &bindings); }
+inline void sg_cmd_update_image_region(sg_command_list* cl, sg_image img, int mip_level, int slice, int x, int y, int width, int height, const sg_range& data) { return sg_cmd_update_image_region(cl, img, mip_level, slice, x, y, width, height, &data); }
 
 inline sg_buffer_desc sg_query_buffer_defaults(const sg_buffer_desc& desc) { return sg_query_buffer_defaults(&desc); }
 inline sg_image_desc sg_query_image_defaults(const sg_image_desc& desc) { return sg_query_image_defaults(&desc); }
 inline sg_shader_desc sg_query_shader_defaults(const sg_shader_desc& desc) { return sg_query_shader_defaults(&desc); }
 inline sg_pipeline_desc sg_query_pipeline_defaults(const sg_pipeline_desc& desc) { return sg_query_pipeline_defaults(&desc); }
+inline sg_compute_pipeline_desc sg_query_compute_pipeline_defaults(const sg_compute_pipeline_desc& desc) { return sg_query_compute_pipeline_defaults(&desc); }
 inline sg_pass_desc sg_query_pass_defaults(const sg_pass_desc& desc) { return sg_query_pass_defaults(&desc); }
+inline sg_sampler_desc sg_query_sampler_defaults(const sg_sampler_desc& desc) { return sg_query_sampler_defaults(&desc); }
 
 inline void sg_init_buffer(sg_buffer buf_id, const sg_buffer_desc& desc) { return sg_init_buffer(buf_id, &desc); }
+inline void sg_init_async_queue(sg_async_queue* q, const sg_async_queue_desc& desc) { return sg_init_async_queue(q, &desc); }
+inline sg_buffer sg_async_make_buffer(sg_async_queue* q, const sg_buffer_desc& desc) { return sg_async_make_buffer(q, &desc); }
+inline sg_image sg_async_make_image(sg_async_queue* q, const sg_image_desc& desc) { return sg_async_make_image(q, &desc); }
 inline void sg_init_image(sg_image img_id, const sg_image_desc& desc) { return sg_init_image(img_id, &desc); }
 inline void sg_init_shader(sg_shader shd_id, const sg_shader_desc& desc) { return sg_init_shader(shd_id, &desc); }
 inline void sg_init_pipeline(sg_pipeline pip_id, const sg_pipeline_desc& desc) { return sg_init_pipeline(pip_id, &desc); }
+inline void sg_init_compute_pipeline(sg_pipeline pip_id, const sg_compute_pipeline_desc& desc) { return sg_init_compute_pipeline(pip_id, &desc); }
 inline void sg_init_pass(sg_pass pass_id, const sg_pass_desc& desc) { return sg_init_pass(pass_id, &desc); }
+inline void sg_init_sampler(sg_sampler smp_id, const sg_sampler_desc& desc) { return sg_init_sampler(smp_id, &desc); }
 
 inline void sg_update_buffer(sg_buffer buf_id, const sg_range& data) { return sg_update_buffer(buf_id, &data); }
 inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_append_buffer(buf_id, &data); }
+inline sg_transient_range sg_alloc_transient(sg_buffer_type type, const sg_range& data) { return sg_alloc_transient(type, &data); }
 #endif
 #endif // SOKOL_GFX_INCLUDED
 
@@ -2422,6 +3729,18 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
 #include <string.h> /* memset */
 #include <float.h> /* FLT_MAX */
 
+/* clock and atomics for the async resource creation queue (see sg_async_queue) */
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+#if defined(__APPLE__) && defined(__MACH__)
+    #include <mach/mach_time.h>
+#elif defined(__EMSCRIPTEN__)
+    #include <emscripten/emscripten.h>
+#else
+    #include <time.h>
+#endif
+
 #ifndef SOKOL_API_IMPL
     #define SOKOL_API_IMPL
 #endif
@@ -2460,6 +3779,13 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
     #endif
 #endif
 
+#ifndef SOKOL_GFX_SLOT_BITS
+    #define SOKOL_GFX_SLOT_BITS (16)
+#endif
+#if (SOKOL_GFX_SLOT_BITS < 8) || (SOKOL_GFX_SLOT_BITS > 24)
+#error "SOKOL_GFX_SLOT_BITS must be in the range 8..24"
+#endif
+
 #ifndef _SOKOL_PRIVATE
     #if defined(__GNUC__) || defined(__clang__)
         #define _SOKOL_PRIVATE __attribute__((unused)) static
@@ -2679,6 +4005,8 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
         #define GL_UNSIGNED_SHORT_4_4_4_4 0x8033
         #define GL_SRC_ALPHA_SATURATE 0x0308
         #define GL_STREAM_DRAW 0x88E0
+        #define GL_PACK_ALIGNMENT 0x0D05
+        #define GL_UNPACK_ALIGNMENT 0x0CF5
         #define GL_ONE 1
         #define GL_NEAREST_MIPMAP_LINEAR 0x2702
         #define GL_RGB10_A2 0x8059
@@ -2831,6 +4159,9 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
         #define GL_CLAMP_TO_BORDER 0x812D
         #define GL_TEXTURE_BORDER_COLOR 0x1004
         #define GL_CURRENT_PROGRAM 0x8B8D
+        #define GL_UNIFORM_BUFFER 0x8A11
+        #define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+        #define GL_INVALID_INDEX 0xFFFFFFFFu
     #endif
 
     #ifndef GL_UNSIGNED_INT_2_10_10_10_REV
@@ -2917,54 +4248,214 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
     #ifndef GL_LUMINANCE
     #define GL_LUMINANCE 0x1909
     #endif
-
-    #ifdef SOKOL_GLES2
-        #ifdef GL_ANGLE_instanced_arrays
-            #define _SOKOL_GL_INSTANCING_ENABLED
-            #define glDrawArraysInstanced(mode, first, count, instancecount)  glDrawArraysInstancedANGLE(mode, first, count, instancecount)
-            #define glDrawElementsInstanced(mode, count, type, indices, instancecount) glDrawElementsInstancedANGLE(mode, count, type, indices, instancecount)
-            #define glVertexAttribDivisor(index, divisor) glVertexAttribDivisorANGLE(index, divisor)
-        #elif defined(GL_EXT_draw_instanced) && defined(GL_EXT_instanced_arrays)
-            #define _SOKOL_GL_INSTANCING_ENABLED
-            #define glDrawArraysInstanced(mode, first, count, instancecount)  glDrawArraysInstancedEXT(mode, first, count, instancecount)
-            #define glDrawElementsInstanced(mode, count, type, indices, instancecount) glDrawElementsInstancedEXT(mode, count, type, indices, instancecount)
-            #define glVertexAttribDivisor(index, divisor) glVertexAttribDivisorEXT(index, divisor)
-        #else
-            #define _SOKOL_GLES2_INSTANCING_ERROR "Select GL_ANGLE_instanced_arrays or (GL_EXT_draw_instanced & GL_EXT_instanced_arrays) to enable instancing in GLES2"
-            #define glDrawArraysInstanced(mode, first, count, instancecount) SOKOL_ASSERT(0 && _SOKOL_GLES2_INSTANCING_ERROR)
-            #define glDrawElementsInstanced(mode, count, type, indices, instancecount) SOKOL_ASSERT(0 && _SOKOL_GLES2_INSTANCING_ERROR)
-            #define glVertexAttribDivisor(index, divisor) SOKOL_ASSERT(0 && _SOKOL_GLES2_INSTANCING_ERROR)
-        #endif
-    #else
-        #define _SOKOL_GL_INSTANCING_ENABLED
+    #ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    #define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
     #endif
-    #define _SG_GL_CHECK_ERROR() { SOKOL_ASSERT(glGetError() == GL_NO_ERROR); }
-#endif
-
-/*=== COMMON BACKEND STUFF ===================================================*/
-
-/* resource pool slots */
-typedef struct {
-    uint32_t id;
-    uint32_t ctx_id;
-    sg_resource_state state;
-} _sg_slot_t;
-
-/* constants */
-enum {
-    _SG_STRING_SIZE = 16,
-    _SG_SLOT_SHIFT = 16,
-    _SG_SLOT_MASK = (1<<_SG_SLOT_SHIFT)-1,
-    _SG_MAX_POOL_SIZE = (1<<_SG_SLOT_SHIFT),
-    _SG_DEFAULT_BUFFER_POOL_SIZE = 128,
-    _SG_DEFAULT_IMAGE_POOL_SIZE = 128,
-    _SG_DEFAULT_SHADER_POOL_SIZE = 32,
-    _SG_DEFAULT_PIPELINE_POOL_SIZE = 64,
-    _SG_DEFAULT_PASS_POOL_SIZE = 16,
+    #ifndef GL_PROGRAM_BINARY_LENGTH
+    #define GL_PROGRAM_BINARY_LENGTH 0x8741
+    #endif
+    #ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+    #define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+    #endif
+    #ifndef GL_MAJOR_VERSION
+    #define GL_MAJOR_VERSION 0x821B
+    #endif
+    #ifndef GL_MINOR_VERSION
+    #define GL_MINOR_VERSION 0x821C
+    #endif
+    /* GL 4.x entry points are only referenced if the GL headers declare them
+       (SOKOL_GLCORE_4X), or if they are resolved by the integrated Win32 GL loader,
+       the actual GL context version is still checked at runtime
+    */
+    #if defined(SOKOL_GLCORE33) && (defined(SOKOL_GLCORE_4X) || defined(_SOKOL_USE_WIN32_GL_LOADER))
+    #define _SOKOL_GL_4X (1)
+    #endif
+    /* program binaries are core in GL 4.1 and GLES3, but not available in WebGL */
+    #if defined(_SOKOL_GL_4X) || (defined(SOKOL_GLES3) && !defined(__EMSCRIPTEN__))
+    #define _SOKOL_GL_PROGRAM_BINARY (1)
+    #endif
+    /* pixel buffer objects, buffer mapping and fences are core in GL 3.3 and GLES3,
+       but WebGL2 has no glMapBufferRange() and no client-side waits
+    */
+    #if (defined(SOKOL_GLCORE33) || defined(SOKOL_GLES3)) && !defined(__EMSCRIPTEN__)
+    #define _SOKOL_GL_PBO_UPLOAD (1)
+    #ifndef GL_PIXEL_UNPACK_BUFFER
+    #define GL_PIXEL_UNPACK_BUFFER 0x88EC
+    #endif
+    #ifndef GL_PIXEL_PACK_BUFFER
+    #define GL_PIXEL_PACK_BUFFER 0x88EB
+    #endif
+    #ifndef GL_STREAM_READ
+    #define GL_STREAM_READ 0x88E1
+    #endif
+    #ifndef GL_MAP_READ_BIT
+    #define GL_MAP_READ_BIT 0x0001
+    #endif
+    #ifndef GL_MAP_WRITE_BIT
+    #define GL_MAP_WRITE_BIT 0x0002
+    #endif
+    #ifndef GL_MAP_INVALIDATE_BUFFER_BIT
+    #define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+    #endif
+    #ifndef GL_MAP_UNSYNCHRONIZED_BIT
+    #define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+    #endif
+    #ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+    #endif
+    #ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+    #endif
+    #ifndef GL_ALREADY_SIGNALED
+    #define GL_ALREADY_SIGNALED 0x911A
+    #endif
+    #ifndef GL_TIMEOUT_EXPIRED
+    #define GL_TIMEOUT_EXPIRED 0x911B
+    #endif
+    #ifndef GL_CONDITION_SATISFIED
+    #define GL_CONDITION_SATISFIED 0x911C
+    #endif
+    #endif
+    /* multi-draw is core in desktop GL, on GLES only available through an extension */
+    #if defined(SOKOL_GLCORE33)
+    #define _SOKOL_GL_MULTI_DRAW (1)
+    #endif
+    /* base vertex draws are core in GL 3.2, but only in GLES 3.2 */
+    #if defined(SOKOL_GLCORE33)
+    #define _SOKOL_GL_BASE_VERTEX (1)
+    #endif
+    /* timestamp queries are core in GL 3.3, on GLES only available through an extension */
+    #if defined(SOKOL_GLCORE33)
+    #define _SOKOL_GL_TIMER_QUERY (1)
+    #ifndef GL_TIMESTAMP
+    #define GL_TIMESTAMP 0x8E28
+    #endif
+    #ifndef GL_QUERY_RESULT
+    #define GL_QUERY_RESULT 0x8866
+    #endif
+    #ifndef GL_QUERY_RESULT_AVAILABLE
+    #define GL_QUERY_RESULT_AVAILABLE 0x8867
+    #endif
+    #endif
+    /* buffer storage is core in GL 4.4, macOS stops at GL 4.1 */
+    #if defined(_SOKOL_GL_4X) && !defined(__APPLE__)
+    #define _SOKOL_GL_BUFFER_STORAGE (1)
+    #ifndef GL_MAP_WRITE_BIT
+    #define GL_MAP_WRITE_BIT 0x0002
+    #endif
+    #ifndef GL_MAP_PERSISTENT_BIT
+    #define GL_MAP_PERSISTENT_BIT 0x0040
+    #endif
+    #ifndef GL_MAP_COHERENT_BIT
+    #define GL_MAP_COHERENT_BIT 0x0080
+    #endif
+    #ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+    #endif
+    #ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+    #endif
+    #ifndef GL_TIMEOUT_EXPIRED
+    #define GL_TIMEOUT_EXPIRED 0x911B
+    #endif
+    #endif
+    /* compute shaders and shader storage buffers are core in GL 4.3, macOS stops at GL 4.1 */
+    #if defined(_SOKOL_GL_4X) && !defined(__APPLE__)
+    #define _SOKOL_GL_COMPUTE (1)
+    #ifndef GL_COMPUTE_SHADER
+    #define GL_COMPUTE_SHADER 0x91B9
+    #endif
+    #ifndef GL_SHADER_STORAGE_BUFFER
+    #define GL_SHADER_STORAGE_BUFFER 0x90D2
+    #endif
+    #ifndef GL_SHADER_STORAGE_BARRIER_BIT
+    #define GL_SHADER_STORAGE_BARRIER_BIT 0x00002000
+    #endif
+    #ifndef GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT
+    #define GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT 0x00000001
+    #endif
+    #ifndef GL_ELEMENT_ARRAY_BARRIER_BIT
+    #define GL_ELEMENT_ARRAY_BARRIER_BIT 0x00000002
+    #endif
+    #ifndef GL_BUFFER_UPDATE_BARRIER_BIT
+    #define GL_BUFFER_UPDATE_BARRIER_BIT 0x00000200
+    #endif
+    #endif
+    /* glInvalidateFramebuffer() is core in GL 4.3 and GLES3/WebGL2, macOS stops at GL 4.1 */
+    #if (defined(_SOKOL_GL_4X) && !defined(__APPLE__)) || defined(SOKOL_GLES3)
+    #define _SOKOL_GL_INVALIDATE (1)
+    #ifndef GL_COLOR
+    #define GL_COLOR 0x1800
+    #endif
+    #ifndef GL_DEPTH
+    #define GL_DEPTH 0x1801
+    #endif
+    #ifndef GL_STENCIL
+    #define GL_STENCIL 0x1802
+    #endif
+    #endif
+
+    #ifdef SOKOL_GLES2
+        #ifdef GL_ANGLE_instanced_arrays
+            #define _SOKOL_GL_INSTANCING_ENABLED
+            #define glDrawArraysInstanced(mode, first, count, instancecount)  glDrawArraysInstancedANGLE(mode, first, count, instancecount)
+            #define glDrawElementsInstanced(mode, count, type, indices, instancecount) glDrawElementsInstancedANGLE(mode, count, type, indices, instancecount)
+            #define glVertexAttribDivisor(index, divisor) glVertexAttribDivisorANGLE(index, divisor)
+        #elif defined(GL_EXT_draw_instanced) && defined(GL_EXT_instanced_arrays)
+            #define _SOKOL_GL_INSTANCING_ENABLED
+            #define glDrawArraysInstanced(mode, first, count, instancecount)  glDrawArraysInstancedEXT(mode, first, count, instancecount)
+            #define glDrawElementsInstanced(mode, count, type, indices, instancecount) glDrawElementsInstancedEXT(mode, count, type, indices, instancecount)
+            #define glVertexAttribDivisor(index, divisor) glVertexAttribDivisorEXT(index, divisor)
+        #else
+            #define _SOKOL_GLES2_INSTANCING_ERROR "Select GL_ANGLE_instanced_arrays or (GL_EXT_draw_instanced & GL_EXT_instanced_arrays) to enable instancing in GLES2"
+            #define glDrawArraysInstanced(mode, first, count, instancecount) SOKOL_ASSERT(0 && _SOKOL_GLES2_INSTANCING_ERROR)
+            #define glDrawElementsInstanced(mode, count, type, indices, instancecount) SOKOL_ASSERT(0 && _SOKOL_GLES2_INSTANCING_ERROR)
+            #define glVertexAttribDivisor(index, divisor) SOKOL_ASSERT(0 && _SOKOL_GLES2_INSTANCING_ERROR)
+        #endif
+    #else
+        #define _SOKOL_GL_INSTANCING_ENABLED
+    #endif
+    #define _SG_GL_CHECK_ERROR() { SOKOL_ASSERT(glGetError() == GL_NO_ERROR); }
+#endif
+
+/*=== COMMON BACKEND STUFF ===================================================*/
+
+/* resource pool slots */
+typedef struct {
+    uint32_t id;
+    uint32_t ctx_id;
+    sg_resource_state state;
+} _sg_slot_t;
+
+/* constants */
+enum {
+    _SG_STRING_SIZE = 16,
+    _SG_SLOT_SHIFT = SOKOL_GFX_SLOT_BITS,
+    _SG_SLOT_MASK = (1<<_SG_SLOT_SHIFT)-1,
+    _SG_MAX_POOL_SIZE = (1<<_SG_SLOT_SHIFT),
+    _SG_DEFAULT_BUFFER_POOL_SIZE = 128,
+    _SG_DEFAULT_IMAGE_POOL_SIZE = 128,
+    _SG_DEFAULT_SHADER_POOL_SIZE = 32,
+    _SG_DEFAULT_PIPELINE_POOL_SIZE = 64,
+    _SG_DEFAULT_PASS_POOL_SIZE = 16,
     _SG_DEFAULT_CONTEXT_POOL_SIZE = 16,
+    _SG_DEFAULT_SAMPLER_POOL_SIZE = 64,
     _SG_DEFAULT_SAMPLER_CACHE_CAPACITY = 64,
     _SG_DEFAULT_UB_SIZE = 4 * 1024 * 1024,
     _SG_DEFAULT_STAGING_SIZE = 8 * 1024 * 1024,
+    _SG_FILTER_MAX_UB_SIZE = 256,
+    _SG_INSTANCING_MAX_RECORD_SIZE = 256,
+    _SG_INSTANCING_STAGING_SIZE = 64 * 1024,
+    _SG_SHADER_CACHE_MAGIC = 0x43485347,    /* 'GSHC' */
+    _SG_SHADER_CACHE_VERSION = 1,
+    _SG_GPU_TIMING_FRAMES = 4,
+    _SG_GPU_TIMING_MAX_DEPTH = 8,
+    _SG_MAX_IMAGE_READBACKS = 16,
+    _SG_MAX_TRACKED_IMAGE_REGIONS = 1024,
+    _SG_DRAW_BATCH_CHUNK_SIZE = 256,
+    _SG_DEFAULT_ASYNC_MAX_PACKETS = 64,
+    _SG_DEFAULT_ASYNC_NUM_RESERVED = 16,
+    _SG_NUM_ALL_SHADER_STAGES = SG_NUM_SHADER_STAGES + 1,  /* render shader stages plus the compute shader stage */
 };
 
 /* fixed-size string */
@@ -3000,13 +4491,20 @@ _SOKOL_PRIVATE void _sg_buffer_common_init(_sg_buffer_common_t* cmn, const sg_bu
     cmn->usage = desc->usage;
     cmn->update_frame_index = 0;
     cmn->append_frame_index = 0;
-    cmn->num_slots = (cmn->usage == SG_USAGE_IMMUTABLE) ? 1 : SG_NUM_INFLIGHT_FRAMES;
+    /* storage buffers are written on the GPU, so they can't rotate through multiple slots */
+    if ((cmn->usage == SG_USAGE_IMMUTABLE) || (cmn->type == SG_BUFFERTYPE_STORAGEBUFFER)) {
+        cmn->num_slots = 1;
+    }
+    else {
+        cmn->num_slots = SG_NUM_INFLIGHT_FRAMES;
+    }
     cmn->active_slot = 0;
 }
 
 typedef struct {
     sg_image_type type;
     bool render_target;
+    bool transient;
     int width;
     int height;
     int num_slices;
@@ -3022,6 +4520,7 @@ typedef struct {
     sg_border_color border_color;
     uint32_t max_anisotropy;
     uint32_t upd_frame_index;
+    uint32_t rgn_frame_index;   /* frame index of last sg_update_image_region() */
     int num_slots;
     int active_slot;
 } _sg_image_common_t;
@@ -3029,6 +4528,7 @@ typedef struct {
 _SOKOL_PRIVATE void _sg_image_common_init(_sg_image_common_t* cmn, const sg_image_desc* desc) {
     cmn->type = desc->type;
     cmn->render_target = desc->render_target;
+    cmn->transient = desc->transient;
     cmn->width = desc->width;
     cmn->height = desc->height;
     cmn->num_slices = desc->num_slices;
@@ -3044,10 +4544,35 @@ _SOKOL_PRIVATE void _sg_image_common_init(_sg_image_common_t* cmn, const sg_imag
     cmn->border_color = desc->border_color;
     cmn->max_anisotropy = desc->max_anisotropy;
     cmn->upd_frame_index = 0;
+    cmn->rgn_frame_index = 0;
     cmn->num_slots = (cmn->usage == SG_USAGE_IMMUTABLE) ? 1 : SG_NUM_INFLIGHT_FRAMES;
     cmn->active_slot = 0;
 }
 
+typedef struct {
+    sg_filter min_filter;
+    sg_filter mag_filter;
+    sg_wrap wrap_u;
+    sg_wrap wrap_v;
+    sg_wrap wrap_w;
+    sg_border_color border_color;
+    uint32_t max_anisotropy;
+    float min_lod;
+    float max_lod;
+} _sg_sampler_common_t;
+
+_SOKOL_PRIVATE void _sg_sampler_common_init(_sg_sampler_common_t* cmn, const sg_sampler_desc* desc) {
+    cmn->min_filter = desc->min_filter;
+    cmn->mag_filter = desc->mag_filter;
+    cmn->wrap_u = desc->wrap_u;
+    cmn->wrap_v = desc->wrap_v;
+    cmn->wrap_w = desc->wrap_w;
+    cmn->border_color = desc->border_color;
+    cmn->max_anisotropy = desc->max_anisotropy;
+    cmn->min_lod = desc->min_lod;
+    cmn->max_lod = desc->max_lod;
+}
+
 typedef struct {
     size_t size;
 } _sg_uniform_block_t;
@@ -3057,20 +4582,39 @@ typedef struct {
     sg_sampler_type sampler_type;
 } _sg_shader_image_t;
 
+typedef struct {
+    bool readonly;
+} _sg_shader_storage_buffer_t;
+
 typedef struct {
     int num_uniform_blocks;
     int num_images;
+    int num_storage_buffers;
     _sg_uniform_block_t uniform_blocks[SG_MAX_SHADERSTAGE_UBS];
     _sg_shader_image_t images[SG_MAX_SHADERSTAGE_IMAGES];
+    _sg_shader_storage_buffer_t storage_buffers[SG_MAX_SHADERSTAGE_STORAGE_BUFFERS];
 } _sg_shader_stage_t;
 
 typedef struct {
-    _sg_shader_stage_t stage[SG_NUM_SHADER_STAGES];
+    _sg_shader_stage_t stage[_SG_NUM_ALL_SHADER_STAGES];
+    bool compute;       /* true if this is a compute shader (only the compute shader stage is used) */
+    bool instancing;
+    int instancing_ub_index;
+    int instancing_buffer_index;
 } _sg_shader_common_t;
 
+_SOKOL_PRIVATE const sg_shader_stage_desc* _sg_shader_stage_desc(const sg_shader_desc* desc, int stage_index) {
+    switch (stage_index) {
+        case SG_SHADERSTAGE_VS: return &desc->vs;
+        case SG_SHADERSTAGE_FS: return &desc->fs;
+        default:                return &desc->cs;
+    }
+}
+
 _SOKOL_PRIVATE void _sg_shader_common_init(_sg_shader_common_t* cmn, const sg_shader_desc* desc) {
-    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
-        const sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS) ? &desc->vs : &desc->fs;
+    cmn->compute = (0 != desc->cs.source) || (0 != desc->cs.bytecode.ptr);
+    for (int stage_index = 0; stage_index < _SG_NUM_ALL_SHADER_STAGES; stage_index++) {
+        const sg_shader_stage_desc* stage_desc = _sg_shader_stage_desc(desc, stage_index);
         _sg_shader_stage_t* stage = &cmn->stage[stage_index];
         SOKOL_ASSERT(stage->num_uniform_blocks == 0);
         for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
@@ -3091,11 +4635,24 @@ _SOKOL_PRIVATE void _sg_shader_common_init(_sg_shader_common_t* cmn, const sg_sh
             stage->images[img_index].sampler_type = img_desc->sampler_type;
             stage->num_images++;
         }
+        SOKOL_ASSERT(stage->num_storage_buffers == 0);
+        for (int sbuf_index = 0; sbuf_index < SG_MAX_SHADERSTAGE_STORAGE_BUFFERS; sbuf_index++) {
+            const sg_shader_storage_buffer_desc* sbuf_desc = &stage_desc->storage_buffers[sbuf_index];
+            if (!sbuf_desc->used) {
+                break;
+            }
+            stage->storage_buffers[sbuf_index].readonly = sbuf_desc->readonly;
+            stage->num_storage_buffers++;
+        }
     }
+    cmn->instancing = desc->instancing.enabled;
+    cmn->instancing_ub_index = desc->instancing.uniform_block;
+    cmn->instancing_buffer_index = desc->instancing.buffer_index;
 }
 
 typedef struct {
     sg_shader shader_id;
+    bool compute;       /* true for compute pipelines created with sg_make_compute_pipeline() */
     sg_index_type index_type;
     bool vertex_layout_valid[SG_MAX_SHADERSTAGE_BUFFERS];
     int color_attachment_count;
@@ -3127,6 +4684,15 @@ _SOKOL_PRIVATE void _sg_pipeline_common_init(_sg_pipeline_common_t* cmn, const s
     cmn->blend_color = desc->blend_color;
 }
 
+_SOKOL_PRIVATE void _sg_compute_pipeline_common_init(_sg_pipeline_common_t* cmn, const sg_compute_pipeline_desc* desc) {
+    cmn->shader_id = desc->shader;
+    cmn->compute = true;
+    cmn->index_type = SG_INDEXTYPE_NONE;
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
+        cmn->vertex_layout_valid[i] = false;
+    }
+}
+
 typedef struct {
     sg_image image_id;
     int mip_level;
@@ -3261,6 +4827,195 @@ _SOKOL_PRIVATE uintptr_t _sg_smpcache_sampler(_sg_sampler_cache_t* cache, int it
     return cache->items[item_index].sampler_handle;
 }
 
+/*=== GENERIC SHADER CACHE ===================================================*/
+
+/*
+    this is used by backends which can retrieve and reload a compiled
+    shader representation (currently GL program binaries), so that
+    the shader compilation can be skipped on the next application start
+
+    serialized layout (all values in host byte order):
+
+        uint32_t magic, version, num_items
+        num_items * {
+            uint64_t hash
+            uint32_t format
+            uint32_t size
+            uint8_t data[size]
+        }
+*/
+typedef struct {
+    uint64_t hash;
+    uint32_t format;        /* backend-specific binary format (e.g. GL program binary format) */
+    uint32_t size;
+    uint8_t* data;
+} _sg_shader_cache_item_t;
+
+typedef struct {
+    bool enabled;
+    int capacity;
+    int num_items;
+    _sg_shader_cache_item_t* items;
+} _sg_shader_cache_t;
+
+_SOKOL_PRIVATE void _sg_shdcache_discard(_sg_shader_cache_t* cache) {
+    SOKOL_ASSERT(cache);
+    for (int i = 0; i < cache->num_items; i++) {
+        SOKOL_FREE(cache->items[i].data);
+    }
+    if (cache->items) {
+        SOKOL_FREE(cache->items);
+    }
+    memset(cache, 0, sizeof(_sg_shader_cache_t));
+}
+
+/* FNV-1a hash over a zero-terminated string, including the terminator */
+_SOKOL_PRIVATE uint64_t _sg_shdcache_hash_str(uint64_t hash, const char* str) {
+    if (str) {
+        do {
+            hash ^= (uint8_t) *str;
+            hash *= 0x100000001B3ULL;
+        } while (*str++);
+    }
+    else {
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/* the cache key, everything which affects the compiled shader */
+_SOKOL_PRIVATE uint64_t _sg_shdcache_hash(const sg_shader_desc* desc) {
+    SOKOL_ASSERT(desc);
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+        hash = _sg_shdcache_hash_str(hash, desc->attrs[i].name);
+        hash = _sg_shdcache_hash_str(hash, desc->attrs[i].sem_name);
+    }
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        const sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS)? &desc->vs : &desc->fs;
+        hash = _sg_shdcache_hash_str(hash, stage_desc->source);
+        hash = _sg_shdcache_hash_str(hash, stage_desc->entry);
+    }
+    /* only hash the compute shader stage if present, so that render shader keys stay the same */
+    if (desc->cs.source) {
+        hash = _sg_shdcache_hash_str(hash, desc->cs.source);
+        hash = _sg_shdcache_hash_str(hash, desc->cs.entry);
+    }
+    return hash;
+}
+
+_SOKOL_PRIVATE _sg_shader_cache_item_t* _sg_shdcache_find_item(_sg_shader_cache_t* cache, uint64_t hash) {
+    /* return matching shader cache item or null */
+    SOKOL_ASSERT(cache);
+    for (int i = 0; i < cache->num_items; i++) {
+        if (cache->items[i].hash == hash) {
+            return &cache->items[i];
+        }
+    }
+    return 0;
+}
+
+/* add a new item, or replace the data of an existing item */
+_SOKOL_PRIVATE void _sg_shdcache_add_item(_sg_shader_cache_t* cache, uint64_t hash, uint32_t format, const void* data, uint32_t size) {
+    SOKOL_ASSERT(cache && data && (size > 0));
+    _sg_shader_cache_item_t* item = _sg_shdcache_find_item(cache, hash);
+    if (item) {
+        SOKOL_FREE(item->data);
+    }
+    else {
+        if (cache->num_items == cache->capacity) {
+            const int new_capacity = (cache->capacity > 0) ? (cache->capacity * 2) : 64;
+            _sg_shader_cache_item_t* new_items = (_sg_shader_cache_item_t*) SOKOL_MALLOC((size_t)new_capacity * sizeof(_sg_shader_cache_item_t));
+            SOKOL_ASSERT(new_items);
+            if (cache->items) {
+                memcpy(new_items, cache->items, (size_t)cache->num_items * sizeof(_sg_shader_cache_item_t));
+                SOKOL_FREE(cache->items);
+            }
+            cache->items = new_items;
+            cache->capacity = new_capacity;
+        }
+        item = &cache->items[cache->num_items++];
+        item->hash = hash;
+    }
+    item->format = format;
+    item->size = size;
+    item->data = (uint8_t*) SOKOL_MALLOC(size);
+    SOKOL_ASSERT(item->data);
+    memcpy(item->data, data, size);
+}
+
+_SOKOL_PRIVATE size_t _sg_shdcache_serialized_size(const _sg_shader_cache_t* cache) {
+    SOKOL_ASSERT(cache);
+    size_t size = 3 * sizeof(uint32_t);
+    for (int i = 0; i < cache->num_items; i++) {
+        size += sizeof(uint64_t) + 2 * sizeof(uint32_t) + cache->items[i].size;
+    }
+    return size;
+}
+
+_SOKOL_PRIVATE void _sg_shdcache_write(uint8_t** dst, const void* src, size_t size) {
+    memcpy(*dst, src, size);
+    *dst += size;
+}
+
+/* returns number of bytes written, or 0 if the destination is too small */
+_SOKOL_PRIVATE size_t _sg_shdcache_save(const _sg_shader_cache_t* cache, void* ptr, size_t size) {
+    SOKOL_ASSERT(cache && ptr);
+    const size_t num_bytes = _sg_shdcache_serialized_size(cache);
+    if (num_bytes > size) {
+        return 0;
+    }
+    uint8_t* dst = (uint8_t*) ptr;
+    const uint32_t header[3] = { _SG_SHADER_CACHE_MAGIC, _SG_SHADER_CACHE_VERSION, (uint32_t)cache->num_items };
+    _sg_shdcache_write(&dst, header, sizeof(header));
+    for (int i = 0; i < cache->num_items; i++) {
+        const _sg_shader_cache_item_t* item = &cache->items[i];
+        _sg_shdcache_write(&dst, &item->hash, sizeof(item->hash));
+        _sg_shdcache_write(&dst, &item->format, sizeof(item->format));
+        _sg_shdcache_write(&dst, &item->size, sizeof(item->size));
+        _sg_shdcache_write(&dst, item->data, item->size);
+    }
+    SOKOL_ASSERT((size_t)(dst - (uint8_t*)ptr) == num_bytes);
+    return num_bytes;
+}
+
+/* populate the cache from serialized data, stops at the first malformed item */
+_SOKOL_PRIVATE void _sg_shdcache_load(_sg_shader_cache_t* cache, const sg_range* data) {
+    SOKOL_ASSERT(cache && data && data->ptr);
+    const uint8_t* src = (const uint8_t*) data->ptr;
+    const uint8_t* end = src + data->size;
+    uint32_t header[3];
+    if (data->size < sizeof(header)) {
+        SOKOL_LOG("sg_setup: ignoring sg_desc.shader_cache_data (too small)");
+        return;
+    }
+    memcpy(header, src, sizeof(header));
+    src += sizeof(header);
+    if ((header[0] != _SG_SHADER_CACHE_MAGIC) || (header[1] != _SG_SHADER_CACHE_VERSION)) {
+        SOKOL_LOG("sg_setup: ignoring sg_desc.shader_cache_data (not a shader cache, or wrong version)");
+        return;
+    }
+    for (uint32_t i = 0; i < header[2]; i++) {
+        uint64_t hash;
+        uint32_t format, size;
+        const size_t item_header_size = sizeof(hash) + sizeof(format) + sizeof(size);
+        if ((size_t)(end - src) < item_header_size) {
+            break;
+        }
+        memcpy(&hash, src, sizeof(hash));
+        src += sizeof(hash);
+        memcpy(&format, src, sizeof(format));
+        src += sizeof(format);
+        memcpy(&size, src, sizeof(size));
+        src += sizeof(size);
+        if ((0 == size) || ((size_t)(end - src) < size)) {
+            break;
+        }
+        _sg_shdcache_add_item(cache, hash, format, src, size);
+        src += size;
+    }
+}
+
 /*=== DUMMY BACKEND DECLARATIONS =============================================*/
 #if defined(SOKOL_DUMMY_BACKEND)
 typedef struct {
@@ -3308,6 +5063,12 @@ typedef struct {
 } _sg_dummy_context_t;
 typedef _sg_dummy_context_t _sg_context_t;
 
+typedef struct {
+    _sg_slot_t slot;
+    _sg_sampler_common_t cmn;
+} _sg_dummy_sampler_t;
+typedef _sg_dummy_sampler_t _sg_sampler_t;
+
 /*== GL BACKEND DECLARATIONS =================================================*/
 #elif defined(_SOKOL_ANY_GL)
 typedef struct {
@@ -3316,6 +5077,9 @@ typedef struct {
     struct {
         GLuint buf[SG_NUM_INFLIGHT_FRAMES];
         bool ext_buffers;   /* if true, external buffers were injected with sg_buffer_desc.gl_buffers */
+        uint8_t* mapped;    /* persistently mapped storage of all slots, or null (see sg_desc.enable_persistent_buffers) */
+        int slot_size;      /* size of one slot in the persistently mapped storage */
+        uint32_t slot_frame_index[SG_NUM_INFLIGHT_FRAMES];  /* frame index at which a slot of the mapped storage was last bound */
     } gl;
 } _sg_gl_buffer_t;
 typedef _sg_gl_buffer_t _sg_buffer_t;
@@ -3329,6 +5093,9 @@ typedef struct {
         GLuint msaa_render_buffer;
         GLuint tex[SG_NUM_INFLIGHT_FRAMES];
         bool ext_textures;  /* if true, external textures were injected with sg_image_desc.gl_textures */
+        #if defined(_SOKOL_GL_PBO_UPLOAD)
+        GLsync upload_fence;    /* signalled when the last asynchronous upload has completed */
+        #endif
     } gl;
 } _sg_gl_image_t;
 typedef _sg_gl_image_t _sg_image_t;
@@ -3341,6 +5108,8 @@ typedef struct {
 } _sg_gl_uniform_t;
 
 typedef struct {
+    bool ubo;               /* true if backed by a uniform buffer object */
+    GLint ubo_binding;      /* uniform buffer binding point, -1 if the uniform block isn't active */
     int num_uniforms;
     _sg_gl_uniform_t uniforms[SG_MAX_UB_MEMBERS];
 } _sg_gl_uniform_block_t;
@@ -3364,7 +5133,7 @@ typedef struct {
     struct {
         GLuint prog;
         _sg_gl_shader_attr_t attrs[SG_MAX_VERTEX_ATTRIBUTES];
-        _sg_gl_shader_stage_t stage[SG_NUM_SHADER_STAGES];
+        _sg_gl_shader_stage_t stage[_SG_NUM_ALL_SHADER_STAGES];
     } gl;
 } _sg_gl_shader_t;
 typedef _sg_gl_shader_t _sg_shader_t;
@@ -3415,15 +5184,51 @@ typedef struct {
 typedef _sg_gl_pass_t _sg_pass_t;
 typedef _sg_pass_attachment_common_t _sg_pass_attachment_t;
 
+#if !defined(SOKOL_GLES2)
+/* vertex array object cache key, the per-draw vertex buffer offsets are not part of the key */
+typedef struct {
+    GLuint ib;
+    GLuint vbufs[SG_MAX_VERTEX_ATTRIBUTES];
+    _sg_gl_attr_t attrs[SG_MAX_VERTEX_ATTRIBUTES];
+} _sg_gl_vao_key_t;
+
+typedef struct {
+    _sg_gl_vao_key_t key;
+    uint32_t hash;          /* hash of the key, compared before the full key */
+    GLuint vao;             /* 0 marks an empty table slot */
+    uint32_t last_use;
+    int vb_offsets[SG_MAX_VERTEX_ATTRIBUTES];   /* vertex buffer offsets of the current attribute pointers */
+} _sg_gl_vao_cache_item_t;
+
+/* open-addressing hash table with linear probing, twice as many slots as cached VAOs */
+typedef struct {
+    int capacity;
+    int num_items;
+    uint32_t mask;
+    uint32_t use_counter;
+    _sg_gl_vao_cache_item_t* items;
+} _sg_gl_vao_cache_t;
+#endif
+
 typedef struct {
     _sg_slot_t slot;
     #if !defined(SOKOL_GLES2)
     GLuint vao;
+    _sg_gl_vao_cache_t vao_cache;
     #endif
     GLuint default_framebuffer;
 } _sg_gl_context_t;
 typedef _sg_gl_context_t _sg_context_t;
 
+typedef struct {
+    _sg_slot_t slot;
+    _sg_sampler_common_t cmn;
+    struct {
+        GLuint smp;     /* GL sampler object, 0 on GLES2 */
+    } gl;
+} _sg_gl_sampler_t;
+typedef _sg_gl_sampler_t _sg_sampler_t;
+
 typedef struct {
     _sg_gl_attr_t gl_attr;
     GLuint gl_vbuf;
@@ -3450,9 +5255,15 @@ typedef struct {
     GLuint index_buffer;
     GLuint stored_vertex_buffer;
     GLuint stored_index_buffer;
+    GLuint uniform_buffer;
+    GLuint vao;
+    GLuint draw_vao;        /* cached VAO selected by the last sg_apply_bindings(), rebound before draws */
+    GLuint draw_vao_ib;     /* index buffer of draw_vao */
     GLuint prog;
     _sg_gl_texture_bind_slot textures[SG_MAX_SHADERSTAGE_IMAGES];
     _sg_gl_texture_bind_slot stored_texture;
+    GLuint samplers[SG_MAX_SHADERSTAGE_IMAGES];     /* 0 if the texture's own sampler state is used */
+    GLuint storage_buffers[SG_MAX_SHADERSTAGE_STORAGE_BUFFERS];
     int cur_ib_offset;
     GLenum cur_primitive_type;
     GLenum cur_index_type;
@@ -3461,6 +5272,55 @@ typedef struct {
     sg_pipeline cur_pipeline_id;
 } _sg_gl_state_cache_t;
 
+#define _SG_GL_MAX_RETIRED_UBS (8)   /* max number of times the uniform buffer can grow in one frame */
+
+/* per-frame uniform buffer for uniform blocks which are backed by uniform buffer objects */
+typedef struct {
+    GLuint buf;         /* created with the first shader which has a uniform buffer object */
+    int size;
+    int offset;
+    int align;          /* GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT */
+    bool orphan;        /* orphan the buffer storage on first use in a new frame */
+    int num_retired;
+    GLuint retired[_SG_GL_MAX_RETIRED_UBS];    /* outgrown buffers, still bound in the current frame */
+    int retired_offset;     /* bytes written into the retired buffers in the current frame */
+} _sg_gl_uniform_buffer_t;
+
+#if defined(_SOKOL_GL_PBO_UPLOAD)
+/* ring of pixel buffer objects for asynchronous image uploads */
+typedef struct {
+    GLuint buf;
+    int size;
+    GLsync fence;       /* signalled when the GPU has finished reading from the buffer */
+} _sg_gl_upload_buffer_t;
+
+typedef struct {
+    int num;
+    int cur;
+    _sg_gl_upload_buffer_t* bufs;
+} _sg_gl_upload_pool_t;
+
+/* pixel buffer object for asynchronous image readbacks, one per readback queue item */
+typedef struct {
+    GLuint buf;
+    int size;
+    GLsync fence;       /* signalled when the GPU has finished writing the pixel data */
+} _sg_gl_readback_buffer_t;
+#endif
+
+/* GL object names which are generated or deleted in one go by
+   the batched resource creation and destruction functions, the
+   names array is kept around between batches and only grows
+   ('cap' is the capacity of the current batch and 0 outside of
+   a batch, 'size' is the number of allocated items)
+*/
+typedef struct {
+    int num;
+    int cap;
+    int size;
+    GLuint* names;
+} _sg_gl_names_t;
+
 typedef struct {
     bool valid;
     bool gles2;
@@ -3470,10 +5330,35 @@ typedef struct {
     _sg_context_t* cur_context;
     _sg_pass_t* cur_pass;
     sg_pass cur_pass_id;
+    sg_pass_action cur_pass_action;     /* needed for the store actions in _sg_gl_end_pass() */
     _sg_gl_state_cache_t cache;
     bool ext_anisotropic;
     GLint max_anisotropy;
     GLint max_combined_texture_image_units;
+    _sg_gl_names_t gen_buffers;
+    _sg_gl_names_t gen_textures;
+    _sg_gl_names_t del_buffers;
+    _sg_gl_names_t del_textures;
+    #if !defined(SOKOL_GLES2)
+    _sg_gl_uniform_buffer_t ub;
+    #endif
+    GLuint readback_fb;     /* created on first use by sg_read_image_async() */
+    #if defined(_SOKOL_GL_PBO_UPLOAD)
+    _sg_gl_upload_pool_t upload;
+    bool pbo_readback;
+    _sg_gl_readback_buffer_t readback_bufs[_SG_MAX_IMAGE_READBACKS];
+    #endif
+    #if defined(_SOKOL_GL_TIMER_QUERY)
+    GLuint timer_queries[_SG_GPU_TIMING_FRAMES][SG_MAX_GPU_TIMINGS * 2];
+    #endif
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    bool persistent_buffers;
+    uint32_t completed_frame_index;         /* all frames before this frame index have been completed by the GPU */
+    GLsync frame_fences[SG_NUM_INFLIGHT_FRAMES];
+    #endif
+    #if defined(_SOKOL_GL_INVALIDATE)
+    bool invalidate;        /* glInvalidateFramebuffer() is available */
+    #endif
     #if _SOKOL_USE_WIN32_GL_LOADER
     HINSTANCE opengl32_dll;
     #endif
@@ -3572,6 +5457,15 @@ typedef struct {
 } _sg_d3d11_context_t;
 typedef _sg_d3d11_context_t _sg_context_t;
 
+typedef struct {
+    _sg_slot_t slot;
+    _sg_sampler_common_t cmn;
+    struct {
+        ID3D11SamplerState* smp;
+    } d3d11;
+} _sg_d3d11_sampler_t;
+typedef _sg_d3d11_sampler_t _sg_sampler_t;
+
 typedef struct {
     bool valid;
     ID3D11Device* dev;
@@ -3592,6 +5486,7 @@ typedef struct {
     sg_pipeline cur_pipeline_id;
     ID3D11RenderTargetView* cur_rtvs[SG_MAX_COLOR_ATTACHMENTS];
     ID3D11DepthStencilView* cur_dsv;
+    sg_store_action cur_store_actions[SG_MAX_COLOR_ATTACHMENTS];  /* used to skip the MSAA resolve */
     /* on-demand loaded d3dcompiler_47.dll handles */
     HINSTANCE d3dcompiler_dll;
     bool d3dcompiler_dll_load_failed;
@@ -3617,6 +5512,7 @@ typedef struct {
 #define _SG_MTL_UB_ALIGN (16)
 #endif
 #define _SG_MTL_INVALID_SLOT_INDEX (0)
+#define _SG_MTL_MAX_UB_CHAIN (7)    /* max number of additional uniform buffers per frame */
 
 typedef struct {
     uint32_t frame_index;   /* frame index at which it is safe to release this resource */
@@ -3705,6 +5601,15 @@ typedef struct {
 } _sg_mtl_context_t;
 typedef _sg_mtl_context_t _sg_context_t;
 
+typedef struct {
+    _sg_slot_t slot;
+    _sg_sampler_common_t cmn;
+    struct {
+        int sampler_state;
+    } mtl;
+} _sg_mtl_sampler_t;
+typedef _sg_mtl_sampler_t _sg_sampler_t;
+
 /* resouce binding state cache */
 typedef struct {
     const _sg_pipeline_t* cur_pipeline;
@@ -3719,6 +5624,8 @@ typedef struct {
     sg_image cur_vs_image_ids[SG_MAX_SHADERSTAGE_IMAGES];
     const _sg_image_t* cur_fs_images[SG_MAX_SHADERSTAGE_IMAGES];
     sg_image cur_fs_image_ids[SG_MAX_SHADERSTAGE_IMAGES];
+    int cur_vs_sampler_states[SG_MAX_SHADERSTAGE_IMAGES];
+    int cur_fs_sampler_states[SG_MAX_SHADERSTAGE_IMAGES];
 } _sg_mtl_state_cache_t;
 
 typedef struct {
@@ -3733,6 +5640,9 @@ typedef struct {
     int ub_size;
     int cur_ub_offset;
     uint8_t* cur_ub_base_ptr;
+    bool ub_chaining;
+    int cur_ub_chain_index;     /* 0: uniform_buffers[], > 0: chained_uniform_buffers[][index-1] */
+    int ub_bound_chain_index[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS];
     bool in_pass;
     bool pass_valid;
     int cur_width;
@@ -3746,6 +5656,7 @@ typedef struct {
     id<MTLCommandBuffer> cmd_buffer;
     id<MTLRenderCommandEncoder> cmd_encoder;
     id<MTLBuffer> uniform_buffers[SG_NUM_INFLIGHT_FRAMES];
+    id<MTLBuffer> chained_uniform_buffers[SG_NUM_INFLIGHT_FRAMES][_SG_MTL_MAX_UB_CHAIN];
 } _sg_mtl_backend_t;
 
 /*=== WGPU BACKEND DECLARATIONS ==============================================*/
@@ -3826,10 +5737,19 @@ typedef struct {
 } _sg_wgpu_context_t;
 typedef _sg_wgpu_context_t _sg_context_t;
 
-/* a pool of per-frame uniform buffers */
 typedef struct {
-    WGPUBindGroupLayout bindgroup_layout;
-    uint32_t num_bytes;
+    _sg_slot_t slot;
+    _sg_sampler_common_t cmn;
+    struct {
+        WGPUSampler sampler;
+    } wgpu;
+} _sg_wgpu_sampler_t;
+typedef _sg_wgpu_sampler_t _sg_sampler_t;
+
+/* a pool of per-frame uniform buffers */
+typedef struct {
+    WGPUBindGroupLayout bindgroup_layout;
+    uint32_t num_bytes;
     uint32_t offset;    /* current offset into current frame's mapped uniform buffer */
     uint32_t bind_offsets[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS];
     WGPUBuffer buf;     /* the GPU-side uniform buffer */
@@ -3885,11 +5805,22 @@ typedef struct {
 /* this *MUST* remain 0 */
 #define _SG_INVALID_SLOT_INDEX (0)
 
+/* pool items are allocated in chunks, so that a growing pool never
+   moves existing items in memory, a non-growable pool has exactly
+   one chunk, the first chunk holds exactly the requested number of
+   items, and each following chunk is as big as all previous chunks
+   together (so that the pool size doubles each time it grows)
+*/
 typedef struct {
     int size;
     int queue_top;
     uint32_t* gen_ctrs;
     int* free_queue;
+    bool growable;
+    size_t item_size;
+    int first_chunk_size;
+    int num_chunks;
+    uint8_t** chunks;
 } _sg_pool_t;
 
 typedef struct {
@@ -3899,12 +5830,7 @@ typedef struct {
     _sg_pool_t pipeline_pool;
     _sg_pool_t pass_pool;
     _sg_pool_t context_pool;
-    _sg_buffer_t* buffers;
-    _sg_image_t* images;
-    _sg_shader_t* shaders;
-    _sg_pipeline_t* pipelines;
-    _sg_pass_t* passes;
-    _sg_context_t* contexts;
+    _sg_pool_t sampler_pool;
 } _sg_pools_t;
 
 /*=== VALIDATION LAYER DECLARATIONS ==========================================*/
@@ -3918,6 +5844,7 @@ typedef enum {
     _SG_VALIDATE_BUFFERDESC_DATA,
     _SG_VALIDATE_BUFFERDESC_DATA_SIZE,
     _SG_VALIDATE_BUFFERDESC_NO_DATA,
+    _SG_VALIDATE_BUFFERDESC_STORAGE_SUPPORT,
 
     /* image creation */
     _SG_VALIDATE_IMAGEDESC_CANARY,
@@ -3931,6 +5858,10 @@ typedef enum {
     _SG_VALIDATE_IMAGEDESC_RT_NO_DATA,
     _SG_VALIDATE_IMAGEDESC_DATA,
     _SG_VALIDATE_IMAGEDESC_NO_DATA,
+    _SG_VALIDATE_IMAGEDESC_TRANSIENT_NO_RT,
+    _SG_VALIDATE_IMAGEDESC_TRANSIENT_TYPE,
+    _SG_VALIDATE_IMAGEDESC_TRANSIENT_MIPMAPS,
+    _SG_VALIDATE_IMAGEDESC_TRANSIENT_INJECTED,
 
     /* shader creation */
     _SG_VALIDATE_SHADERDESC_CANARY,
@@ -3944,10 +5875,21 @@ typedef enum {
     _SG_VALIDATE_SHADERDESC_NO_UB_MEMBERS,
     _SG_VALIDATE_SHADERDESC_UB_MEMBER_NAME,
     _SG_VALIDATE_SHADERDESC_UB_SIZE_MISMATCH,
+    _SG_VALIDATE_SHADERDESC_UB_STD140_SIZE,
+    _SG_VALIDATE_SHADERDESC_UB_STD140_ARRAY_TYPE,
     _SG_VALIDATE_SHADERDESC_IMG_NAME,
     _SG_VALIDATE_SHADERDESC_ATTR_NAMES,
     _SG_VALIDATE_SHADERDESC_ATTR_SEMANTICS,
     _SG_VALIDATE_SHADERDESC_ATTR_STRING_TOO_LONG,
+    _SG_VALIDATE_SHADERDESC_INSTANCING_UB,
+    _SG_VALIDATE_SHADERDESC_INSTANCING_UB_SIZE,
+    _SG_VALIDATE_SHADERDESC_INSTANCING_BUFFER,
+    _SG_VALIDATE_SHADERDESC_INSTANCING_TRANSIENT,
+    _SG_VALIDATE_SHADERDESC_COMPUTE_SUPPORT,
+    _SG_VALIDATE_SHADERDESC_COMPUTE_STAGES,
+    _SG_VALIDATE_SHADERDESC_COMPUTE_IMAGES,
+    _SG_VALIDATE_SHADERDESC_STORAGE_BUFFER_STAGE,
+    _SG_VALIDATE_SHADERDESC_NO_CONT_STORAGE_BUFFERS,
 
     /* pipeline creation */
     _SG_VALIDATE_PIPELINEDESC_CANARY,
@@ -3956,6 +5898,14 @@ typedef enum {
     _SG_VALIDATE_PIPELINEDESC_LAYOUT_STRIDE4,
     _SG_VALIDATE_PIPELINEDESC_ATTR_NAME,
     _SG_VALIDATE_PIPELINEDESC_ATTR_SEMANTICS,
+    _SG_VALIDATE_PIPELINEDESC_INSTANCING_LAYOUT,
+    _SG_VALIDATE_PIPELINEDESC_INSTANCING_LAST_BUFFER,
+    _SG_VALIDATE_PIPELINEDESC_COMPUTE_SHADER,
+
+    /* compute pipeline creation */
+    _SG_VALIDATE_CPIPELINEDESC_CANARY,
+    _SG_VALIDATE_CPIPELINEDESC_SHADER,
+    _SG_VALIDATE_CPIPELINEDESC_NO_COMPUTE_SHADER,
 
     /* pass creation */
     _SG_VALIDATE_PASSDESC_CANARY,
@@ -3972,9 +5922,15 @@ typedef enum {
     _SG_VALIDATE_PASSDESC_IMAGE_SIZES,
     _SG_VALIDATE_PASSDESC_IMAGE_SAMPLE_COUNTS,
 
+    /* sampler creation */
+    _SG_VALIDATE_SAMPLERDESC_CANARY,
+    _SG_VALIDATE_SAMPLERDESC_ANISTROPY,
+
     /* sg_begin_pass validation */
     _SG_VALIDATE_BEGINPASS_PASS,
     _SG_VALIDATE_BEGINPASS_IMAGE,
+    _SG_VALIDATE_BEGINPASS_DEPTH_RESOLVE,
+    _SG_VALIDATE_BEGINPASS_TRANSIENT_LOAD,
 
     /* sg_apply_pipeline validation */
     _SG_VALIDATE_APIP_PIPELINE_VALID_ID,
@@ -3986,6 +5942,8 @@ typedef enum {
     _SG_VALIDATE_APIP_COLOR_FORMAT,
     _SG_VALIDATE_APIP_DEPTH_FORMAT,
     _SG_VALIDATE_APIP_SAMPLE_COUNT,
+    _SG_VALIDATE_APIP_COMPUTE_PASS,
+    _SG_VALIDATE_APIP_RENDER_PASS,
 
     /* sg_apply_bindings validation */
     _SG_VALIDATE_ABND_PIPELINE,
@@ -3995,6 +5953,7 @@ typedef enum {
     _SG_VALIDATE_ABND_VB_EXISTS,
     _SG_VALIDATE_ABND_VB_TYPE,
     _SG_VALIDATE_ABND_VB_OVERFLOW,
+    _SG_VALIDATE_ABND_INSTANCING_VB,
     _SG_VALIDATE_ABND_NO_IB,
     _SG_VALIDATE_ABND_IB,
     _SG_VALIDATE_ABND_IB_EXISTS,
@@ -4003,9 +5962,23 @@ typedef enum {
     _SG_VALIDATE_ABND_VS_IMGS,
     _SG_VALIDATE_ABND_VS_IMG_EXISTS,
     _SG_VALIDATE_ABND_VS_IMG_TYPES,
+    _SG_VALIDATE_ABND_VS_IMG_TRANSIENT,
     _SG_VALIDATE_ABND_FS_IMGS,
     _SG_VALIDATE_ABND_FS_IMG_EXISTS,
     _SG_VALIDATE_ABND_FS_IMG_TYPES,
+    _SG_VALIDATE_ABND_FS_IMG_TRANSIENT,
+    _SG_VALIDATE_ABND_SMP_SUPPORT,
+    _SG_VALIDATE_ABND_VS_SMP_EXISTS,
+    _SG_VALIDATE_ABND_VS_SMP_NO_IMG,
+    _SG_VALIDATE_ABND_FS_SMP_EXISTS,
+    _SG_VALIDATE_ABND_FS_SMP_NO_IMG,
+    _SG_VALIDATE_ABND_CS_SBUFS,
+    _SG_VALIDATE_ABND_CS_SBUF_EXISTS,
+    _SG_VALIDATE_ABND_CS_SBUF_TYPE,
+
+    /* sg_apply_prepared_bindings validation */
+    _SG_VALIDATE_APBND_VALID,
+    _SG_VALIDATE_APBND_PIPELINE,
 
     /* sg_apply_uniforms validation */
     _SG_VALIDATE_AUB_NO_PIPELINE,
@@ -4028,11 +6001,169 @@ typedef enum {
     _SG_VALIDATE_UPDIMG_NOTENOUGHDATA,
     _SG_VALIDATE_UPDIMG_SIZE,
     _SG_VALIDATE_UPDIMG_COMPRESSED,
-    _SG_VALIDATE_UPDIMG_ONCE
+    _SG_VALIDATE_UPDIMG_ONCE,
+    _SG_VALIDATE_UPDIMG_AFTER_REGION,
+
+    /* sg_update_image_region validation */
+    _SG_VALIDATE_UPDIMGRGN_SUPPORT,
+    _SG_VALIDATE_UPDIMGRGN_USAGE,
+    _SG_VALIDATE_UPDIMGRGN_COMPRESSED,
+    _SG_VALIDATE_UPDIMGRGN_MIPLEVEL,
+    _SG_VALIDATE_UPDIMGRGN_SLICE,
+    _SG_VALIDATE_UPDIMGRGN_REGION,
+    _SG_VALIDATE_UPDIMGRGN_DATA,
+    _SG_VALIDATE_UPDIMGRGN_OVERLAP,
+
+    /* sg_read_image_async validation */
+    _SG_VALIDATE_READIMG_CALLBACK,
+    _SG_VALIDATE_READIMG_FORMAT,
+    _SG_VALIDATE_READIMG_TRANSIENT,
+    _SG_VALIDATE_READIMG_MIPLEVEL,
+    _SG_VALIDATE_READIMG_SLICE,
+    _SG_VALIDATE_READIMG_REGION
 } _sg_validate_error_t;
 
 /*=== GENERIC BACKEND STATE ==================================================*/
 
+/* per-frame statistics, with optional history ring buffer */
+typedef struct {
+    sg_frame_stats cur;
+    sg_frame_stats prev;
+    int history_size;
+    int history_count;
+    sg_frame_stats* history;
+} _sg_stats_t;
+
+/* redundant state filter, this tracks what has actually been applied to the backend */
+typedef struct {
+    bool valid;
+    size_t size;
+    uint8_t data[_SG_FILTER_MAX_UB_SIZE];
+} _sg_filter_uniforms_t;
+
+typedef struct {
+    bool enabled;
+    sg_pipeline pipeline;
+    bool bindings_valid;
+    sg_bindings bindings;
+    _sg_filter_uniforms_t uniforms[_SG_NUM_ALL_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS];
+    sg_state_filter_stats cur_stats;
+    sg_state_filter_stats prev_stats;
+} _sg_state_filter_t;
+
+/* the shared transient vertex- and index-buffer */
+typedef struct {
+    sg_buffer vbuf;
+    sg_buffer ibuf;
+    uint32_t overflow_frame_index;  /* frame index of the last logged overflow, to log only once per frame */
+} _sg_transient_t;
+
+/* auto-instancing state, collects uniform+draw pairs into instanced draws */
+typedef struct {
+    bool active;
+    sg_pipeline pip;
+    int ub_index;
+    int buffer_index;
+    int record_size;
+    uint8_t record[_SG_INSTANCING_MAX_RECORD_SIZE];
+    bool bindings_valid;
+    sg_bindings bindings;
+    int base_element;
+    int num_elements;
+    int base_vertex;
+    int num_instances;
+    int pos;
+    int staging_size;
+    uint8_t* staging;
+} _sg_instancing_t;
+
+/* GPU timing state, one set of timestamp queries per frame in flight */
+typedef struct {
+    uint32_t frame_index;       /* 0 if there are no pending results */
+    int num_timings;
+    sg_gpu_timing timings[SG_MAX_GPU_TIMINGS];
+} _sg_gpu_timing_frame_t;
+
+typedef struct {
+    bool enabled;
+    int cur_frame;
+    int depth;
+    int skipped_depth;          /* nesting depth of timers beyond _SG_GPU_TIMING_MAX_DEPTH */
+    int stack[_SG_GPU_TIMING_MAX_DEPTH];    /* timing index, or -1 if the timer was dropped */
+    _sg_gpu_timing_frame_t frames[_SG_GPU_TIMING_FRAMES];
+    sg_gpu_timings result;
+} _sg_gpu_timing_t;
+
+/* a pending image readback */
+typedef struct {
+    sg_image_readback readback;
+    sg_read_image_callback callback;
+    int num_bytes;
+    void* data;                 /* client memory, for backends which read back synchronously */
+} _sg_readback_t;
+
+/* a resource creation request in an sg_async_queue */
+typedef enum {
+    _SG_ASYNC_BUFFER = 0,
+    _SG_ASYNC_IMAGE = 1,
+    _SG_ASYNC_NUM_TYPES,
+} _sg_async_type_t;
+
+typedef struct {
+    _sg_async_type_t type;
+    uint32_t id;
+    union {
+        sg_buffer_desc buf;
+        sg_image_desc img;
+    } desc;
+    void* data;                 /* owned copy of the initial content and label, desc points into it */
+} _sg_async_packet_t;
+
+/* a destroyed buffer or image, waiting until the GPU no longer uses it */
+typedef enum {
+    _SG_DESTROY_BUFFER,
+    _SG_DESTROY_IMAGE,
+} _sg_destroy_type_t;
+
+typedef struct {
+    _sg_destroy_type_t type;
+    uint32_t frame_index;       /* frame index of the sg_destroy_buffer()/sg_destroy_image() call */
+    size_t num_bytes;
+    union {
+        _sg_buffer_t buf;
+        _sg_image_t img;
+    } res;                      /* copy of the resource slot, the slot itself is already free */
+} _sg_destroy_item_t;
+
+typedef struct {
+    bool enabled;
+    int num;
+    int cap;
+    size_t num_bytes;
+    _sg_destroy_item_t* items;
+} _sg_destroy_queue_t;
+
+/* pending image readbacks in the order they have been started */
+typedef struct {
+    int head;
+    int num;
+    _sg_readback_t items[_SG_MAX_IMAGE_READBACKS];
+} _sg_readback_queue_t;
+
+#if defined(SOKOL_DEBUG)
+/* image regions written in the current frame, for the overlap check in sg_update_image_region() */
+typedef struct {
+    uint32_t img_id;
+    sg_image_region region;
+} _sg_tracked_image_region_t;
+
+typedef struct {
+    uint32_t frame_index;
+    int num;
+    _sg_tracked_image_region_t items[_SG_MAX_TRACKED_IMAGE_REGIONS];
+} _sg_image_region_tracker_t;
+#endif
+
 typedef struct {
     bool valid;
     sg_desc desc;       /* original desc with default values patched in */
@@ -4041,11 +6172,23 @@ typedef struct {
     sg_pass cur_pass;
     sg_pipeline cur_pipeline;
     bool pass_valid;
+    bool compute_pass;
     bool bindings_valid;
     bool next_draw_valid;
+    uint32_t base_vertex_log_frame_index;   /* frame index of the last logged base_vertex rejection, to log only once per frame */
     #if defined(SOKOL_DEBUG)
     _sg_validate_error_t validate_error;
+    _sg_image_region_tracker_t updated_regions;
     #endif
+    _sg_state_filter_t filter;
+    _sg_stats_t stats;
+    _sg_transient_t transient;
+    _sg_instancing_t instancing;
+    _sg_shader_cache_t shader_cache;
+    _sg_gpu_timing_t timing;
+    _sg_readback_queue_t readback;
+    _sg_destroy_queue_t destroy_queue;
+    sg_memory_stats memory;
     _sg_pools_t pools;
     sg_backend backend;
     sg_features features;
@@ -4066,6 +6209,13 @@ typedef struct {
 } _sg_state_t;
 static _sg_state_t _sg;
 
+/* called when the backend bindings no longer match what the state filter
+   has recorded, defined here because backends may call it too
+*/
+_SOKOL_PRIVATE void _sg_filter_reset_bindings(void) {
+    _sg.filter.bindings_valid = false;
+}
+
 /*-- helper functions --------------------------------------------------------*/
 
 _SOKOL_PRIVATE bool _sg_strempty(const _sg_str_t* str) {
@@ -4131,6 +6281,21 @@ _SOKOL_PRIVATE int _sg_uniform_size(sg_uniform_type type, int count) {
     }
 }
 
+/* std140 base alignment of a uniform block member (only FLOAT4 and MAT4 arrays are allowed) */
+_SOKOL_PRIVATE int _sg_std140_uniform_alignment(sg_uniform_type type, int count) {
+    if (count > 1) {
+        return 16;
+    }
+    switch (type) {
+        case SG_UNIFORMTYPE_FLOAT:      return 4;
+        case SG_UNIFORMTYPE_FLOAT2:     return 8;
+        case SG_UNIFORMTYPE_FLOAT3:     return 16;
+        case SG_UNIFORMTYPE_FLOAT4:     return 16;
+        case SG_UNIFORMTYPE_MAT4:       return 16;
+        default:                        return 1;
+    }
+}
+
 /* return true if pixel format is a compressed format */
 _SOKOL_PRIVATE bool _sg_is_compressed_pixel_format(sg_pixel_format fmt) {
     switch (fmt) {
@@ -4338,6 +6503,64 @@ _SOKOL_PRIVATE int _sg_surface_pitch(sg_pixel_format fmt, int width, int height,
     return num_rows * _sg_row_pitch(fmt, width, row_align);
 }
 
+/* number of backend copies of a dynamic resource, D3D11 renames dynamic
+   resources inside the driver, so only one copy is known to sokol-gfx
+*/
+_SOKOL_PRIVATE int _sg_num_memory_slots(int num_slots) {
+    #if defined(SOKOL_D3D11)
+    _SOKOL_UNUSED(num_slots);
+    return 1;
+    #else
+    return num_slots;
+    #endif
+}
+
+/* approximate backend memory size of a buffer, including all in-flight slots */
+_SOKOL_PRIVATE size_t _sg_buffer_num_bytes(const _sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf);
+    return (size_t)buf->cmn.size * (size_t)_sg_num_memory_slots(buf->cmn.num_slots);
+}
+
+/* approximate backend memory size of an image, including all mipmaps,
+   slices and in-flight slots, MSAA color render targets have a separate
+   MSAA surface in addition to the resolve texture, MSAA depth render
+   targets and transient MSAA color render targets only the MSAA surface
+   (the depth formats are assumed to take 4 bytes per pixel)
+*/
+_SOKOL_PRIVATE size_t _sg_image_num_bytes(const _sg_image_t* img) {
+    SOKOL_ASSERT(img);
+    const _sg_image_common_t* cmn = &img->cmn;
+    const bool is_depth = _sg_is_valid_rendertarget_depth_format(cmn->pixel_format);
+    /* only the GL and Metal backends skip the resolve texture of transient MSAA images */
+    #if defined(_SOKOL_ANY_GL) || defined(SOKOL_METAL)
+    const bool msaa_only = cmn->transient && (cmn->sample_count > 1);
+    #else
+    const bool msaa_only = false;
+    #endif
+    const int num_faces = (cmn->type == SG_IMAGETYPE_CUBE) ? SG_CUBEFACE_NUM : 1;
+    const int num_slices = ((cmn->type == SG_IMAGETYPE_ARRAY) || (cmn->type == SG_IMAGETYPE_3D)) ? cmn->num_slices : 1;
+    size_t num_bytes = 0;
+    for (int mip_index = 0; mip_index < cmn->num_mipmaps; mip_index++) {
+        const int mip_width = _sg_max(cmn->width >> mip_index, 1);
+        const int mip_height = _sg_max(cmn->height >> mip_index, 1);
+        const int mip_slices = (cmn->type == SG_IMAGETYPE_3D) ? _sg_max(num_slices >> mip_index, 1) : num_slices;
+        const size_t surface_bytes = is_depth ?
+            (size_t)mip_width * (size_t)mip_height * 4 :
+            (size_t)_sg_surface_pitch(cmn->pixel_format, mip_width, mip_height, 1);
+        const size_t mip_bytes = surface_bytes * (size_t)(num_faces * mip_slices);
+        if (is_depth || msaa_only) {
+            num_bytes += mip_bytes * (size_t)_sg_max(cmn->sample_count, 1);
+        }
+        else {
+            num_bytes += mip_bytes;
+            if ((0 == mip_index) && (cmn->sample_count > 1)) {
+                num_bytes += mip_bytes * (size_t)cmn->sample_count;
+            }
+        }
+    }
+    return num_bytes * (size_t)_sg_num_memory_slots(cmn->num_slots);
+}
+
 /* capability table pixel format helper functions */
 _SOKOL_PRIVATE void _sg_pixelformat_all(sg_pixelformat_info* pfi) {
     pfi->sample = true;
@@ -4400,29 +6623,6 @@ _SOKOL_PRIVATE void _sg_pixelformat_sfbr(sg_pixelformat_info* pfi) {
     pfi->render = true;
 }
 
-/* resolve pass action defaults into a new pass action struct */
-_SOKOL_PRIVATE void _sg_resolve_default_pass_action(const sg_pass_action* from, sg_pass_action* to) {
-    SOKOL_ASSERT(from && to);
-    *to = *from;
-    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
-        if (to->colors[i].action  == _SG_ACTION_DEFAULT) {
-            to->colors[i].action = SG_ACTION_CLEAR;
-            to->colors[i].value.r = SG_DEFAULT_CLEAR_RED;
-            to->colors[i].value.g = SG_DEFAULT_CLEAR_GREEN;
-            to->colors[i].value.b = SG_DEFAULT_CLEAR_BLUE;
-            to->colors[i].value.a = SG_DEFAULT_CLEAR_ALPHA;
-        }
-    }
-    if (to->depth.action == _SG_ACTION_DEFAULT) {
-        to->depth.action = SG_ACTION_CLEAR;
-        to->depth.value = SG_DEFAULT_CLEAR_DEPTH;
-    }
-    if (to->stencil.action == _SG_ACTION_DEFAULT) {
-        to->stencil.action = SG_ACTION_CLEAR;
-        to->stencil.value = SG_DEFAULT_CLEAR_STENCIL;
-    }
-}
-
 /*== DUMMY BACKEND IMPL ======================================================*/
 #if defined(SOKOL_DUMMY_BACKEND)
 
@@ -4439,6 +6639,12 @@ _SOKOL_PRIVATE void _sg_dummy_setup_backend(const sg_desc* desc) {
     }
     _sg.formats[SG_PIXELFORMAT_DEPTH].depth = true;
     _sg.formats[SG_PIXELFORMAT_DEPTH_STENCIL].depth = true;
+    _sg.features.gpu_timing = true;
+    _sg.features.image_readback = true;
+    _sg.features.base_vertex = true;
+    _sg.features.sampler_objects = true;
+    _sg.features.image_region_update = true;
+    _sg.features.compute = true;
 }
 
 _SOKOL_PRIVATE void _sg_dummy_discard_backend(void) {
@@ -4513,6 +6719,13 @@ _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_pipeline(_sg_pipeline_t* pip,
     return SG_RESOURCESTATE_VALID;
 }
 
+_SOKOL_PRIVATE sg_resource_state _sg_dummy_create_compute_pipeline(_sg_pipeline_t* pip, _sg_shader_t* shd, const sg_compute_pipeline_desc* desc) {
+    SOKOL_ASSERT(pip && desc);
+    pip->shader = shd;
+    _sg_compute_pipeline_common_init(&pip->cmn, desc);
+    return SG_RESOURCESTATE_VALID;
+}
+
 _SOKOL_PRIVATE void _sg_dummy_destroy_pipeline(_sg_pipeline_t* pip) {
     SOKOL_ASSERT(pip);
     _SOKOL_UNUSED(pip);
@@ -4550,6 +6763,17 @@ _SOKOL_PRIVATE void _sg_dummy_destroy_pass(_sg_pass_t* pass) {
     _SOKOL_UNUSED(pass);
 }
 
+_SOKOL_PRIVATE sg_resource_state _sg_dummy_create_sampler(_sg_sampler_t* smp, const sg_sampler_desc* desc) {
+    SOKOL_ASSERT(smp && desc);
+    _sg_sampler_common_init(&smp->cmn, desc);
+    return SG_RESOURCESTATE_VALID;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_destroy_sampler(_sg_sampler_t* smp) {
+    SOKOL_ASSERT(smp);
+    _SOKOL_UNUSED(smp);
+}
+
 _SOKOL_PRIVATE _sg_image_t* _sg_dummy_pass_color_image(const _sg_pass_t* pass, int index) {
     SOKOL_ASSERT(pass && (index >= 0) && (index < SG_MAX_COLOR_ATTACHMENTS));
     /* NOTE: may return null */
@@ -4578,6 +6802,51 @@ _SOKOL_PRIVATE void _sg_dummy_commit(void) {
     /* empty */
 }
 
+_SOKOL_PRIVATE void _sg_dummy_write_timestamp(int frame, int query_index) {
+    _SOKOL_UNUSED(frame);
+    _SOKOL_UNUSED(query_index);
+}
+
+_SOKOL_PRIVATE bool _sg_dummy_timestamps_available(int frame, int num_queries) {
+    _SOKOL_UNUSED(frame);
+    _SOKOL_UNUSED(num_queries);
+    return true;
+}
+
+_SOKOL_PRIVATE uint64_t _sg_dummy_read_timestamp(int frame, int query_index) {
+    _SOKOL_UNUSED(frame);
+    _SOKOL_UNUSED(query_index);
+    return 0;
+}
+
+/* the dummy backend has no image content, readbacks always return zeroes */
+_SOKOL_PRIVATE bool _sg_dummy_read_image(int index, const _sg_image_t* img, _sg_readback_t* rb) {
+    SOKOL_ASSERT(img && rb);
+    _SOKOL_UNUSED(index);
+    _SOKOL_UNUSED(img);
+    rb->data = SOKOL_MALLOC((size_t)rb->num_bytes);
+    SOKOL_ASSERT(rb->data);
+    memset(rb->data, 0, (size_t)rb->num_bytes);
+    return true;
+}
+
+_SOKOL_PRIVATE bool _sg_dummy_readback_ready(int index, const _sg_readback_t* rb) {
+    _SOKOL_UNUSED(index);
+    _SOKOL_UNUSED(rb);
+    return true;
+}
+
+_SOKOL_PRIVATE const void* _sg_dummy_map_readback(int index, const _sg_readback_t* rb) {
+    SOKOL_ASSERT(rb);
+    _SOKOL_UNUSED(index);
+    return rb->data;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_unmap_readback(int index, const _sg_readback_t* rb) {
+    _SOKOL_UNUSED(index);
+    _SOKOL_UNUSED(rb);
+}
+
 _SOKOL_PRIVATE void _sg_dummy_apply_viewport(int x, int y, int w, int h, bool origin_top_left) {
     _SOKOL_UNUSED(x);
     _SOKOL_UNUSED(y);
@@ -4603,8 +6872,8 @@ _SOKOL_PRIVATE void _sg_dummy_apply_bindings(
     _sg_pipeline_t* pip,
     _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
     _sg_buffer_t* ib, int ib_offset,
-    _sg_image_t** vs_imgs, int num_vs_imgs,
-    _sg_image_t** fs_imgs, int num_fs_imgs)
+    _sg_image_t** vs_imgs, _sg_sampler_t** vs_smps, int num_vs_imgs,
+    _sg_image_t** fs_imgs, _sg_sampler_t** fs_smps, int num_fs_imgs)
 {
     SOKOL_ASSERT(pip);
     SOKOL_ASSERT(vbs && vb_offsets);
@@ -4613,8 +6882,8 @@ _SOKOL_PRIVATE void _sg_dummy_apply_bindings(
     _SOKOL_UNUSED(pip);
     _SOKOL_UNUSED(vbs); _SOKOL_UNUSED(vb_offsets); _SOKOL_UNUSED(num_vbs);
     _SOKOL_UNUSED(ib); _SOKOL_UNUSED(ib_offset);
-    _SOKOL_UNUSED(vs_imgs); _SOKOL_UNUSED(num_vs_imgs);
-    _SOKOL_UNUSED(fs_imgs); _SOKOL_UNUSED(num_fs_imgs);
+    _SOKOL_UNUSED(vs_imgs); _SOKOL_UNUSED(vs_smps); _SOKOL_UNUSED(num_vs_imgs);
+    _SOKOL_UNUSED(fs_imgs); _SOKOL_UNUSED(fs_smps); _SOKOL_UNUSED(num_fs_imgs);
 }
 
 _SOKOL_PRIVATE void _sg_dummy_apply_uniforms(sg_shader_stage stage_index, int ub_index, const sg_range* data) {
@@ -4623,10 +6892,32 @@ _SOKOL_PRIVATE void _sg_dummy_apply_uniforms(sg_shader_stage stage_index, int ub
     _SOKOL_UNUSED(data);
 }
 
-_SOKOL_PRIVATE void _sg_dummy_draw(int base_element, int num_elements, int num_instances) {
+_SOKOL_PRIVATE void _sg_dummy_draw(int base_element, int num_elements, int num_instances, int base_vertex) {
     _SOKOL_UNUSED(base_element);
     _SOKOL_UNUSED(num_elements);
     _SOKOL_UNUSED(num_instances);
+    _SOKOL_UNUSED(base_vertex);
+}
+
+_SOKOL_PRIVATE void _sg_dummy_begin_compute_pass(void) {
+    /* empty */
+}
+
+_SOKOL_PRIVATE void _sg_dummy_end_compute_pass(void) {
+    /* empty */
+}
+
+_SOKOL_PRIVATE void _sg_dummy_apply_compute_bindings(_sg_pipeline_t* pip, _sg_buffer_t** sbufs, int num_sbufs) {
+    SOKOL_ASSERT(pip && sbufs);
+    _SOKOL_UNUSED(pip);
+    _SOKOL_UNUSED(sbufs);
+    _SOKOL_UNUSED(num_sbufs);
+}
+
+_SOKOL_PRIVATE void _sg_dummy_dispatch(int num_groups_x, int num_groups_y, int num_groups_z) {
+    _SOKOL_UNUSED(num_groups_x);
+    _SOKOL_UNUSED(num_groups_y);
+    _SOKOL_UNUSED(num_groups_z);
 }
 
 _SOKOL_PRIVATE void _sg_dummy_update_buffer(_sg_buffer_t* buf, const sg_range* data) {
@@ -4657,6 +6948,13 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
     }
 }
 
+_SOKOL_PRIVATE void _sg_dummy_update_image_region(_sg_image_t* img, const sg_image_region* region, const sg_range* data) {
+    SOKOL_ASSERT(img && region && data);
+    _SOKOL_UNUSED(img);
+    _SOKOL_UNUSED(region);
+    _SOKOL_UNUSED(data);
+}
+
 /*== GL BACKEND ==============================================================*/
 #elif defined(_SOKOL_ANY_GL)
 
@@ -4721,6 +7019,11 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
     _SG_XMACRO(glViewport,                        void, (GLint x, GLint y, GLsizei width, GLsizei height)) \
     _SG_XMACRO(glDeleteBuffers,                   void, (GLsizei n, const GLuint * buffers)) \
     _SG_XMACRO(glDrawArrays,                      void, (GLenum mode, GLint first, GLsizei count)) \
+    _SG_XMACRO(glMultiDrawArrays,                 void, (GLenum mode, const GLint * first, const GLsizei * count, GLsizei drawcount)) \
+    _SG_XMACRO(glMultiDrawElements,               void, (GLenum mode, const GLsizei * count, GLenum type, const void * const * indices, GLsizei drawcount)) \
+    _SG_XMACRO(glDrawElementsBaseVertex,          void, (GLenum mode, GLsizei count, GLenum type, const void * indices, GLint basevertex)) \
+    _SG_XMACRO(glDrawElementsInstancedBaseVertex, void, (GLenum mode, GLsizei count, GLenum type, const void * indices, GLsizei instancecount, GLint basevertex)) \
+    _SG_XMACRO(glMultiDrawElementsBaseVertex,     void, (GLenum mode, const GLsizei * count, GLenum type, const void * const * indices, GLsizei drawcount, const GLint * basevertex)) \
     _SG_XMACRO(glDrawElementsInstanced,           void, (GLenum mode, GLsizei count, GLenum type, const void * indices, GLsizei instancecount)) \
     _SG_XMACRO(glVertexAttribPointer,             void, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pointer)) \
     _SG_XMACRO(glUniform1i,                       void, (GLint location, GLint v0)) \
@@ -4756,29 +7059,68 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
     _SG_XMACRO(glBlendFunc,                       void, (GLenum sfactor, GLenum dfactor)) \
     _SG_XMACRO(glUniform1fv,                      void, (GLint location, GLsizei count, const GLfloat * value)) \
     _SG_XMACRO(glReadBuffer,                      void, (GLenum src)) \
+    _SG_XMACRO(glReadPixels,                      void, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void * data)) \
+    _SG_XMACRO(glPixelStorei,                     void, (GLenum pname, GLint param)) \
     _SG_XMACRO(glClear,                           void, (GLbitfield mask)) \
     _SG_XMACRO(glTexImage2D,                      void, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void * pixels)) \
     _SG_XMACRO(glGenVertexArrays,                 void, (GLsizei n, GLuint * arrays)) \
     _SG_XMACRO(glFrontFace,                       void, (GLenum mode)) \
-    _SG_XMACRO(glCullFace,                        void, (GLenum mode))
+    _SG_XMACRO(glCullFace,                        void, (GLenum mode)) \
+    _SG_XMACRO(glGetUniformBlockIndex,            GLuint, (GLuint program, const GLchar * uniformBlockName)) \
+    _SG_XMACRO(glUniformBlockBinding,             void, (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)) \
+    _SG_XMACRO(glBindBufferRange,                 void, (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)) \
+    _SG_XMACRO(glGenSamplers,                     void, (GLsizei count, GLuint * samplers)) \
+    _SG_XMACRO(glDeleteSamplers,                  void, (GLsizei count, const GLuint * samplers)) \
+    _SG_XMACRO(glBindSampler,                     void, (GLuint unit, GLuint sampler)) \
+    _SG_XMACRO(glSamplerParameteri,               void, (GLuint sampler, GLenum pname, GLint param)) \
+    _SG_XMACRO(glSamplerParameterf,               void, (GLuint sampler, GLenum pname, GLfloat param)) \
+    _SG_XMACRO(glSamplerParameterfv,              void, (GLuint sampler, GLenum pname, const GLfloat * params))
+
+// X Macro list of optional GL functions, these are null if not provided by the GL driver
+#define _SG_GL_OPT_FUNCS \
+    _SG_XMACRO(glGetProgramBinary,                void, (GLuint program, GLsizei bufSize, GLsizei * length, GLenum * binaryFormat, void * binary)) \
+    _SG_XMACRO(glProgramBinary,                   void, (GLuint program, GLenum binaryFormat, const void * binary, GLsizei length)) \
+    _SG_XMACRO(glProgramParameteri,               void, (GLuint program, GLenum pname, GLint value)) \
+    _SG_XMACRO(glBufferStorage,                   void, (GLenum target, GLsizeiptr size, const void * data, GLbitfield flags)) \
+    _SG_XMACRO(glMapBufferRange,                  void *, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)) \
+    _SG_XMACRO(glUnmapBuffer,                     GLboolean, (GLenum target)) \
+    _SG_XMACRO(glFenceSync,                       GLsync, (GLenum condition, GLbitfield flags)) \
+    _SG_XMACRO(glClientWaitSync,                  GLenum, (GLsync sync, GLbitfield flags, GLuint64 timeout)) \
+    _SG_XMACRO(glDeleteSync,                      void, (GLsync sync)) \
+    _SG_XMACRO(glGenQueries,                      void, (GLsizei n, GLuint * ids)) \
+    _SG_XMACRO(glDeleteQueries,                   void, (GLsizei n, const GLuint * ids)) \
+    _SG_XMACRO(glQueryCounter,                    void, (GLuint id, GLenum target)) \
+    _SG_XMACRO(glGetQueryObjectiv,                void, (GLuint id, GLenum pname, GLint * params)) \
+    _SG_XMACRO(glGetQueryObjectui64v,             void, (GLuint id, GLenum pname, GLuint64 * params)) \
+    _SG_XMACRO(glBindBufferBase,                  void, (GLenum target, GLuint index, GLuint buffer)) \
+    _SG_XMACRO(glDispatchCompute,                 void, (GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z)) \
+    _SG_XMACRO(glMemoryBarrier,                   void, (GLbitfield barriers)) \
+    _SG_XMACRO(glInvalidateFramebuffer,           void, (GLenum target, GLsizei numAttachments, const GLenum * attachments))
 
 // generate GL function pointer typedefs
 #define _SG_XMACRO(name, ret, args) typedef ret (GL_APIENTRY* PFN_ ## name) args;
 _SG_GL_FUNCS
+_SG_GL_OPT_FUNCS
 #undef _SG_XMACRO
 
 // generate GL function pointers
 #define _SG_XMACRO(name, ret, args) static PFN_ ## name name;
 _SG_GL_FUNCS
+_SG_GL_OPT_FUNCS
 #undef _SG_XMACRO
 
 // helper function to lookup GL functions in GL DLL
 typedef PROC (WINAPI * _sg_wglGetProcAddress)(LPCSTR);
-_SOKOL_PRIVATE void* _sg_gl_getprocaddr(const char* name, _sg_wglGetProcAddress wgl_getprocaddress) {
+_SOKOL_PRIVATE void* _sg_gl_getprocaddr_opt(const char* name, _sg_wglGetProcAddress wgl_getprocaddress) {
     void* proc_addr = (void*) wgl_getprocaddress(name);
     if (0 == proc_addr) {
         proc_addr = (void*) GetProcAddress(_sg.gl.opengl32_dll, name);
     }
+    return proc_addr;
+}
+
+_SOKOL_PRIVATE void* _sg_gl_getprocaddr(const char* name, _sg_wglGetProcAddress wgl_getprocaddress) {
+    void* proc_addr = _sg_gl_getprocaddr_opt(name, wgl_getprocaddress);
     SOKOL_ASSERT(proc_addr);
     return proc_addr;
 }
@@ -4793,6 +7135,9 @@ _SOKOL_PRIVATE  void _sg_gl_load_opengl(void) {
     #define _SG_XMACRO(name, ret, args) name = (PFN_ ## name) _sg_gl_getprocaddr(#name, wgl_getprocaddress);
     _SG_GL_FUNCS
     #undef _SG_XMACRO
+    #define _SG_XMACRO(name, ret, args) name = (PFN_ ## name) _sg_gl_getprocaddr_opt(#name, wgl_getprocaddress);
+    _SG_GL_OPT_FUNCS
+    #undef _SG_XMACRO
 }
 
 _SOKOL_PRIVATE void _sg_gl_unload_opengl(void) {
@@ -4807,6 +7152,8 @@ _SOKOL_PRIVATE GLenum _sg_gl_buffer_target(sg_buffer_type t) {
     switch (t) {
         case SG_BUFFERTYPE_VERTEXBUFFER:    return GL_ARRAY_BUFFER;
         case SG_BUFFERTYPE_INDEXBUFFER:     return GL_ELEMENT_ARRAY_BUFFER;
+        /* storage buffers are created and updated through the vertex buffer binding point */
+        case SG_BUFFERTYPE_STORAGEBUFFER:   return GL_ARRAY_BUFFER;
         default: SOKOL_UNREACHABLE; return 0;
     }
 }
@@ -4836,6 +7183,9 @@ _SOKOL_PRIVATE GLenum _sg_gl_shader_stage(sg_shader_stage stage) {
     switch (stage) {
         case SG_SHADERSTAGE_VS:     return GL_VERTEX_SHADER;
         case SG_SHADERSTAGE_FS:     return GL_FRAGMENT_SHADER;
+        #if defined(_SOKOL_GL_COMPUTE)
+        case SG_SHADERSTAGE_CS:     return GL_COMPUTE_SHADER;
+        #endif
         default: SOKOL_UNREACHABLE; return 0;
     }
 }
@@ -5501,6 +7851,71 @@ _SOKOL_PRIVATE void _sg_gl_init_pixelformats_etc2(void) {
     _sg_pixelformat_sf(&_sg.formats[SG_PIXELFORMAT_ETC2_RG11SN]);
 }
 
+#if defined(_SOKOL_GL_TIMER_QUERY)
+_SOKOL_PRIVATE bool _sg_gl_has_timer_query(void) {
+    #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+    return glGenQueries && glDeleteQueries && glQueryCounter && glGetQueryObjectiv && glGetQueryObjectui64v;
+    #else
+    return true;
+    #endif
+}
+#endif
+
+#if defined(_SOKOL_GL_PBO_UPLOAD)
+_SOKOL_PRIVATE bool _sg_gl_has_pbo_upload(void) {
+    #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+    return glMapBufferRange && glUnmapBuffer && glFenceSync && glClientWaitSync && glDeleteSync;
+    #else
+    return true;
+    #endif
+}
+#endif
+
+#if defined(_SOKOL_GL_BUFFER_STORAGE)
+_SOKOL_PRIVATE bool _sg_gl_has_buffer_storage(void) {
+    #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+    return glBufferStorage && glMapBufferRange && glFenceSync && glClientWaitSync && glDeleteSync;
+    #else
+    return true;
+    #endif
+}
+#endif
+
+#if defined(_SOKOL_GL_COMPUTE)
+_SOKOL_PRIVATE bool _sg_gl_has_compute(void) {
+    #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+    return glBindBufferBase && glDispatchCompute && glMemoryBarrier;
+    #else
+    return true;
+    #endif
+}
+#endif
+
+#if defined(_SOKOL_GL_INVALIDATE)
+_SOKOL_PRIVATE bool _sg_gl_has_invalidate(void) {
+    #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+    return 0 != glInvalidateFramebuffer;
+    #else
+    return true;
+    #endif
+}
+#endif
+
+#if defined(_SOKOL_GL_PROGRAM_BINARY)
+/* program binaries can only be used if the driver supports at least one binary format */
+_SOKOL_PRIVATE bool _sg_gl_has_program_binary(void) {
+    #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+    if (!(glGetProgramBinary && glProgramBinary && glProgramParameteri)) {
+        return false;
+    }
+    #endif
+    GLint num_formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+    _SG_GL_CHECK_ERROR();
+    return num_formats > 0;
+}
+#endif
+
 _SOKOL_PRIVATE void _sg_gl_init_limits(void) {
     _SG_GL_CHECK_ERROR();
     GLint gl_int;
@@ -5553,6 +7968,9 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_glcore33(void) {
     _sg.features.image_clamp_to_border = true;
     _sg.features.mrt_independent_blend_state = false;
     _sg.features.mrt_independent_write_mask = true;
+    _sg.features.base_vertex = true;
+    _sg.features.sampler_objects = true;
+    _sg.features.image_region_update = true;
 
     /* scan extensions */
     bool has_s3tc = false;  /* BC1..BC3 */
@@ -5560,6 +7978,11 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_glcore33(void) {
     bool has_bptc = false;  /* BC6H and BC7 */
     bool has_pvrtc = false;
     bool has_etc2 = false;
+    bool has_program_binary = false;
+    bool has_buffer_storage = false;
+    bool has_compute_shader = false;
+    bool has_ssbo = false;
+    bool has_invalidate = false;
     GLint num_ext = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &num_ext);
     for (int i = 0; i < num_ext; i++) {
@@ -5583,9 +8006,68 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_glcore33(void) {
             else if (strstr(ext, "_texture_filter_anisotropic")) {
                 _sg.gl.ext_anisotropic = true;
             }
+            else if (strstr(ext, "_get_program_binary")) {
+                has_program_binary = true;
+            }
+            else if (strstr(ext, "GL_ARB_buffer_storage")) {
+                has_buffer_storage = true;
+            }
+            else if (strstr(ext, "GL_ARB_compute_shader")) {
+                has_compute_shader = true;
+            }
+            else if (strstr(ext, "GL_ARB_shader_storage_buffer_object")) {
+                has_ssbo = true;
+            }
+            else if (strstr(ext, "GL_ARB_invalidate_subdata")) {
+                has_invalidate = true;
+            }
         }
     }
 
+    /* program binaries are core since GL 4.1 */
+    GLint major_version = 0, minor_version = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major_version);
+    glGetIntegerv(GL_MINOR_VERSION, &minor_version);
+    if ((major_version > 4) || ((major_version == 4) && (minor_version >= 1))) {
+        has_program_binary = true;
+    }
+    #if defined(_SOKOL_GL_PROGRAM_BINARY)
+    _sg.features.shader_cache = has_program_binary && _sg_gl_has_program_binary();
+    #else
+    _SOKOL_UNUSED(has_program_binary);
+    #endif
+
+    /* buffer storage is core since GL 4.4 */
+    if ((major_version > 4) || ((major_version == 4) && (minor_version >= 4))) {
+        has_buffer_storage = true;
+    }
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    _sg.features.persistent_buffers = has_buffer_storage && _sg_gl_has_buffer_storage();
+    #else
+    _SOKOL_UNUSED(has_buffer_storage);
+    #endif
+
+    /* compute shaders, storage buffers and framebuffer invalidation are core since GL 4.3 */
+    if ((major_version > 4) || ((major_version == 4) && (minor_version >= 3))) {
+        has_compute_shader = true;
+        has_ssbo = true;
+        has_invalidate = true;
+    }
+    #if defined(_SOKOL_GL_COMPUTE)
+    _sg.features.compute = has_compute_shader && has_ssbo && _sg_gl_has_compute();
+    #else
+    _SOKOL_UNUSED(has_compute_shader);
+    _SOKOL_UNUSED(has_ssbo);
+    #endif
+    #if defined(_SOKOL_GL_INVALIDATE)
+    _sg.gl.invalidate = has_invalidate && _sg_gl_has_invalidate();
+    #else
+    _SOKOL_UNUSED(has_invalidate);
+    #endif
+    #if defined(_SOKOL_GL_TIMER_QUERY)
+    _sg.features.gpu_timing = _sg_gl_has_timer_query();
+    #endif
+
     /* limits */
     _sg_gl_init_limits();
 
@@ -5630,6 +8112,8 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_gles3(void) {
     _sg.features.image_clamp_to_border = false;
     _sg.features.mrt_independent_blend_state = false;
     _sg.features.mrt_independent_write_mask = false;
+    _sg.features.sampler_objects = true;
+    _sg.features.image_region_update = true;
 
     bool has_s3tc = false;  /* BC1..BC3 */
     bool has_rgtc = false;  /* BC4 and BC5 */
@@ -5695,6 +8179,13 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_gles3(void) {
     has_colorbuffer_half_float = has_colorbuffer_float;
     #endif
 
+    #if defined(_SOKOL_GL_PROGRAM_BINARY)
+    _sg.features.shader_cache = _sg_gl_has_program_binary();
+    #endif
+    #if defined(_SOKOL_GL_INVALIDATE)
+    _sg.gl.invalidate = true;
+    #endif
+
     /* limits */
     _sg_gl_init_limits();
 
@@ -5767,6 +8258,7 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_gles2(void) {
     _sg.features.image_clamp_to_border = false;
     _sg.features.mrt_independent_blend_state = false;
     _sg.features.mrt_independent_write_mask = false;
+    _sg.features.image_region_update = true;
 
     /* limits */
     _sg_gl_init_limits();
@@ -5806,7 +8298,136 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_gles2(void) {
 #endif
 
 /*-- state cache implementation ----------------------------------------------*/
+#if !defined(SOKOL_GLES2)
+/* the index buffer binding is vertex array object state, bind the
+   context's default VAO before binding index buffers outside of
+   sg_apply_bindings() to not modify a cached VAO, the cached VAO
+   of the current bindings is rebound by _sg_gl_cache_rebind_draw_vao()
+*/
+_SOKOL_PRIVATE void _sg_gl_cache_unbind_vao(void) {
+    if (_sg.gl.cur_context && (_sg.gl.cache.vao != _sg.gl.cur_context->vao)) {
+        _sg.gl.cache.vao = _sg.gl.cur_context->vao;
+        glBindVertexArray(_sg.gl.cache.vao);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        _sg.gl.cache.index_buffer = 0;
+        _sg_filter_reset_bindings();
+    }
+}
+
+/* called before draws, restore the cached VAO of the current bindings if
+   it has been unbound since sg_apply_bindings() (e.g. by an index buffer update)
+*/
+_SOKOL_PRIVATE void _sg_gl_cache_rebind_draw_vao(void) {
+    if (_sg.gl.cache.draw_vao && (_sg.gl.cache.vao != _sg.gl.cache.draw_vao)) {
+        _sg.gl.cache.vao = _sg.gl.cache.draw_vao;
+        _sg.gl.cache.index_buffer = _sg.gl.cache.draw_vao_ib;
+        glBindVertexArray(_sg.gl.cache.vao);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_gl_vao_cache_init(_sg_gl_vao_cache_t* cache, int capacity) {
+    SOKOL_ASSERT(cache && (capacity > 0));
+    memset(cache, 0, sizeof(_sg_gl_vao_cache_t));
+    cache->capacity = capacity;
+    /* keep the load factor at or below 0.5 so that probe sequences stay short */
+    uint32_t num_slots = 1;
+    while (num_slots < (2 * (uint32_t)capacity)) {
+        num_slots <<= 1;
+    }
+    cache->mask = num_slots - 1;
+    const size_t size = (size_t)num_slots * sizeof(_sg_gl_vao_cache_item_t);
+    cache->items = (_sg_gl_vao_cache_item_t*) SOKOL_MALLOC(size);
+    SOKOL_ASSERT(cache->items);
+    memset(cache->items, 0, size);
+}
+
+_SOKOL_PRIVATE void _sg_gl_vao_cache_discard(_sg_gl_vao_cache_t* cache) {
+    SOKOL_ASSERT(cache);
+    if (cache->items) {
+        for (uint32_t i = 0; i <= cache->mask; i++) {
+            if (cache->items[i].vao) {
+                glDeleteVertexArrays(1, &cache->items[i].vao);
+            }
+        }
+        SOKOL_FREE(cache->items);
+    }
+    memset(cache, 0, sizeof(_sg_gl_vao_cache_t));
+}
+
+/* delete the VAO in a table slot, and move following items of the same
+   probe sequence back so that lookups don't need tombstones
+*/
+_SOKOL_PRIVATE void _sg_gl_vao_cache_remove(_sg_gl_vao_cache_t* cache, uint32_t index) {
+    SOKOL_ASSERT(cache && (index <= cache->mask) && cache->items[index].vao);
+    _sg_gl_vao_cache_item_t* items = cache->items;
+    if (items[index].vao == _sg.gl.cache.vao) {
+        _sg_gl_cache_unbind_vao();
+    }
+    if (items[index].vao == _sg.gl.cache.draw_vao) {
+        _sg.gl.cache.draw_vao = 0;
+        _sg.gl.cache.draw_vao_ib = 0;
+    }
+    glDeleteVertexArrays(1, &items[index].vao);
+    uint32_t hole = index;
+    uint32_t i = index;
+    while (true) {
+        i = (i + 1) & cache->mask;
+        if (0 == items[i].vao) {
+            break;
+        }
+        /* an item can't move in front of its home slot */
+        const uint32_t home = items[i].hash & cache->mask;
+        const bool stays = (hole <= i) ? ((hole < home) && (home <= i)) : ((hole < home) || (home <= i));
+        if (!stays) {
+            items[hole] = items[i];
+            hole = i;
+        }
+    }
+    memset(&items[hole], 0, sizeof(_sg_gl_vao_cache_item_t));
+    cache->num_items--;
+}
+
+/* FNV-1a over the 32-bit words of a zero-initialized cache key */
+_SOKOL_PRIVATE uint32_t _sg_gl_vao_key_hash(const _sg_gl_vao_key_t* key) {
+    SOKOL_ASSERT(key && ((sizeof(_sg_gl_vao_key_t) & 3) == 0));
+    const uint8_t* ptr = (const uint8_t*) key;
+    uint32_t hash = 0x811C9DC5;
+    for (size_t i = 0; i < sizeof(_sg_gl_vao_key_t); i += sizeof(uint32_t)) {
+        uint32_t word;
+        memcpy(&word, ptr + i, sizeof(word));
+        hash = (hash ^ word) * 0x01000193;
+    }
+    return hash;
+}
+
+/* called from _sg_gl_cache_invalidate_buffer(), delete all VAOs which reference a buffer */
+_SOKOL_PRIVATE void _sg_gl_vao_cache_invalidate_buffer(_sg_gl_vao_cache_t* cache, GLuint buf) {
+    SOKOL_ASSERT(cache);
+    uint32_t i = 0;
+    while ((cache->num_items > 0) && (i <= cache->mask)) {
+        const _sg_gl_vao_cache_item_t* item = &cache->items[i];
+        bool uses_buf = false;
+        if (item->vao) {
+            uses_buf = (item->key.ib == buf);
+            for (int attr_index = 0; !uses_buf && (attr_index < SG_MAX_VERTEX_ATTRIBUTES); attr_index++) {
+                uses_buf = (item->key.vbufs[attr_index] == buf);
+            }
+        }
+        if (uses_buf) {
+            /* another item may have been moved into this slot, check it again */
+            _sg_gl_vao_cache_remove(cache, i);
+        }
+        else {
+            i++;
+        }
+    }
+}
+#endif
+
 _SOKOL_PRIVATE void _sg_gl_cache_clear_buffer_bindings(bool force) {
+    #if !defined(SOKOL_GLES2)
+    _sg_gl_cache_unbind_vao();
+    #endif
     if (force || (_sg.gl.cache.vertex_buffer != 0)) {
         glBindBuffer(GL_ARRAY_BUFFER, 0);
         _sg.gl.cache.vertex_buffer = 0;
@@ -5826,6 +8447,9 @@ _SOKOL_PRIVATE void _sg_gl_cache_bind_buffer(GLenum target, GLuint buffer) {
         }
     }
     else {
+        #if !defined(SOKOL_GLES2)
+        _sg_gl_cache_unbind_vao();
+        #endif
         if (_sg.gl.cache.index_buffer != buffer) {
             _sg.gl.cache.index_buffer = buffer;
             glBindBuffer(target, buffer);
@@ -5833,7 +8457,32 @@ _SOKOL_PRIVATE void _sg_gl_cache_bind_buffer(GLenum target, GLuint buffer) {
     }
 }
 
-_SOKOL_PRIVATE void _sg_gl_cache_store_buffer_binding(GLenum target) {
+#if !defined(SOKOL_GLES2)
+_SOKOL_PRIVATE void _sg_gl_cache_bind_uniform_buffer(GLuint buffer) {
+    if (_sg.gl.cache.uniform_buffer != buffer) {
+        _sg.gl.cache.uniform_buffer = buffer;
+        glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    }
+}
+
+/* create the per-frame uniform buffer, called on demand so that applications
+   without uniform buffer objects don't pay for it
+*/
+_SOKOL_PRIVATE void _sg_gl_create_uniform_buffer(int size) {
+    SOKOL_ASSERT(size > 0);
+    _sg.gl.ub.size = size;
+    _sg.gl.ub.offset = 0;
+    _sg.gl.ub.orphan = false;
+    _sg.gl.ub.buf = 0;
+    glGenBuffers(1, &_sg.gl.ub.buf);
+    SOKOL_ASSERT(_sg.gl.ub.buf);
+    _sg_gl_cache_bind_uniform_buffer(_sg.gl.ub.buf);
+    glBufferData(GL_UNIFORM_BUFFER, size, 0, GL_STREAM_DRAW);
+    _SG_GL_CHECK_ERROR();
+}
+#endif
+
+_SOKOL_PRIVATE void _sg_gl_cache_store_buffer_binding(GLenum target) {
     if (target == GL_ARRAY_BUFFER) {
         _sg.gl.cache.stored_vertex_buffer = _sg.gl.cache.vertex_buffer;
     }
@@ -5861,6 +8510,11 @@ _SOKOL_PRIVATE void _sg_gl_cache_restore_buffer_binding(GLenum target) {
 
 /* called when from _sg_gl_destroy_buffer() */
 _SOKOL_PRIVATE void _sg_gl_cache_invalidate_buffer(GLuint buf) {
+    #if !defined(SOKOL_GLES2)
+    if (_sg.gl.cur_context) {
+        _sg_gl_vao_cache_invalidate_buffer(&_sg.gl.cur_context->vao_cache, buf);
+    }
+    #endif
     if (buf == _sg.gl.cache.vertex_buffer) {
         _sg.gl.cache.vertex_buffer = 0;
         glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -5880,6 +8534,14 @@ _SOKOL_PRIVATE void _sg_gl_cache_invalidate_buffer(GLuint buf) {
             _sg.gl.cache.attrs[i].gl_vbuf = 0;
         }
     }
+    #if defined(_SOKOL_GL_COMPUTE)
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_STORAGE_BUFFERS; i++) {
+        if (buf == _sg.gl.cache.storage_buffers[i]) {
+            _sg.gl.cache.storage_buffers[i] = 0;
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, (GLuint)i, 0);
+        }
+    }
+    #endif
 }
 
 _SOKOL_PRIVATE void _sg_gl_cache_active_texture(GLenum texture) {
@@ -5906,6 +8568,12 @@ _SOKOL_PRIVATE void _sg_gl_cache_clear_texture_bindings(bool force) {
             _sg.gl.cache.textures[i].texture = 0;
             _sg.gl.cache.cur_active_texture = gl_texture_slot;
         }
+        #if !defined(SOKOL_GLES2)
+        if (!_sg.gl.gles2 && (force || (_sg.gl.cache.samplers[i] != 0))) {
+            glBindSampler((GLuint)i, 0);
+            _sg.gl.cache.samplers[i] = 0;
+        }
+        #endif
     }
 }
 
@@ -5968,6 +8636,30 @@ _SOKOL_PRIVATE void _sg_gl_cache_invalidate_texture(GLuint tex) {
     }
 }
 
+#if !defined(SOKOL_GLES2)
+_SOKOL_PRIVATE void _sg_gl_cache_bind_sampler(int slot_index, GLuint smp) {
+    /* smp=0 unbinds the sampler object, so that the texture's own sampler state is used */
+    SOKOL_ASSERT(slot_index < SG_MAX_SHADERSTAGE_IMAGES);
+    if (slot_index >= _sg.gl.max_combined_texture_image_units) {
+        return;
+    }
+    if (_sg.gl.cache.samplers[slot_index] != smp) {
+        _sg.gl.cache.samplers[slot_index] = smp;
+        glBindSampler((GLuint)slot_index, smp);
+    }
+}
+
+/* called from _sg_gl_destroy_sampler() */
+_SOKOL_PRIVATE void _sg_gl_cache_invalidate_sampler(GLuint smp) {
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+        if (smp == _sg.gl.cache.samplers[i]) {
+            glBindSampler((GLuint)i, 0);
+            _sg.gl.cache.samplers[i] = 0;
+        }
+    }
+}
+#endif
+
 /* called from _sg_gl_destroy_shader() */
 _SOKOL_PRIVATE void _sg_gl_cache_invalidate_program(GLuint prog) {
     if (prog == _sg.gl.cache.prog) {
@@ -5986,6 +8678,9 @@ _SOKOL_PRIVATE void _sg_gl_reset_state_cache(void) {
         }
         #endif
         memset(&_sg.gl.cache, 0, sizeof(_sg.gl.cache));
+        #if !defined(SOKOL_GLES2)
+        _sg.gl.cache.vao = _sg.gl.cur_context->vao;
+        #endif
         _sg_gl_cache_clear_buffer_bindings(true);
         _SG_GL_CHECK_ERROR();
         _sg_gl_cache_clear_texture_bindings(true);
@@ -6063,7 +8758,6 @@ _SOKOL_PRIVATE void _sg_gl_setup_backend(const sg_desc* desc) {
     #if defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
     _sg.gl.gles2 = desc->context.gl.force_gles2;
     #else
-    _SOKOL_UNUSED(desc);
     _sg.gl.gles2 = false;
     #endif
 
@@ -6087,10 +8781,118 @@ _SOKOL_PRIVATE void _sg_gl_setup_backend(const sg_desc* desc) {
     #else
         _sg_gl_init_caps_gles2();
     #endif
+
+    /* per-frame uniform buffer for uniform blocks backed by uniform buffer objects */
+    #if !defined(SOKOL_GLES2)
+    if (!_sg.gl.gles2) {
+        SOKOL_ASSERT(desc->uniform_buffer_size > 0);
+        _sg.gl.ub.size = desc->uniform_buffer_size;
+        _sg.gl.ub.offset = 0;
+        _sg.gl.ub.orphan = false;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &_sg.gl.ub.align);
+        if (_sg.gl.ub.align <= 0) {
+            _sg.gl.ub.align = 256;
+        }
+        _SG_GL_CHECK_ERROR();
+    }
+    #else
+    _SOKOL_UNUSED(desc);
+    #endif
+
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    _sg.gl.persistent_buffers = desc->enable_persistent_buffers && _sg.features.persistent_buffers;
+    #endif
+
+    /* timestamp queries for GPU timing */
+    #if defined(_SOKOL_GL_TIMER_QUERY)
+    if (desc->enable_gpu_timing && _sg.features.gpu_timing) {
+        glGenQueries(_SG_GPU_TIMING_FRAMES * SG_MAX_GPU_TIMINGS * 2, &_sg.gl.timer_queries[0][0]);
+        _SG_GL_CHECK_ERROR();
+    }
+    #endif
+
+    /* images are read back through pixel buffer objects, or synchronously on GLES2 */
+    _sg.features.image_readback = true;
+    #if defined(_SOKOL_GL_PBO_UPLOAD)
+    _sg.gl.pbo_readback = !_sg.gl.gles2 && _sg_gl_has_pbo_upload();
+    #endif
+
+    /* pixel buffer objects for asynchronous image uploads */
+    #if defined(_SOKOL_GL_PBO_UPLOAD)
+    if (!_sg.gl.gles2 && (desc->image_upload_buffers > 0) && _sg_gl_has_pbo_upload()) {
+        _sg_gl_upload_pool_t* pool = &_sg.gl.upload;
+        pool->num = desc->image_upload_buffers;
+        const size_t size = (size_t)pool->num * sizeof(_sg_gl_upload_buffer_t);
+        pool->bufs = (_sg_gl_upload_buffer_t*) SOKOL_MALLOC(size);
+        SOKOL_ASSERT(pool->bufs);
+        memset(pool->bufs, 0, size);
+        for (int i = 0; i < pool->num; i++) {
+            glGenBuffers(1, &pool->bufs[i].buf);
+            SOKOL_ASSERT(pool->bufs[i].buf);
+        }
+        _SG_GL_CHECK_ERROR();
+    }
+    #endif
 }
 
 _SOKOL_PRIVATE void _sg_gl_discard_backend(void) {
     SOKOL_ASSERT(_sg.gl.valid);
+    _sg_gl_names_t* names[4] = { &_sg.gl.gen_buffers, &_sg.gl.gen_textures, &_sg.gl.del_buffers, &_sg.gl.del_textures };
+    for (int i = 0; i < 4; i++) {
+        if (names[i]->names) {
+            SOKOL_FREE(names[i]->names);
+        }
+        memset(names[i], 0, sizeof(_sg_gl_names_t));
+    }
+    #if defined(_SOKOL_GL_TIMER_QUERY)
+    if (_sg.gl.timer_queries[0][0]) {
+        glDeleteQueries(_SG_GPU_TIMING_FRAMES * SG_MAX_GPU_TIMINGS * 2, &_sg.gl.timer_queries[0][0]);
+    }
+    #endif
+    #if defined(_SOKOL_GL_PBO_UPLOAD)
+    if (_sg.gl.upload.bufs) {
+        for (int i = 0; i < _sg.gl.upload.num; i++) {
+            if (_sg.gl.upload.bufs[i].fence) {
+                glDeleteSync(_sg.gl.upload.bufs[i].fence);
+            }
+            glDeleteBuffers(1, &_sg.gl.upload.bufs[i].buf);
+        }
+        SOKOL_FREE(_sg.gl.upload.bufs);
+        memset(&_sg.gl.upload, 0, sizeof(_sg.gl.upload));
+    }
+    for (int i = 0; i < _SG_MAX_IMAGE_READBACKS; i++) {
+        _sg_gl_readback_buffer_t* rbuf = &_sg.gl.readback_bufs[i];
+        if (rbuf->fence) {
+            glDeleteSync(rbuf->fence);
+        }
+        if (rbuf->buf) {
+            glDeleteBuffers(1, &rbuf->buf);
+        }
+    }
+    memset(_sg.gl.readback_bufs, 0, sizeof(_sg.gl.readback_bufs));
+    #endif
+    if (_sg.gl.readback_fb) {
+        glDeleteFramebuffers(1, &_sg.gl.readback_fb);
+        _sg.gl.readback_fb = 0;
+    }
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    for (int i = 0; i < SG_NUM_INFLIGHT_FRAMES; i++) {
+        if (_sg.gl.frame_fences[i]) {
+            glDeleteSync(_sg.gl.frame_fences[i]);
+            _sg.gl.frame_fences[i] = 0;
+        }
+    }
+    #endif
+    #if !defined(SOKOL_GLES2)
+    if (_sg.gl.ub.buf) {
+        glDeleteBuffers(1, &_sg.gl.ub.buf);
+        _sg.gl.ub.buf = 0;
+    }
+    if (_sg.gl.ub.num_retired > 0) {
+        glDeleteBuffers(_sg.gl.ub.num_retired, _sg.gl.ub.retired);
+        _sg.gl.ub.num_retired = 0;
+    }
+    #endif
     _sg.gl.valid = false;
     #if defined(_SOKOL_USE_WIN32_GL_LOADER)
     _sg_gl_unload_opengl();
@@ -6117,6 +8919,9 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_context(_sg_context_t* ctx) {
         glGenVertexArrays(1, &ctx->vao);
         glBindVertexArray(ctx->vao);
         _SG_GL_CHECK_ERROR();
+        if (_sg.desc.vao_cache_size > 0) {
+            _sg_gl_vao_cache_init(&ctx->vao_cache, _sg.desc.vao_cache_size);
+        }
     }
     #endif
     return SG_RESOURCESTATE_VALID;
@@ -6126,6 +8931,10 @@ _SOKOL_PRIVATE void _sg_gl_destroy_context(_sg_context_t* ctx) {
     SOKOL_ASSERT(ctx);
     #if !defined(SOKOL_GLES2)
     if (!_sg.gl.gles2) {
+        if (ctx == _sg.gl.cur_context) {
+            _sg_gl_cache_unbind_vao();
+        }
+        _sg_gl_vao_cache_discard(&ctx->vao_cache);
         if (ctx->vao) {
             glDeleteVertexArrays(1, &ctx->vao);
         }
@@ -6136,6 +8945,215 @@ _SOKOL_PRIVATE void _sg_gl_destroy_context(_sg_context_t* ctx) {
     #endif
 }
 
+/*-- batched GL object name generation and deletion --------------------------*/
+_SOKOL_PRIVATE void _sg_gl_alloc_names(_sg_gl_names_t* names, int cap) {
+    SOKOL_ASSERT(names && (0 == names->cap) && (cap >= 0));
+    if (cap > names->size) {
+        if (names->names) {
+            SOKOL_FREE(names->names);
+        }
+        names->names = (GLuint*) SOKOL_MALLOC(sizeof(GLuint) * (size_t)cap);
+        SOKOL_ASSERT(names->names);
+        names->size = cap;
+    }
+    names->num = 0;
+    names->cap = cap;
+}
+
+/* ends the current batch, but keeps the names array for the next one */
+_SOKOL_PRIVATE void _sg_gl_free_names(_sg_gl_names_t* names) {
+    SOKOL_ASSERT(names);
+    names->num = 0;
+    names->cap = 0;
+}
+
+_SOKOL_PRIVATE GLuint _sg_gl_gen_buffer(void) {
+    GLuint gl_buf = 0;
+    if (_sg.gl.gen_buffers.num > 0) {
+        gl_buf = _sg.gl.gen_buffers.names[--_sg.gl.gen_buffers.num];
+    }
+    else {
+        glGenBuffers(1, &gl_buf);
+    }
+    return gl_buf;
+}
+
+_SOKOL_PRIVATE GLuint _sg_gl_gen_texture(void) {
+    GLuint gl_tex = 0;
+    if (_sg.gl.gen_textures.num > 0) {
+        gl_tex = _sg.gl.gen_textures.names[--_sg.gl.gen_textures.num];
+    }
+    else {
+        glGenTextures(1, &gl_tex);
+    }
+    return gl_tex;
+}
+
+_SOKOL_PRIVATE void _sg_gl_delete_buffer(GLuint gl_buf) {
+    if (_sg.gl.del_buffers.num < _sg.gl.del_buffers.cap) {
+        _sg.gl.del_buffers.names[_sg.gl.del_buffers.num++] = gl_buf;
+    }
+    else {
+        glDeleteBuffers(1, &gl_buf);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_gl_delete_texture(GLuint gl_tex) {
+    if (_sg.gl.del_textures.num < _sg.gl.del_textures.cap) {
+        _sg.gl.del_textures.names[_sg.gl.del_textures.num++] = gl_tex;
+    }
+    else {
+        glDeleteTextures(1, &gl_tex);
+    }
+}
+
+/* generate the GL buffer names for a batch of buffers with a single glGenBuffers() call */
+_SOKOL_PRIVATE void _sg_gl_begin_make_buffers(const sg_buffer_desc* descs, int count) {
+    int num_names = 0;
+    for (int i = 0; i < count; i++) {
+        if (0 == descs[i].gl_buffers[0]) {
+            num_names += (_sg_def(descs[i].usage, SG_USAGE_IMMUTABLE) == SG_USAGE_IMMUTABLE) ? 1 : SG_NUM_INFLIGHT_FRAMES;
+        }
+    }
+    _sg_gl_alloc_names(&_sg.gl.gen_buffers, num_names);
+    if (num_names > 0) {
+        glGenBuffers(num_names, _sg.gl.gen_buffers.names);
+        _sg.gl.gen_buffers.num = num_names;
+    }
+}
+
+/* delete any names which haven't been used (e.g. because of failed validation) */
+_SOKOL_PRIVATE void _sg_gl_end_make_buffers(void) {
+    if (_sg.gl.gen_buffers.num > 0) {
+        glDeleteBuffers(_sg.gl.gen_buffers.num, _sg.gl.gen_buffers.names);
+    }
+    _sg_gl_free_names(&_sg.gl.gen_buffers);
+}
+
+_SOKOL_PRIVATE void _sg_gl_begin_make_images(const sg_image_desc* descs, int count) {
+    int num_names = 0;
+    for (int i = 0; i < count; i++) {
+        if ((0 == descs[i].gl_textures[0]) && !_sg_is_valid_rendertarget_depth_format(descs[i].pixel_format)) {
+            num_names += (_sg_def(descs[i].usage, SG_USAGE_IMMUTABLE) == SG_USAGE_IMMUTABLE) ? 1 : SG_NUM_INFLIGHT_FRAMES;
+        }
+    }
+    _sg_gl_alloc_names(&_sg.gl.gen_textures, num_names);
+    if (num_names > 0) {
+        glGenTextures(num_names, _sg.gl.gen_textures.names);
+        _sg.gl.gen_textures.num = num_names;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_gl_end_make_images(void) {
+    if (_sg.gl.gen_textures.num > 0) {
+        glDeleteTextures(_sg.gl.gen_textures.num, _sg.gl.gen_textures.names);
+    }
+    _sg_gl_free_names(&_sg.gl.gen_textures);
+}
+
+/* collect the GL buffer names of a batch of destroyed buffers for a single glDeleteBuffers() call */
+_SOKOL_PRIVATE void _sg_gl_begin_destroy_buffers(int count) {
+    _sg_gl_alloc_names(&_sg.gl.del_buffers, count * SG_NUM_INFLIGHT_FRAMES);
+}
+
+_SOKOL_PRIVATE void _sg_gl_end_destroy_buffers(void) {
+    if (_sg.gl.del_buffers.num > 0) {
+        glDeleteBuffers(_sg.gl.del_buffers.num, _sg.gl.del_buffers.names);
+    }
+    _sg_gl_free_names(&_sg.gl.del_buffers);
+}
+
+_SOKOL_PRIVATE void _sg_gl_begin_destroy_images(int count) {
+    _sg_gl_alloc_names(&_sg.gl.del_textures, count * SG_NUM_INFLIGHT_FRAMES);
+}
+
+_SOKOL_PRIVATE void _sg_gl_end_destroy_images(void) {
+    if (_sg.gl.del_textures.num > 0) {
+        glDeleteTextures(_sg.gl.del_textures.num, _sg.gl.del_textures.names);
+    }
+    _sg_gl_free_names(&_sg.gl.del_textures);
+}
+
+#if defined(_SOKOL_GL_BUFFER_STORAGE)
+/* wait until the GPU has finished the frame which last used a slot of a persistently mapped buffer */
+_SOKOL_PRIVATE void _sg_gl_wait_buffer_slot(const _sg_buffer_t* buf, int slot) {
+    SOKOL_ASSERT(buf && buf->gl.mapped && (slot < SG_NUM_INFLIGHT_FRAMES));
+    const uint32_t used_frame_index = buf->gl.slot_frame_index[slot];
+    /* frame indices start at 1, a slot frame index of 0 means the slot was never used */
+    if ((0 == used_frame_index) || (used_frame_index < _sg.gl.completed_frame_index) || (used_frame_index >= _sg.frame_index)) {
+        /* never used, already completed, or only used in the current frame (appending to a slot) */
+        return;
+    }
+    /* fences of frames older than SG_NUM_INFLIGHT_FRAMES have been deleted, but
+       GL commands complete in order, so waiting on a more recent frame is fine
+    */
+    uint32_t wait_frame_index = used_frame_index;
+    if ((wait_frame_index + SG_NUM_INFLIGHT_FRAMES) < _sg.frame_index) {
+        wait_frame_index = _sg.frame_index - SG_NUM_INFLIGHT_FRAMES;
+    }
+    GLsync fence = _sg.gl.frame_fences[wait_frame_index % SG_NUM_INFLIGHT_FRAMES];
+    if (fence) {
+        GLenum res;
+        do {
+            res = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        } while (res == GL_TIMEOUT_EXPIRED);
+        _SG_GL_CHECK_ERROR();
+    }
+    _sg.gl.completed_frame_index = wait_frame_index + 1;
+}
+
+/* called from _sg_gl_commit(), insert a fence for the current frame */
+_SOKOL_PRIVATE void _sg_gl_insert_frame_fence(void) {
+    const uint32_t fence_index = _sg.frame_index % SG_NUM_INFLIGHT_FRAMES;
+    if (_sg.gl.frame_fences[fence_index]) {
+        glDeleteSync(_sg.gl.frame_fences[fence_index]);
+    }
+    _sg.gl.frame_fences[fence_index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _SG_GL_CHECK_ERROR();
+}
+
+/* one persistently mapped GL buffer for all slots, returns false if mapping failed */
+_SOKOL_PRIVATE bool _sg_gl_create_persistent_buffer(_sg_buffer_t* buf, GLenum gl_target) {
+    SOKOL_ASSERT(buf && (buf->cmn.usage != SG_USAGE_IMMUTABLE));
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    buf->gl.slot_size = _sg_roundup(buf->cmn.size, 256);
+    const GLsizeiptr size = (GLsizeiptr)buf->gl.slot_size * buf->cmn.num_slots;
+    GLuint gl_buf = _sg_gl_gen_buffer();
+    _sg_gl_cache_store_buffer_binding(gl_target);
+    _sg_gl_cache_bind_buffer(gl_target, gl_buf);
+    glBufferStorage(gl_target, size, 0, flags);
+    buf->gl.mapped = (uint8_t*) glMapBufferRange(gl_target, 0, size, flags);
+    _sg_gl_cache_restore_buffer_binding(gl_target);
+    _SG_GL_CHECK_ERROR();
+    if (0 == buf->gl.mapped) {
+        SOKOL_LOG("_sg_gl_create_buffer: failed to map buffer storage, falling back to regular buffers");
+        _sg_gl_cache_invalidate_buffer(gl_buf);
+        _sg_gl_delete_buffer(gl_buf);
+        buf->gl.slot_size = 0;
+        return false;
+    }
+    for (int slot = 0; slot < buf->cmn.num_slots; slot++) {
+        buf->gl.buf[slot] = gl_buf;
+    }
+    return true;
+}
+#endif
+
+/* byte offset of the active slot in a persistently mapped buffer (0 for regular
+   buffers), also records the frame index at which the slot is used by the GPU
+*/
+_SOKOL_PRIVATE int _sg_gl_buffer_slot_offset(_sg_buffer_t* buf) {
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    if (buf->gl.mapped) {
+        buf->gl.slot_frame_index[buf->cmn.active_slot] = _sg.frame_index;
+        return buf->cmn.active_slot * buf->gl.slot_size;
+    }
+    #else
+    _SOKOL_UNUSED(buf);
+    #endif
+    return 0;
+}
+
 _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const sg_buffer_desc* desc) {
     SOKOL_ASSERT(buf && desc);
     _SG_GL_CHECK_ERROR();
@@ -6143,6 +9161,14 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const s
     buf->gl.ext_buffers = (0 != desc->gl_buffers[0]);
     GLenum gl_target = _sg_gl_buffer_target(buf->cmn.type);
     GLenum gl_usage  = _sg_gl_usage(buf->cmn.usage);
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    /* storage buffers are written by the GPU and never persistently mapped */
+    if (_sg.gl.persistent_buffers && !buf->gl.ext_buffers && (buf->cmn.usage != SG_USAGE_IMMUTABLE) && (buf->cmn.type != SG_BUFFERTYPE_STORAGEBUFFER)) {
+        if (_sg_gl_create_persistent_buffer(buf, gl_target)) {
+            return SG_RESOURCESTATE_VALID;
+        }
+    }
+    #endif
     for (int slot = 0; slot < buf->cmn.num_slots; slot++) {
         GLuint gl_buf = 0;
         if (buf->gl.ext_buffers) {
@@ -6150,7 +9176,7 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const s
             gl_buf = desc->gl_buffers[slot];
         }
         else {
-            glGenBuffers(1, &gl_buf);
+            gl_buf = _sg_gl_gen_buffer();
             _sg_gl_cache_store_buffer_binding(gl_target);
             _sg_gl_cache_bind_buffer(gl_target, gl_buf);
             glBufferData(gl_target, buf->cmn.size, 0, gl_usage);
@@ -6169,11 +9195,15 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const s
 _SOKOL_PRIVATE void _sg_gl_destroy_buffer(_sg_buffer_t* buf) {
     SOKOL_ASSERT(buf);
     _SG_GL_CHECK_ERROR();
-    for (int slot = 0; slot < buf->cmn.num_slots; slot++) {
+    /* all slots of a persistently mapped buffer share the same GL buffer, which is
+       implicitly unmapped when deleted
+    */
+    const int num_slots = buf->gl.mapped ? 1 : buf->cmn.num_slots;
+    for (int slot = 0; slot < num_slots; slot++) {
         if (buf->gl.buf[slot]) {
             _sg_gl_cache_invalidate_buffer(buf->gl.buf[slot]);
             if (!buf->gl.ext_buffers) {
-                glDeleteBuffers(1, &buf->gl.buf[slot]);
+                _sg_gl_delete_buffer(buf->gl.buf[slot]);
             }
         }
     }
@@ -6186,65 +9216,289 @@ _SOKOL_PRIVATE bool _sg_gl_supported_texture_format(sg_pixel_format fmt) {
     return _sg.formats[fmt_index].sample;
 }
 
-_SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_image_desc* desc) {
-    SOKOL_ASSERT(img && desc);
-    _SG_GL_CHECK_ERROR();
-    _sg_image_common_init(&img->cmn, desc);
-    img->gl.ext_textures = (0 != desc->gl_textures[0]);
+#if defined(_SOKOL_GL_PBO_UPLOAD)
+/* returns true if a GL sync object has been signalled, waits up to timeout nanoseconds */
+_SOKOL_PRIVATE bool _sg_gl_sync_signalled(GLsync sync, GLuint64 timeout) {
+    const GLenum res = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+    return (res == GL_ALREADY_SIGNALED) || (res == GL_CONDITION_SATISFIED);
+}
 
-    /* check if texture format is support */
-    if (!_sg_gl_supported_texture_format(img->cmn.pixel_format)) {
-        SOKOL_LOG("texture format not supported by GL context\n");
-        return SG_RESOURCESTATE_FAILED;
+/* copy all subimages into the next pixel buffer object and leave it bound
+   to GL_PIXEL_UNPACK_BUFFER, the GL texture functions must then be called
+   with the returned buffer offsets instead of data pointers, returns
+   false if the data must be uploaded directly from client memory
+*/
+_SOKOL_PRIVATE bool _sg_gl_begin_upload(const _sg_image_t* img, const sg_image_data* data, GLintptr offsets[SG_CUBEFACE_NUM][SG_MAX_MIPMAPS]) {
+    SOKOL_ASSERT(img && data);
+    _sg_gl_upload_pool_t* pool = &_sg.gl.upload;
+    if (0 == pool->bufs) {
+        return false;
     }
-    /* check for optional texture types */
-    if ((img->cmn.type == SG_IMAGETYPE_3D) && !_sg.features.imagetype_3d) {
-        SOKOL_LOG("3D textures not supported by GL context\n");
-        return SG_RESOURCESTATE_FAILED;
+    const int num_faces = (img->cmn.type == SG_IMAGETYPE_CUBE) ? 6 : 1;
+    const int num_mips = img->cmn.num_mipmaps;
+    int size = 0;
+    for (int face_index = 0; face_index < num_faces; face_index++) {
+        for (int mip_index = 0; mip_index < num_mips; mip_index++) {
+            const sg_range* sub = &data->subimage[face_index][mip_index];
+            if ((0 == sub->ptr) || (0 == sub->size)) {
+                return false;
+            }
+            offsets[face_index][mip_index] = size;
+            size += _sg_roundup((int)sub->size, 16);
+        }
     }
-    if ((img->cmn.type == SG_IMAGETYPE_ARRAY) && !_sg.features.imagetype_array) {
-        SOKOL_LOG("array textures not supported by GL context\n");
-        return SG_RESOURCESTATE_FAILED;
+
+    /* wait until the next buffer in the ring is no longer used by the GPU */
+    pool->cur = (pool->cur + 1) % pool->num;
+    _sg_gl_upload_buffer_t* ubuf = &pool->bufs[pool->cur];
+    if (ubuf->fence) {
+        while (!_sg_gl_sync_signalled(ubuf->fence, 1000000000)) { }
+        glDeleteSync(ubuf->fence);
+        ubuf->fence = 0;
     }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, ubuf->buf);
+    if (ubuf->size < size) {
+        ubuf->size = size;
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, 0, GL_STREAM_DRAW);
+    }
+    uint8_t* dst = (uint8_t*) glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (0 == dst) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return false;
+    }
+    for (int face_index = 0; face_index < num_faces; face_index++) {
+        for (int mip_index = 0; mip_index < num_mips; mip_index++) {
+            const sg_range* sub = &data->subimage[face_index][mip_index];
+            memcpy(dst + offsets[face_index][mip_index], sub->ptr, sub->size);
+        }
+    }
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    _SG_GL_CHECK_ERROR();
+    return true;
+}
 
-    #if !defined(SOKOL_GLES2)
-    bool msaa = false;
-    if (!_sg.gl.gles2) {
-        msaa = (img->cmn.sample_count > 1) && (_sg.features.msaa_render_targets);
+/* unbind the pixel buffer object and insert fences for the buffer and the image */
+_SOKOL_PRIVATE void _sg_gl_end_upload(_sg_image_t* img) {
+    SOKOL_ASSERT(img);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    _sg_gl_upload_buffer_t* ubuf = &_sg.gl.upload.bufs[_sg.gl.upload.cur];
+    SOKOL_ASSERT(0 == ubuf->fence);
+    ubuf->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (img->gl.upload_fence) {
+        glDeleteSync(img->gl.upload_fence);
+    }
+    img->gl.upload_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _SG_GL_CHECK_ERROR();
+}
+#endif
+
+_SOKOL_PRIVATE bool _sg_gl_image_upload_done(_sg_image_t* img) {
+    SOKOL_ASSERT(img);
+    #if defined(_SOKOL_GL_PBO_UPLOAD)
+    if (img->gl.upload_fence) {
+        if (!_sg_gl_sync_signalled(img->gl.upload_fence, 0)) {
+            return false;
+        }
+        glDeleteSync(img->gl.upload_fence);
+        img->gl.upload_fence = 0;
     }
+    #else
+    _SOKOL_UNUSED(img);
     #endif
+    return true;
+}
 
-    if (_sg_is_valid_rendertarget_depth_format(img->cmn.pixel_format)) {
-        /* special case depth-stencil-buffer? */
-        SOKOL_ASSERT((img->cmn.usage == SG_USAGE_IMMUTABLE) && (img->cmn.num_slots == 1));
-        SOKOL_ASSERT(!img->gl.ext_textures);   /* cannot provide external texture for depth images */
-        glGenRenderbuffers(1, &img->gl.depth_render_buffer);
-        glBindRenderbuffer(GL_RENDERBUFFER, img->gl.depth_render_buffer);
-        GLenum gl_depth_format = _sg_gl_depth_attachment_format(img->cmn.pixel_format);
-        #if !defined(SOKOL_GLES2)
-        if (!_sg.gl.gles2 && msaa) {
-            glRenderbufferStorageMultisample(GL_RENDERBUFFER, img->cmn.sample_count, gl_depth_format, img->cmn.width, img->cmn.height);
+/* attach an image to the readback framebuffer and start reading the pixel
+   data either into a pixel buffer object, or synchronously into client memory
+*/
+_SOKOL_PRIVATE bool _sg_gl_read_image(int index, const _sg_image_t* img, _sg_readback_t* rb) {
+    SOKOL_ASSERT(img && rb);
+    SOKOL_ASSERT((index >= 0) && (index < _SG_MAX_IMAGE_READBACKS));
+    _SOKOL_UNUSED(index);
+    _SG_GL_CHECK_ERROR();
+    const sg_image_region* region = &rb->readback.region;
+
+    /* store current framebuffer binding (restored at end of function) */
+    GLuint gl_orig_fb;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, (GLint*)&gl_orig_fb);
+    if (0 == _sg.gl.readback_fb) {
+        glGenFramebuffers(1, &_sg.gl.readback_fb);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, _sg.gl.readback_fb);
+    const GLuint gl_tex = img->gl.tex[img->cmn.active_slot];
+    SOKOL_ASSERT(gl_tex);
+    switch (img->cmn.type) {
+        case SG_IMAGETYPE_2D:
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gl_tex, region->mip_level);
+            break;
+        case SG_IMAGETYPE_CUBE:
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, _sg_gl_cubeface_target(region->slice), gl_tex, region->mip_level);
+            break;
+        default:
+            /* 3D- or array-texture */
+            #if !defined(SOKOL_GLES2)
+            if (!_sg.gl.gles2) {
+                glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, gl_tex, region->mip_level, region->slice);
+            }
+            #endif
+            break;
+    }
+    bool result = false;
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE) {
+        const GLenum gl_format = _sg_gl_teximage_format(img->cmn.pixel_format);
+        const GLenum gl_type = _sg_gl_teximage_type(img->cmn.pixel_format);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        #if defined(_SOKOL_GL_PBO_UPLOAD)
+        if (_sg.gl.pbo_readback) {
+            _sg_gl_readback_buffer_t* rbuf = &_sg.gl.readback_bufs[index];
+            SOKOL_ASSERT(0 == rbuf->fence);
+            if (0 == rbuf->buf) {
+                glGenBuffers(1, &rbuf->buf);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, rbuf->buf);
+            if (rbuf->size < rb->num_bytes) {
+                rbuf->size = rb->num_bytes;
+                glBufferData(GL_PIXEL_PACK_BUFFER, rbuf->size, 0, GL_STREAM_READ);
+            }
+            glReadPixels(region->x, region->y, region->width, region->height, gl_format, gl_type, 0);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            rbuf->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            result = true;
         }
-        else
         #endif
-        {
-            glRenderbufferStorage(GL_RENDERBUFFER, gl_depth_format, img->cmn.width, img->cmn.height);
+        if (!result) {
+            rb->data = SOKOL_MALLOC((size_t)rb->num_bytes);
+            SOKOL_ASSERT(rb->data);
+            glReadPixels(region->x, region->y, region->width, region->height, gl_format, gl_type, rb->data);
+            result = true;
         }
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
     }
     else {
-        /* regular color texture */
-        img->gl.target = _sg_gl_texture_target(img->cmn.type);
-        const GLenum gl_internal_format = _sg_gl_teximage_internal_format(img->cmn.pixel_format);
+        SOKOL_LOG("sg_read_image_async: framebuffer completeness check failed!");
+    }
 
-        /* if this is a MSAA render target, need to create a separate render buffer */
-        #if !defined(SOKOL_GLES2)
-        if (!_sg.gl.gles2 && img->cmn.render_target && msaa) {
-            glGenRenderbuffers(1, &img->gl.msaa_render_buffer);
+    /* detach the image, so that the framebuffer doesn't keep destroyed textures alive */
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, gl_orig_fb);
+    _SG_GL_CHECK_ERROR();
+    return result;
+}
+
+_SOKOL_PRIVATE bool _sg_gl_readback_ready(int index, const _sg_readback_t* rb) {
+    SOKOL_ASSERT(rb);
+    if (rb->data) {
+        return true;
+    }
+    #if defined(_SOKOL_GL_PBO_UPLOAD)
+    _sg_gl_readback_buffer_t* rbuf = &_sg.gl.readback_bufs[index];
+    SOKOL_ASSERT(rbuf->fence);
+    if (!_sg_gl_sync_signalled(rbuf->fence, 0)) {
+        return false;
+    }
+    glDeleteSync(rbuf->fence);
+    rbuf->fence = 0;
+    #else
+    _SOKOL_UNUSED(index);
+    #endif
+    return true;
+}
+
+_SOKOL_PRIVATE const void* _sg_gl_map_readback(int index, const _sg_readback_t* rb) {
+    SOKOL_ASSERT(rb);
+    if (rb->data) {
+        return rb->data;
+    }
+    #if defined(_SOKOL_GL_PBO_UPLOAD)
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, _sg.gl.readback_bufs[index].buf);
+    const void* ptr = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, rb->num_bytes, GL_MAP_READ_BIT);
+    if (0 == ptr) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+    _SG_GL_CHECK_ERROR();
+    return ptr;
+    #else
+    _SOKOL_UNUSED(index);
+    return 0;
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_gl_unmap_readback(int index, const _sg_readback_t* rb) {
+    SOKOL_ASSERT(rb);
+    _SOKOL_UNUSED(index);
+    if (rb->data) {
+        return;
+    }
+    #if defined(_SOKOL_GL_PBO_UPLOAD)
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    _SG_GL_CHECK_ERROR();
+    #endif
+}
+
+_SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_image_desc* desc) {
+    SOKOL_ASSERT(img && desc);
+    _SG_GL_CHECK_ERROR();
+    _sg_image_common_init(&img->cmn, desc);
+    img->gl.ext_textures = (0 != desc->gl_textures[0]);
+
+    /* check if texture format is support */
+    if (!_sg_gl_supported_texture_format(img->cmn.pixel_format)) {
+        SOKOL_LOG("texture format not supported by GL context\n");
+        return SG_RESOURCESTATE_FAILED;
+    }
+    /* check for optional texture types */
+    if ((img->cmn.type == SG_IMAGETYPE_3D) && !_sg.features.imagetype_3d) {
+        SOKOL_LOG("3D textures not supported by GL context\n");
+        return SG_RESOURCESTATE_FAILED;
+    }
+    if ((img->cmn.type == SG_IMAGETYPE_ARRAY) && !_sg.features.imagetype_array) {
+        SOKOL_LOG("array textures not supported by GL context\n");
+        return SG_RESOURCESTATE_FAILED;
+    }
+
+    #if !defined(SOKOL_GLES2)
+    bool msaa = false;
+    if (!_sg.gl.gles2) {
+        msaa = (img->cmn.sample_count > 1) && (_sg.features.msaa_render_targets);
+    }
+    #endif
+
+    if (_sg_is_valid_rendertarget_depth_format(img->cmn.pixel_format)) {
+        /* special case depth-stencil-buffer? */
+        SOKOL_ASSERT((img->cmn.usage == SG_USAGE_IMMUTABLE) && (img->cmn.num_slots == 1));
+        SOKOL_ASSERT(!img->gl.ext_textures);   /* cannot provide external texture for depth images */
+        glGenRenderbuffers(1, &img->gl.depth_render_buffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, img->gl.depth_render_buffer);
+        GLenum gl_depth_format = _sg_gl_depth_attachment_format(img->cmn.pixel_format);
+        #if !defined(SOKOL_GLES2)
+        if (!_sg.gl.gles2 && msaa) {
+            glRenderbufferStorageMultisample(GL_RENDERBUFFER, img->cmn.sample_count, gl_depth_format, img->cmn.width, img->cmn.height);
+        }
+        else
+        #endif
+        {
+            glRenderbufferStorage(GL_RENDERBUFFER, gl_depth_format, img->cmn.width, img->cmn.height);
+        }
+    }
+    else {
+        /* regular color texture */
+        img->gl.target = _sg_gl_texture_target(img->cmn.type);
+        const GLenum gl_internal_format = _sg_gl_teximage_internal_format(img->cmn.pixel_format);
+
+        /* if this is a MSAA render target, need to create a separate render buffer */
+        #if !defined(SOKOL_GLES2)
+        if (!_sg.gl.gles2 && img->cmn.render_target && msaa) {
+            glGenRenderbuffers(1, &img->gl.msaa_render_buffer);
             glBindRenderbuffer(GL_RENDERBUFFER, img->gl.msaa_render_buffer);
             glRenderbufferStorageMultisample(GL_RENDERBUFFER, img->cmn.sample_count, gl_internal_format, img->cmn.width, img->cmn.height);
         }
         #endif
 
+        /* transient MSAA render targets are never resolved, so they don't need a texture */
+        const bool needs_texture = !(img->cmn.transient && (0 != img->gl.msaa_render_buffer));
+
         if (img->gl.ext_textures) {
             /* inject externally GL textures */
             for (int slot = 0; slot < img->cmn.num_slots; slot++) {
@@ -6255,12 +9509,16 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_
                 img->gl.target = (GLenum)desc->gl_texture_target;
             }
         }
-        else {
+        else if (needs_texture) {
             /* create our own GL texture(s) */
             const GLenum gl_format = _sg_gl_teximage_format(img->cmn.pixel_format);
             const bool is_compressed = _sg_is_compressed_pixel_format(img->cmn.pixel_format);
+            #if defined(_SOKOL_GL_PBO_UPLOAD)
+            GLintptr pbo_offsets[SG_CUBEFACE_NUM][SG_MAX_MIPMAPS];
+            const bool pbo = (img->cmn.usage == SG_USAGE_IMMUTABLE) && _sg_gl_begin_upload(img, &desc->data, pbo_offsets);
+            #endif
             for (int slot = 0; slot < img->cmn.num_slots; slot++) {
-                glGenTextures(1, &img->gl.tex[slot]);
+                img->gl.tex[slot] = _sg_gl_gen_texture();
                 SOKOL_ASSERT(img->gl.tex[slot]);
                 _sg_gl_cache_store_texture_binding(0);
                 _sg_gl_cache_bind_texture(0, img->gl.target, img->gl.tex[slot]);
@@ -6321,6 +9579,11 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_
                             gl_img_target = _sg_gl_cubeface_target(face_index);
                         }
                         const GLvoid* data_ptr = desc->data.subimage[face_index][mip_index].ptr;
+                        #if defined(_SOKOL_GL_PBO_UPLOAD)
+                        if (pbo) {
+                            data_ptr = (const GLvoid*) pbo_offsets[face_index][mip_index];
+                        }
+                        #endif
                         const GLsizei data_size = (GLsizei) desc->data.subimage[face_index][mip_index].size;
                         int mip_width = img->cmn.width >> mip_index;
                         if (mip_width == 0) {
@@ -6365,6 +9628,11 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_
                 }
                 _sg_gl_cache_restore_texture_binding(0);
             }
+            #if defined(_SOKOL_GL_PBO_UPLOAD)
+            if (pbo) {
+                _sg_gl_end_upload(img);
+            }
+            #endif
         }
     }
     _SG_GL_CHECK_ERROR();
@@ -6378,7 +9646,7 @@ _SOKOL_PRIVATE void _sg_gl_destroy_image(_sg_image_t* img) {
         if (img->gl.tex[slot]) {
             _sg_gl_cache_invalidate_texture(img->gl.tex[slot]);
             if (!img->gl.ext_textures) {
-                glDeleteTextures(1, &img->gl.tex[slot]);
+                _sg_gl_delete_texture(img->gl.tex[slot]);
             }
         }
     }
@@ -6388,6 +9656,11 @@ _SOKOL_PRIVATE void _sg_gl_destroy_image(_sg_image_t* img) {
     if (img->gl.msaa_render_buffer) {
         glDeleteRenderbuffers(1, &img->gl.msaa_render_buffer);
     }
+    #if defined(_SOKOL_GL_PBO_UPLOAD)
+    if (img->gl.upload_fence) {
+        glDeleteSync(img->gl.upload_fence);
+    }
+    #endif
     _SG_GL_CHECK_ERROR();
 }
 
@@ -6416,29 +9689,46 @@ _SOKOL_PRIVATE GLuint _sg_gl_compile_shader(sg_shader_stage stage, const char* s
     return gl_shd;
 }
 
-_SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
-    SOKOL_ASSERT(shd && desc);
-    SOKOL_ASSERT(!shd->gl.prog);
-    _SG_GL_CHECK_ERROR();
-
-    _sg_shader_common_init(&shd->cmn, desc);
-
-    /* copy vertex attribute names over, these are required for GLES2, and optional for GLES3 and GL3.x */
-    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
-        _sg_strcpy(&shd->gl.attrs[i].name, desc->attrs[i].name);
+/* compile and link a program object from source, returns 0 on failure */
+_SOKOL_PRIVATE GLuint _sg_gl_link_program(const sg_shader_desc* desc) {
+    /* compute programs only consist of the compute shader stage */
+    GLuint gl_shds[2] = { 0 };
+    int num_shds = 0;
+    #if defined(_SOKOL_GL_COMPUTE)
+    if (desc->cs.source) {
+        gl_shds[num_shds++] = _sg_gl_compile_shader(SG_SHADERSTAGE_CS, desc->cs.source);
     }
-
-    GLuint gl_vs = _sg_gl_compile_shader(SG_SHADERSTAGE_VS, desc->vs.source);
-    GLuint gl_fs = _sg_gl_compile_shader(SG_SHADERSTAGE_FS, desc->fs.source);
-    if (!(gl_vs && gl_fs)) {
-        return SG_RESOURCESTATE_FAILED;
+    else
+    #endif
+    {
+        gl_shds[num_shds++] = _sg_gl_compile_shader(SG_SHADERSTAGE_VS, desc->vs.source);
+        gl_shds[num_shds++] = _sg_gl_compile_shader(SG_SHADERSTAGE_FS, desc->fs.source);
+    }
+    bool shds_valid = true;
+    for (int i = 0; i < num_shds; i++) {
+        shds_valid &= (0 != gl_shds[i]);
+    }
+    if (!shds_valid) {
+        for (int i = 0; i < num_shds; i++) {
+            if (gl_shds[i]) {
+                glDeleteShader(gl_shds[i]);
+            }
+        }
+        return 0;
     }
     GLuint gl_prog = glCreateProgram();
-    glAttachShader(gl_prog, gl_vs);
-    glAttachShader(gl_prog, gl_fs);
+    #if defined(_SOKOL_GL_PROGRAM_BINARY)
+    if (_sg.shader_cache.enabled) {
+        glProgramParameteri(gl_prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    #endif
+    for (int i = 0; i < num_shds; i++) {
+        glAttachShader(gl_prog, gl_shds[i]);
+    }
     glLinkProgram(gl_prog);
-    glDeleteShader(gl_vs);
-    glDeleteShader(gl_fs);
+    for (int i = 0; i < num_shds; i++) {
+        glDeleteShader(gl_shds[i]);
+    }
     _SG_GL_CHECK_ERROR();
 
     GLint link_status;
@@ -6453,20 +9743,110 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
             SOKOL_FREE(log_buf);
         }
         glDeleteProgram(gl_prog);
-        return SG_RESOURCESTATE_FAILED;
+        return 0;
+    }
+    return gl_prog;
+}
+
+#if defined(_SOKOL_GL_PROGRAM_BINARY)
+/* create a program object from the shader cache, returns 0 on cache miss or if the driver rejects the binary */
+_SOKOL_PRIVATE GLuint _sg_gl_load_program_binary(uint64_t hash) {
+    const _sg_shader_cache_item_t* item = _sg_shdcache_find_item(&_sg.shader_cache, hash);
+    if (0 == item) {
+        return 0;
+    }
+    GLuint gl_prog = glCreateProgram();
+    glProgramBinary(gl_prog, (GLenum)item->format, item->data, (GLsizei)item->size);
+    GLint link_status = 0;
+    glGetProgramiv(gl_prog, GL_LINK_STATUS, &link_status);
+    if (!link_status) {
+        /* binary format no longer supported (e.g. after a driver update), drain the resulting GL error */
+        glDeleteProgram(gl_prog);
+        while (glGetError() != GL_NO_ERROR) { }
+        return 0;
+    }
+    _SG_GL_CHECK_ERROR();
+    return gl_prog;
+}
+
+_SOKOL_PRIVATE void _sg_gl_store_program_binary(uint64_t hash, GLuint gl_prog) {
+    GLint length = 0;
+    glGetProgramiv(gl_prog, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length > 0) {
+        void* buf = SOKOL_MALLOC((size_t)length);
+        SOKOL_ASSERT(buf);
+        GLsizei num_bytes = 0;
+        GLenum format = 0;
+        glGetProgramBinary(gl_prog, length, &num_bytes, &format, buf);
+        if (num_bytes > 0) {
+            _sg_shdcache_add_item(&_sg.shader_cache, hash, (uint32_t)format, buf, (uint32_t)num_bytes);
+        }
+        SOKOL_FREE(buf);
+    }
+    _SG_GL_CHECK_ERROR();
+}
+#endif
+
+_SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
+    SOKOL_ASSERT(shd && desc);
+    SOKOL_ASSERT(!shd->gl.prog);
+    _SG_GL_CHECK_ERROR();
+
+    _sg_shader_common_init(&shd->cmn, desc);
+
+    /* copy vertex attribute names over, these are required for GLES2, and optional for GLES3 and GL3.x */
+    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+        _sg_strcpy(&shd->gl.attrs[i].name, desc->attrs[i].name);
+    }
+
+    GLuint gl_prog = 0;
+    #if defined(_SOKOL_GL_PROGRAM_BINARY)
+    const uint64_t cache_hash = _sg.shader_cache.enabled ? _sg_shdcache_hash(desc) : 0;
+    if (_sg.shader_cache.enabled) {
+        gl_prog = _sg_gl_load_program_binary(cache_hash);
+    }
+    #endif
+    if (0 == gl_prog) {
+        gl_prog = _sg_gl_link_program(desc);
+        if (0 == gl_prog) {
+            return SG_RESOURCESTATE_FAILED;
+        }
+        #if defined(_SOKOL_GL_PROGRAM_BINARY)
+        if (_sg.shader_cache.enabled) {
+            _sg_gl_store_program_binary(cache_hash, gl_prog);
+        }
+        #endif
     }
     shd->gl.prog = gl_prog;
 
     /* resolve uniforms */
     _SG_GL_CHECK_ERROR();
-    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
-        const sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS)? &desc->vs : &desc->fs;
+    for (int stage_index = 0; stage_index < _SG_NUM_ALL_SHADER_STAGES; stage_index++) {
+        const sg_shader_stage_desc* stage_desc = _sg_shader_stage_desc(desc, stage_index);
         _sg_gl_shader_stage_t* gl_stage = &shd->gl.stage[stage_index];
         for (int ub_index = 0; ub_index < shd->cmn.stage[stage_index].num_uniform_blocks; ub_index++) {
             const sg_shader_uniform_block_desc* ub_desc = &stage_desc->uniform_blocks[ub_index];
             SOKOL_ASSERT(ub_desc->size > 0);
             _sg_gl_uniform_block_t* ub = &gl_stage->uniform_blocks[ub_index];
             SOKOL_ASSERT(ub->num_uniforms == 0);
+            #if !defined(SOKOL_GLES2)
+            if (ub_desc->name && !_sg.gl.gles2) {
+                /* backed by a uniform buffer object, bind the block to a fixed binding point */
+                ub->ubo = true;
+                if (0 == _sg.gl.ub.buf) {
+                    _sg_gl_create_uniform_buffer(_sg.gl.ub.size);
+                }
+                const GLuint gl_ub_index = glGetUniformBlockIndex(gl_prog, ub_desc->name);
+                if (gl_ub_index != GL_INVALID_INDEX) {
+                    ub->ubo_binding = stage_index * SG_MAX_SHADERSTAGE_UBS + ub_index;
+                    glUniformBlockBinding(gl_prog, gl_ub_index, (GLuint)ub->ubo_binding);
+                }
+                else {
+                    ub->ubo_binding = -1;
+                }
+                continue;
+            }
+            #endif
             int cur_uniform_offset = 0;
             for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
                 const sg_shader_uniform_desc* u_desc = &ub_desc->uniforms[u_index];
@@ -6476,6 +9856,10 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
                 _sg_gl_uniform_t* u = &ub->uniforms[u_index];
                 u->type = u_desc->type;
                 u->count = (uint8_t) u_desc->array_count;
+                if (ub_desc->name) {
+                    /* GLES2 fallback for a uniform buffer object, data is in std140 layout */
+                    cur_uniform_offset = _sg_roundup(cur_uniform_offset, _sg_std140_uniform_alignment(u->type, u->count));
+                }
                 u->offset = (uint16_t) cur_uniform_offset;
                 cur_uniform_offset += _sg_uniform_size(u->type, u->count);
                 if (u_desc->name) {
@@ -6486,7 +9870,10 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
                 }
                 ub->num_uniforms++;
             }
-            SOKOL_ASSERT(ub_desc->size == (size_t)cur_uniform_offset);
+            if (ub_desc->name) {
+                cur_uniform_offset = _sg_roundup(cur_uniform_offset, 16);
+            }
+            SOKOL_ASSERT((ub_desc->size == (size_t)cur_uniform_offset) || (shd->cmn.instancing && (stage_index == SG_SHADERSTAGE_VS) && (ub_index == shd->cmn.instancing_ub_index)));
         }
     }
 
@@ -6496,8 +9883,8 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
     glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&cur_prog);
     glUseProgram(gl_prog);
     int gl_tex_slot = 0;
-    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
-        const sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS)? &desc->vs : &desc->fs;
+    for (int stage_index = 0; stage_index < _SG_NUM_ALL_SHADER_STAGES; stage_index++) {
+        const sg_shader_stage_desc* stage_desc = _sg_shader_stage_desc(desc, stage_index);
         _sg_gl_shader_stage_t* gl_stage = &shd->gl.stage[stage_index];
         for (int img_index = 0; img_index < shd->cmn.stage[stage_index].num_images; img_index++) {
             const sg_shader_image_desc* img_desc = &stage_desc->images[img_index];
@@ -6596,6 +9983,18 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_pipeline(_sg_pipeline_t* pip, _sg
     return SG_RESOURCESTATE_VALID;
 }
 
+#if defined(_SOKOL_GL_COMPUTE)
+_SOKOL_PRIVATE sg_resource_state _sg_gl_create_compute_pipeline(_sg_pipeline_t* pip, _sg_shader_t* shd, const sg_compute_pipeline_desc* desc) {
+    SOKOL_ASSERT(pip && shd && desc);
+    SOKOL_ASSERT(!pip->shader && pip->cmn.shader_id.id == SG_INVALID_ID);
+    SOKOL_ASSERT(desc->shader.id == shd->slot.id);
+    SOKOL_ASSERT(shd->gl.prog && shd->cmn.compute);
+    pip->shader = shd;
+    _sg_compute_pipeline_common_init(&pip->cmn, desc);
+    return SG_RESOURCESTATE_VALID;
+}
+#endif
+
 _SOKOL_PRIVATE void _sg_gl_destroy_pipeline(_sg_pipeline_t* pip) {
     SOKOL_ASSERT(pip);
     _SOKOL_UNUSED(pip);
@@ -6718,7 +10117,7 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_pass(_sg_pass_t* pass, _sg_image_
         for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
             _sg_gl_attachment_t* gl_att = &pass->gl.color_atts[i];
             _sg_pass_attachment_t* cmn_att = &pass->cmn.color_atts[i];
-            if (gl_att->image) {
+            if (gl_att->image && !gl_att->image->cmn.transient) {
                 SOKOL_ASSERT(0 == gl_att->gl_msaa_resolve_buffer);
                 glGenFramebuffers(1, &gl_att->gl_msaa_resolve_buffer);
                 glBindFramebuffer(GL_FRAMEBUFFER, gl_att->gl_msaa_resolve_buffer);
@@ -6780,6 +10179,64 @@ _SOKOL_PRIVATE void _sg_gl_destroy_pass(_sg_pass_t* pass) {
     _SG_GL_CHECK_ERROR();
 }
 
+_SOKOL_PRIVATE sg_resource_state _sg_gl_create_sampler(_sg_sampler_t* smp, const sg_sampler_desc* desc) {
+    SOKOL_ASSERT(smp && desc);
+    _SG_GL_CHECK_ERROR();
+    _sg_sampler_common_init(&smp->cmn, desc);
+    #if !defined(SOKOL_GLES2)
+    if (!_sg.gl.gles2) {
+        glGenSamplers(1, &smp->gl.smp);
+        SOKOL_ASSERT(smp->gl.smp);
+        const GLuint gl_smp = smp->gl.smp;
+        glSamplerParameteri(gl_smp, GL_TEXTURE_MIN_FILTER, (GLint)_sg_gl_filter(smp->cmn.min_filter));
+        glSamplerParameteri(gl_smp, GL_TEXTURE_MAG_FILTER, (GLint)_sg_gl_filter(smp->cmn.mag_filter));
+        if (_sg.gl.ext_anisotropic && (smp->cmn.max_anisotropy > 1)) {
+            GLint max_aniso = (GLint) smp->cmn.max_anisotropy;
+            if (max_aniso > _sg.gl.max_anisotropy) {
+                max_aniso = _sg.gl.max_anisotropy;
+            }
+            glSamplerParameteri(gl_smp, GL_TEXTURE_MAX_ANISOTROPY_EXT, max_aniso);
+        }
+        glSamplerParameteri(gl_smp, GL_TEXTURE_WRAP_S, (GLint)_sg_gl_wrap(smp->cmn.wrap_u));
+        glSamplerParameteri(gl_smp, GL_TEXTURE_WRAP_T, (GLint)_sg_gl_wrap(smp->cmn.wrap_v));
+        glSamplerParameteri(gl_smp, GL_TEXTURE_WRAP_R, (GLint)_sg_gl_wrap(smp->cmn.wrap_w));
+        #if defined(SOKOL_GLCORE33)
+        float border[4];
+        switch (smp->cmn.border_color) {
+            case SG_BORDERCOLOR_TRANSPARENT_BLACK:
+                border[0] = 0.0f; border[1] = 0.0f; border[2] = 0.0f; border[3] = 0.0f;
+                break;
+            case SG_BORDERCOLOR_OPAQUE_WHITE:
+                border[0] = 1.0f; border[1] = 1.0f; border[2] = 1.0f; border[3] = 1.0f;
+                break;
+            default:
+                border[0] = 0.0f; border[1] = 0.0f; border[2] = 0.0f; border[3] = 1.0f;
+                break;
+        }
+        glSamplerParameterfv(gl_smp, GL_TEXTURE_BORDER_COLOR, border);
+        #endif
+        /* GL spec has strange defaults for mipmap min/max lod: -1000 to +1000 */
+        glSamplerParameterf(gl_smp, GL_TEXTURE_MIN_LOD, _sg_clamp(smp->cmn.min_lod, 0.0f, 1000.0f));
+        glSamplerParameterf(gl_smp, GL_TEXTURE_MAX_LOD, _sg_clamp(smp->cmn.max_lod, 0.0f, 1000.0f));
+    }
+    #endif
+    _SG_GL_CHECK_ERROR();
+    return SG_RESOURCESTATE_VALID;
+}
+
+_SOKOL_PRIVATE void _sg_gl_destroy_sampler(_sg_sampler_t* smp) {
+    SOKOL_ASSERT(smp);
+    _SOKOL_UNUSED(smp);
+    _SG_GL_CHECK_ERROR();
+    #if !defined(SOKOL_GLES2)
+    if (0 != smp->gl.smp) {
+        _sg_gl_cache_invalidate_sampler(smp->gl.smp);
+        glDeleteSamplers(1, &smp->gl.smp);
+    }
+    #endif
+    _SG_GL_CHECK_ERROR();
+}
+
 _SOKOL_PRIVATE _sg_image_t* _sg_gl_pass_color_image(const _sg_pass_t* pass, int index) {
     SOKOL_ASSERT(pass && (index >= 0) && (index < SG_MAX_COLOR_ATTACHMENTS));
     /* NOTE: may return null */
@@ -6808,6 +10265,7 @@ _SOKOL_PRIVATE void _sg_gl_begin_pass(_sg_pass_t* pass, const sg_pass_action* ac
     }
     _sg.gl.cur_pass_width = w;
     _sg.gl.cur_pass_height = h;
+    _sg.gl.cur_pass_action = *action;
 
     /* number of color attachments */
     const int num_color_atts = pass ? pass->cmn.num_color_atts : 1;
@@ -6933,6 +10391,63 @@ _SOKOL_PRIVATE void _sg_gl_begin_pass(_sg_pass_t* pass, const sg_pass_action* ac
     _SG_GL_CHECK_ERROR();
 }
 
+#if defined(_SOKOL_GL_INVALIDATE)
+/* discard the content of pass attachments which isn't needed after the pass,
+   this lets tiled GPUs skip writing the attachments back to memory
+*/
+_SOKOL_PRIVATE void _sg_gl_invalidate_pass_attachments(void) {
+    const sg_pass_action* action = &_sg.gl.cur_pass_action;
+    const _sg_pass_t* pass = _sg.gl.cur_pass;
+    GLenum atts[SG_MAX_COLOR_ATTACHMENTS + 2];
+    GLsizei num_atts = 0;
+    if (pass) {
+        const bool is_msaa = (0 != pass->gl.color_atts[0].image->gl.msaa_render_buffer);
+        for (int i = 0; i < pass->cmn.num_color_atts; i++) {
+            const _sg_image_t* img = pass->gl.color_atts[i].image;
+            SOKOL_ASSERT(img);
+            const sg_store_action store_action = action->colors[i].store_action;
+            if (img->cmn.transient ||
+                (SG_STOREACTION_DONTCARE == store_action) ||
+                (is_msaa && (SG_STOREACTION_RESOLVE == store_action)))
+            {
+                atts[num_atts++] = (GLenum)(GL_COLOR_ATTACHMENT0 + i);
+            }
+        }
+        const _sg_image_t* ds_img = pass->gl.ds_att.image;
+        if (ds_img) {
+            if (ds_img->cmn.transient || (SG_STOREACTION_DONTCARE == action->depth.store_action)) {
+                atts[num_atts++] = GL_DEPTH_ATTACHMENT;
+            }
+            if (_sg_is_depth_stencil_format(ds_img->cmn.pixel_format)) {
+                if (ds_img->cmn.transient || (SG_STOREACTION_DONTCARE == action->stencil.store_action)) {
+                    atts[num_atts++] = GL_STENCIL_ATTACHMENT;
+                }
+            }
+        }
+        if (num_atts > 0) {
+            glBindFramebuffer(GL_FRAMEBUFFER, pass->gl.fb);
+        }
+    }
+    else {
+        /* the default framebuffer uses different attachment names than framebuffer objects */
+        SOKOL_ASSERT(_sg.gl.cur_context);
+        const bool is_default_fb = (0 == _sg.gl.cur_context->default_framebuffer);
+        if (SG_STOREACTION_DONTCARE == action->colors[0].store_action) {
+            atts[num_atts++] = is_default_fb ? GL_COLOR : GL_COLOR_ATTACHMENT0;
+        }
+        if (SG_STOREACTION_DONTCARE == action->depth.store_action) {
+            atts[num_atts++] = is_default_fb ? GL_DEPTH : GL_DEPTH_ATTACHMENT;
+        }
+        if (SG_STOREACTION_DONTCARE == action->stencil.store_action) {
+            atts[num_atts++] = is_default_fb ? GL_STENCIL : GL_STENCIL_ATTACHMENT;
+        }
+    }
+    if (num_atts > 0) {
+        glInvalidateFramebuffer(GL_FRAMEBUFFER, num_atts, atts);
+    }
+}
+#endif
+
 _SOKOL_PRIVATE void _sg_gl_end_pass(void) {
     SOKOL_ASSERT(_sg.gl.in_pass);
     _SG_GL_CHECK_ERROR();
@@ -6944,20 +10459,22 @@ _SOKOL_PRIVATE void _sg_gl_end_pass(void) {
         /* check if the pass object is still valid */
         const _sg_pass_t* pass = _sg.gl.cur_pass;
         SOKOL_ASSERT(pass->slot.id == _sg.gl.cur_pass_id.id);
-        bool is_msaa = (0 != _sg.gl.cur_pass->gl.color_atts[0].gl_msaa_resolve_buffer);
+        SOKOL_ASSERT(pass->gl.color_atts[0].image);
+        bool is_msaa = (0 != pass->gl.color_atts[0].image->gl.msaa_render_buffer);
         if (is_msaa) {
             SOKOL_ASSERT(pass->gl.fb);
             glBindFramebuffer(GL_READ_FRAMEBUFFER, pass->gl.fb);
-            SOKOL_ASSERT(pass->gl.color_atts[0].image);
             const int w = pass->gl.color_atts[0].image->cmn.width;
             const int h = pass->gl.color_atts[0].image->cmn.height;
             for (int att_index = 0; att_index < SG_MAX_COLOR_ATTACHMENTS; att_index++) {
                 const _sg_gl_attachment_t* gl_att = &pass->gl.color_atts[att_index];
                 if (gl_att->image) {
-                    SOKOL_ASSERT(gl_att->gl_msaa_resolve_buffer);
-                    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, gl_att->gl_msaa_resolve_buffer);
-                    glReadBuffer((GLenum)(GL_COLOR_ATTACHMENT0 + att_index));
-                    glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+                    /* transient images have no resolve buffer, and DONTCARE skips the resolve */
+                    if (gl_att->gl_msaa_resolve_buffer && (_sg.gl.cur_pass_action.colors[att_index].store_action != SG_STOREACTION_DONTCARE)) {
+                        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, gl_att->gl_msaa_resolve_buffer);
+                        glReadBuffer((GLenum)(GL_COLOR_ATTACHMENT0 + att_index));
+                        glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+                    }
                 }
                 else {
                     break;
@@ -6966,6 +10483,11 @@ _SOKOL_PRIVATE void _sg_gl_end_pass(void) {
         }
     }
     #endif
+    #if defined(_SOKOL_GL_INVALIDATE)
+    if (_sg.gl.invalidate) {
+        _sg_gl_invalidate_pass_attachments();
+    }
+    #endif
     _sg.gl.cur_pass = 0;
     _sg.gl.cur_pass_id.id = SG_INVALID_ID;
     _sg.gl.cur_pass_width = 0;
@@ -6993,6 +10515,17 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
     SOKOL_ASSERT(pip);
     SOKOL_ASSERT(pip->shader && (pip->cmn.shader_id.id == pip->shader->slot.id));
     _SG_GL_CHECK_ERROR();
+    if (pip->cmn.compute) {
+        /* compute pipelines have no render state, only the program object */
+        _sg.gl.cache.cur_pipeline = pip;
+        _sg.gl.cache.cur_pipeline_id.id = pip->slot.id;
+        if (pip->shader->gl.prog != _sg.gl.cache.prog) {
+            _sg.gl.cache.prog = pip->shader->gl.prog;
+            glUseProgram(pip->shader->gl.prog);
+        }
+        _SG_GL_CHECK_ERROR();
+        return;
+    }
     if ((_sg.gl.cache.cur_pipeline != pip) || (_sg.gl.cache.cur_pipeline_id.id != pip->slot.id)) {
         _sg.gl.cache.cur_pipeline = pip;
         _sg.gl.cache.cur_pipeline_id.id = pip->slot.id;
@@ -7201,34 +10734,156 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
     _SG_GL_CHECK_ERROR();
 }
 
-_SOKOL_PRIVATE void _sg_gl_apply_bindings(
-    _sg_pipeline_t* pip,
-    _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
-    _sg_buffer_t* ib, int ib_offset,
-    _sg_image_t** vs_imgs, int num_vs_imgs,
-    _sg_image_t** fs_imgs, int num_fs_imgs)
-{
-    SOKOL_ASSERT(pip);
-    _SOKOL_UNUSED(num_fs_imgs);
-    _SOKOL_UNUSED(num_vs_imgs);
+#if !defined(SOKOL_GLES2)
+/* lookup or create a cached vertex array object for the vertex layout, vertex buffers and index buffer */
+_SOKOL_PRIVATE void _sg_gl_apply_vao(_sg_pipeline_t* pip, _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs, GLuint gl_ib) {
+    _sg_gl_vao_cache_t* cache = &_sg.gl.cur_context->vao_cache;
+    SOKOL_ASSERT(cache->items && (cache->capacity > 0));
     _SOKOL_UNUSED(num_vbs);
-    _SG_GL_CHECK_ERROR();
 
-    /* bind textures */
-    _SG_GL_CHECK_ERROR();
-    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
-        const _sg_shader_stage_t* stage = &pip->shader->cmn.stage[stage_index];
-        const _sg_gl_shader_stage_t* gl_stage = &pip->shader->gl.stage[stage_index];
-        _sg_image_t** imgs = (stage_index == SG_SHADERSTAGE_VS)? vs_imgs : fs_imgs;
-        SOKOL_ASSERT(((stage_index == SG_SHADERSTAGE_VS)? num_vs_imgs : num_fs_imgs) == stage->num_images);
-        for (int img_index = 0; img_index < stage->num_images; img_index++) {
-            const _sg_gl_shader_image_t* gl_shd_img = &gl_stage->images[img_index];
+    /* build the cache key (zero-initialized so that it can be compared with memcmp) */
+    _sg_gl_vao_key_t key;
+    memset(&key, 0, sizeof(key));
+    int attr_vb_offsets[SG_MAX_VERTEX_ATTRIBUTES];
+    memset(attr_vb_offsets, 0, sizeof(attr_vb_offsets));
+    key.ib = gl_ib;
+    for (int attr_index = 0; attr_index < _sg.limits.max_vertex_attrs; attr_index++) {
+        const _sg_gl_attr_t* attr = &pip->gl.attrs[attr_index];
+        _sg_gl_attr_t* key_attr = &key.attrs[attr_index];
+        key_attr->vb_index = attr->vb_index;
+        if (attr->vb_index >= 0) {
+            SOKOL_ASSERT(attr->vb_index < num_vbs);
+            const _sg_buffer_t* vb = vbs[attr->vb_index];
+            SOKOL_ASSERT(vb);
+            key.vbufs[attr_index] = vb->gl.buf[vb->cmn.active_slot];
+            key_attr->divisor = attr->divisor;
+            key_attr->stride = attr->stride;
+            key_attr->size = attr->size;
+            key_attr->normalized = attr->normalized;
+            key_attr->offset = attr->offset;
+            key_attr->type = attr->type;
+            attr_vb_offsets[attr_index] = vb_offsets[attr->vb_index];
+        }
+    }
+
+    /* lookup */
+    const uint32_t hash = _sg_gl_vao_key_hash(&key);
+    cache->use_counter++;
+    uint32_t index = hash & cache->mask;
+    while (cache->items[index].vao) {
+        _sg_gl_vao_cache_item_t* item = &cache->items[index];
+        if ((item->hash == hash) && (0 == memcmp(&item->key, &key, sizeof(key)))) {
+            item->last_use = cache->use_counter;
+            _sg.gl.cache.draw_vao = item->vao;
+            _sg.gl.cache.draw_vao_ib = gl_ib;
+            if (_sg.gl.cache.vao != item->vao) {
+                _sg.gl.cache.vao = item->vao;
+                _sg.gl.cache.index_buffer = gl_ib;
+                glBindVertexArray(item->vao);
+            }
+            /* only re-specify the attribute pointers if the vertex buffer offsets have changed */
+            for (GLuint attr_index = 0; attr_index < (GLuint)_sg.limits.max_vertex_attrs; attr_index++) {
+                const _sg_gl_attr_t* attr = &key.attrs[attr_index];
+                if ((attr->vb_index >= 0) && (item->vb_offsets[attr_index] != attr_vb_offsets[attr_index])) {
+                    _sg_gl_cache_bind_buffer(GL_ARRAY_BUFFER, key.vbufs[attr_index]);
+                    glVertexAttribPointer(attr_index, attr->size, attr->type,
+                        attr->normalized, attr->stride,
+                        (const GLvoid*)(GLintptr)(attr_vb_offsets[attr_index] + attr->offset));
+                    item->vb_offsets[attr_index] = attr_vb_offsets[attr_index];
+                }
+            }
+            _SG_GL_CHECK_ERROR();
+            return;
+        }
+        index = (index + 1) & cache->mask;
+    }
+
+    /* cache miss, if the cache is full replace the least recently used VAO */
+    if (cache->num_items == cache->capacity) {
+        uint32_t lru_index = 0;
+        uint32_t lru_age = 0;
+        for (uint32_t i = 0; i <= cache->mask; i++) {
+            const _sg_gl_vao_cache_item_t* item = &cache->items[i];
+            if (item->vao && ((cache->use_counter - item->last_use) > lru_age)) {
+                lru_index = i;
+                lru_age = cache->use_counter - item->last_use;
+            }
+        }
+        _sg_gl_vao_cache_remove(cache, lru_index);
+        /* removing may have moved items, find the free slot again */
+        index = hash & cache->mask;
+        while (cache->items[index].vao) {
+            index = (index + 1) & cache->mask;
+        }
+    }
+    _sg_gl_vao_cache_item_t* item = &cache->items[index];
+    cache->num_items++;
+    item->key = key;
+    item->hash = hash;
+    item->last_use = cache->use_counter;
+    memcpy(item->vb_offsets, attr_vb_offsets, sizeof(attr_vb_offsets));
+    item->vao = 0;
+    glGenVertexArrays(1, &item->vao);
+    SOKOL_ASSERT(item->vao);
+    glBindVertexArray(item->vao);
+    _sg.gl.cache.vao = item->vao;
+    _sg.gl.cache.draw_vao = item->vao;
+    _sg.gl.cache.draw_vao_ib = gl_ib;
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gl_ib);
+    _sg.gl.cache.index_buffer = gl_ib;
+    for (GLuint attr_index = 0; attr_index < (GLuint)_sg.limits.max_vertex_attrs; attr_index++) {
+        const _sg_gl_attr_t* attr = &key.attrs[attr_index];
+        if (attr->vb_index >= 0) {
+            _sg_gl_cache_bind_buffer(GL_ARRAY_BUFFER, key.vbufs[attr_index]);
+            glVertexAttribPointer(attr_index, attr->size, attr->type,
+                attr->normalized, attr->stride,
+                (const GLvoid*)(GLintptr)(attr_vb_offsets[attr_index] + attr->offset));
+            #if defined(_SOKOL_GL_INSTANCING_ENABLED)
+                if (_sg.features.instancing) {
+                    glVertexAttribDivisor(attr_index, (GLuint)attr->divisor);
+                }
+            #endif
+            glEnableVertexAttribArray(attr_index);
+        }
+    }
+    _SG_GL_CHECK_ERROR();
+}
+#endif
+
+_SOKOL_PRIVATE void _sg_gl_apply_bindings(
+    _sg_pipeline_t* pip,
+    _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
+    _sg_buffer_t* ib, int ib_offset,
+    _sg_image_t** vs_imgs, _sg_sampler_t** vs_smps, int num_vs_imgs,
+    _sg_image_t** fs_imgs, _sg_sampler_t** fs_smps, int num_fs_imgs)
+{
+    SOKOL_ASSERT(pip);
+    _SOKOL_UNUSED(num_fs_imgs);
+    _SOKOL_UNUSED(num_vs_imgs);
+    _SG_GL_CHECK_ERROR();
+
+    /* bind textures */
+    _SG_GL_CHECK_ERROR();
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        const _sg_shader_stage_t* stage = &pip->shader->cmn.stage[stage_index];
+        const _sg_gl_shader_stage_t* gl_stage = &pip->shader->gl.stage[stage_index];
+        _sg_image_t** imgs = (stage_index == SG_SHADERSTAGE_VS)? vs_imgs : fs_imgs;
+        _sg_sampler_t** smps = (stage_index == SG_SHADERSTAGE_VS)? vs_smps : fs_smps;
+        _SOKOL_UNUSED(smps);
+        SOKOL_ASSERT(((stage_index == SG_SHADERSTAGE_VS)? num_vs_imgs : num_fs_imgs) == stage->num_images);
+        for (int img_index = 0; img_index < stage->num_images; img_index++) {
+            const _sg_gl_shader_image_t* gl_shd_img = &gl_stage->images[img_index];
             if (gl_shd_img->gl_tex_slot != -1) {
                 _sg_image_t* img = imgs[img_index];
                 const GLuint gl_tex = img->gl.tex[img->cmn.active_slot];
                 SOKOL_ASSERT(img && img->gl.target);
                 SOKOL_ASSERT((gl_shd_img->gl_tex_slot != -1) && gl_tex);
                 _sg_gl_cache_bind_texture(gl_shd_img->gl_tex_slot, img->gl.target, gl_tex);
+                #if !defined(SOKOL_GLES2)
+                if (!_sg.gl.gles2) {
+                    _sg_gl_cache_bind_sampler(gl_shd_img->gl_tex_slot, smps[img_index] ? smps[img_index]->gl.smp : 0);
+                }
+                #endif
             }
         }
     }
@@ -7236,8 +10891,24 @@ _SOKOL_PRIVATE void _sg_gl_apply_bindings(
 
     /* index buffer (can be 0) */
     const GLuint gl_ib = ib ? ib->gl.buf[ib->cmn.active_slot] : 0;
+    _sg.gl.cache.cur_ib_offset = ib_offset + (ib ? _sg_gl_buffer_slot_offset(ib) : 0);
+
+    /* vertex buffer offsets, including the active slot of persistently mapped buffers */
+    int gl_vb_offsets[SG_MAX_SHADERSTAGE_BUFFERS];
+    for (int i = 0; i < num_vbs; i++) {
+        gl_vb_offsets[i] = vb_offsets[i] + _sg_gl_buffer_slot_offset(vbs[i]);
+    }
+
+    /* vertex array object cache */
+    #if !defined(SOKOL_GLES2)
+    if (_sg.gl.cur_context->vao_cache.items) {
+        _sg_gl_apply_vao(pip, vbs, gl_vb_offsets, num_vbs, gl_ib);
+        return;
+    }
+    _sg.gl.cache.draw_vao = 0;
+    _sg.gl.cache.draw_vao_ib = 0;
+    #endif
     _sg_gl_cache_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, gl_ib);
-    _sg.gl.cache.cur_ib_offset = ib_offset;
 
     /* vertex attributes */
     for (GLuint attr_index = 0; attr_index < (GLuint)_sg.limits.max_vertex_attrs; attr_index++) {
@@ -7252,7 +10923,7 @@ _SOKOL_PRIVATE void _sg_gl_apply_bindings(
             _sg_buffer_t* vb = vbs[attr->vb_index];
             SOKOL_ASSERT(vb);
             gl_vb = vb->gl.buf[vb->cmn.active_slot];
-            vb_offset = vb_offsets[attr->vb_index] + attr->offset;
+            vb_offset = gl_vb_offsets[attr->vb_index] + attr->offset;
             if ((gl_vb != cache_attr->gl_vbuf) ||
                 (attr->size != cache_attr->gl_attr.size) ||
                 (attr->type != cache_attr->gl_attr.type) ||
@@ -7293,6 +10964,52 @@ _SOKOL_PRIVATE void _sg_gl_apply_bindings(
     _SG_GL_CHECK_ERROR();
 }
 
+#if !defined(SOKOL_GLES2)
+/* replace an exhausted uniform buffer with one of twice the size, the old buffer
+   is still bound to uniform blocks in the current frame and is deleted in _sg_gl_commit()
+*/
+_SOKOL_PRIVATE bool _sg_gl_grow_uniform_buffer(int num_bytes) {
+    if ((_sg.gl.ub.num_retired >= _SG_GL_MAX_RETIRED_UBS) || (_sg.gl.ub.size > (0x7FFFFFFF / 2))) {
+        return false;
+    }
+    int new_size = _sg.gl.ub.size * 2;
+    if (new_size < num_bytes) {
+        new_size = _sg_roundup(num_bytes, _sg.gl.ub.align);
+    }
+    SOKOL_LOG("_sg_gl_apply_uniforms: uniform buffer exhausted, growing it (increase sg_desc.uniform_buffer_size)");
+    _sg.gl.ub.retired[_sg.gl.ub.num_retired++] = _sg.gl.ub.buf;
+    _sg.gl.ub.retired_offset += _sg.gl.ub.offset;
+    _sg_gl_create_uniform_buffer(new_size);
+    _sg.stats.cur.num_uniform_buffer_chains++;
+    return true;
+}
+
+/* copy uniform data into the per-frame uniform buffer and bind the range to a uniform block binding */
+_SOKOL_PRIVATE void _sg_gl_apply_uniform_buffer(GLint binding, const sg_range* data) {
+    SOKOL_ASSERT(_sg.gl.ub.buf);
+    if ((_sg.gl.ub.offset + (int)data->size) > _sg.gl.ub.size) {
+        if (!_sg.desc.uniform_buffer_chaining || !_sg_gl_grow_uniform_buffer((int)data->size)) {
+            /* only log the first dropped call in a frame */
+            if (0 == _sg.stats.cur.num_uniform_buffer_overflows) {
+                SOKOL_LOG("_sg_gl_apply_uniforms: uniform buffer exhausted (increase sg_desc.uniform_buffer_size or set sg_desc.uniform_buffer_chaining)");
+            }
+            _sg.stats.cur.num_uniform_buffer_overflows++;
+            return;
+        }
+    }
+    _sg_gl_cache_bind_uniform_buffer(_sg.gl.ub.buf);
+    if (_sg.gl.ub.orphan) {
+        /* first update in a new frame, orphan the buffer storage to not stall on the GPU */
+        glBufferData(GL_UNIFORM_BUFFER, _sg.gl.ub.size, 0, GL_STREAM_DRAW);
+        _sg.gl.ub.orphan = false;
+    }
+    glBufferSubData(GL_UNIFORM_BUFFER, _sg.gl.ub.offset, (GLsizeiptr)data->size, data->ptr);
+    glBindBufferRange(GL_UNIFORM_BUFFER, (GLuint)binding, _sg.gl.ub.buf, _sg.gl.ub.offset, (GLsizeiptr)data->size);
+    _sg.gl.ub.offset = _sg_roundup(_sg.gl.ub.offset + (int)data->size, _sg.gl.ub.align);
+    _SG_GL_CHECK_ERROR();
+}
+#endif
+
 _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_index, const sg_range* data) {
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline);
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline->slot.id == _sg.gl.cache.cur_pipeline_id.id);
@@ -7301,6 +11018,14 @@ _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_in
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline->shader->cmn.stage[stage_index].uniform_blocks[ub_index].size == data->size);
     const _sg_gl_shader_stage_t* gl_stage = &_sg.gl.cache.cur_pipeline->shader->gl.stage[stage_index];
     const _sg_gl_uniform_block_t* gl_ub = &gl_stage->uniform_blocks[ub_index];
+    #if !defined(SOKOL_GLES2)
+    if (gl_ub->ubo) {
+        if (gl_ub->ubo_binding != -1) {
+            _sg_gl_apply_uniform_buffer(gl_ub->ubo_binding, data);
+        }
+        return;
+    }
+    #endif
     for (int u_index = 0; u_index < gl_ub->num_uniforms; u_index++) {
         const _sg_gl_uniform_t* u = &gl_ub->uniforms[u_index];
         SOKOL_ASSERT(u->type != SG_UNIFORMTYPE_INVALID);
@@ -7333,7 +11058,45 @@ _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_in
     }
 }
 
-_SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_instances) {
+#if defined(_SOKOL_GL_COMPUTE)
+_SOKOL_PRIVATE void _sg_gl_begin_compute_pass(void) {
+    /* compute passes don't touch the framebuffer, nothing to do here */
+}
+
+/* make storage buffer writes visible to subsequent draws and buffer updates */
+_SOKOL_PRIVATE void _sg_gl_end_compute_pass(void) {
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT|GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT|GL_ELEMENT_ARRAY_BARRIER_BIT|GL_BUFFER_UPDATE_BARRIER_BIT);
+    _SG_GL_CHECK_ERROR();
+}
+
+_SOKOL_PRIVATE void _sg_gl_apply_compute_bindings(_sg_pipeline_t* pip, _sg_buffer_t** sbufs, int num_sbufs) {
+    SOKOL_ASSERT(pip && sbufs);
+    _SOKOL_UNUSED(pip);
+    _SG_GL_CHECK_ERROR();
+    for (int i = 0; i < num_sbufs; i++) {
+        const _sg_buffer_t* sbuf = sbufs[i];
+        SOKOL_ASSERT(sbuf && (sbuf->cmn.num_slots == 1));
+        const GLuint gl_buf = sbuf->gl.buf[0];
+        if (gl_buf != _sg.gl.cache.storage_buffers[i]) {
+            _sg.gl.cache.storage_buffers[i] = gl_buf;
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, (GLuint)i, gl_buf);
+        }
+    }
+    _SG_GL_CHECK_ERROR();
+}
+
+/* successive dispatches in the same pass may read what the previous dispatch has written */
+_SOKOL_PRIVATE void _sg_gl_dispatch(int num_groups_x, int num_groups_y, int num_groups_z) {
+    glDispatchCompute((GLuint)num_groups_x, (GLuint)num_groups_y, (GLuint)num_groups_z);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    _SG_GL_CHECK_ERROR();
+}
+#endif
+
+_SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_instances, int base_vertex) {
+    #if !defined(SOKOL_GLES2)
+    _sg_gl_cache_rebind_draw_vao();
+    #endif
     const GLenum i_type = _sg.gl.cache.cur_index_type;
     const GLenum p_type = _sg.gl.cache.cur_primitive_type;
     if (0 != i_type) {
@@ -7341,6 +11104,20 @@ _SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_inst
         const int i_size = (i_type == GL_UNSIGNED_SHORT) ? 2 : 4;
         const int ib_offset = _sg.gl.cache.cur_ib_offset;
         const GLvoid* indices = (const GLvoid*)(GLintptr)(base_element*i_size+ib_offset);
+        #if defined(_SOKOL_GL_BASE_VERTEX)
+        if (0 != base_vertex) {
+            if (num_instances == 1) {
+                glDrawElementsBaseVertex(p_type, num_elements, i_type, indices, base_vertex);
+            }
+            else {
+                glDrawElementsInstancedBaseVertex(p_type, num_elements, i_type, indices, num_instances, base_vertex);
+            }
+            return;
+        }
+        #else
+        /* draws with a base vertex have been dropped in sg_draw_ex() */
+        SOKOL_ASSERT(0 == base_vertex);
+        #endif
         if (num_instances == 1) {
             glDrawElements(p_type, num_elements, i_type, indices);
         }
@@ -7352,15 +11129,117 @@ _SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_inst
     }
     else {
         /* non-indexed rendering */
+        const int first = base_element + base_vertex;
         if (num_instances == 1) {
-            glDrawArrays(p_type, base_element, num_elements);
+            glDrawArrays(p_type, first, num_elements);
         }
         else {
             if (_sg.features.instancing) {
-                glDrawArraysInstanced(p_type, base_element, num_elements, num_instances);
+                glDrawArraysInstanced(p_type, first, num_elements, num_instances);
+            }
+        }
+    }
+}
+
+/* submit non-instanced ranges with glMultiDraw*() in chunks (to avoid allocating
+   temporary memory), instanced ranges fall back to separate draw calls
+*/
+_SOKOL_PRIVATE void _sg_gl_draw_batch(const sg_draw_range* ranges, int count) {
+    SOKOL_ASSERT(ranges && (count > 0));
+    #if !defined(SOKOL_GLES2)
+    _sg_gl_cache_rebind_draw_vao();
+    #endif
+    #if defined(_SOKOL_GL_MULTI_DRAW)
+    const GLenum i_type = _sg.gl.cache.cur_index_type;
+    const GLenum p_type = _sg.gl.cache.cur_primitive_type;
+    const int i_size = (i_type == GL_UNSIGNED_SHORT) ? 2 : 4;
+    const int ib_offset = _sg.gl.cache.cur_ib_offset;
+    GLsizei counts[_SG_DRAW_BATCH_CHUNK_SIZE];
+    GLint firsts[_SG_DRAW_BATCH_CHUNK_SIZE];
+    const GLvoid* indices[_SG_DRAW_BATCH_CHUNK_SIZE];
+    GLint base_vertices[_SG_DRAW_BATCH_CHUNK_SIZE];
+    int num = 0;
+    for (int i = 0; i <= count; i++) {
+        const bool last = (i == count);
+        const sg_draw_range* range = last ? 0 : &ranges[i];
+        const bool instanced = !last && (_sg_def(range->num_instances, 1) > 1);
+        if ((num > 0) && (last || instanced || (num == _SG_DRAW_BATCH_CHUNK_SIZE))) {
+            if (0 != i_type) {
+                #if defined(_SOKOL_GL_BASE_VERTEX)
+                glMultiDrawElementsBaseVertex(p_type, counts, i_type, indices, num, base_vertices);
+                #else
+                glMultiDrawElements(p_type, counts, i_type, indices, num);
+                #endif
             }
+            else {
+                glMultiDrawArrays(p_type, firsts, counts, num);
+            }
+            num = 0;
+        }
+        if (last || (0 == range->num_elements)) {
+            continue;
+        }
+        if (instanced) {
+            _sg_gl_draw(range->base_element, range->num_elements, range->num_instances, range->base_vertex);
+        }
+        else {
+            counts[num] = range->num_elements;
+            firsts[num] = range->base_element + range->base_vertex;
+            indices[num] = (const GLvoid*)(GLintptr)(range->base_element*i_size+ib_offset);
+            base_vertices[num] = range->base_vertex;
+            num++;
+        }
+    }
+    #else
+    for (int i = 0; i < count; i++) {
+        if (ranges[i].num_elements > 0) {
+            _sg_gl_draw(ranges[i].base_element, ranges[i].num_elements, _sg_def(ranges[i].num_instances, 1), ranges[i].base_vertex);
+        }
+    }
+    #endif
+}
+
+/* GPU timing with timestamp queries, frame is the GPU timing frame slot */
+_SOKOL_PRIVATE void _sg_gl_write_timestamp(int frame, int query_index) {
+    #if defined(_SOKOL_GL_TIMER_QUERY)
+    SOKOL_ASSERT((frame < _SG_GPU_TIMING_FRAMES) && (query_index < (SG_MAX_GPU_TIMINGS * 2)));
+    glQueryCounter(_sg.gl.timer_queries[frame][query_index], GL_TIMESTAMP);
+    _SG_GL_CHECK_ERROR();
+    #else
+    _SOKOL_UNUSED(frame);
+    _SOKOL_UNUSED(query_index);
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_gl_timestamps_available(int frame, int num_queries) {
+    #if defined(_SOKOL_GL_TIMER_QUERY)
+    SOKOL_ASSERT((frame < _SG_GPU_TIMING_FRAMES) && (num_queries <= (SG_MAX_GPU_TIMINGS * 2)));
+    for (int i = 0; i < num_queries; i++) {
+        GLint available = 0;
+        glGetQueryObjectiv(_sg.gl.timer_queries[frame][i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            return false;
         }
     }
+    return true;
+    #else
+    _SOKOL_UNUSED(frame);
+    _SOKOL_UNUSED(num_queries);
+    return false;
+    #endif
+}
+
+_SOKOL_PRIVATE uint64_t _sg_gl_read_timestamp(int frame, int query_index) {
+    #if defined(_SOKOL_GL_TIMER_QUERY)
+    SOKOL_ASSERT((frame < _SG_GPU_TIMING_FRAMES) && (query_index < (SG_MAX_GPU_TIMINGS * 2)));
+    GLuint64 timestamp = 0;
+    glGetQueryObjectui64v(_sg.gl.timer_queries[frame][query_index], GL_QUERY_RESULT, &timestamp);
+    return (uint64_t)timestamp;
+    #else
+    _SOKOL_UNUSED(frame);
+    _SOKOL_UNUSED(query_index);
+    return 0;
+    #endif
 }
 
 _SOKOL_PRIVATE void _sg_gl_commit(void) {
@@ -7368,6 +11247,27 @@ _SOKOL_PRIVATE void _sg_gl_commit(void) {
     /* "soft" clear bindings (only those that are actually bound) */
     _sg_gl_cache_clear_buffer_bindings(false);
     _sg_gl_cache_clear_texture_bindings(false);
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    if (_sg.gl.persistent_buffers) {
+        _sg_gl_insert_frame_fence();
+    }
+    #endif
+    #if !defined(SOKOL_GLES2)
+    if (!_sg.gl.gles2) {
+        _sg.stats.cur.size_uniform_buffer = (size_t)_sg.gl.ub.retired_offset + (size_t)_sg.gl.ub.offset;
+        _sg.gl.ub.offset = 0;
+        _sg.gl.ub.retired_offset = 0;
+        _sg.gl.ub.orphan = true;
+        if (_sg.gl.ub.num_retired > 0) {
+            glDeleteBuffers(_sg.gl.ub.num_retired, _sg.gl.ub.retired);
+            _sg.gl.ub.num_retired = 0;
+            /* deleting buffers which are bound to indexed binding points may
+               also reset the generic GL_UNIFORM_BUFFER binding
+            */
+            _sg.gl.cache.uniform_buffer = 0;
+        }
+    }
+    #endif
 }
 
 _SOKOL_PRIVATE void _sg_gl_update_buffer(_sg_buffer_t* buf, const sg_range* data) {
@@ -7376,8 +11276,15 @@ _SOKOL_PRIVATE void _sg_gl_update_buffer(_sg_buffer_t* buf, const sg_range* data
     if (++buf->cmn.active_slot >= buf->cmn.num_slots) {
         buf->cmn.active_slot = 0;
     }
-    GLenum gl_tgt = _sg_gl_buffer_target(buf->cmn.type);
     SOKOL_ASSERT(buf->cmn.active_slot < SG_NUM_INFLIGHT_FRAMES);
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    if (buf->gl.mapped) {
+        _sg_gl_wait_buffer_slot(buf, buf->cmn.active_slot);
+        memcpy(buf->gl.mapped + buf->cmn.active_slot * buf->gl.slot_size, data->ptr, data->size);
+        return;
+    }
+    #endif
+    GLenum gl_tgt = _sg_gl_buffer_target(buf->cmn.type);
     GLuint gl_buf = buf->gl.buf[buf->cmn.active_slot];
     SOKOL_ASSERT(gl_buf);
     _SG_GL_CHECK_ERROR();
@@ -7395,8 +11302,15 @@ _SOKOL_PRIVATE int _sg_gl_append_buffer(_sg_buffer_t* buf, const sg_range* data,
             buf->cmn.active_slot = 0;
         }
     }
-    GLenum gl_tgt = _sg_gl_buffer_target(buf->cmn.type);
     SOKOL_ASSERT(buf->cmn.active_slot < SG_NUM_INFLIGHT_FRAMES);
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    if (buf->gl.mapped) {
+        _sg_gl_wait_buffer_slot(buf, buf->cmn.active_slot);
+        memcpy(buf->gl.mapped + buf->cmn.active_slot * buf->gl.slot_size + buf->cmn.append_pos, data->ptr, data->size);
+        return _sg_roundup((int)data->size, 4);
+    }
+    #endif
+    GLenum gl_tgt = _sg_gl_buffer_target(buf->cmn.type);
     GLuint gl_buf = buf->gl.buf[buf->cmn.active_slot];
     SOKOL_ASSERT(gl_buf);
     _SG_GL_CHECK_ERROR();
@@ -7423,6 +11337,10 @@ _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_data* d
     const GLenum gl_img_type = _sg_gl_teximage_type(img->cmn.pixel_format);
     const int num_faces = img->cmn.type == SG_IMAGETYPE_CUBE ? 6 : 1;
     const int num_mips = img->cmn.num_mipmaps;
+    #if defined(_SOKOL_GL_PBO_UPLOAD)
+    GLintptr pbo_offsets[SG_CUBEFACE_NUM][SG_MAX_MIPMAPS];
+    const bool pbo = _sg_gl_begin_upload(img, data, pbo_offsets);
+    #endif
     for (int face_index = 0; face_index < num_faces; face_index++) {
         for (int mip_index = 0; mip_index < num_mips; mip_index++) {
             GLenum gl_img_target = img->gl.target;
@@ -7430,6 +11348,11 @@ _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_data* d
                 gl_img_target = _sg_gl_cubeface_target(face_index);
             }
             const GLvoid* data_ptr = data->subimage[face_index][mip_index].ptr;
+            #if defined(_SOKOL_GL_PBO_UPLOAD)
+            if (pbo) {
+                data_ptr = (const GLvoid*) pbo_offsets[face_index][mip_index];
+            }
+            #endif
             int mip_width = img->cmn.width >> mip_index;
             if (mip_width == 0) {
                 mip_width = 1;
@@ -7461,7 +11384,50 @@ _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_data* d
             #endif
         }
     }
+    #if defined(_SOKOL_GL_PBO_UPLOAD)
+    if (pbo) {
+        _sg_gl_end_upload(img);
+    }
+    #endif
+    _sg_gl_cache_restore_texture_binding(0);
+}
+
+_SOKOL_PRIVATE void _sg_gl_update_image_region(_sg_image_t* img, const sg_image_region* region, const sg_range* data) {
+    SOKOL_ASSERT(img && region && data && data->ptr);
+    /* region updates go into the active texture without cycling slots,
+       the driver orders them with draw calls which still use the texture
+    */
+    SOKOL_ASSERT(0 != img->gl.tex[img->cmn.active_slot]);
+    _SG_GL_CHECK_ERROR();
+    _sg_gl_cache_store_texture_binding(0);
+    _sg_gl_cache_bind_texture(0, img->gl.target, img->gl.tex[img->cmn.active_slot]);
+    const GLenum gl_img_format = _sg_gl_teximage_format(img->cmn.pixel_format);
+    const GLenum gl_img_type = _sg_gl_teximage_type(img->cmn.pixel_format);
+    /* region rows are tightly packed, and may have any width */
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if ((SG_IMAGETYPE_2D == img->cmn.type) || (SG_IMAGETYPE_CUBE == img->cmn.type)) {
+        GLenum gl_img_target = img->gl.target;
+        if (SG_IMAGETYPE_CUBE == img->cmn.type) {
+            gl_img_target = _sg_gl_cubeface_target(region->slice);
+        }
+        glTexSubImage2D(gl_img_target, region->mip_level,
+            region->x, region->y,
+            region->width, region->height,
+            gl_img_format, gl_img_type,
+            data->ptr);
+    }
+    #if !defined(SOKOL_GLES2)
+    else if (!_sg.gl.gles2 && ((SG_IMAGETYPE_3D == img->cmn.type) || (SG_IMAGETYPE_ARRAY == img->cmn.type))) {
+        glTexSubImage3D(img->gl.target, region->mip_level,
+            region->x, region->y, region->slice,
+            region->width, region->height, 1,
+            gl_img_format, gl_img_type,
+            data->ptr);
+    }
+    #endif
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     _sg_gl_cache_restore_texture_binding(0);
+    _SG_GL_CHECK_ERROR();
 }
 
 /*== D3D11 BACKEND IMPLEMENTATION ============================================*/
@@ -8121,6 +12087,8 @@ _SOKOL_PRIVATE void _sg_d3d11_init_caps(void) {
     _sg.features.image_clamp_to_border = true;
     _sg.features.mrt_independent_blend_state = true;
     _sg.features.mrt_independent_write_mask = true;
+    _sg.features.base_vertex = true;
+    _sg.features.sampler_objects = true;
 
     _sg.limits.max_image_size_2d = 16 * 1024;
     _sg.limits.max_image_size_cube = 16 * 1024;
@@ -8955,6 +12923,50 @@ _SOKOL_PRIVATE void _sg_d3d11_destroy_pass(_sg_pass_t* pass) {
     }
 }
 
+_SOKOL_PRIVATE sg_resource_state _sg_d3d11_create_sampler(_sg_sampler_t* smp, const sg_sampler_desc* desc) {
+    SOKOL_ASSERT(smp && desc);
+    SOKOL_ASSERT(_sg.d3d11.dev);
+    SOKOL_ASSERT(0 == smp->d3d11.smp);
+    _sg_sampler_common_init(&smp->cmn, desc);
+    D3D11_SAMPLER_DESC d3d11_smp_desc;
+    memset(&d3d11_smp_desc, 0, sizeof(d3d11_smp_desc));
+    d3d11_smp_desc.Filter = _sg_d3d11_filter(smp->cmn.min_filter, smp->cmn.mag_filter, smp->cmn.max_anisotropy);
+    d3d11_smp_desc.AddressU = _sg_d3d11_address_mode(smp->cmn.wrap_u);
+    d3d11_smp_desc.AddressV = _sg_d3d11_address_mode(smp->cmn.wrap_v);
+    d3d11_smp_desc.AddressW = _sg_d3d11_address_mode(smp->cmn.wrap_w);
+    switch (smp->cmn.border_color) {
+        case SG_BORDERCOLOR_TRANSPARENT_BLACK:
+            /* all 0.0f */
+            break;
+        case SG_BORDERCOLOR_OPAQUE_WHITE:
+            for (int i = 0; i < 4; i++) {
+                d3d11_smp_desc.BorderColor[i] = 1.0f;
+            }
+            break;
+        default:
+            /* opaque black */
+            d3d11_smp_desc.BorderColor[3] = 1.0f;
+            break;
+    }
+    d3d11_smp_desc.MaxAnisotropy = smp->cmn.max_anisotropy;
+    d3d11_smp_desc.ComparisonFunc = D3D11_COMPARISON_NEVER;
+    d3d11_smp_desc.MinLOD = smp->cmn.min_lod;
+    d3d11_smp_desc.MaxLOD = smp->cmn.max_lod;
+    HRESULT hr = _sg_d3d11_CreateSamplerState(_sg.d3d11.dev, &d3d11_smp_desc, &smp->d3d11.smp);
+    if (!(SUCCEEDED(hr) && smp->d3d11.smp)) {
+        SOKOL_LOG("failed to create D3D11 sampler state\n");
+        return SG_RESOURCESTATE_FAILED;
+    }
+    return SG_RESOURCESTATE_VALID;
+}
+
+_SOKOL_PRIVATE void _sg_d3d11_destroy_sampler(_sg_sampler_t* smp) {
+    SOKOL_ASSERT(smp);
+    if (smp->d3d11.smp) {
+        _sg_d3d11_Release(smp->d3d11.smp);
+    }
+}
+
 _SOKOL_PRIVATE _sg_image_t* _sg_d3d11_pass_color_image(const _sg_pass_t* pass, int index) {
     SOKOL_ASSERT(pass && (index >= 0) && (index < SG_MAX_COLOR_ATTACHMENTS));
     /* NOTE: may return null */
@@ -8975,6 +12987,9 @@ _SOKOL_PRIVATE void _sg_d3d11_begin_pass(_sg_pass_t* pass, const sg_pass_action*
     _sg.d3d11.in_pass = true;
     _sg.d3d11.cur_width = w;
     _sg.d3d11.cur_height = h;
+    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+        _sg.d3d11.cur_store_actions[i] = action->colors[i].store_action;
+    }
     if (pass) {
         _sg.d3d11.cur_pass = pass;
         _sg.d3d11.cur_pass_id.id = pass->slot.id;
@@ -9060,7 +13075,8 @@ _SOKOL_PRIVATE void _sg_d3d11_end_pass(void) {
             _sg_pass_attachment_t* cmn_att = &_sg.d3d11.cur_pass->cmn.color_atts[i];
             _sg_image_t* att_img = _sg.d3d11.cur_pass->d3d11.color_atts[i].image;
             SOKOL_ASSERT(att_img && (att_img->slot.id == cmn_att->image_id.id));
-            if (att_img->cmn.sample_count > 1) {
+            const bool skip_resolve = att_img->cmn.transient || (SG_STOREACTION_DONTCARE == _sg.d3d11.cur_store_actions[i]);
+            if ((att_img->cmn.sample_count > 1) && !skip_resolve) {
                 /* FIXME: support MSAA resolve into 3D texture */
                 SOKOL_ASSERT(att_img->d3d11.tex2d && att_img->d3d11.texmsaa && !att_img->d3d11.tex3d);
                 SOKOL_ASSERT(DXGI_FORMAT_UNKNOWN != att_img->d3d11.format);
@@ -9135,8 +13151,8 @@ _SOKOL_PRIVATE void _sg_d3d11_apply_bindings(
     _sg_pipeline_t* pip,
     _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
     _sg_buffer_t* ib, int ib_offset,
-    _sg_image_t** vs_imgs, int num_vs_imgs,
-    _sg_image_t** fs_imgs, int num_fs_imgs)
+    _sg_image_t** vs_imgs, _sg_sampler_t** vs_smps, int num_vs_imgs,
+    _sg_image_t** fs_imgs, _sg_sampler_t** fs_smps, int num_fs_imgs)
 {
     SOKOL_ASSERT(pip);
     SOKOL_ASSERT(_sg.d3d11.ctx);
@@ -9164,7 +13180,7 @@ _SOKOL_PRIVATE void _sg_d3d11_apply_bindings(
         SOKOL_ASSERT(vs_imgs[i]->d3d11.srv);
         SOKOL_ASSERT(vs_imgs[i]->d3d11.smp);
         d3d11_vs_srvs[i] = vs_imgs[i]->d3d11.srv;
-        d3d11_vs_smps[i] = vs_imgs[i]->d3d11.smp;
+        d3d11_vs_smps[i] = vs_smps[i] ? vs_smps[i]->d3d11.smp : vs_imgs[i]->d3d11.smp;
     }
     for (; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
         d3d11_vs_srvs[i] = 0;
@@ -9174,7 +13190,7 @@ _SOKOL_PRIVATE void _sg_d3d11_apply_bindings(
         SOKOL_ASSERT(fs_imgs[i]->d3d11.srv);
         SOKOL_ASSERT(fs_imgs[i]->d3d11.smp);
         d3d11_fs_srvs[i] = fs_imgs[i]->d3d11.srv;
-        d3d11_fs_smps[i] = fs_imgs[i]->d3d11.smp;
+        d3d11_fs_smps[i] = fs_smps[i] ? fs_smps[i]->d3d11.smp : fs_imgs[i]->d3d11.smp;
     }
     for (; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
         d3d11_fs_srvs[i] = 0;
@@ -9200,22 +13216,22 @@ _SOKOL_PRIVATE void _sg_d3d11_apply_uniforms(sg_shader_stage stage_index, int ub
     _sg_d3d11_UpdateSubresource(_sg.d3d11.ctx, (ID3D11Resource*)cb, 0, NULL, data->ptr, 0, 0);
 }
 
-_SOKOL_PRIVATE void _sg_d3d11_draw(int base_element, int num_elements, int num_instances) {
+_SOKOL_PRIVATE void _sg_d3d11_draw(int base_element, int num_elements, int num_instances, int base_vertex) {
     SOKOL_ASSERT(_sg.d3d11.in_pass);
     if (_sg.d3d11.use_indexed_draw) {
         if (1 == num_instances) {
-            _sg_d3d11_DrawIndexed(_sg.d3d11.ctx, (UINT)num_elements, (UINT)base_element, 0);
+            _sg_d3d11_DrawIndexed(_sg.d3d11.ctx, (UINT)num_elements, (UINT)base_element, (INT)base_vertex);
         }
         else {
-            _sg_d3d11_DrawIndexedInstanced(_sg.d3d11.ctx, (UINT)num_elements, (UINT)num_instances, (UINT)base_element, 0, 0);
+            _sg_d3d11_DrawIndexedInstanced(_sg.d3d11.ctx, (UINT)num_elements, (UINT)num_instances, (UINT)base_element, (INT)base_vertex, 0);
         }
     }
     else {
         if (1 == num_instances) {
-            _sg_d3d11_Draw(_sg.d3d11.ctx, (UINT)num_elements, (UINT)base_element);
+            _sg_d3d11_Draw(_sg.d3d11.ctx, (UINT)num_elements, (UINT)(base_element + base_vertex));
         }
         else {
-            _sg_d3d11_DrawInstanced(_sg.d3d11.ctx, (UINT)num_elements, (UINT)num_instances, (UINT)base_element, 0);
+            _sg_d3d11_DrawInstanced(_sg.d3d11.ctx, (UINT)num_elements, (UINT)num_instances, (UINT)(base_element + base_vertex), 0);
         }
     }
 }
@@ -9326,6 +13342,31 @@ _SOKOL_PRIVATE MTLLoadAction _sg_mtl_load_action(sg_action a) {
     }
 }
 
+/* has_resolve is false for non-MSAA attachments, and for transient MSAA
+   attachments which don't have a resolve texture
+*/
+_SOKOL_PRIVATE MTLStoreAction _sg_mtl_store_action(sg_store_action a, bool transient, bool has_resolve) {
+    switch (a) {
+        case SG_STOREACTION_STORE:
+            if (has_resolve) {
+                return MTLStoreActionStoreAndMultisampleResolve;
+            }
+            else {
+                return transient ? MTLStoreActionDontCare : MTLStoreActionStore;
+            }
+        case SG_STOREACTION_RESOLVE:
+            if (has_resolve) {
+                return MTLStoreActionMultisampleResolve;
+            }
+            else {
+                return transient ? MTLStoreActionDontCare : MTLStoreActionStore;
+            }
+        case SG_STOREACTION_DONTCARE:
+            return MTLStoreActionDontCare;
+        default: SOKOL_UNREACHABLE; return (MTLStoreAction)0;
+    }
+}
+
 _SOKOL_PRIVATE MTLResourceOptions _sg_mtl_buffer_resource_options(sg_usage usg) {
     switch (usg) {
         case SG_USAGE_IMMUTABLE:
@@ -9649,7 +13690,8 @@ _SOKOL_PRIVATE void _sg_mtl_init_pool(const sg_desc* desc) {
             5 * desc->image_pool_size +
             4 * desc->shader_pool_size +
             2 * desc->pipeline_pool_size +
-            desc->pass_pool_size
+            desc->pass_pool_size +
+            desc->sampler_pool_size
         );
     _sg.mtl.idpool.pool = [NSMutableArray arrayWithCapacity:(NSUInteger)_sg.mtl.idpool.num_slots];
     _SG_OBJC_RETAIN(_sg.mtl.idpool.pool);
@@ -9684,8 +13726,50 @@ _SOKOL_PRIVATE void _sg_mtl_destroy_pool(void) {
     _SG_OBJC_RELEASE(_sg.mtl.idpool.pool);
 }
 
+/* double the size of an exhausted id pool, this happens when growable
+   resource pools have outgrown the initial pool size estimate
+*/
+_SOKOL_PRIVATE void _sg_mtl_grow_pool(void) {
+    SOKOL_ASSERT(0 == _sg.mtl.idpool.free_queue_top);
+    const int old_num_slots = _sg.mtl.idpool.num_slots;
+    const int new_num_slots = 2 * old_num_slots;
+    NSNull* null = [NSNull null];
+    for (int i = old_num_slots; i < new_num_slots; i++) {
+        [_sg.mtl.idpool.pool addObject:null];
+    }
+    SOKOL_ASSERT([_sg.mtl.idpool.pool count] == (NSUInteger)new_num_slots);
+    /* the free queue is empty, so no need to copy its content */
+    SOKOL_FREE(_sg.mtl.idpool.free_queue);
+    _sg.mtl.idpool.free_queue = (int*)SOKOL_MALLOC((size_t)new_num_slots * sizeof(int));
+    for (int i = new_num_slots-1; i >= old_num_slots; i--) {
+        _sg.mtl.idpool.free_queue[_sg.mtl.idpool.free_queue_top++] = i;
+    }
+    /* unwrap the pending items of the circular release queue into the new queue */
+    _sg_mtl_release_item_t* release_queue = (_sg_mtl_release_item_t*)SOKOL_MALLOC((size_t)new_num_slots * sizeof(_sg_mtl_release_item_t));
+    int num_items = 0;
+    int back = _sg.mtl.idpool.release_queue_back;
+    while (back != _sg.mtl.idpool.release_queue_front) {
+        release_queue[num_items++] = _sg.mtl.idpool.release_queue[back++];
+        if (back >= old_num_slots) {
+            back = 0;
+        }
+    }
+    for (int i = num_items; i < new_num_slots; i++) {
+        release_queue[i].frame_index = 0;
+        release_queue[i].slot_index = _SG_MTL_INVALID_SLOT_INDEX;
+    }
+    SOKOL_FREE(_sg.mtl.idpool.release_queue);
+    _sg.mtl.idpool.release_queue = release_queue;
+    _sg.mtl.idpool.release_queue_back = 0;
+    _sg.mtl.idpool.release_queue_front = num_items;
+    _sg.mtl.idpool.num_slots = new_num_slots;
+}
+
 /* get a new free resource pool slot */
 _SOKOL_PRIVATE int _sg_mtl_alloc_pool_slot(void) {
+    if (0 == _sg.mtl.idpool.free_queue_top) {
+        _sg_mtl_grow_pool();
+    }
     SOKOL_ASSERT(_sg.mtl.idpool.free_queue_top > 0);
     const int slot_index = _sg.mtl.idpool.free_queue[--_sg.mtl.idpool.free_queue_top];
     SOKOL_ASSERT((slot_index > 0) && (slot_index < _sg.mtl.idpool.num_slots));
@@ -9782,7 +13866,7 @@ _SOKOL_PRIVATE void _sg_mtl_destroy_sampler_cache(uint32_t frame_index) {
     create and add an MTLSamplerStateObject and return its resource pool index,
     reuse identical sampler state if one exists
 */
-_SOKOL_PRIVATE int _sg_mtl_create_sampler(id<MTLDevice> mtl_device, const sg_image_desc* img_desc) {
+_SOKOL_PRIVATE int _sg_mtl_create_image_sampler(id<MTLDevice> mtl_device, const sg_image_desc* img_desc) {
     SOKOL_ASSERT(img_desc);
     int index = _sg_smpcache_find_item(&_sg.mtl.sampler_cache, img_desc);
     if (index >= 0) {
@@ -9843,6 +13927,13 @@ _SOKOL_PRIVATE void _sg_mtl_init_caps(void) {
     #endif
     _sg.features.mrt_independent_blend_state = true;
     _sg.features.mrt_independent_write_mask = true;
+    #if defined(_SG_TARGET_MACOS)
+        _sg.features.base_vertex = true;
+    #else
+        _sg.features.base_vertex = [_sg.mtl.device supportsFeatureSet:MTLFeatureSet_iOS_GPUFamily3_v1];
+    #endif
+    _sg.features.sampler_objects = true;
+    _sg.features.image_region_update = true;
 
     #if defined(_SG_TARGET_MACOS)
         _sg.limits.max_image_size_2d = 16 * 1024;
@@ -9978,6 +14069,7 @@ _SOKOL_PRIVATE void _sg_mtl_setup_backend(const sg_desc* desc) {
     _sg.mtl.user_data = desc->context.metal.user_data;
     _sg.mtl.frame_index = 1;
     _sg.mtl.ub_size = desc->uniform_buffer_size;
+    _sg.mtl.ub_chaining = desc->uniform_buffer_chaining;
     _sg.mtl.sem = dispatch_semaphore_create(SG_NUM_INFLIGHT_FRAMES);
     _sg.mtl.device = (__bridge id<MTLDevice>) desc->context.metal.device;
     _sg.mtl.cmd_queue = [_sg.mtl.device newCommandQueue];
@@ -10014,24 +14106,76 @@ _SOKOL_PRIVATE void _sg_mtl_discard_backend(void) {
     _SG_OBJC_RELEASE(_sg.mtl.cmd_queue);
     for (int i = 0; i < SG_NUM_INFLIGHT_FRAMES; i++) {
         _SG_OBJC_RELEASE(_sg.mtl.uniform_buffers[i]);
+        for (int chain_index = 0; chain_index < _SG_MTL_MAX_UB_CHAIN; chain_index++) {
+            if (nil != _sg.mtl.chained_uniform_buffers[i][chain_index]) {
+                _SG_OBJC_RELEASE(_sg.mtl.chained_uniform_buffers[i][chain_index]);
+            }
+        }
     }
     /* NOTE: MTLCommandBuffer and MTLRenderCommandEncoder are auto-released */
     _sg.mtl.cmd_buffer = nil;
     _sg.mtl.cmd_encoder = nil;
 }
 
+/* the uniform buffer which is currently written to, this is either the
+   frame's main uniform buffer, or one of the chained uniform buffers
+   when the main uniform buffer has been exhausted
+*/
+_SOKOL_PRIVATE id<MTLBuffer> _sg_mtl_cur_uniform_buffer(void) {
+    const uint32_t rot = _sg.mtl.cur_frame_rotate_index;
+    if (0 == _sg.mtl.cur_ub_chain_index) {
+        return _sg.mtl.uniform_buffers[rot];
+    }
+    else {
+        return _sg.mtl.chained_uniform_buffers[rot][_sg.mtl.cur_ub_chain_index - 1];
+    }
+}
+
 _SOKOL_PRIVATE void _sg_mtl_bind_uniform_buffers(void) {
     SOKOL_ASSERT(nil != _sg.mtl.cmd_encoder);
+    id<MTLBuffer> mtl_ub = _sg_mtl_cur_uniform_buffer();
     for (int slot = 0; slot < SG_MAX_SHADERSTAGE_UBS; slot++) {
         [_sg.mtl.cmd_encoder
-            setVertexBuffer:_sg.mtl.uniform_buffers[_sg.mtl.cur_frame_rotate_index]
+            setVertexBuffer:mtl_ub
             offset:0
             atIndex:(NSUInteger)slot];
         [_sg.mtl.cmd_encoder
-            setFragmentBuffer:_sg.mtl.uniform_buffers[_sg.mtl.cur_frame_rotate_index]
+            setFragmentBuffer:mtl_ub
             offset:0
             atIndex:(NSUInteger)slot];
+        _sg.mtl.ub_bound_chain_index[SG_SHADERSTAGE_VS][slot] = _sg.mtl.cur_ub_chain_index;
+        _sg.mtl.ub_bound_chain_index[SG_SHADERSTAGE_FS][slot] = _sg.mtl.cur_ub_chain_index;
+    }
+}
+
+/* continue in the next chained uniform buffer when the current uniform
+   buffer is exhausted, the chained buffers are created on demand and
+   reused in later frames, returns false if uniform buffer chaining
+   is disabled or the chain is full
+*/
+_SOKOL_PRIVATE bool _sg_mtl_chain_uniform_buffer(void) {
+    if (!_sg.mtl.ub_chaining || (_sg.mtl.cur_ub_chain_index >= _SG_MTL_MAX_UB_CHAIN)) {
+        return false;
+    }
+    #if defined(_SG_TARGET_MACOS)
+    [_sg_mtl_cur_uniform_buffer() didModifyRange:NSMakeRange(0, (NSUInteger)_sg.mtl.cur_ub_offset)];
+    #endif
+    const uint32_t rot = _sg.mtl.cur_frame_rotate_index;
+    const int chain_index = _sg.mtl.cur_ub_chain_index;
+    if (nil == _sg.mtl.chained_uniform_buffers[rot][chain_index]) {
+        MTLResourceOptions res_opts = MTLResourceCPUCacheModeWriteCombined;
+        #if defined(_SG_TARGET_MACOS)
+        res_opts |= MTLResourceStorageModeManaged;
+        #endif
+        _sg.mtl.chained_uniform_buffers[rot][chain_index] = [_sg.mtl.device
+            newBufferWithLength:(NSUInteger)_sg.mtl.ub_size
+            options:res_opts
+        ];
     }
+    _sg.mtl.cur_ub_chain_index++;
+    _sg.mtl.cur_ub_offset = 0;
+    _sg.mtl.cur_ub_base_ptr = (uint8_t*)[_sg_mtl_cur_uniform_buffer() contents];
+    return true;
 }
 
 _SOKOL_PRIVATE void _sg_mtl_reset_state_cache(void) {
@@ -10190,10 +14334,20 @@ _SOKOL_PRIVATE bool _sg_mtl_init_texdesc_common(MTLTextureDescriptor* mtl_desc,
     return true;
 }
 
+/* transient render targets only live in tile memory on iOS devices */
+_SOKOL_PRIVATE void _sg_mtl_init_texdesc_transient(MTLTextureDescriptor* mtl_desc, _sg_image_t* img) {
+    SOKOL_ASSERT(img->cmn.transient);
+    _SOKOL_UNUSED(img);
+    mtl_desc.usage = MTLTextureUsageRenderTarget;
+    #if defined(_SG_TARGET_IOS) && !defined(_SG_TARGET_IOS_SIMULATOR)
+    mtl_desc.resourceOptions = MTLResourceStorageModeMemoryless;
+    mtl_desc.storageMode = MTLStorageModeMemoryless;
+    #endif
+}
+
 /* initialize MTLTextureDescritor with rendertarget attributes */
 _SOKOL_PRIVATE void _sg_mtl_init_texdesc_rt(MTLTextureDescriptor* mtl_desc, _sg_image_t* img) {
     SOKOL_ASSERT(img->cmn.render_target);
-    _SOKOL_UNUSED(img);
     /* reset the cpuCacheMode to 'default' */
     mtl_desc.cpuCacheMode = MTLCPUCacheModeDefaultCache;
     /* render targets are only visible to the GPU */
@@ -10201,6 +14355,9 @@ _SOKOL_PRIVATE void _sg_mtl_init_texdesc_rt(MTLTextureDescriptor* mtl_desc, _sg_
     mtl_desc.storageMode = MTLStorageModePrivate;
     /* non-MSAA render targets are shader-readable */
     mtl_desc.usage = MTLTextureUsageShaderRead | MTLTextureUsageRenderTarget;
+    if (img->cmn.transient) {
+        _sg_mtl_init_texdesc_transient(mtl_desc, img);
+    }
 }
 
 /* initialize MTLTextureDescritor with MSAA attributes */
@@ -10218,6 +14375,9 @@ _SOKOL_PRIVATE void _sg_mtl_init_texdesc_rt_msaa(MTLTextureDescriptor* mtl_desc,
     mtl_desc.arrayLength = 1;
     mtl_desc.mipmapLevelCount = 1;
     mtl_desc.sampleCount = (NSUInteger)img->cmn.sample_count;
+    if (img->cmn.transient) {
+        _sg_mtl_init_texdesc_transient(mtl_desc, img);
+    }
 }
 
 _SOKOL_PRIVATE sg_resource_state _sg_mtl_create_image(_sg_image_t* img, const sg_image_desc* desc) {
@@ -10270,7 +14430,9 @@ _SOKOL_PRIVATE sg_resource_state _sg_mtl_create_image(_sg_image_t* img, const sg
         if (img->cmn.render_target && !msaa) {
             _sg_mtl_init_texdesc_rt(mtl_desc, img);
         }
-        for (int slot = 0; slot < img->cmn.num_slots; slot++) {
+        /* transient MSAA render targets are never resolved, so they don't need a resolve texture */
+        const int num_slots = (img->cmn.transient && msaa) ? 0 : img->cmn.num_slots;
+        for (int slot = 0; slot < num_slots; slot++) {
             id<MTLTexture> tex;
             if (injected) {
                 SOKOL_ASSERT(desc->mtl_textures[slot]);
@@ -10293,7 +14455,7 @@ _SOKOL_PRIVATE sg_resource_state _sg_mtl_create_image(_sg_image_t* img, const sg
         }
 
         /* create (possibly shared) sampler state */
-        img->mtl.sampler_state = _sg_mtl_create_sampler(_sg.mtl.device, desc);
+        img->mtl.sampler_state = _sg_mtl_create_image_sampler(_sg.mtl.device, desc);
     }
     _SG_OBJC_RELEASE(mtl_desc);
     return SG_RESOURCESTATE_VALID;
@@ -10550,8 +14712,42 @@ _SOKOL_PRIVATE void _sg_mtl_destroy_pass(_sg_pass_t* pass) {
     _SOKOL_UNUSED(pass);
 }
 
-_SOKOL_PRIVATE _sg_image_t* _sg_mtl_pass_color_image(const _sg_pass_t* pass, int index) {
-    SOKOL_ASSERT(pass && (index >= 0) && (index < SG_MAX_COLOR_ATTACHMENTS));
+/* sampler objects are owned by their sg_sampler and bypass the image sampler cache */
+_SOKOL_PRIVATE sg_resource_state _sg_mtl_create_sampler(_sg_sampler_t* smp, const sg_sampler_desc* desc) {
+    SOKOL_ASSERT(smp && desc);
+    _sg_sampler_common_init(&smp->cmn, desc);
+    MTLSamplerDescriptor* mtl_desc = [[MTLSamplerDescriptor alloc] init];
+    mtl_desc.sAddressMode = _sg_mtl_address_mode(smp->cmn.wrap_u);
+    mtl_desc.tAddressMode = _sg_mtl_address_mode(smp->cmn.wrap_v);
+    mtl_desc.rAddressMode = _sg_mtl_address_mode(smp->cmn.wrap_w);
+    #if defined(_SG_TARGET_MACOS)
+        mtl_desc.borderColor = _sg_mtl_border_color(smp->cmn.border_color);
+    #endif
+    mtl_desc.minFilter = _sg_mtl_minmag_filter(smp->cmn.min_filter);
+    mtl_desc.magFilter = _sg_mtl_minmag_filter(smp->cmn.mag_filter);
+    mtl_desc.mipFilter = _sg_mtl_mip_filter(smp->cmn.min_filter);
+    mtl_desc.lodMinClamp = smp->cmn.min_lod;
+    mtl_desc.lodMaxClamp = smp->cmn.max_lod;
+    mtl_desc.maxAnisotropy = smp->cmn.max_anisotropy;
+    mtl_desc.normalizedCoordinates = YES;
+    id<MTLSamplerState> mtl_sampler = [_sg.mtl.device newSamplerStateWithDescriptor:mtl_desc];
+    _SG_OBJC_RELEASE(mtl_desc);
+    if (nil == mtl_sampler) {
+        SOKOL_LOG("failed to create Metal sampler state\n");
+        return SG_RESOURCESTATE_FAILED;
+    }
+    smp->mtl.sampler_state = _sg_mtl_add_resource(mtl_sampler);
+    return SG_RESOURCESTATE_VALID;
+}
+
+_SOKOL_PRIVATE void _sg_mtl_destroy_sampler(_sg_sampler_t* smp) {
+    SOKOL_ASSERT(smp);
+    /* it's valid to call release resource with a 'null resource' */
+    _sg_mtl_release_resource(_sg.mtl.frame_index, smp->mtl.sampler_state);
+}
+
+_SOKOL_PRIVATE _sg_image_t* _sg_mtl_pass_color_image(const _sg_pass_t* pass, int index) {
+    SOKOL_ASSERT(pass && (index >= 0) && (index < SG_MAX_COLOR_ATTACHMENTS));
     /* NOTE: may return null */
     return pass->mtl.color_atts[index].image;
 }
@@ -10587,7 +14783,7 @@ _SOKOL_PRIVATE void _sg_mtl_begin_pass(_sg_pass_t* pass, const sg_pass_action* a
 
     /* if this is first pass in frame, get uniform buffer base pointer */
     if (0 == _sg.mtl.cur_ub_base_ptr) {
-        _sg.mtl.cur_ub_base_ptr = (uint8_t*)[_sg.mtl.uniform_buffers[_sg.mtl.cur_frame_rotate_index] contents];
+        _sg.mtl.cur_ub_base_ptr = (uint8_t*)[_sg_mtl_cur_uniform_buffer() contents];
     }
 
     /* initialize a render pass descriptor */
@@ -10625,25 +14821,28 @@ _SOKOL_PRIVATE void _sg_mtl_begin_pass(_sg_pass_t* pass, const sg_pass_action* a
             SOKOL_ASSERT(att_img->slot.state == SG_RESOURCESTATE_VALID);
             SOKOL_ASSERT(att_img->slot.id == cmn_att->image_id.id);
             const bool is_msaa = (att_img->cmn.sample_count > 1);
+            const bool has_resolve = is_msaa && !att_img->cmn.transient;
             pass_desc.colorAttachments[i].loadAction = _sg_mtl_load_action(action->colors[i].action);
-            pass_desc.colorAttachments[i].storeAction = is_msaa ? MTLStoreActionMultisampleResolve : MTLStoreActionStore;
+            pass_desc.colorAttachments[i].storeAction = _sg_mtl_store_action(action->colors[i].store_action, att_img->cmn.transient, has_resolve);
             sg_color c = action->colors[i].value;
             pass_desc.colorAttachments[i].clearColor = MTLClearColorMake(c.r, c.g, c.b, c.a);
             if (is_msaa) {
                 SOKOL_ASSERT(att_img->mtl.msaa_tex != _SG_MTL_INVALID_SLOT_INDEX);
-                SOKOL_ASSERT(att_img->mtl.tex[mtl_att->image->cmn.active_slot] != _SG_MTL_INVALID_SLOT_INDEX);
                 pass_desc.colorAttachments[i].texture = _sg_mtl_id(att_img->mtl.msaa_tex);
-                pass_desc.colorAttachments[i].resolveTexture = _sg_mtl_id(att_img->mtl.tex[att_img->cmn.active_slot]);
-                pass_desc.colorAttachments[i].resolveLevel = (NSUInteger)cmn_att->mip_level;
-                switch (att_img->cmn.type) {
-                    case SG_IMAGETYPE_CUBE:
-                    case SG_IMAGETYPE_ARRAY:
-                        pass_desc.colorAttachments[i].resolveSlice = (NSUInteger)cmn_att->slice;
-                        break;
-                    case SG_IMAGETYPE_3D:
-                        pass_desc.colorAttachments[i].resolveDepthPlane = (NSUInteger)cmn_att->slice;
-                        break;
-                    default: break;
+                if (has_resolve) {
+                    SOKOL_ASSERT(att_img->mtl.tex[mtl_att->image->cmn.active_slot] != _SG_MTL_INVALID_SLOT_INDEX);
+                    pass_desc.colorAttachments[i].resolveTexture = _sg_mtl_id(att_img->mtl.tex[att_img->cmn.active_slot]);
+                    pass_desc.colorAttachments[i].resolveLevel = (NSUInteger)cmn_att->mip_level;
+                    switch (att_img->cmn.type) {
+                        case SG_IMAGETYPE_CUBE:
+                        case SG_IMAGETYPE_ARRAY:
+                            pass_desc.colorAttachments[i].resolveSlice = (NSUInteger)cmn_att->slice;
+                            break;
+                        case SG_IMAGETYPE_3D:
+                            pass_desc.colorAttachments[i].resolveDepthPlane = (NSUInteger)cmn_att->slice;
+                            break;
+                        default: break;
+                    }
                 }
             }
             else {
@@ -10669,10 +14868,12 @@ _SOKOL_PRIVATE void _sg_mtl_begin_pass(_sg_pass_t* pass, const sg_pass_action* a
             SOKOL_ASSERT(ds_att_img->mtl.depth_tex != _SG_MTL_INVALID_SLOT_INDEX);
             pass_desc.depthAttachment.texture = _sg_mtl_id(ds_att_img->mtl.depth_tex);
             pass_desc.depthAttachment.loadAction = _sg_mtl_load_action(action->depth.action);
+            pass_desc.depthAttachment.storeAction = _sg_mtl_store_action(action->depth.store_action, ds_att_img->cmn.transient, false);
             pass_desc.depthAttachment.clearDepth = action->depth.value;
             if (_sg_is_depth_stencil_format(ds_att_img->cmn.pixel_format)) {
                 pass_desc.stencilAttachment.texture = _sg_mtl_id(ds_att_img->mtl.depth_tex);
                 pass_desc.stencilAttachment.loadAction = _sg_mtl_load_action(action->stencil.action);
+                pass_desc.stencilAttachment.storeAction = _sg_mtl_store_action(action->stencil.store_action, ds_att_img->cmn.transient, false);
                 pass_desc.stencilAttachment.clearStencil = action->stencil.value;
             }
         }
@@ -10686,6 +14887,17 @@ _SOKOL_PRIVATE void _sg_mtl_begin_pass(_sg_pass_t* pass, const sg_pass_action* a
         pass_desc.depthAttachment.clearDepth = action->depth.value;
         pass_desc.stencilAttachment.loadAction = _sg_mtl_load_action(action->stencil.action);
         pass_desc.stencilAttachment.clearStencil = action->stencil.value;
+        /* only override the store actions of the default pass descriptor for DONTCARE,
+           otherwise keep what has been configured by the view (e.g. MSAA resolve) */
+        if (SG_STOREACTION_DONTCARE == action->colors[0].store_action) {
+            pass_desc.colorAttachments[0].storeAction = MTLStoreActionDontCare;
+        }
+        if (SG_STOREACTION_DONTCARE == action->depth.store_action) {
+            pass_desc.depthAttachment.storeAction = MTLStoreActionDontCare;
+        }
+        if (SG_STOREACTION_DONTCARE == action->stencil.store_action) {
+            pass_desc.stencilAttachment.storeAction = MTLStoreActionDontCare;
+        }
     }
 
     /* create a render command encoder, this might return nil if window is minimized */
@@ -10718,8 +14930,10 @@ _SOKOL_PRIVATE void _sg_mtl_commit(void) {
     SOKOL_ASSERT(nil != _sg.mtl.cmd_buffer);
 
     #if defined(_SG_TARGET_MACOS)
-    [_sg.mtl.uniform_buffers[_sg.mtl.cur_frame_rotate_index] didModifyRange:NSMakeRange(0, (NSUInteger)_sg.mtl.cur_ub_offset)];
+    [_sg_mtl_cur_uniform_buffer() didModifyRange:NSMakeRange(0, (NSUInteger)_sg.mtl.cur_ub_offset)];
     #endif
+    _sg.stats.cur.size_uniform_buffer = (size_t)(_sg.mtl.cur_ub_chain_index * _sg.mtl.ub_size + _sg.mtl.cur_ub_offset);
+    _sg.stats.cur.num_uniform_buffer_chains = _sg.mtl.cur_ub_chain_index;
 
     /* present, commit and signal semaphore when done */
     id<MTLDrawable> cur_drawable = nil;
@@ -10744,6 +14958,7 @@ _SOKOL_PRIVATE void _sg_mtl_commit(void) {
     _sg.mtl.frame_index++;
     _sg.mtl.cur_ub_offset = 0;
     _sg.mtl.cur_ub_base_ptr = 0;
+    _sg.mtl.cur_ub_chain_index = 0;
     /* NOTE: MTLCommandBuffer is autoreleased */
     _sg.mtl.cmd_buffer = nil;
 }
@@ -10819,8 +15034,8 @@ _SOKOL_PRIVATE void _sg_mtl_apply_bindings(
     _sg_pipeline_t* pip,
     _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
     _sg_buffer_t* ib, int ib_offset,
-    _sg_image_t** vs_imgs, int num_vs_imgs,
-    _sg_image_t** fs_imgs, int num_fs_imgs)
+    _sg_image_t** vs_imgs, _sg_sampler_t** vs_smps, int num_vs_imgs,
+    _sg_image_t** fs_imgs, _sg_sampler_t** fs_smps, int num_fs_imgs)
 {
     _SOKOL_UNUSED(pip);
     SOKOL_ASSERT(_sg.mtl.in_pass);
@@ -10868,8 +15083,13 @@ _SOKOL_PRIVATE void _sg_mtl_apply_bindings(
             _sg.mtl.state_cache.cur_vs_image_ids[slot].id = img->slot.id;
             SOKOL_ASSERT(img->mtl.tex[img->cmn.active_slot] != _SG_MTL_INVALID_SLOT_INDEX);
             [_sg.mtl.cmd_encoder setVertexTexture:_sg_mtl_id(img->mtl.tex[img->cmn.active_slot]) atIndex:slot];
-            SOKOL_ASSERT(img->mtl.sampler_state != _SG_MTL_INVALID_SLOT_INDEX);
-            [_sg.mtl.cmd_encoder setVertexSamplerState:_sg_mtl_id(img->mtl.sampler_state) atIndex:slot];
+        }
+        /* a bound sampler object overrides the image's sampler state */
+        const int sampler_state = vs_smps[slot] ? vs_smps[slot]->mtl.sampler_state : img->mtl.sampler_state;
+        SOKOL_ASSERT(sampler_state != _SG_MTL_INVALID_SLOT_INDEX);
+        if (_sg.mtl.state_cache.cur_vs_sampler_states[slot] != sampler_state) {
+            _sg.mtl.state_cache.cur_vs_sampler_states[slot] = sampler_state;
+            [_sg.mtl.cmd_encoder setVertexSamplerState:_sg_mtl_id(sampler_state) atIndex:slot];
         }
     }
 
@@ -10881,8 +15101,13 @@ _SOKOL_PRIVATE void _sg_mtl_apply_bindings(
             _sg.mtl.state_cache.cur_fs_image_ids[slot].id = img->slot.id;
             SOKOL_ASSERT(img->mtl.tex[img->cmn.active_slot] != _SG_MTL_INVALID_SLOT_INDEX);
             [_sg.mtl.cmd_encoder setFragmentTexture:_sg_mtl_id(img->mtl.tex[img->cmn.active_slot]) atIndex:slot];
-            SOKOL_ASSERT(img->mtl.sampler_state != _SG_MTL_INVALID_SLOT_INDEX);
-            [_sg.mtl.cmd_encoder setFragmentSamplerState:_sg_mtl_id(img->mtl.sampler_state) atIndex:slot];
+        }
+        /* a bound sampler object overrides the image's sampler state */
+        const int sampler_state = fs_smps[slot] ? fs_smps[slot]->mtl.sampler_state : img->mtl.sampler_state;
+        SOKOL_ASSERT(sampler_state != _SG_MTL_INVALID_SLOT_INDEX);
+        if (_sg.mtl.state_cache.cur_fs_sampler_states[slot] != sampler_state) {
+            _sg.mtl.state_cache.cur_fs_sampler_states[slot] = sampler_state;
+            [_sg.mtl.cmd_encoder setFragmentSamplerState:_sg_mtl_id(sampler_state) atIndex:slot];
         }
     }
 }
@@ -10893,7 +15118,16 @@ _SOKOL_PRIVATE void _sg_mtl_apply_uniforms(sg_shader_stage stage_index, int ub_i
         return;
     }
     SOKOL_ASSERT(nil != _sg.mtl.cmd_encoder);
-    SOKOL_ASSERT(((size_t)_sg.mtl.cur_ub_offset + data->size) <= (size_t)_sg.mtl.ub_size);
+    if (((size_t)_sg.mtl.cur_ub_offset + data->size) > (size_t)_sg.mtl.ub_size) {
+        if ((data->size > (size_t)_sg.mtl.ub_size) || !_sg_mtl_chain_uniform_buffer()) {
+            /* only log the first dropped call in a frame */
+            if (0 == _sg.stats.cur.num_uniform_buffer_overflows) {
+                SOKOL_LOG("_sg_mtl_apply_uniforms: uniform buffer exhausted (increase sg_desc.uniform_buffer_size or set sg_desc.uniform_buffer_chaining)");
+            }
+            _sg.stats.cur.num_uniform_buffer_overflows++;
+            return;
+        }
+    }
     SOKOL_ASSERT((_sg.mtl.cur_ub_offset & (_SG_MTL_UB_ALIGN-1)) == 0);
     SOKOL_ASSERT(_sg.mtl.state_cache.cur_pipeline && _sg.mtl.state_cache.cur_pipeline->shader);
     SOKOL_ASSERT(_sg.mtl.state_cache.cur_pipeline->slot.id == _sg.mtl.state_cache.cur_pipeline_id.id);
@@ -10904,7 +15138,18 @@ _SOKOL_PRIVATE void _sg_mtl_apply_uniforms(sg_shader_stage stage_index, int ub_i
     /* copy to global uniform buffer, record offset into cmd encoder, and advance offset */
     uint8_t* dst = &_sg.mtl.cur_ub_base_ptr[_sg.mtl.cur_ub_offset];
     memcpy(dst, data->ptr, data->size);
-    if (stage_index == SG_SHADERSTAGE_VS) {
+    if (_sg.mtl.ub_bound_chain_index[stage_index][ub_index] != _sg.mtl.cur_ub_chain_index) {
+        /* a new uniform buffer in the chain has been started since this slot was bound */
+        id<MTLBuffer> mtl_ub = _sg_mtl_cur_uniform_buffer();
+        if (stage_index == SG_SHADERSTAGE_VS) {
+            [_sg.mtl.cmd_encoder setVertexBuffer:mtl_ub offset:(NSUInteger)_sg.mtl.cur_ub_offset atIndex:(NSUInteger)ub_index];
+        }
+        else {
+            [_sg.mtl.cmd_encoder setFragmentBuffer:mtl_ub offset:(NSUInteger)_sg.mtl.cur_ub_offset atIndex:(NSUInteger)ub_index];
+        }
+        _sg.mtl.ub_bound_chain_index[stage_index][ub_index] = _sg.mtl.cur_ub_chain_index;
+    }
+    else if (stage_index == SG_SHADERSTAGE_VS) {
         [_sg.mtl.cmd_encoder setVertexBufferOffset:(NSUInteger)_sg.mtl.cur_ub_offset atIndex:(NSUInteger)ub_index];
     }
     else {
@@ -10913,7 +15158,7 @@ _SOKOL_PRIVATE void _sg_mtl_apply_uniforms(sg_shader_stage stage_index, int ub_i
     _sg.mtl.cur_ub_offset = _sg_roundup(_sg.mtl.cur_ub_offset + (int)data->size, _SG_MTL_UB_ALIGN);
 }
 
-_SOKOL_PRIVATE void _sg_mtl_draw(int base_element, int num_elements, int num_instances) {
+_SOKOL_PRIVATE void _sg_mtl_draw(int base_element, int num_elements, int num_instances, int base_vertex) {
     SOKOL_ASSERT(_sg.mtl.in_pass);
     if (!_sg.mtl.pass_valid) {
         return;
@@ -10926,17 +15171,30 @@ _SOKOL_PRIVATE void _sg_mtl_draw(int base_element, int num_elements, int num_ins
         const _sg_buffer_t* ib = _sg.mtl.state_cache.cur_indexbuffer;
         SOKOL_ASSERT(ib->mtl.buf[ib->cmn.active_slot] != _SG_MTL_INVALID_SLOT_INDEX);
         const NSUInteger index_buffer_offset = (NSUInteger) (_sg.mtl.state_cache.cur_indexbuffer_offset + base_element * _sg.mtl.state_cache.cur_pipeline->mtl.index_size);
-        [_sg.mtl.cmd_encoder drawIndexedPrimitives:_sg.mtl.state_cache.cur_pipeline->mtl.prim_type
-            indexCount:(NSUInteger)num_elements
-            indexType:_sg.mtl.state_cache.cur_pipeline->mtl.index_type
-            indexBuffer:_sg_mtl_id(ib->mtl.buf[ib->cmn.active_slot])
-            indexBufferOffset:index_buffer_offset
-            instanceCount:(NSUInteger)num_instances];
+        if (0 == base_vertex) {
+            [_sg.mtl.cmd_encoder drawIndexedPrimitives:_sg.mtl.state_cache.cur_pipeline->mtl.prim_type
+                indexCount:(NSUInteger)num_elements
+                indexType:_sg.mtl.state_cache.cur_pipeline->mtl.index_type
+                indexBuffer:_sg_mtl_id(ib->mtl.buf[ib->cmn.active_slot])
+                indexBufferOffset:index_buffer_offset
+                instanceCount:(NSUInteger)num_instances];
+        }
+        else {
+            /* requires macOS 10.11 or iOS GPU family 3 (see sg_features.base_vertex) */
+            [_sg.mtl.cmd_encoder drawIndexedPrimitives:_sg.mtl.state_cache.cur_pipeline->mtl.prim_type
+                indexCount:(NSUInteger)num_elements
+                indexType:_sg.mtl.state_cache.cur_pipeline->mtl.index_type
+                indexBuffer:_sg_mtl_id(ib->mtl.buf[ib->cmn.active_slot])
+                indexBufferOffset:index_buffer_offset
+                instanceCount:(NSUInteger)num_instances
+                baseVertex:(NSInteger)base_vertex
+                baseInstance:0];
+        }
     }
     else {
         /* non-indexed rendering */
         [_sg.mtl.cmd_encoder drawPrimitives:_sg.mtl.state_cache.cur_pipeline->mtl.prim_type
-            vertexStart:(NSUInteger)base_element
+            vertexStart:(NSUInteger)(base_element + base_vertex)
             vertexCount:(NSUInteger)num_elements
             instanceCount:(NSUInteger)num_instances];
     }
@@ -10982,6 +15240,29 @@ _SOKOL_PRIVATE void _sg_mtl_update_image(_sg_image_t* img, const sg_image_data*
     _sg_mtl_copy_image_data(img, mtl_tex, data);
 }
 
+_SOKOL_PRIVATE void _sg_mtl_update_image_region(_sg_image_t* img, const sg_image_region* region, const sg_range* data) {
+    SOKOL_ASSERT(img && region && data && data->ptr);
+    /* written into the active texture without cycling slots, see sg_update_image_region() */
+    __unsafe_unretained id<MTLTexture> mtl_tex = _sg_mtl_id(img->mtl.tex[img->cmn.active_slot]);
+    const int bytes_per_row = _sg_row_pitch(img->cmn.pixel_format, region->width, 1);
+    const int bytes_per_image = _sg_surface_pitch(img->cmn.pixel_format, region->width, region->height, 1);
+    MTLRegion mtl_region;
+    NSUInteger mtl_slice_index = 0;
+    if (img->cmn.type == SG_IMAGETYPE_3D) {
+        mtl_region = MTLRegionMake3D((NSUInteger)region->x, (NSUInteger)region->y, (NSUInteger)region->slice, (NSUInteger)region->width, (NSUInteger)region->height, 1);
+    }
+    else {
+        mtl_region = MTLRegionMake2D((NSUInteger)region->x, (NSUInteger)region->y, (NSUInteger)region->width, (NSUInteger)region->height);
+        mtl_slice_index = (NSUInteger)region->slice;
+    }
+    [mtl_tex replaceRegion:mtl_region
+        mipmapLevel:(NSUInteger)region->mip_level
+        slice:mtl_slice_index
+        withBytes:data->ptr
+        bytesPerRow:(NSUInteger)bytes_per_row
+        bytesPerImage:(NSUInteger)bytes_per_image];
+}
+
 /*== WEBGPU BACKEND IMPLEMENTATION ===========================================*/
 #elif defined(SOKOL_WGPU)
 
@@ -11012,6 +15293,22 @@ _SOKOL_PRIVATE WGPULoadOp _sg_wgpu_load_op(sg_action a) {
     }
 }
 
+/* NOTE: WGPUStoreOp_Clear discards the attachment content, the MSAA resolve
+   happens independently from the store-op if a resolve target is provided
+*/
+_SOKOL_PRIVATE WGPUStoreOp _sg_wgpu_store_op(sg_store_action a, bool transient) {
+    switch (a) {
+        case SG_STOREACTION_STORE:
+            return transient ? WGPUStoreOp_Clear : WGPUStoreOp_Store;
+        case SG_STOREACTION_RESOLVE:
+        case SG_STOREACTION_DONTCARE:
+            return WGPUStoreOp_Clear;
+        default:
+            SOKOL_UNREACHABLE;
+            return (WGPUStoreOp)0;
+    }
+}
+
 _SOKOL_PRIVATE WGPUTextureViewDimension _sg_wgpu_tex_viewdim(sg_image_type t) {
     switch (t) {
         case SG_IMAGETYPE_2D:       return WGPUTextureViewDimension_2D;
@@ -11315,6 +15612,9 @@ _SOKOL_PRIVATE void _sg_wgpu_init_caps(void) {
     _sg.features.image_clamp_to_border = false;
     _sg.features.mrt_independent_blend_state = true;
     _sg.features.mrt_independent_write_mask = true;
+    _sg.features.base_vertex = true;
+    _sg.features.sampler_objects = true;
+    _sg.features.image_region_update = true;
 
     /* FIXME: max images size??? */
     _sg.limits.max_image_size_2d = 8 * 1024;
@@ -11765,6 +16065,58 @@ _SOKOL_PRIVATE bool _sg_wgpu_staging_copy_to_texture(_sg_image_t* img, const sg_
     return true;
 }
 
+_SOKOL_PRIVATE bool _sg_wgpu_staging_copy_to_texture_region(_sg_image_t* img, const sg_image_region* region, const sg_range* data) {
+    /* like _sg_wgpu_staging_copy_to_texture(), but for a single region in one mipmap and slice */
+    SOKOL_ASSERT(_sg.wgpu.staging_cmd_enc);
+    const sg_pixel_format fmt = img->cmn.pixel_format;
+    const uint32_t num_rows = (uint32_t)_sg_num_rows(fmt, region->height);
+    const uint32_t src_bytes_per_row = (uint32_t)_sg_row_pitch(fmt, region->width, 1);
+    const uint32_t dst_bytes_per_row = (uint32_t)_sg_row_pitch(fmt, region->width, _SG_WGPU_ROWPITCH_ALIGN);
+    const uint32_t num_bytes = dst_bytes_per_row * num_rows;
+    if ((_sg.wgpu.staging.offset + num_bytes) >= _sg.wgpu.staging.num_bytes) {
+        SOKOL_LOG("WGPU: Per frame staging buffer full (in _sg_wgpu_staging_copy_to_texture_region)!\n");
+        return false;
+    }
+    SOKOL_ASSERT(data->size == (size_t)(src_bytes_per_row * num_rows));
+    const int cur = _sg.wgpu.staging.cur;
+    SOKOL_ASSERT(_sg.wgpu.staging.ptr[cur]);
+    const uint32_t stg_offset = _sg.wgpu.staging.offset;
+    uint8_t* dst_ptr = _sg.wgpu.staging.ptr[cur] + stg_offset;
+    const uint8_t* src_ptr = (const uint8_t*) data->ptr;
+    for (uint32_t row_index = 0; row_index < num_rows; row_index++) {
+        memcpy(dst_ptr, src_ptr, src_bytes_per_row);
+        src_ptr += src_bytes_per_row;
+        dst_ptr += dst_bytes_per_row;
+    }
+
+    WGPUBufferCopyView src_view;
+    memset(&src_view, 0, sizeof(src_view));
+    src_view.buffer = _sg.wgpu.staging.buf[cur];
+    src_view.offset = stg_offset;
+    src_view.rowPitch = dst_bytes_per_row;
+    src_view.imageHeight = (uint32_t)region->height;
+    WGPUTextureCopyView dst_view;
+    memset(&dst_view, 0, sizeof(dst_view));
+    dst_view.texture = img->wgpu.tex;
+    dst_view.mipLevel = (uint32_t)region->mip_level;
+    dst_view.origin.x = (uint32_t)region->x;
+    dst_view.origin.y = (uint32_t)region->y;
+    if (img->cmn.type == SG_IMAGETYPE_3D) {
+        dst_view.origin.z = (uint32_t)region->slice;
+    }
+    else {
+        dst_view.arrayLayer = (uint32_t)region->slice;
+    }
+    WGPUExtent3D extent;
+    memset(&extent, 0, sizeof(extent));
+    extent.width = (uint32_t)region->width;
+    extent.height = (uint32_t)region->height;
+    extent.depth = 1;
+    wgpuCommandEncoderCopyBufferToTexture(_sg.wgpu.staging_cmd_enc, &src_view, &dst_view, &extent);
+    _sg.wgpu.staging.offset = _sg_roundup(stg_offset + num_bytes, _SG_WGPU_STAGING_ALIGN);
+    return true;
+}
+
 _SOKOL_PRIVATE void _sg_wgpu_staging_unmap(void) {
     /* called at end of frame before queue-submit */
     const int cur = _sg.wgpu.staging.cur;
@@ -11788,7 +16140,7 @@ _SOKOL_PRIVATE void _sg_wgpu_destroy_sampler_cache(void) {
     _sg_smpcache_discard(&_sg.wgpu.sampler_cache);
 }
 
-_SOKOL_PRIVATE WGPUSampler _sg_wgpu_create_sampler(const sg_image_desc* img_desc) {
+_SOKOL_PRIVATE WGPUSampler _sg_wgpu_create_image_sampler(const sg_image_desc* img_desc) {
     SOKOL_ASSERT(img_desc);
     int index = _sg_smpcache_find_item(&_sg.wgpu.sampler_cache, img_desc);
     if (index >= 0) {
@@ -12043,7 +16395,7 @@ _SOKOL_PRIVATE sg_resource_state _sg_wgpu_create_image(_sg_image_t* img, const s
         }
 
         /* create sampler via shared-sampler-cache */
-        img->wgpu.sampler = _sg_wgpu_create_sampler(desc);
+        img->wgpu.sampler = _sg_wgpu_create_image_sampler(desc);
         SOKOL_ASSERT(img->wgpu.sampler);
     }
     return SG_RESOURCESTATE_VALID;
@@ -12374,6 +16726,37 @@ _SOKOL_PRIVATE void _sg_wgpu_destroy_pass(_sg_pass_t* pass) {
     }
 }
 
+/* sampler objects are owned by their sg_sampler and bypass the image sampler cache */
+_SOKOL_PRIVATE sg_resource_state _sg_wgpu_create_sampler(_sg_sampler_t* smp, const sg_sampler_desc* desc) {
+    SOKOL_ASSERT(smp && desc);
+    SOKOL_ASSERT(_sg.wgpu.dev);
+    _sg_sampler_common_init(&smp->cmn, desc);
+    WGPUSamplerDescriptor smp_desc;
+    memset(&smp_desc, 0, sizeof(smp_desc));
+    smp_desc.addressModeU = _sg_wgpu_sampler_addrmode(smp->cmn.wrap_u);
+    smp_desc.addressModeV = _sg_wgpu_sampler_addrmode(smp->cmn.wrap_v);
+    smp_desc.addressModeW = _sg_wgpu_sampler_addrmode(smp->cmn.wrap_w);
+    smp_desc.magFilter = _sg_wgpu_sampler_minmagfilter(smp->cmn.mag_filter);
+    smp_desc.minFilter = _sg_wgpu_sampler_minmagfilter(smp->cmn.min_filter);
+    smp_desc.mipmapFilter = _sg_wgpu_sampler_mipfilter(smp->cmn.min_filter);
+    smp_desc.lodMinClamp = smp->cmn.min_lod;
+    smp_desc.lodMaxClamp = smp->cmn.max_lod;
+    smp->wgpu.sampler = wgpuDeviceCreateSampler(_sg.wgpu.dev, &smp_desc);
+    if (0 == smp->wgpu.sampler) {
+        SOKOL_LOG("failed to create WGPU sampler object\n");
+        return SG_RESOURCESTATE_FAILED;
+    }
+    return SG_RESOURCESTATE_VALID;
+}
+
+_SOKOL_PRIVATE void _sg_wgpu_destroy_sampler(_sg_sampler_t* smp) {
+    SOKOL_ASSERT(smp);
+    if (smp->wgpu.sampler) {
+        wgpuSamplerRelease(smp->wgpu.sampler);
+        smp->wgpu.sampler = 0;
+    }
+}
+
 _SOKOL_PRIVATE _sg_image_t* _sg_wgpu_pass_color_image(const _sg_pass_t* pass, int index) {
     SOKOL_ASSERT(pass && (index >= 0) && (index < SG_MAX_COLOR_ATTACHMENTS));
     /* NOTE: may return null */
@@ -12409,14 +16792,20 @@ _SOKOL_PRIVATE void _sg_wgpu_begin_pass(_sg_pass_t* pass, const sg_pass_action*
         SOKOL_ASSERT(pass->slot.state == SG_RESOURCESTATE_VALID);
         for (uint32_t i = 0; i < pass->cmn.num_color_atts; i++) {
             const _sg_wgpu_attachment_t* wgpu_att = &pass->wgpu.color_atts[i];
+            const bool is_msaa = wgpu_att->image->cmn.sample_count > 1;
+            sg_store_action store_action = action->colors[i].store_action;
+            if (!is_msaa && (SG_STOREACTION_RESOLVE == store_action)) {
+                /* nothing to resolve, keep the content */
+                store_action = SG_STOREACTION_STORE;
+            }
             wgpu_color_att_desc[i].loadOp = _sg_wgpu_load_op(action->colors[i].action);
-            wgpu_color_att_desc[i].storeOp = WGPUStoreOp_Store;
+            wgpu_color_att_desc[i].storeOp = _sg_wgpu_store_op(store_action, wgpu_att->image->cmn.transient);
             wgpu_color_att_desc[i].clearColor.r = action->colors[i].value.r;
             wgpu_color_att_desc[i].clearColor.g = action->colors[i].value.g;
             wgpu_color_att_desc[i].clearColor.b = action->colors[i].value.b;
             wgpu_color_att_desc[i].clearColor.a = action->colors[i].value.a;
             wgpu_color_att_desc[i].attachment = wgpu_att->render_tex_view;
-            if (wgpu_att->image->cmn.sample_count > 1) {
+            if (is_msaa && !wgpu_att->image->cmn.transient && (SG_STOREACTION_DONTCARE != store_action)) {
                 wgpu_color_att_desc[i].resolveTarget = wgpu_att->resolve_tex_view;
             }
         }
@@ -12425,9 +16814,12 @@ _SOKOL_PRIVATE void _sg_wgpu_begin_pass(_sg_pass_t* pass, const sg_pass_action*
         if (pass->wgpu.ds_att.image) {
             WGPURenderPassDepthStencilAttachmentDescriptor wgpu_ds_att_desc;
             memset(&wgpu_ds_att_desc, 0, sizeof(wgpu_ds_att_desc));
+            const bool ds_transient = pass->wgpu.ds_att.image->cmn.transient;
             wgpu_ds_att_desc.depthLoadOp = _sg_wgpu_load_op(action->depth.action);
+            wgpu_ds_att_desc.depthStoreOp = _sg_wgpu_store_op(action->depth.store_action, ds_transient);
             wgpu_ds_att_desc.clearDepth = action->depth.value;
             wgpu_ds_att_desc.stencilLoadOp = _sg_wgpu_load_op(action->stencil.action);
+            wgpu_ds_att_desc.stencilStoreOp = _sg_wgpu_store_op(action->stencil.store_action, ds_transient);
             wgpu_ds_att_desc.clearStencil = action->stencil.value;
             wgpu_ds_att_desc.attachment = pass->wgpu.ds_att.render_tex_view;
             wgpu_pass_desc.depthStencilAttachment = &wgpu_ds_att_desc;
@@ -12445,6 +16837,7 @@ _SOKOL_PRIVATE void _sg_wgpu_begin_pass(_sg_pass_t* pass, const sg_pass_action*
         WGPURenderPassColorAttachmentDescriptor color_att_desc;
         memset(&color_att_desc, 0, sizeof(color_att_desc));
         color_att_desc.loadOp = _sg_wgpu_load_op(action->colors[0].action);
+        color_att_desc.storeOp = (SG_STOREACTION_DONTCARE == action->colors[0].store_action) ? WGPUStoreOp_Clear : WGPUStoreOp_Store;
         color_att_desc.clearColor.r = action->colors[0].value.r;
         color_att_desc.clearColor.g = action->colors[0].value.g;
         color_att_desc.clearColor.b = action->colors[0].value.b;
@@ -12458,8 +16851,10 @@ _SOKOL_PRIVATE void _sg_wgpu_begin_pass(_sg_pass_t* pass, const sg_pass_action*
         ds_att_desc.attachment = wgpu_depth_stencil_view;
         SOKOL_ASSERT(0 != ds_att_desc.attachment);
         ds_att_desc.depthLoadOp = _sg_wgpu_load_op(action->depth.action);
+        ds_att_desc.depthStoreOp = _sg_wgpu_store_op(action->depth.store_action, false);
         ds_att_desc.clearDepth = action->depth.value;
         ds_att_desc.stencilLoadOp = _sg_wgpu_load_op(action->stencil.action);
+        ds_att_desc.stencilStoreOp = _sg_wgpu_store_op(action->stencil.store_action, false);
         ds_att_desc.clearStencil = action->stencil.value;
         pass_desc.depthStencilAttachment = &ds_att_desc;
         _sg.wgpu.pass_enc = wgpuCommandEncoderBeginRenderPass(_sg.wgpu.render_cmd_enc, &pass_desc);
@@ -12489,7 +16884,10 @@ _SOKOL_PRIVATE void _sg_wgpu_commit(void) {
     SOKOL_ASSERT(_sg.wgpu.render_cmd_enc);
     SOKOL_ASSERT(_sg.wgpu.staging_cmd_enc);
 
-    /* finish and submit this frame's work */
+    /* finish and submit this frame's work, the uniform buffer isn't chained
+       on WebGPU (overflowing applies are dropped), so its offset covers the whole frame
+    */
+    _sg.stats.cur.size_uniform_buffer = (size_t)_sg.wgpu.ub.offset;
     _sg_wgpu_ubpool_flush();
     _sg_wgpu_staging_unmap();
 
@@ -12571,7 +16969,7 @@ _SOKOL_PRIVATE void _sg_wgpu_apply_pipeline(_sg_pipeline_t* pip) {
     wgpuRenderPassEncoderSetStencilReference(_sg.wgpu.pass_enc, pip->wgpu.stencil_ref);
 }
 
-_SOKOL_PRIVATE WGPUBindGroup _sg_wgpu_create_images_bindgroup(WGPUBindGroupLayout bgl, _sg_image_t** imgs, int num_imgs) {
+_SOKOL_PRIVATE WGPUBindGroup _sg_wgpu_create_images_bindgroup(WGPUBindGroupLayout bgl, _sg_image_t** imgs, _sg_sampler_t** smps, int num_imgs) {
     SOKOL_ASSERT(_sg.wgpu.dev);
     SOKOL_ASSERT(num_imgs <= _SG_WGPU_MAX_SHADERSTAGE_IMAGES);
     WGPUBindGroupBinding img_bgb[_SG_WGPU_MAX_SHADERSTAGE_IMAGES * 2];
@@ -12582,7 +16980,7 @@ _SOKOL_PRIVATE WGPUBindGroup _sg_wgpu_create_images_bindgroup(WGPUBindGroupLayou
         tex_bdg->binding = img_index;
         tex_bdg->textureView = imgs[img_index]->wgpu.tex_view;
         smp_bdg->binding = img_index + _SG_WGPU_MAX_SHADERSTAGE_IMAGES;
-        smp_bdg->sampler = imgs[img_index]->wgpu.sampler;
+        smp_bdg->sampler = smps[img_index] ? smps[img_index]->wgpu.sampler : imgs[img_index]->wgpu.sampler;
     }
     WGPUBindGroupDescriptor bg_desc;
     memset(&bg_desc, 0, sizeof(bg_desc));
@@ -12598,8 +16996,8 @@ _SOKOL_PRIVATE void _sg_wgpu_apply_bindings(
     _sg_pipeline_t* pip,
     _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
     _sg_buffer_t* ib, int ib_offset,
-    _sg_image_t** vs_imgs, int num_vs_imgs,
-    _sg_image_t** fs_imgs, int num_fs_imgs)
+    _sg_image_t** vs_imgs, _sg_sampler_t** vs_smps, int num_vs_imgs,
+    _sg_image_t** fs_imgs, _sg_sampler_t** fs_smps, int num_fs_imgs)
 {
     SOKOL_ASSERT(_sg.wgpu.in_pass);
     SOKOL_ASSERT(_sg.wgpu.pass_enc);
@@ -12622,7 +17020,7 @@ _SOKOL_PRIVATE void _sg_wgpu_apply_bindings(
         }
         WGPUBindGroupLayout vs_bgl = pip->shader->wgpu.stage[SG_SHADERSTAGE_VS].bind_group_layout;
         SOKOL_ASSERT(vs_bgl);
-        WGPUBindGroup vs_img_bg = _sg_wgpu_create_images_bindgroup(vs_bgl, vs_imgs, num_vs_imgs);
+        WGPUBindGroup vs_img_bg = _sg_wgpu_create_images_bindgroup(vs_bgl, vs_imgs, vs_smps, num_vs_imgs);
         wgpuRenderPassEncoderSetBindGroup(_sg.wgpu.pass_enc, 1, vs_img_bg, 0, 0);
         wgpuBindGroupRelease(vs_img_bg);
     }
@@ -12635,7 +17033,7 @@ _SOKOL_PRIVATE void _sg_wgpu_apply_bindings(
         }
         WGPUBindGroupLayout fs_bgl = pip->shader->wgpu.stage[SG_SHADERSTAGE_FS].bind_group_layout;
         SOKOL_ASSERT(fs_bgl);
-        WGPUBindGroup fs_img_bg = _sg_wgpu_create_images_bindgroup(fs_bgl, fs_imgs, num_fs_imgs);
+        WGPUBindGroup fs_img_bg = _sg_wgpu_create_images_bindgroup(fs_bgl, fs_imgs, fs_smps, num_fs_imgs);
         wgpuRenderPassEncoderSetBindGroup(_sg.wgpu.pass_enc, 2, fs_img_bg, 0, 0);
         wgpuBindGroupRelease(fs_img_bg);
     }
@@ -12647,7 +17045,14 @@ _SOKOL_PRIVATE void _sg_wgpu_apply_bindings(
 _SOKOL_PRIVATE void _sg_wgpu_apply_uniforms(sg_shader_stage stage_index, int ub_index, const sg_range* data) {
     SOKOL_ASSERT(_sg.wgpu.in_pass);
     SOKOL_ASSERT(_sg.wgpu.pass_enc);
-    SOKOL_ASSERT((_sg.wgpu.ub.offset + data->size) <= _sg.wgpu.ub.num_bytes);
+    if ((_sg.wgpu.ub.offset + data->size) > _sg.wgpu.ub.num_bytes) {
+        /* only log the first dropped call in a frame */
+        if (0 == _sg.stats.cur.num_uniform_buffer_overflows) {
+            SOKOL_LOG("_sg_wgpu_apply_uniforms: uniform buffer exhausted (increase sg_desc.uniform_buffer_size)");
+        }
+        _sg.stats.cur.num_uniform_buffer_overflows++;
+        return;
+    }
     SOKOL_ASSERT((_sg.wgpu.ub.offset & (_SG_WGPU_STAGING_ALIGN-1)) == 0);
     SOKOL_ASSERT(_sg.wgpu.cur_pipeline && _sg.wgpu.cur_pipeline->shader);
     SOKOL_ASSERT(_sg.wgpu.cur_pipeline->slot.id == _sg.wgpu.cur_pipeline_id.id);
@@ -12668,14 +17073,14 @@ _SOKOL_PRIVATE void _sg_wgpu_apply_uniforms(sg_shader_stage stage_index, int ub_
     _sg.wgpu.ub.offset = _sg_roundup(_sg.wgpu.ub.offset + data->size, _SG_WGPU_STAGING_ALIGN);
 }
 
-_SOKOL_PRIVATE void _sg_wgpu_draw(int base_element, int num_elements, int num_instances) {
+_SOKOL_PRIVATE void _sg_wgpu_draw(int base_element, int num_elements, int num_instances, int base_vertex) {
     SOKOL_ASSERT(_sg.wgpu.in_pass);
     SOKOL_ASSERT(_sg.wgpu.pass_enc);
     if (_sg.wgpu.draw_indexed) {
-        wgpuRenderPassEncoderDrawIndexed(_sg.wgpu.pass_enc, num_elements, num_instances, base_element, 0, 0);
+        wgpuRenderPassEncoderDrawIndexed(_sg.wgpu.pass_enc, num_elements, num_instances, base_element, base_vertex, 0);
     }
     else {
-        wgpuRenderPassEncoderDraw(_sg.wgpu.pass_enc, num_elements, num_instances, base_element, 0);
+        wgpuRenderPassEncoderDraw(_sg.wgpu.pass_enc, num_elements, num_instances, base_element + base_vertex, 0);
     }
 }
 
@@ -12699,6 +17104,13 @@ _SOKOL_PRIVATE void _sg_wgpu_update_image(_sg_image_t* img, const sg_image_data*
     SOKOL_ASSERT(success);
     _SOKOL_UNUSED(success);
 }
+
+_SOKOL_PRIVATE void _sg_wgpu_update_image_region(_sg_image_t* img, const sg_image_region* region, const sg_range* data) {
+    SOKOL_ASSERT(img && region && data);
+    bool success = _sg_wgpu_staging_copy_to_texture_region(img, region, data);
+    SOKOL_ASSERT(success);
+    _SOKOL_UNUSED(success);
+}
 #endif
 
 /*== BACKEND API WRAPPERS ====================================================*/
@@ -12862,6 +17274,68 @@ static inline void _sg_destroy_image(_sg_image_t* img) {
     #endif
 }
 
+/* batched resource creation and destruction hooks, backends may use those
+   to coalesce work over a batch of resources (currently only the GL backend
+   does this by generating and deleting GL object names in one go)
+*/
+static inline void _sg_begin_make_buffers(const sg_buffer_desc* descs, int count) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_begin_make_buffers(descs, count);
+    #else
+    _SOKOL_UNUSED(descs);
+    _SOKOL_UNUSED(count);
+    #endif
+}
+
+static inline void _sg_end_make_buffers(void) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_end_make_buffers();
+    #endif
+}
+
+static inline void _sg_begin_make_images(const sg_image_desc* descs, int count) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_begin_make_images(descs, count);
+    #else
+    _SOKOL_UNUSED(descs);
+    _SOKOL_UNUSED(count);
+    #endif
+}
+
+static inline void _sg_end_make_images(void) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_end_make_images();
+    #endif
+}
+
+static inline void _sg_begin_destroy_buffers(int count) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_begin_destroy_buffers(count);
+    #else
+    _SOKOL_UNUSED(count);
+    #endif
+}
+
+static inline void _sg_end_destroy_buffers(void) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_end_destroy_buffers();
+    #endif
+}
+
+static inline void _sg_begin_destroy_images(int count) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_begin_destroy_images(count);
+    #else
+    _SOKOL_UNUSED(count);
+    #endif
+}
+
+static inline void _sg_end_destroy_images(void) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_end_destroy_images();
+    #endif
+}
+
 static inline sg_resource_state _sg_create_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
     #if defined(_SOKOL_ANY_GL)
     return _sg_gl_create_shader(shd, desc);
@@ -12958,6 +17432,38 @@ static inline void _sg_destroy_pass(_sg_pass_t* pass) {
     #endif
 }
 
+static inline sg_resource_state _sg_create_sampler(_sg_sampler_t* smp, const sg_sampler_desc* desc) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_create_sampler(smp, desc);
+    #elif defined(SOKOL_METAL)
+    return _sg_mtl_create_sampler(smp, desc);
+    #elif defined(SOKOL_D3D11)
+    return _sg_d3d11_create_sampler(smp, desc);
+    #elif defined(SOKOL_WGPU)
+    return _sg_wgpu_create_sampler(smp, desc);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_create_sampler(smp, desc);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_destroy_sampler(_sg_sampler_t* smp) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_destroy_sampler(smp);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_destroy_sampler(smp);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_destroy_sampler(smp);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_destroy_sampler(smp);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_destroy_sampler(smp);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
 static inline _sg_image_t* _sg_pass_color_image(const _sg_pass_t* pass, int index) {
     #if defined(_SOKOL_ANY_GL)
     return _sg_gl_pass_color_image(pass, index);
@@ -13074,19 +17580,19 @@ static inline void _sg_apply_bindings(
     _sg_pipeline_t* pip,
     _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
     _sg_buffer_t* ib, int ib_offset,
-    _sg_image_t** vs_imgs, int num_vs_imgs,
-    _sg_image_t** fs_imgs, int num_fs_imgs)
+    _sg_image_t** vs_imgs, _sg_sampler_t** vs_smps, int num_vs_imgs,
+    _sg_image_t** fs_imgs, _sg_sampler_t** fs_smps, int num_fs_imgs)
 {
     #if defined(_SOKOL_ANY_GL)
-    _sg_gl_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
+    _sg_gl_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, vs_smps, num_vs_imgs, fs_imgs, fs_smps, num_fs_imgs);
     #elif defined(SOKOL_METAL)
-    _sg_mtl_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
+    _sg_mtl_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, vs_smps, num_vs_imgs, fs_imgs, fs_smps, num_fs_imgs);
     #elif defined(SOKOL_D3D11)
-    _sg_d3d11_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
+    _sg_d3d11_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, vs_smps, num_vs_imgs, fs_imgs, fs_smps, num_fs_imgs);
     #elif defined(SOKOL_WGPU)
-    _sg_wgpu_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
+    _sg_wgpu_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, vs_smps, num_vs_imgs, fs_imgs, fs_smps, num_fs_imgs);
     #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
+    _sg_dummy_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, vs_smps, num_vs_imgs, fs_imgs, fs_smps, num_fs_imgs);
     #else
     #error("INVALID BACKEND");
     #endif
@@ -13108,22 +17614,90 @@ static inline void _sg_apply_uniforms(sg_shader_stage stage_index, int ub_index,
     #endif
 }
 
-static inline void _sg_draw(int base_element, int num_elements, int num_instances) {
+static inline void _sg_draw(int base_element, int num_elements, int num_instances, int base_vertex) {
     #if defined(_SOKOL_ANY_GL)
-    _sg_gl_draw(base_element, num_elements, num_instances);
+    _sg_gl_draw(base_element, num_elements, num_instances, base_vertex);
     #elif defined(SOKOL_METAL)
-    _sg_mtl_draw(base_element, num_elements, num_instances);
+    _sg_mtl_draw(base_element, num_elements, num_instances, base_vertex);
     #elif defined(SOKOL_D3D11)
-    _sg_d3d11_draw(base_element, num_elements, num_instances);
+    _sg_d3d11_draw(base_element, num_elements, num_instances, base_vertex);
     #elif defined(SOKOL_WGPU)
-    _sg_wgpu_draw(base_element, num_elements, num_instances);
+    _sg_wgpu_draw(base_element, num_elements, num_instances, base_vertex);
     #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_draw(base_element, num_elements, num_instances);
+    _sg_dummy_draw(base_element, num_elements, num_instances, base_vertex);
     #else
     #error("INVALID BACKEND");
     #endif
 }
 
+/* only the GL backend has a native batch path, all other backends issue separate draw calls */
+static inline void _sg_draw_batch(const sg_draw_range* ranges, int count) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_draw_batch(ranges, count);
+    #else
+    for (int i = 0; i < count; i++) {
+        if (ranges[i].num_elements > 0) {
+            _sg_draw(ranges[i].base_element, ranges[i].num_elements, _sg_def(ranges[i].num_instances, 1), ranges[i].base_vertex);
+        }
+    }
+    #endif
+}
+
+/* compute pipelines are only supported on GL 4.3 and the dummy backend (see sg_features.compute) */
+static inline sg_resource_state _sg_create_compute_pipeline(_sg_pipeline_t* pip, _sg_shader_t* shd, const sg_compute_pipeline_desc* desc) {
+    #if defined(_SOKOL_GL_COMPUTE)
+    return _sg_gl_create_compute_pipeline(pip, shd, desc);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_create_compute_pipeline(pip, shd, desc);
+    #else
+    _SOKOL_UNUSED(pip);
+    _SOKOL_UNUSED(shd);
+    _SOKOL_UNUSED(desc);
+    SOKOL_LOG("compute pipelines are not supported by this backend");
+    return SG_RESOURCESTATE_FAILED;
+    #endif
+}
+
+static inline void _sg_begin_compute_pass(void) {
+    #if defined(_SOKOL_GL_COMPUTE)
+    _sg_gl_begin_compute_pass();
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_begin_compute_pass();
+    #endif
+}
+
+static inline void _sg_end_compute_pass(void) {
+    #if defined(_SOKOL_GL_COMPUTE)
+    _sg_gl_end_compute_pass();
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_end_compute_pass();
+    #endif
+}
+
+static inline void _sg_apply_compute_bindings(_sg_pipeline_t* pip, _sg_buffer_t** sbufs, int num_sbufs) {
+    #if defined(_SOKOL_GL_COMPUTE)
+    _sg_gl_apply_compute_bindings(pip, sbufs, num_sbufs);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_apply_compute_bindings(pip, sbufs, num_sbufs);
+    #else
+    _SOKOL_UNUSED(pip);
+    _SOKOL_UNUSED(sbufs);
+    _SOKOL_UNUSED(num_sbufs);
+    #endif
+}
+
+static inline void _sg_dispatch(int num_groups_x, int num_groups_y, int num_groups_z) {
+    #if defined(_SOKOL_GL_COMPUTE)
+    _sg_gl_dispatch(num_groups_x, num_groups_y, num_groups_z);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_dispatch(num_groups_x, num_groups_y, num_groups_z);
+    #else
+    _SOKOL_UNUSED(num_groups_x);
+    _SOKOL_UNUSED(num_groups_y);
+    _SOKOL_UNUSED(num_groups_z);
+    #endif
+}
+
 static inline void _sg_commit(void) {
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_commit();
@@ -13140,6 +17714,91 @@ static inline void _sg_commit(void) {
     #endif
 }
 
+/* GPU timing is only supported on GL and the dummy backend (see sg_features.gpu_timing) */
+static inline void _sg_write_timestamp(int frame, int query_index) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_write_timestamp(frame, query_index);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_write_timestamp(frame, query_index);
+    #else
+    _SOKOL_UNUSED(frame);
+    _SOKOL_UNUSED(query_index);
+    #endif
+}
+
+static inline bool _sg_timestamps_available(int frame, int num_queries) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_timestamps_available(frame, num_queries);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_timestamps_available(frame, num_queries);
+    #else
+    _SOKOL_UNUSED(frame);
+    _SOKOL_UNUSED(num_queries);
+    return false;
+    #endif
+}
+
+static inline uint64_t _sg_read_timestamp(int frame, int query_index) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_read_timestamp(frame, query_index);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_read_timestamp(frame, query_index);
+    #else
+    _SOKOL_UNUSED(frame);
+    _SOKOL_UNUSED(query_index);
+    return 0;
+    #endif
+}
+
+/* image readback is only supported on GL and the dummy backend (see sg_features.image_readback) */
+static inline bool _sg_read_image(int index, const _sg_image_t* img, _sg_readback_t* rb) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_read_image(index, img, rb);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_read_image(index, img, rb);
+    #else
+    _SOKOL_UNUSED(index);
+    _SOKOL_UNUSED(img);
+    _SOKOL_UNUSED(rb);
+    return false;
+    #endif
+}
+
+static inline bool _sg_readback_ready(int index, const _sg_readback_t* rb) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_readback_ready(index, rb);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_readback_ready(index, rb);
+    #else
+    _SOKOL_UNUSED(index);
+    _SOKOL_UNUSED(rb);
+    return true;
+    #endif
+}
+
+static inline const void* _sg_map_readback(int index, const _sg_readback_t* rb) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_map_readback(index, rb);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_map_readback(index, rb);
+    #else
+    _SOKOL_UNUSED(index);
+    _SOKOL_UNUSED(rb);
+    return 0;
+    #endif
+}
+
+static inline void _sg_unmap_readback(int index, const _sg_readback_t* rb) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_unmap_readback(index, rb);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_unmap_readback(index, rb);
+    #else
+    _SOKOL_UNUSED(index);
+    _SOKOL_UNUSED(rb);
+    #endif
+}
+
 static inline void _sg_update_buffer(_sg_buffer_t* buf, const sg_range* data) {
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_update_buffer(buf, data);
@@ -13188,29 +17847,191 @@ static inline void _sg_update_image(_sg_image_t* img, const sg_image_data* data)
     #endif
 }
 
-/*== RESOURCE POOLS ==========================================================*/
-
-_SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num) {
-    SOKOL_ASSERT(pool && (num >= 1));
-    /* slot 0 is reserved for the 'invalid id', so bump the pool size by 1 */
-    pool->size = num + 1;
-    pool->queue_top = 0;
-    /* generation counters indexable by pool slot index, slot 0 is reserved */
-    size_t gen_ctrs_size = sizeof(uint32_t) * (size_t)pool->size;
-    pool->gen_ctrs = (uint32_t*) SOKOL_MALLOC(gen_ctrs_size);
-    SOKOL_ASSERT(pool->gen_ctrs);
-    memset(pool->gen_ctrs, 0, gen_ctrs_size);
-    /* it's not a bug to only reserve 'num' here */
-    pool->free_queue = (int*) SOKOL_MALLOC(sizeof(int) * (size_t)num);
-    SOKOL_ASSERT(pool->free_queue);
-    /* never allocate the zero-th pool item since the invalid id is 0 */
-    for (int i = pool->size-1; i >= 1; i--) {
-        pool->free_queue[pool->queue_top++] = i;
-    }
+/* partial image updates are not supported on D3D11 (see sg_features.image_region_update) */
+static inline void _sg_update_image_region(_sg_image_t* img, const sg_image_region* region, const sg_range* data) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_update_image_region(img, region, data);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_update_image_region(img, region, data);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_update_image_region(img, region, data);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_update_image_region(img, region, data);
+    #else
+    _SOKOL_UNUSED(img);
+    _SOKOL_UNUSED(region);
+    _SOKOL_UNUSED(data);
+    #endif
+}
+
+static inline bool _sg_image_upload_done(_sg_image_t* img) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_image_upload_done(img);
+    #else
+    _SOKOL_UNUSED(img);
+    return true;
+    #endif
+}
+
+/* resolve pass action defaults into a new pass action struct, pass is 0 for the default pass */
+_SOKOL_PRIVATE void _sg_resolve_default_pass_action(const _sg_pass_t* pass, const sg_pass_action* from, sg_pass_action* to) {
+    SOKOL_ASSERT(from && to);
+    *to = *from;
+    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+        if (to->colors[i].action  == _SG_ACTION_DEFAULT) {
+            to->colors[i].action = SG_ACTION_CLEAR;
+            to->colors[i].value.r = SG_DEFAULT_CLEAR_RED;
+            to->colors[i].value.g = SG_DEFAULT_CLEAR_GREEN;
+            to->colors[i].value.b = SG_DEFAULT_CLEAR_BLUE;
+            to->colors[i].value.a = SG_DEFAULT_CLEAR_ALPHA;
+        }
+        if (to->colors[i].store_action == _SG_STOREACTION_DEFAULT) {
+            /* MSAA surfaces are usually only needed for their resolved content */
+            const _sg_image_t* img = pass ? _sg_pass_color_image(pass, i) : 0;
+            if (img && (img->cmn.sample_count > 1) && !img->cmn.transient) {
+                to->colors[i].store_action = SG_STOREACTION_RESOLVE;
+            }
+            else {
+                to->colors[i].store_action = SG_STOREACTION_STORE;
+            }
+        }
+    }
+    if (to->depth.action == _SG_ACTION_DEFAULT) {
+        to->depth.action = SG_ACTION_CLEAR;
+        to->depth.value = SG_DEFAULT_CLEAR_DEPTH;
+    }
+    if (to->depth.store_action == _SG_STOREACTION_DEFAULT) {
+        to->depth.store_action = SG_STOREACTION_STORE;
+    }
+    if (to->stencil.action == _SG_ACTION_DEFAULT) {
+        to->stencil.action = SG_ACTION_CLEAR;
+        to->stencil.value = SG_DEFAULT_CLEAR_STENCIL;
+    }
+    if (to->stencil.store_action == _SG_STOREACTION_DEFAULT) {
+        to->stencil.store_action = SG_STOREACTION_STORE;
+    }
+}
+
+/*== MEMORY ACCOUNTING =======================================================*/
+_SOKOL_PRIVATE void _sg_memory_count(sg_memory_counter* counter, int delta, size_t num_bytes) {
+    if (delta > 0) {
+        counter->num++;
+        counter->bytes += num_bytes;
+    }
+    else {
+        SOKOL_ASSERT((counter->num > 0) && (counter->bytes >= num_bytes));
+        counter->num--;
+        counter->bytes -= num_bytes;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_memory_count_usage(sg_usage usage, int delta, size_t num_bytes) {
+    switch (usage) {
+        case SG_USAGE_IMMUTABLE:    _sg_memory_count(&_sg.memory.immutable, delta, num_bytes); break;
+        case SG_USAGE_DYNAMIC:      _sg_memory_count(&_sg.memory.dynamic, delta, num_bytes); break;
+        case SG_USAGE_STREAM:       _sg_memory_count(&_sg.memory.stream, delta, num_bytes); break;
+        default: SOKOL_UNREACHABLE; break;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_memory_update_budget(void) {
+    const sg_memory_budget* budget = &_sg.desc.memory_budget;
+    _sg.memory.over_budget =
+        ((budget->total > 0) && (_sg.memory.total.bytes > budget->total)) ||
+        ((budget->buffers > 0) && (_sg.memory.buffers.bytes > budget->buffers)) ||
+        ((budget->images > 0) && (_sg.memory.images.bytes > budget->images));
+}
+
+/* add (delta = 1) or remove (delta = -1) a valid buffer from the memory stats */
+_SOKOL_PRIVATE void _sg_memory_track_buffer(const _sg_buffer_t* buf, int delta) {
+    SOKOL_ASSERT(buf);
+    const size_t num_bytes = _sg_buffer_num_bytes(buf);
+    _sg_memory_count(&_sg.memory.total, delta, num_bytes);
+    _sg_memory_count(&_sg.memory.buffers, delta, num_bytes);
+    _sg_memory_count_usage(buf->cmn.usage, delta, num_bytes);
+    switch (buf->cmn.type) {
+        case SG_BUFFERTYPE_VERTEXBUFFER:    _sg_memory_count(&_sg.memory.vertex_buffers, delta, num_bytes); break;
+        case SG_BUFFERTYPE_INDEXBUFFER:     _sg_memory_count(&_sg.memory.index_buffers, delta, num_bytes); break;
+        case SG_BUFFERTYPE_STORAGEBUFFER:   _sg_memory_count(&_sg.memory.storage_buffers, delta, num_bytes); break;
+        default: SOKOL_UNREACHABLE; break;
+    }
+    _sg_memory_update_budget();
+}
+
+_SOKOL_PRIVATE void _sg_memory_track_image(const _sg_image_t* img, int delta) {
+    SOKOL_ASSERT(img);
+    const size_t num_bytes = _sg_image_num_bytes(img);
+    _sg_memory_count(&_sg.memory.total, delta, num_bytes);
+    _sg_memory_count(&_sg.memory.images, delta, num_bytes);
+    _sg_memory_count_usage(img->cmn.usage, delta, num_bytes);
+    switch (img->cmn.type) {
+        case SG_IMAGETYPE_2D:       _sg_memory_count(&_sg.memory.images_2d, delta, num_bytes); break;
+        case SG_IMAGETYPE_CUBE:     _sg_memory_count(&_sg.memory.images_cube, delta, num_bytes); break;
+        case SG_IMAGETYPE_3D:       _sg_memory_count(&_sg.memory.images_3d, delta, num_bytes); break;
+        case SG_IMAGETYPE_ARRAY:    _sg_memory_count(&_sg.memory.images_array, delta, num_bytes); break;
+        default: SOKOL_UNREACHABLE; break;
+    }
+    if (img->cmn.render_target) {
+        _sg_memory_count(&_sg.memory.render_targets, delta, num_bytes);
+    }
+    _sg_memory_update_budget();
+}
+
+_SOKOL_PRIVATE void _sg_memory_commit(void) {
+    if (_sg.memory.over_budget) {
+        if (_sg.desc.memory_budget_cb) {
+            _sg.desc.memory_budget_cb(&_sg.memory);
+        }
+        else if (_sg.desc.memory_budget_userdata_cb) {
+            _sg.desc.memory_budget_userdata_cb(&_sg.memory, _sg.desc.memory_budget_user_data);
+        }
+    }
+}
+
+/*== RESOURCE POOLS ==========================================================*/
+
+_SOKOL_PRIVATE uint8_t* _sg_alloc_pool_chunk(size_t byte_size) {
+    uint8_t* chunk = (uint8_t*) SOKOL_MALLOC(byte_size);
+    SOKOL_ASSERT(chunk);
+    memset(chunk, 0, byte_size);
+    return chunk;
+}
+
+_SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num, size_t item_size, bool growable) {
+    SOKOL_ASSERT(pool && (num >= 1) && (item_size > 0));
+    /* slot 0 is reserved for the 'invalid id', so bump the pool size by 1 */
+    pool->size = num + 1;
+    pool->queue_top = 0;
+    pool->growable = growable;
+    pool->item_size = item_size;
+    pool->first_chunk_size = pool->size;
+    pool->num_chunks = 1;
+    pool->chunks = (uint8_t**) SOKOL_MALLOC(sizeof(uint8_t*));
+    SOKOL_ASSERT(pool->chunks);
+    pool->chunks[0] = _sg_alloc_pool_chunk(item_size * (size_t)pool->size);
+    /* generation counters indexable by pool slot index, slot 0 is reserved */
+    size_t gen_ctrs_size = sizeof(uint32_t) * (size_t)pool->size;
+    pool->gen_ctrs = (uint32_t*) SOKOL_MALLOC(gen_ctrs_size);
+    SOKOL_ASSERT(pool->gen_ctrs);
+    memset(pool->gen_ctrs, 0, gen_ctrs_size);
+    /* it's not a bug to only reserve 'size-1' here */
+    pool->free_queue = (int*) SOKOL_MALLOC(sizeof(int) * (size_t)(pool->size - 1));
+    SOKOL_ASSERT(pool->free_queue);
+    /* never allocate the zero-th pool item since the invalid id is 0 */
+    for (int i = pool->size-1; i >= 1; i--) {
+        pool->free_queue[pool->queue_top++] = i;
+    }
 }
 
 _SOKOL_PRIVATE void _sg_discard_pool(_sg_pool_t* pool) {
     SOKOL_ASSERT(pool);
+    SOKOL_ASSERT(pool->chunks);
+    for (int i = 0; i < pool->num_chunks; i++) {
+        SOKOL_FREE(pool->chunks[i]);
+    }
+    SOKOL_FREE(pool->chunks);
+    pool->chunks = 0;
+    pool->num_chunks = 0;
     SOKOL_ASSERT(pool->free_queue);
     SOKOL_FREE(pool->free_queue);
     pool->free_queue = 0;
@@ -13221,9 +18042,54 @@ _SOKOL_PRIVATE void _sg_discard_pool(_sg_pool_t* pool) {
     pool->queue_top = 0;
 }
 
+/* add a new chunk to an exhausted growable pool, existing items
+   are not moved, so that pointers to pool items remain valid, the
+   new chunk doubles the pool size (clamped to _SG_MAX_POOL_SIZE),
+   returns false if the pool has reached _SG_MAX_POOL_SIZE
+*/
+_SOKOL_PRIVATE bool _sg_pool_grow(_sg_pool_t* pool) {
+    SOKOL_ASSERT(pool && pool->growable);
+    SOKOL_ASSERT(0 == pool->queue_top);
+    if (pool->size >= _SG_MAX_POOL_SIZE) {
+        return false;
+    }
+    int chunk_size = pool->size;
+    if (chunk_size > (_SG_MAX_POOL_SIZE - pool->size)) {
+        chunk_size = _SG_MAX_POOL_SIZE - pool->size;
+    }
+    const int new_size = pool->size + chunk_size;
+    uint8_t** chunks = (uint8_t**) SOKOL_MALLOC(sizeof(uint8_t*) * (size_t)(pool->num_chunks + 1));
+    SOKOL_ASSERT(chunks);
+    memcpy(chunks, pool->chunks, sizeof(uint8_t*) * (size_t)pool->num_chunks);
+    chunks[pool->num_chunks] = _sg_alloc_pool_chunk(pool->item_size * (size_t)chunk_size);
+    SOKOL_FREE(pool->chunks);
+    pool->chunks = chunks;
+    pool->num_chunks++;
+
+    uint32_t* gen_ctrs = (uint32_t*) SOKOL_MALLOC(sizeof(uint32_t) * (size_t)new_size);
+    SOKOL_ASSERT(gen_ctrs);
+    memcpy(gen_ctrs, pool->gen_ctrs, sizeof(uint32_t) * (size_t)pool->size);
+    memset(gen_ctrs + pool->size, 0, sizeof(uint32_t) * (size_t)chunk_size);
+    SOKOL_FREE(pool->gen_ctrs);
+    pool->gen_ctrs = gen_ctrs;
+
+    /* the free queue is empty, so no need to copy its content */
+    SOKOL_FREE(pool->free_queue);
+    pool->free_queue = (int*) SOKOL_MALLOC(sizeof(int) * (size_t)(new_size - 1));
+    SOKOL_ASSERT(pool->free_queue);
+    for (int i = new_size-1; i >= pool->size; i--) {
+        pool->free_queue[pool->queue_top++] = i;
+    }
+    pool->size = new_size;
+    return true;
+}
+
 _SOKOL_PRIVATE int _sg_pool_alloc_index(_sg_pool_t* pool) {
     SOKOL_ASSERT(pool);
     SOKOL_ASSERT(pool->free_queue);
+    if ((0 == pool->queue_top) && pool->growable) {
+        _sg_pool_grow(pool);
+    }
     if (pool->queue_top > 0) {
         int slot_index = pool->free_queue[--pool->queue_top];
         SOKOL_ASSERT((slot_index > 0) && (slot_index < pool->size));
@@ -13235,6 +18101,25 @@ _SOKOL_PRIVATE int _sg_pool_alloc_index(_sg_pool_t* pool) {
     }
 }
 
+/* returns pointer to the pool item at slot_index, items in the first
+   chunk are the common case, otherwise walk the (few) doubling chunks
+*/
+_SOKOL_PRIVATE void* _sg_pool_item(const _sg_pool_t* pool, int slot_index) {
+    SOKOL_ASSERT(pool && pool->chunks);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < pool->size));
+    int index = slot_index;
+    int chunk_size = pool->first_chunk_size;
+    int chunk_index = 0;
+    while (index >= chunk_size) {
+        index -= chunk_size;
+        if (++chunk_index > 1) {
+            chunk_size *= 2;
+        }
+    }
+    SOKOL_ASSERT(chunk_index < pool->num_chunks);
+    return pool->chunks[chunk_index] + (size_t)index * pool->item_size;
+}
+
 _SOKOL_PRIVATE void _sg_pool_free_index(_sg_pool_t* pool, int slot_index) {
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < pool->size));
     SOKOL_ASSERT(pool);
@@ -13303,61 +18188,38 @@ _SOKOL_PRIVATE void _sg_reset_context(_sg_context_t* ctx) {
     ctx->slot.state = SG_RESOURCESTATE_ALLOC;
 }
 
+_SOKOL_PRIVATE void _sg_reset_sampler(_sg_sampler_t* smp) {
+    SOKOL_ASSERT(smp);
+    _sg_slot_t slot = smp->slot;
+    memset(smp, 0, sizeof(_sg_sampler_t));
+    smp->slot = slot;
+    smp->slot.state = SG_RESOURCESTATE_ALLOC;
+}
+
 _SOKOL_PRIVATE void _sg_setup_pools(_sg_pools_t* p, const sg_desc* desc) {
     SOKOL_ASSERT(p);
     SOKOL_ASSERT(desc);
     /* note: the pools here will have an additional item, since slot 0 is reserved */
+    const bool growable = desc->growable_pools;
     SOKOL_ASSERT((desc->buffer_pool_size > 0) && (desc->buffer_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->buffer_pool, desc->buffer_pool_size);
-    size_t buffer_pool_byte_size = sizeof(_sg_buffer_t) * (size_t)p->buffer_pool.size;
-    p->buffers = (_sg_buffer_t*) SOKOL_MALLOC(buffer_pool_byte_size);
-    SOKOL_ASSERT(p->buffers);
-    memset(p->buffers, 0, buffer_pool_byte_size);
-
+    _sg_init_pool(&p->buffer_pool, desc->buffer_pool_size, sizeof(_sg_buffer_t), growable);
     SOKOL_ASSERT((desc->image_pool_size > 0) && (desc->image_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->image_pool, desc->image_pool_size);
-    size_t image_pool_byte_size = sizeof(_sg_image_t) * (size_t)p->image_pool.size;
-    p->images = (_sg_image_t*) SOKOL_MALLOC(image_pool_byte_size);
-    SOKOL_ASSERT(p->images);
-    memset(p->images, 0, image_pool_byte_size);
-
+    _sg_init_pool(&p->image_pool, desc->image_pool_size, sizeof(_sg_image_t), growable);
     SOKOL_ASSERT((desc->shader_pool_size > 0) && (desc->shader_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->shader_pool, desc->shader_pool_size);
-    size_t shader_pool_byte_size = sizeof(_sg_shader_t) * (size_t)p->shader_pool.size;
-    p->shaders = (_sg_shader_t*) SOKOL_MALLOC(shader_pool_byte_size);
-    SOKOL_ASSERT(p->shaders);
-    memset(p->shaders, 0, shader_pool_byte_size);
-
+    _sg_init_pool(&p->shader_pool, desc->shader_pool_size, sizeof(_sg_shader_t), growable);
     SOKOL_ASSERT((desc->pipeline_pool_size > 0) && (desc->pipeline_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->pipeline_pool, desc->pipeline_pool_size);
-    size_t pipeline_pool_byte_size = sizeof(_sg_pipeline_t) * (size_t)p->pipeline_pool.size;
-    p->pipelines = (_sg_pipeline_t*) SOKOL_MALLOC(pipeline_pool_byte_size);
-    SOKOL_ASSERT(p->pipelines);
-    memset(p->pipelines, 0, pipeline_pool_byte_size);
-
+    _sg_init_pool(&p->pipeline_pool, desc->pipeline_pool_size, sizeof(_sg_pipeline_t), growable);
     SOKOL_ASSERT((desc->pass_pool_size > 0) && (desc->pass_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->pass_pool, desc->pass_pool_size);
-    size_t pass_pool_byte_size = sizeof(_sg_pass_t) * (size_t)p->pass_pool.size;
-    p->passes = (_sg_pass_t*) SOKOL_MALLOC(pass_pool_byte_size);
-    SOKOL_ASSERT(p->passes);
-    memset(p->passes, 0, pass_pool_byte_size);
-
+    _sg_init_pool(&p->pass_pool, desc->pass_pool_size, sizeof(_sg_pass_t), growable);
     SOKOL_ASSERT((desc->context_pool_size > 0) && (desc->context_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->context_pool, desc->context_pool_size);
-    size_t context_pool_byte_size = sizeof(_sg_context_t) * (size_t)p->context_pool.size;
-    p->contexts = (_sg_context_t*) SOKOL_MALLOC(context_pool_byte_size);
-    SOKOL_ASSERT(p->contexts);
-    memset(p->contexts, 0, context_pool_byte_size);
+    _sg_init_pool(&p->context_pool, desc->context_pool_size, sizeof(_sg_context_t), growable);
+    SOKOL_ASSERT((desc->sampler_pool_size > 0) && (desc->sampler_pool_size < _SG_MAX_POOL_SIZE));
+    _sg_init_pool(&p->sampler_pool, desc->sampler_pool_size, sizeof(_sg_sampler_t), growable);
 }
 
 _SOKOL_PRIVATE void _sg_discard_pools(_sg_pools_t* p) {
     SOKOL_ASSERT(p);
-    SOKOL_FREE(p->contexts);    p->contexts = 0;
-    SOKOL_FREE(p->passes);      p->passes = 0;
-    SOKOL_FREE(p->pipelines);   p->pipelines = 0;
-    SOKOL_FREE(p->shaders);     p->shaders = 0;
-    SOKOL_FREE(p->images);      p->images = 0;
-    SOKOL_FREE(p->buffers);     p->buffers = 0;
+    _sg_discard_pool(&p->sampler_pool);
     _sg_discard_pool(&p->context_pool);
     _sg_discard_pool(&p->pass_pool);
     _sg_discard_pool(&p->pipeline_pool);
@@ -13399,42 +18261,49 @@ _SOKOL_PRIVATE _sg_buffer_t* _sg_buffer_at(const _sg_pools_t* p, uint32_t buf_id
     SOKOL_ASSERT(p && (SG_INVALID_ID != buf_id));
     int slot_index = _sg_slot_index(buf_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->buffer_pool.size));
-    return &p->buffers[slot_index];
+    return (_sg_buffer_t*) _sg_pool_item(&p->buffer_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_image_t* _sg_image_at(const _sg_pools_t* p, uint32_t img_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != img_id));
     int slot_index = _sg_slot_index(img_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->image_pool.size));
-    return &p->images[slot_index];
+    return (_sg_image_t*) _sg_pool_item(&p->image_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_shader_t* _sg_shader_at(const _sg_pools_t* p, uint32_t shd_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != shd_id));
     int slot_index = _sg_slot_index(shd_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->shader_pool.size));
-    return &p->shaders[slot_index];
+    return (_sg_shader_t*) _sg_pool_item(&p->shader_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_pipeline_t* _sg_pipeline_at(const _sg_pools_t* p, uint32_t pip_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != pip_id));
     int slot_index = _sg_slot_index(pip_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->pipeline_pool.size));
-    return &p->pipelines[slot_index];
+    return (_sg_pipeline_t*) _sg_pool_item(&p->pipeline_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_pass_t* _sg_pass_at(const _sg_pools_t* p, uint32_t pass_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != pass_id));
     int slot_index = _sg_slot_index(pass_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->pass_pool.size));
-    return &p->passes[slot_index];
+    return (_sg_pass_t*) _sg_pool_item(&p->pass_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_context_t* _sg_context_at(const _sg_pools_t* p, uint32_t context_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != context_id));
     int slot_index = _sg_slot_index(context_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->context_pool.size));
-    return &p->contexts[slot_index];
+    return (_sg_context_t*) _sg_pool_item(&p->context_pool, slot_index);
+}
+
+_SOKOL_PRIVATE _sg_sampler_t* _sg_sampler_at(const _sg_pools_t* p, uint32_t smp_id) {
+    SOKOL_ASSERT(p && (SG_INVALID_ID != smp_id));
+    int slot_index = _sg_slot_index(smp_id);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->sampler_pool.size));
+    return (_sg_sampler_t*) _sg_pool_item(&p->sampler_pool, slot_index);
 }
 
 /* returns pointer to resource with matching id check, may return 0 */
@@ -13502,6 +18371,17 @@ _SOKOL_PRIVATE _sg_context_t* _sg_lookup_context(const _sg_pools_t* p, uint32_t
     return 0;
 }
 
+_SOKOL_PRIVATE _sg_sampler_t* _sg_lookup_sampler(const _sg_pools_t* p, uint32_t smp_id) {
+    SOKOL_ASSERT(p);
+    if (SG_INVALID_ID != smp_id) {
+        _sg_sampler_t* smp = _sg_sampler_at(p, smp_id);
+        if (smp->slot.id == smp_id) {
+            return smp;
+        }
+    }
+    return 0;
+}
+
 _SOKOL_PRIVATE void _sg_destroy_all_resources(_sg_pools_t* p, uint32_t ctx_id) {
     /*  this is a bit dumb since it loops over all pool slots to
         find the occupied slots, on the other hand it is only ever
@@ -13511,42 +18391,62 @@ _SOKOL_PRIVATE void _sg_destroy_all_resources(_sg_pools_t* p, uint32_t ctx_id) {
               and the resource slots not be cleared!
     */
     for (int i = 1; i < p->buffer_pool.size; i++) {
-        if (p->buffers[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->buffers[i].slot.state;
+        _sg_buffer_t* buf = (_sg_buffer_t*) _sg_pool_item(&p->buffer_pool, i);
+        if (buf->slot.ctx_id == ctx_id) {
+            sg_resource_state state = buf->slot.state;
+            if (state == SG_RESOURCESTATE_VALID) {
+                _sg_memory_track_buffer(buf, -1);
+            }
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_buffer(&p->buffers[i]);
+                _sg_destroy_buffer(buf);
             }
         }
     }
     for (int i = 1; i < p->image_pool.size; i++) {
-        if (p->images[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->images[i].slot.state;
+        _sg_image_t* img = (_sg_image_t*) _sg_pool_item(&p->image_pool, i);
+        if (img->slot.ctx_id == ctx_id) {
+            sg_resource_state state = img->slot.state;
+            if (state == SG_RESOURCESTATE_VALID) {
+                _sg_memory_track_image(img, -1);
+            }
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_image(&p->images[i]);
+                _sg_destroy_image(img);
             }
         }
     }
     for (int i = 1; i < p->shader_pool.size; i++) {
-        if (p->shaders[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->shaders[i].slot.state;
+        _sg_shader_t* shd = (_sg_shader_t*) _sg_pool_item(&p->shader_pool, i);
+        if (shd->slot.ctx_id == ctx_id) {
+            sg_resource_state state = shd->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_shader(&p->shaders[i]);
+                _sg_destroy_shader(shd);
             }
         }
     }
     for (int i = 1; i < p->pipeline_pool.size; i++) {
-        if (p->pipelines[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->pipelines[i].slot.state;
+        _sg_pipeline_t* pip = (_sg_pipeline_t*) _sg_pool_item(&p->pipeline_pool, i);
+        if (pip->slot.ctx_id == ctx_id) {
+            sg_resource_state state = pip->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_pipeline(&p->pipelines[i]);
+                _sg_destroy_pipeline(pip);
             }
         }
     }
     for (int i = 1; i < p->pass_pool.size; i++) {
-        if (p->passes[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->passes[i].slot.state;
+        _sg_pass_t* pass = (_sg_pass_t*) _sg_pool_item(&p->pass_pool, i);
+        if (pass->slot.ctx_id == ctx_id) {
+            sg_resource_state state = pass->slot.state;
+            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
+                _sg_destroy_pass(pass);
+            }
+        }
+    }
+    for (int i = 1; i < p->sampler_pool.size; i++) {
+        _sg_sampler_t* smp = (_sg_sampler_t*) _sg_pool_item(&p->sampler_pool, i);
+        if (smp->slot.ctx_id == ctx_id) {
+            sg_resource_state state = smp->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_pass(&p->passes[i]);
+                _sg_destroy_sampler(smp);
             }
         }
     }
@@ -13563,6 +18463,7 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_BUFFERDESC_DATA:          return "immutable buffers must be initialized with data (sg_buffer_desc.data.ptr and sg_buffer_desc.data.size)";
         case _SG_VALIDATE_BUFFERDESC_DATA_SIZE:     return "immutable buffer data size differs from buffer size";
         case _SG_VALIDATE_BUFFERDESC_NO_DATA:       return "dynamic/stream usage buffers cannot be initialized with data";
+        case _SG_VALIDATE_BUFFERDESC_STORAGE_SUPPORT:   return "storage buffers are not supported by this backend (sg_features.compute)";
 
         /* image creation validation errros */
         case _SG_VALIDATE_IMAGEDESC_CANARY:             return "sg_image_desc not initialized";
@@ -13576,6 +18477,10 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_IMAGEDESC_RT_NO_DATA:         return "render target images cannot be initialized with data";
         case _SG_VALIDATE_IMAGEDESC_DATA:               return "missing or invalid data for immutable image";
         case _SG_VALIDATE_IMAGEDESC_NO_DATA:            return "dynamic/stream usage images cannot be initialized with data";
+        case _SG_VALIDATE_IMAGEDESC_TRANSIENT_NO_RT:    return "transient images must be render targets";
+        case _SG_VALIDATE_IMAGEDESC_TRANSIENT_TYPE:     return "transient images must be SG_IMAGETYPE_2D";
+        case _SG_VALIDATE_IMAGEDESC_TRANSIENT_MIPMAPS:  return "transient images cannot have mipmaps";
+        case _SG_VALIDATE_IMAGEDESC_TRANSIENT_INJECTED: return "transient images cannot be injected";
 
         /* shader creation */
         case _SG_VALIDATE_SHADERDESC_CANARY:                return "sg_shader_desc not initialized";
@@ -13588,11 +18493,22 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_SHADERDESC_NO_UB_MEMBERS:         return "GL backend requires uniform block member declarations";
         case _SG_VALIDATE_SHADERDESC_UB_MEMBER_NAME:        return "uniform block member name missing";
         case _SG_VALIDATE_SHADERDESC_UB_SIZE_MISMATCH:      return "size of uniform block members doesn't match uniform block size";
+        case _SG_VALIDATE_SHADERDESC_UB_STD140_SIZE:        return "size of named uniform block doesn't match std140 layout of members (rounded up to 16 bytes)";
+        case _SG_VALIDATE_SHADERDESC_UB_STD140_ARRAY_TYPE:  return "uniform arrays in named uniform blocks must be of type FLOAT4 or MAT4";
         case _SG_VALIDATE_SHADERDESC_NO_CONT_IMGS:          return "shader images must occupy continuous slots";
         case _SG_VALIDATE_SHADERDESC_IMG_NAME:              return "GL backend requires uniform block member names";
         case _SG_VALIDATE_SHADERDESC_ATTR_NAMES:            return "GLES2 backend requires vertex attribute names";
         case _SG_VALIDATE_SHADERDESC_ATTR_SEMANTICS:        return "D3D11 backend requires vertex attribute semantics";
         case _SG_VALIDATE_SHADERDESC_ATTR_STRING_TOO_LONG:  return "vertex attribute name/semantic string too long (max len 16)";
+        case _SG_VALIDATE_SHADERDESC_INSTANCING_UB:         return "sg_shader_desc.instancing.uniform_block must be a vertex shader uniform block";
+        case _SG_VALIDATE_SHADERDESC_INSTANCING_UB_SIZE:    return "auto-instancing uniform block size must be a multiple of 4 and not exceed 256 bytes";
+        case _SG_VALIDATE_SHADERDESC_INSTANCING_BUFFER:     return "sg_shader_desc.instancing.buffer_index out of range";
+        case _SG_VALIDATE_SHADERDESC_INSTANCING_TRANSIENT:  return "auto-instancing requires a transient vertex buffer (sg_desc.transient_vertex_buffer_size)";
+        case _SG_VALIDATE_SHADERDESC_COMPUTE_SUPPORT:       return "compute shaders are not supported by this backend (sg_features.compute)";
+        case _SG_VALIDATE_SHADERDESC_COMPUTE_STAGES:        return "compute shaders can't have vertex- or fragment-shader-stages, vertex attributes or auto-instancing";
+        case _SG_VALIDATE_SHADERDESC_COMPUTE_IMAGES:        return "compute shader stages can't use images";
+        case _SG_VALIDATE_SHADERDESC_STORAGE_BUFFER_STAGE:  return "storage buffers can only be used in the compute shader stage";
+        case _SG_VALIDATE_SHADERDESC_NO_CONT_STORAGE_BUFFERS:   return "shader storage buffers must occupy continuous slots";
 
         /* pipeline creation */
         case _SG_VALIDATE_PIPELINEDESC_CANARY:          return "sg_pipeline_desc not initialized";
@@ -13601,6 +18517,14 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_PIPELINEDESC_LAYOUT_STRIDE4:  return "sg_pipeline_desc.layout.buffers[].stride must be multiple of 4";
         case _SG_VALIDATE_PIPELINEDESC_ATTR_NAME:       return "GLES2/WebGL missing vertex attribute name in shader";
         case _SG_VALIDATE_PIPELINEDESC_ATTR_SEMANTICS:  return "D3D11 missing vertex attribute semantics in shader";
+        case _SG_VALIDATE_PIPELINEDESC_INSTANCING_LAYOUT:   return "auto-instancing vertex buffer layout must be per-instance with a stride equal to the uniform block size";
+        case _SG_VALIDATE_PIPELINEDESC_INSTANCING_LAST_BUFFER:  return "auto-instancing vertex buffer must be the last vertex buffer in sg_pipeline_desc.layout";
+        case _SG_VALIDATE_PIPELINEDESC_COMPUTE_SHADER:  return "compute shaders can only be used with sg_make_compute_pipeline()";
+
+        /* compute pipeline creation */
+        case _SG_VALIDATE_CPIPELINEDESC_CANARY:             return "sg_compute_pipeline_desc not initialized";
+        case _SG_VALIDATE_CPIPELINEDESC_SHADER:             return "sg_compute_pipeline_desc.shader missing or invalid";
+        case _SG_VALIDATE_CPIPELINEDESC_NO_COMPUTE_SHADER:  return "sg_compute_pipeline_desc.shader is not a compute shader";
 
         /* pass creation */
         case _SG_VALIDATE_PASSDESC_CANARY:                  return "sg_pass_desc not initialized";
@@ -13617,9 +18541,15 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_PASSDESC_IMAGE_SIZES:             return "all pass attachments must have the same size";
         case _SG_VALIDATE_PASSDESC_IMAGE_SAMPLE_COUNTS:     return "all pass attachments must have the same sample count";
 
+        /* sampler creation */
+        case _SG_VALIDATE_SAMPLERDESC_CANARY:       return "sg_sampler_desc not initialized";
+        case _SG_VALIDATE_SAMPLERDESC_ANISTROPY:    return "sg_sampler_desc.max_anisotropy must be 1..16";
+
         /* sg_begin_pass */
         case _SG_VALIDATE_BEGINPASS_PASS:       return "sg_begin_pass: pass must be valid";
         case _SG_VALIDATE_BEGINPASS_IMAGE:      return "sg_begin_pass: one or more attachment images are not valid";
+        case _SG_VALIDATE_BEGINPASS_DEPTH_RESOLVE:  return "sg_begin_pass: SG_STOREACTION_RESOLVE is only valid for color attachments";
+        case _SG_VALIDATE_BEGINPASS_TRANSIENT_LOAD: return "sg_begin_pass: SG_ACTION_LOAD is not allowed for transient attachment images (content isn't preserved across passes)";
 
         /* sg_apply_pipeline */
         case _SG_VALIDATE_APIP_PIPELINE_VALID_ID:   return "sg_apply_pipeline: invalid pipeline id provided";
@@ -13631,6 +18561,8 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_APIP_COLOR_FORMAT:        return "sg_apply_pipeline: pipeline color attachment pixel format doesn't match pass color attachment pixel format";
         case _SG_VALIDATE_APIP_DEPTH_FORMAT:        return "sg_apply_pipeline: pipeline depth pixel_format doesn't match pass depth attachment pixel format";
         case _SG_VALIDATE_APIP_SAMPLE_COUNT:        return "sg_apply_pipeline: pipeline MSAA sample count doesn't match render pass attachment sample count";
+        case _SG_VALIDATE_APIP_COMPUTE_PASS:        return "sg_apply_pipeline: render pipelines can't be applied in compute passes";
+        case _SG_VALIDATE_APIP_RENDER_PASS:         return "sg_apply_pipeline: compute pipelines can only be applied in compute passes";
 
         /* sg_apply_bindings */
         case _SG_VALIDATE_ABND_PIPELINE:            return "sg_apply_bindings: must be called after sg_apply_pipeline";
@@ -13638,8 +18570,9 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_ABND_PIPELINE_VALID:      return "sg_apply_bindings: currently applied pipeline object not in valid state";
         case _SG_VALIDATE_ABND_VBS:                 return "sg_apply_bindings: number of vertex buffers doesn't match number of pipeline vertex layouts";
         case _SG_VALIDATE_ABND_VB_EXISTS:           return "sg_apply_bindings: vertex buffer no longer alive";
-        case _SG_VALIDATE_ABND_VB_TYPE:             return "sg_apply_bindings: buffer in vertex buffer slot is not a SG_BUFFERTYPE_VERTEXBUFFER";
+        case _SG_VALIDATE_ABND_VB_TYPE:             return "sg_apply_bindings: buffer in vertex buffer slot is not a SG_BUFFERTYPE_VERTEXBUFFER or SG_BUFFERTYPE_STORAGEBUFFER";
         case _SG_VALIDATE_ABND_VB_OVERFLOW:         return "sg_apply_bindings: buffer in vertex buffer slot is overflown";
+        case _SG_VALIDATE_ABND_INSTANCING_VB:       return "sg_apply_bindings: vertex buffer slot is reserved for auto-instancing data";
         case _SG_VALIDATE_ABND_NO_IB:               return "sg_apply_bindings: pipeline object defines indexed rendering, but no index buffer provided";
         case _SG_VALIDATE_ABND_IB:                  return "sg_apply_bindings: pipeline object defines non-indexed rendering, but index buffer provided";
         case _SG_VALIDATE_ABND_IB_EXISTS:           return "sg_apply_bindings: index buffer no longer alive";
@@ -13648,9 +18581,23 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_ABND_VS_IMGS:             return "sg_apply_bindings: vertex shader image count doesn't match sg_shader_desc";
         case _SG_VALIDATE_ABND_VS_IMG_EXISTS:       return "sg_apply_bindings: vertex shader image no longer alive";
         case _SG_VALIDATE_ABND_VS_IMG_TYPES:        return "sg_apply_bindings: one or more vertex shader image types don't match sg_shader_desc";
+        case _SG_VALIDATE_ABND_VS_IMG_TRANSIENT:    return "sg_apply_bindings: transient images cannot be bound to vertex shader";
         case _SG_VALIDATE_ABND_FS_IMGS:             return "sg_apply_bindings: fragment shader image count doesn't match sg_shader_desc";
         case _SG_VALIDATE_ABND_FS_IMG_EXISTS:       return "sg_apply_bindings: fragment shader image no longer alive";
         case _SG_VALIDATE_ABND_FS_IMG_TYPES:        return "sg_apply_bindings: one or more fragment shader image types don't match sg_shader_desc";
+        case _SG_VALIDATE_ABND_FS_IMG_TRANSIENT:    return "sg_apply_bindings: transient images cannot be bound to fragment shader";
+        case _SG_VALIDATE_ABND_SMP_SUPPORT:         return "sg_apply_bindings: sampler objects are not supported by this backend (sg_features.sampler_objects)";
+        case _SG_VALIDATE_ABND_VS_SMP_EXISTS:       return "sg_apply_bindings: vertex shader sampler no longer alive";
+        case _SG_VALIDATE_ABND_VS_SMP_NO_IMG:       return "sg_apply_bindings: vertex shader sampler bound to a slot without image";
+        case _SG_VALIDATE_ABND_FS_SMP_EXISTS:       return "sg_apply_bindings: fragment shader sampler no longer alive";
+        case _SG_VALIDATE_ABND_FS_SMP_NO_IMG:       return "sg_apply_bindings: fragment shader sampler bound to a slot without image";
+        case _SG_VALIDATE_ABND_CS_SBUFS:            return "sg_apply_bindings: storage buffer count doesn't match number of declared compute shader storage buffers";
+        case _SG_VALIDATE_ABND_CS_SBUF_EXISTS:      return "sg_apply_bindings: storage buffer no longer alive";
+        case _SG_VALIDATE_ABND_CS_SBUF_TYPE:        return "sg_apply_bindings: buffer in storage buffer slot is not a SG_BUFFERTYPE_STORAGEBUFFER";
+
+        /* sg_apply_prepared_bindings */
+        case _SG_VALIDATE_APBND_VALID:          return "sg_apply_prepared_bindings: prepared bindings are not valid (check sg_prepare_bindings() validation errors)";
+        case _SG_VALIDATE_APBND_PIPELINE:       return "sg_apply_prepared_bindings: bindings were prepared for a different pipeline than the currently applied pipeline";
 
         /* sg_apply_uniforms */
         case _SG_VALIDATE_AUB_NO_PIPELINE:      return "sg_apply_uniforms: must be called after sg_apply_pipeline()";
@@ -13674,6 +18621,25 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_UPDIMG_SIZE:          return "sg_update_image: provided subimage data size too big";
         case _SG_VALIDATE_UPDIMG_COMPRESSED:    return "sg_update_image: cannot update images with compressed format";
         case _SG_VALIDATE_UPDIMG_ONCE:          return "sg_update_image: only one update allowed per image and frame";
+        case _SG_VALIDATE_UPDIMG_AFTER_REGION:  return "sg_update_image: not allowed after sg_update_image_region() on the same image in the same frame";
+
+        /* sg_update_image_region */
+        case _SG_VALIDATE_UPDIMGRGN_SUPPORT:    return "sg_update_image_region: not supported by backend (see sg_features.image_region_update)";
+        case _SG_VALIDATE_UPDIMGRGN_USAGE:      return "sg_update_image_region: cannot update immutable image";
+        case _SG_VALIDATE_UPDIMGRGN_COMPRESSED: return "sg_update_image_region: cannot update images with compressed format";
+        case _SG_VALIDATE_UPDIMGRGN_MIPLEVEL:   return "sg_update_image_region: mip level out of range";
+        case _SG_VALIDATE_UPDIMGRGN_SLICE:      return "sg_update_image_region: slice out of range";
+        case _SG_VALIDATE_UPDIMGRGN_REGION:     return "sg_update_image_region: region out of bounds";
+        case _SG_VALIDATE_UPDIMGRGN_DATA:       return "sg_update_image_region: data size must match region size";
+        case _SG_VALIDATE_UPDIMGRGN_OVERLAP:    return "sg_update_image_region: region overlaps a region updated earlier in the same frame";
+
+        /* sg_read_image_async */
+        case _SG_VALIDATE_READIMG_CALLBACK:     return "sg_read_image_async: callback function required";
+        case _SG_VALIDATE_READIMG_FORMAT:       return "sg_read_image_async: image pixel format must be a renderable color format";
+        case _SG_VALIDATE_READIMG_TRANSIENT:    return "sg_read_image_async: cannot read back transient images";
+        case _SG_VALIDATE_READIMG_MIPLEVEL:     return "sg_read_image_async: mip level out of range";
+        case _SG_VALIDATE_READIMG_SLICE:        return "sg_read_image_async: slice out of range";
+        case _SG_VALIDATE_READIMG_REGION:       return "sg_read_image_async: region out of bounds";
 
         default: return "unknown validation error";
     }
@@ -13728,6 +18694,9 @@ _SOKOL_PRIVATE bool _sg_validate_buffer_desc(const sg_buffer_desc* desc) {
         else {
             SOKOL_VALIDATE(0 == desc->data.ptr, _SG_VALIDATE_BUFFERDESC_NO_DATA);
         }
+        if (desc->type == SG_BUFFERTYPE_STORAGEBUFFER) {
+            SOKOL_VALIDATE(_sg.features.compute, _SG_VALIDATE_BUFFERDESC_STORAGE_SUPPORT);
+        }
         return SOKOL_VALIDATE_END();
     #endif
 }
@@ -13764,8 +18733,14 @@ _SOKOL_PRIVATE bool _sg_validate_image_desc(const sg_image_desc* desc) {
             #endif
             SOKOL_VALIDATE(usage == SG_USAGE_IMMUTABLE, _SG_VALIDATE_IMAGEDESC_RT_IMMUTABLE);
             SOKOL_VALIDATE(desc->data.subimage[0][0].ptr==0, _SG_VALIDATE_IMAGEDESC_RT_NO_DATA);
+            if (desc->transient) {
+                SOKOL_VALIDATE(desc->type == SG_IMAGETYPE_2D, _SG_VALIDATE_IMAGEDESC_TRANSIENT_TYPE);
+                SOKOL_VALIDATE(desc->num_mipmaps <= 1, _SG_VALIDATE_IMAGEDESC_TRANSIENT_MIPMAPS);
+                SOKOL_VALIDATE(!injected, _SG_VALIDATE_IMAGEDESC_TRANSIENT_INJECTED);
+            }
         }
         else {
+            SOKOL_VALIDATE(!desc->transient, _SG_VALIDATE_IMAGEDESC_TRANSIENT_NO_RT);
             SOKOL_VALIDATE(desc->sample_count <= 1, _SG_VALIDATE_IMAGEDESC_MSAA_BUT_NO_RT);
             const bool valid_nonrt_fmt = !_sg_is_valid_rendertarget_depth_format(fmt);
             SOKOL_VALIDATE(valid_nonrt_fmt, _SG_VALIDATE_IMAGEDESC_NONRT_PIXELFORMAT);
@@ -13809,21 +18784,39 @@ _SOKOL_PRIVATE bool _sg_validate_shader_desc(const sg_shader_desc* desc) {
         #elif defined(SOKOL_D3D11)
             SOKOL_VALIDATE(0 != desc->attrs[0].sem_name, _SG_VALIDATE_SHADERDESC_ATTR_SEMANTICS);
         #endif
-        #if defined(SOKOL_GLCORE33) || defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
-            /* on GL, must provide shader source code */
-            SOKOL_VALIDATE(0 != desc->vs.source, _SG_VALIDATE_SHADERDESC_SOURCE);
-            SOKOL_VALIDATE(0 != desc->fs.source, _SG_VALIDATE_SHADERDESC_SOURCE);
-        #elif defined(SOKOL_METAL) || defined(SOKOL_D3D11)
-            /* on Metal or D3D11, must provide shader source code or byte code */
-            SOKOL_VALIDATE((0 != desc->vs.source)||(0 != desc->vs.bytecode.ptr), _SG_VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE);
-            SOKOL_VALIDATE((0 != desc->fs.source)||(0 != desc->fs.bytecode.ptr), _SG_VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE);
-        #elif defined(SOKOL_WGPU)
-            /* on WGPU byte code must be provided */
-            SOKOL_VALIDATE((0 != desc->vs.bytecode.ptr), _SG_VALIDATE_SHADERDESC_BYTECODE);
-            SOKOL_VALIDATE((0 != desc->fs.bytecode.ptr), _SG_VALIDATE_SHADERDESC_BYTECODE);
-        #else
-            /* Dummy Backend, don't require source or bytecode */
-        #endif
+        const bool is_compute = (0 != desc->cs.source) || (0 != desc->cs.bytecode.ptr);
+        if (is_compute) {
+            /* compute shaders only have the compute shader stage */
+            SOKOL_VALIDATE(_sg.features.compute, _SG_VALIDATE_SHADERDESC_COMPUTE_SUPPORT);
+            SOKOL_VALIDATE((0 == desc->vs.source) && (0 == desc->vs.bytecode.ptr), _SG_VALIDATE_SHADERDESC_COMPUTE_STAGES);
+            SOKOL_VALIDATE((0 == desc->fs.source) && (0 == desc->fs.bytecode.ptr), _SG_VALIDATE_SHADERDESC_COMPUTE_STAGES);
+            SOKOL_VALIDATE(0 == desc->attrs[0].name, _SG_VALIDATE_SHADERDESC_COMPUTE_STAGES);
+            SOKOL_VALIDATE(!desc->instancing.enabled, _SG_VALIDATE_SHADERDESC_COMPUTE_STAGES);
+            SOKOL_VALIDATE(desc->cs.images[0].image_type == _SG_IMAGETYPE_DEFAULT, _SG_VALIDATE_SHADERDESC_COMPUTE_IMAGES);
+            #if defined(SOKOL_GLCORE33) || defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
+                SOKOL_VALIDATE(0 != desc->cs.source, _SG_VALIDATE_SHADERDESC_SOURCE);
+            #endif
+        }
+        else {
+            #if defined(SOKOL_GLCORE33) || defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
+                /* on GL, must provide shader source code */
+                SOKOL_VALIDATE(0 != desc->vs.source, _SG_VALIDATE_SHADERDESC_SOURCE);
+                SOKOL_VALIDATE(0 != desc->fs.source, _SG_VALIDATE_SHADERDESC_SOURCE);
+            #elif defined(SOKOL_METAL) || defined(SOKOL_D3D11)
+                /* on Metal or D3D11, must provide shader source code or byte code */
+                SOKOL_VALIDATE((0 != desc->vs.source)||(0 != desc->vs.bytecode.ptr), _SG_VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE);
+                SOKOL_VALIDATE((0 != desc->fs.source)||(0 != desc->fs.bytecode.ptr), _SG_VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE);
+            #elif defined(SOKOL_WGPU)
+                /* on WGPU byte code must be provided */
+                SOKOL_VALIDATE((0 != desc->vs.bytecode.ptr), _SG_VALIDATE_SHADERDESC_BYTECODE);
+                SOKOL_VALIDATE((0 != desc->fs.bytecode.ptr), _SG_VALIDATE_SHADERDESC_BYTECODE);
+            #else
+                /* Dummy Backend, don't require source or bytecode */
+            #endif
+            /* storage buffers can only be used in the compute shader stage */
+            SOKOL_VALIDATE(!desc->vs.storage_buffers[0].used, _SG_VALIDATE_SHADERDESC_STORAGE_BUFFER_STAGE);
+            SOKOL_VALIDATE(!desc->fs.storage_buffers[0].used, _SG_VALIDATE_SHADERDESC_STORAGE_BUFFER_STAGE);
+        }
         for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
             if (desc->attrs[i].name) {
                 SOKOL_VALIDATE(strlen(desc->attrs[i].name) < _SG_STRING_SIZE, _SG_VALIDATE_SHADERDESC_ATTR_STRING_TOO_LONG);
@@ -13839,8 +18832,22 @@ _SOKOL_PRIVATE bool _sg_validate_shader_desc(const sg_shader_desc* desc) {
         if (0 != desc->fs.bytecode.ptr) {
             SOKOL_VALIDATE(desc->fs.bytecode.size > 0, _SG_VALIDATE_SHADERDESC_NO_BYTECODE_SIZE);
         }
-        for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
-            const sg_shader_stage_desc* stage_desc = (stage_index == 0)? &desc->vs : &desc->fs;
+        if (0 != desc->cs.bytecode.ptr) {
+            SOKOL_VALIDATE(desc->cs.bytecode.size > 0, _SG_VALIDATE_SHADERDESC_NO_BYTECODE_SIZE);
+        }
+        if (desc->instancing.enabled) {
+            const int ub_index = desc->instancing.uniform_block;
+            const bool ub_valid = (ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS) && (desc->vs.uniform_blocks[ub_index].size > 0);
+            SOKOL_VALIDATE(ub_valid, _SG_VALIDATE_SHADERDESC_INSTANCING_UB);
+            if (ub_valid) {
+                const size_t ub_size = desc->vs.uniform_blocks[ub_index].size;
+                SOKOL_VALIDATE(((ub_size & 3) == 0) && (ub_size <= _SG_INSTANCING_MAX_RECORD_SIZE), _SG_VALIDATE_SHADERDESC_INSTANCING_UB_SIZE);
+            }
+            SOKOL_VALIDATE((desc->instancing.buffer_index >= 0) && (desc->instancing.buffer_index < SG_MAX_SHADERSTAGE_BUFFERS), _SG_VALIDATE_SHADERDESC_INSTANCING_BUFFER);
+            SOKOL_VALIDATE(0 != _sg.instancing.staging, _SG_VALIDATE_SHADERDESC_INSTANCING_TRANSIENT);
+        }
+        for (int stage_index = 0; stage_index < _SG_NUM_ALL_SHADER_STAGES; stage_index++) {
+            const sg_shader_stage_desc* stage_desc = _sg_shader_stage_desc(desc, stage_index);
             bool uniform_blocks_continuous = true;
             for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
                 const sg_shader_uniform_block_desc* ub_desc = &stage_desc->uniform_blocks[ub_index];
@@ -13853,10 +18860,18 @@ _SOKOL_PRIVATE bool _sg_validate_shader_desc(const sg_shader_desc* desc) {
                         const sg_shader_uniform_desc* u_desc = &ub_desc->uniforms[u_index];
                         if (u_desc->type != SG_UNIFORMTYPE_INVALID) {
                             SOKOL_VALIDATE(uniforms_continuous, _SG_VALIDATE_SHADERDESC_NO_CONT_UB_MEMBERS);
-                            #if defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
+                            #if defined(SOKOL_GLES2)
                             SOKOL_VALIDATE(0 != u_desc->name, _SG_VALIDATE_SHADERDESC_UB_MEMBER_NAME);
+                            #elif defined(SOKOL_GLES3)
+                            /* members of uniform buffer objects are only looked up by name in the GLES2 fallback */
+                            SOKOL_VALIDATE((0 != u_desc->name) || ((0 != ub_desc->name) && !_sg.gl.gles2), _SG_VALIDATE_SHADERDESC_UB_MEMBER_NAME);
                             #endif
                             const int array_count = u_desc->array_count;
+                            if (ub_desc->name) {
+                                /* uniform buffer object, std140 layout */
+                                SOKOL_VALIDATE((array_count <= 1) || (u_desc->type == SG_UNIFORMTYPE_FLOAT4) || (u_desc->type == SG_UNIFORMTYPE_MAT4), _SG_VALIDATE_SHADERDESC_UB_STD140_ARRAY_TYPE);
+                                uniform_offset = _sg_roundup(uniform_offset, _sg_std140_uniform_alignment(u_desc->type, array_count));
+                            }
                             uniform_offset += _sg_uniform_size(u_desc->type, array_count);
                             num_uniforms++;
                         }
@@ -13865,8 +18880,22 @@ _SOKOL_PRIVATE bool _sg_validate_shader_desc(const sg_shader_desc* desc) {
                         }
                     }
                     #if defined(SOKOL_GLCORE33) || defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
-                    SOKOL_VALIDATE((size_t)uniform_offset == ub_desc->size, _SG_VALIDATE_SHADERDESC_UB_SIZE_MISMATCH);
-                    SOKOL_VALIDATE(num_uniforms > 0, _SG_VALIDATE_SHADERDESC_NO_UB_MEMBERS);
+                    /* the auto-instancing uniform block isn't a GL uniform block, members are optional */
+                    const bool instancing_ub = desc->instancing.enabled && (stage_index == SG_SHADERSTAGE_VS) && (ub_index == desc->instancing.uniform_block);
+                    if (ub_desc->name) {
+                        /* uniform buffer object, members are optional except for the GLES2 fallback */
+                        SOKOL_VALIDATE((ub_desc->size & 15) == 0, _SG_VALIDATE_SHADERDESC_UB_STD140_SIZE);
+                        if (_sg.gl.gles2) {
+                            SOKOL_VALIDATE(num_uniforms > 0, _SG_VALIDATE_SHADERDESC_NO_UB_MEMBERS);
+                        }
+                        if (num_uniforms > 0) {
+                            SOKOL_VALIDATE((size_t)_sg_roundup(uniform_offset, 16) == ub_desc->size, _SG_VALIDATE_SHADERDESC_UB_STD140_SIZE);
+                        }
+                    }
+                    else if (!instancing_ub) {
+                        SOKOL_VALIDATE((size_t)uniform_offset == ub_desc->size, _SG_VALIDATE_SHADERDESC_UB_SIZE_MISMATCH);
+                        SOKOL_VALIDATE(num_uniforms > 0, _SG_VALIDATE_SHADERDESC_NO_UB_MEMBERS);
+                    }
                     #endif
                 }
                 else {
@@ -13886,6 +18915,15 @@ _SOKOL_PRIVATE bool _sg_validate_shader_desc(const sg_shader_desc* desc) {
                     images_continuous = false;
                 }
             }
+            bool storage_buffers_continuous = true;
+            for (int sbuf_index = 0; sbuf_index < SG_MAX_SHADERSTAGE_STORAGE_BUFFERS; sbuf_index++) {
+                if (stage_desc->storage_buffers[sbuf_index].used) {
+                    SOKOL_VALIDATE(storage_buffers_continuous, _SG_VALIDATE_SHADERDESC_NO_CONT_STORAGE_BUFFERS);
+                }
+                else {
+                    storage_buffers_continuous = false;
+                }
+            }
         }
         return SOKOL_VALIDATE_END();
     #endif
@@ -13913,6 +18951,7 @@ _SOKOL_PRIVATE bool _sg_validate_pipeline_desc(const sg_pipeline_desc* desc) {
         SOKOL_VALIDATE(0 != shd, _SG_VALIDATE_PIPELINEDESC_SHADER);
         if (shd) {
             SOKOL_VALIDATE(shd->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_PIPELINEDESC_SHADER);
+            SOKOL_VALIDATE(!shd->cmn.compute, _SG_VALIDATE_PIPELINEDESC_COMPUTE_SHADER);
             bool attrs_cont = true;
             for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
                 const sg_vertex_attr_desc* a_desc = &desc->layout.attrs[attr_index];
@@ -13930,6 +18969,40 @@ _SOKOL_PRIVATE bool _sg_validate_pipeline_desc(const sg_pipeline_desc* desc) {
                 SOKOL_VALIDATE(!_sg_strempty(&shd->d3d11.attrs[attr_index].sem_name), _SG_VALIDATE_PIPELINEDESC_ATTR_SEMANTICS);
                 #endif
             }
+            if (shd->cmn.instancing) {
+                /* the auto-instancing vertex buffer must be the last, per-instance data with one uniform block per instance */
+                const int inst_buf_index = shd->cmn.instancing_buffer_index;
+                const sg_buffer_layout_desc* l_desc = &desc->layout.buffers[inst_buf_index];
+                const size_t ub_size = shd->cmn.stage[SG_SHADERSTAGE_VS].uniform_blocks[shd->cmn.instancing_ub_index].size;
+                SOKOL_VALIDATE(l_desc->step_func == SG_VERTEXSTEP_PER_INSTANCE, _SG_VALIDATE_PIPELINEDESC_INSTANCING_LAYOUT);
+                SOKOL_VALIDATE((size_t)l_desc->stride == ub_size, _SG_VALIDATE_PIPELINEDESC_INSTANCING_LAYOUT);
+                for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+                    const sg_vertex_attr_desc* a_desc = &desc->layout.attrs[attr_index];
+                    if (a_desc->format != SG_VERTEXFORMAT_INVALID) {
+                        SOKOL_VALIDATE(a_desc->buffer_index <= inst_buf_index, _SG_VALIDATE_PIPELINEDESC_INSTANCING_LAST_BUFFER);
+                    }
+                }
+            }
+        }
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_compute_pipeline_desc(const sg_compute_pipeline_desc* desc) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(desc);
+        return true;
+    #else
+        SOKOL_ASSERT(desc);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(desc->_start_canary == 0, _SG_VALIDATE_CPIPELINEDESC_CANARY);
+        SOKOL_VALIDATE(desc->_end_canary == 0, _SG_VALIDATE_CPIPELINEDESC_CANARY);
+        SOKOL_VALIDATE(desc->shader.id != SG_INVALID_ID, _SG_VALIDATE_CPIPELINEDESC_SHADER);
+        const _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, desc->shader.id);
+        SOKOL_VALIDATE(shd != 0, _SG_VALIDATE_CPIPELINEDESC_SHADER);
+        if (shd) {
+            SOKOL_VALIDATE(shd->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_CPIPELINEDESC_SHADER);
+            SOKOL_VALIDATE(shd->cmn.compute, _SG_VALIDATE_CPIPELINEDESC_NO_COMPUTE_SHADER);
         }
         return SOKOL_VALIDATE_END();
     #endif
@@ -14005,13 +19078,30 @@ _SOKOL_PRIVATE bool _sg_validate_pass_desc(const sg_pass_desc* desc) {
     #endif
 }
 
-_SOKOL_PRIVATE bool _sg_validate_begin_pass(_sg_pass_t* pass) {
+_SOKOL_PRIVATE bool _sg_validate_sampler_desc(const sg_sampler_desc* desc) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(desc);
+        return true;
+    #else
+        SOKOL_ASSERT(desc);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(desc->_start_canary == 0, _SG_VALIDATE_SAMPLERDESC_CANARY);
+        SOKOL_VALIDATE(desc->_end_canary == 0, _SG_VALIDATE_SAMPLERDESC_CANARY);
+        SOKOL_VALIDATE((desc->max_anisotropy >= 1) && (desc->max_anisotropy <= 16), _SG_VALIDATE_SAMPLERDESC_ANISTROPY);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_begin_pass(_sg_pass_t* pass, const sg_pass_action* action) {
     #if !defined(SOKOL_DEBUG)
         _SOKOL_UNUSED(pass);
+        _SOKOL_UNUSED(action);
         return true;
     #else
         SOKOL_VALIDATE_BEGIN();
         SOKOL_VALIDATE(pass->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_BEGINPASS_PASS);
+        SOKOL_VALIDATE(action->depth.store_action != SG_STOREACTION_RESOLVE, _SG_VALIDATE_BEGINPASS_DEPTH_RESOLVE);
+        SOKOL_VALIDATE(action->stencil.store_action != SG_STOREACTION_RESOLVE, _SG_VALIDATE_BEGINPASS_DEPTH_RESOLVE);
 
         for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
             const _sg_pass_attachment_t* att = &pass->cmn.color_atts[i];
@@ -14019,6 +19109,9 @@ _SOKOL_PRIVATE bool _sg_validate_begin_pass(_sg_pass_t* pass) {
             if (img) {
                 SOKOL_VALIDATE(img->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_BEGINPASS_IMAGE);
                 SOKOL_VALIDATE(img->slot.id == att->image_id.id, _SG_VALIDATE_BEGINPASS_IMAGE);
+                if (img->cmn.transient) {
+                    SOKOL_VALIDATE(action->colors[i].action != SG_ACTION_LOAD, _SG_VALIDATE_BEGINPASS_TRANSIENT_LOAD);
+                }
             }
         }
         const _sg_image_t* ds_img = _sg_pass_ds_image(pass);
@@ -14026,6 +19119,12 @@ _SOKOL_PRIVATE bool _sg_validate_begin_pass(_sg_pass_t* pass) {
             const _sg_pass_attachment_t* att = &pass->cmn.ds_att;
             SOKOL_VALIDATE(ds_img->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_BEGINPASS_IMAGE);
             SOKOL_VALIDATE(ds_img->slot.id == att->image_id.id, _SG_VALIDATE_BEGINPASS_IMAGE);
+            if (ds_img->cmn.transient) {
+                SOKOL_VALIDATE(action->depth.action != SG_ACTION_LOAD, _SG_VALIDATE_BEGINPASS_TRANSIENT_LOAD);
+                if (_sg_is_depth_stencil_format(ds_img->cmn.pixel_format)) {
+                    SOKOL_VALIDATE(action->stencil.action != SG_ACTION_LOAD, _SG_VALIDATE_BEGINPASS_TRANSIENT_LOAD);
+                }
+            }
         }
         return SOKOL_VALIDATE_END();
     #endif
@@ -14049,6 +19148,15 @@ _SOKOL_PRIVATE bool _sg_validate_apply_pipeline(sg_pipeline pip_id) {
         SOKOL_ASSERT(pip->shader);
         SOKOL_VALIDATE(pip->shader->slot.id == pip->cmn.shader_id.id, _SG_VALIDATE_APIP_SHADER_EXISTS);
         SOKOL_VALIDATE(pip->shader->slot.state == SG_RESOURCESTATE_VALID, _SG_VALIDATE_APIP_SHADER_VALID);
+        /* compute pipelines only in compute passes, render pipelines only in render passes */
+        if (_sg.compute_pass) {
+            SOKOL_VALIDATE(pip->cmn.compute, _SG_VALIDATE_APIP_COMPUTE_PASS);
+            return SOKOL_VALIDATE_END();
+        }
+        SOKOL_VALIDATE(!pip->cmn.compute, _SG_VALIDATE_APIP_RENDER_PASS);
+        if (pip->cmn.compute) {
+            return SOKOL_VALIDATE_END();
+        }
         /* check that pipeline attributes match current pass attributes */
         const _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, _sg.cur_pass.id);
         if (pass) {
@@ -14078,16 +19186,17 @@ _SOKOL_PRIVATE bool _sg_validate_apply_pipeline(sg_pipeline pip_id) {
     #endif
 }
 
-_SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
+_SOKOL_PRIVATE bool _sg_validate_apply_bindings(sg_pipeline pip_id, const sg_bindings* bindings) {
     #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(pip_id);
         _SOKOL_UNUSED(bindings);
         return true;
     #else
         SOKOL_VALIDATE_BEGIN();
 
         /* a pipeline object must have been applied */
-        SOKOL_VALIDATE(_sg.cur_pipeline.id != SG_INVALID_ID, _SG_VALIDATE_ABND_PIPELINE);
-        const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
+        SOKOL_VALIDATE(pip_id.id != SG_INVALID_ID, _SG_VALIDATE_ABND_PIPELINE);
+        const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
         SOKOL_VALIDATE(pip != 0, _SG_VALIDATE_ABND_PIPELINE_EXISTS);
         if (!pip) {
             return SOKOL_VALIDATE_END();
@@ -14103,15 +19212,20 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
                 const _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, bindings->vertex_buffers[i].id);
                 SOKOL_VALIDATE(buf != 0, _SG_VALIDATE_ABND_VB_EXISTS);
                 if (buf && buf->slot.state == SG_RESOURCESTATE_VALID) {
-                    SOKOL_VALIDATE(SG_BUFFERTYPE_VERTEXBUFFER == buf->cmn.type, _SG_VALIDATE_ABND_VB_TYPE);
+                    /* storage buffers can be rendered as vertex buffers */
+                    SOKOL_VALIDATE((SG_BUFFERTYPE_VERTEXBUFFER == buf->cmn.type) || (SG_BUFFERTYPE_STORAGEBUFFER == buf->cmn.type), _SG_VALIDATE_ABND_VB_TYPE);
                     SOKOL_VALIDATE(!buf->cmn.append_overflow, _SG_VALIDATE_ABND_VB_OVERFLOW);
                 }
             }
-            else {
+            else if (!(pip->shader->cmn.instancing && (i == pip->shader->cmn.instancing_buffer_index))) {
                 /* vertex buffer provided in a slot which has no vertex layout in pipeline */
                 SOKOL_VALIDATE(!pip->cmn.vertex_layout_valid[i], _SG_VALIDATE_ABND_VBS);
             }
         }
+        if (pip->shader->cmn.instancing) {
+            /* the auto-instancing vertex buffer slot is provided by sokol-gfx */
+            SOKOL_VALIDATE(bindings->vertex_buffers[pip->shader->cmn.instancing_buffer_index].id == SG_INVALID_ID, _SG_VALIDATE_ABND_INSTANCING_VB);
+        }
 
         /* index buffer expected or not, and index buffer still exists */
         if (pip->cmn.index_type == SG_INDEXTYPE_NONE) {
@@ -14141,11 +19255,18 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
                 SOKOL_VALIDATE(img != 0, _SG_VALIDATE_ABND_VS_IMG_EXISTS);
                 if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
                     SOKOL_VALIDATE(img->cmn.type == stage->images[i].image_type, _SG_VALIDATE_ABND_VS_IMG_TYPES);
+                    SOKOL_VALIDATE(!img->cmn.transient, _SG_VALIDATE_ABND_VS_IMG_TRANSIENT);
                 }
             }
             else {
                 SOKOL_VALIDATE(i >= stage->num_images, _SG_VALIDATE_ABND_VS_IMGS);
             }
+            if (bindings->vs_samplers[i].id != SG_INVALID_ID) {
+                SOKOL_VALIDATE(_sg.features.sampler_objects, _SG_VALIDATE_ABND_SMP_SUPPORT);
+                SOKOL_VALIDATE(bindings->vs_images[i].id != SG_INVALID_ID, _SG_VALIDATE_ABND_VS_SMP_NO_IMG);
+                const _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, bindings->vs_samplers[i].id);
+                SOKOL_VALIDATE(smp != 0, _SG_VALIDATE_ABND_VS_SMP_EXISTS);
+            }
         }
 
         /* has expected fragment shader images */
@@ -14157,16 +19278,52 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
                 SOKOL_VALIDATE(img != 0, _SG_VALIDATE_ABND_FS_IMG_EXISTS);
                 if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
                     SOKOL_VALIDATE(img->cmn.type == stage->images[i].image_type, _SG_VALIDATE_ABND_FS_IMG_TYPES);
+                    SOKOL_VALIDATE(!img->cmn.transient, _SG_VALIDATE_ABND_FS_IMG_TRANSIENT);
                 }
             }
             else {
                 SOKOL_VALIDATE(i >= stage->num_images, _SG_VALIDATE_ABND_FS_IMGS);
             }
+            if (bindings->fs_samplers[i].id != SG_INVALID_ID) {
+                SOKOL_VALIDATE(_sg.features.sampler_objects, _SG_VALIDATE_ABND_SMP_SUPPORT);
+                SOKOL_VALIDATE(bindings->fs_images[i].id != SG_INVALID_ID, _SG_VALIDATE_ABND_FS_SMP_NO_IMG);
+                const _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, bindings->fs_samplers[i].id);
+                SOKOL_VALIDATE(smp != 0, _SG_VALIDATE_ABND_FS_SMP_EXISTS);
+            }
+        }
+
+        /* has expected compute shader storage buffers (render pipelines have none) */
+        for (int i = 0; i < SG_MAX_SHADERSTAGE_STORAGE_BUFFERS; i++) {
+            _sg_shader_stage_t* stage = &pip->shader->cmn.stage[SG_SHADERSTAGE_CS];
+            if (bindings->cs_storage_buffers[i].id != SG_INVALID_ID) {
+                SOKOL_VALIDATE(i < stage->num_storage_buffers, _SG_VALIDATE_ABND_CS_SBUFS);
+                const _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, bindings->cs_storage_buffers[i].id);
+                SOKOL_VALIDATE(buf != 0, _SG_VALIDATE_ABND_CS_SBUF_EXISTS);
+                if (buf && buf->slot.state == SG_RESOURCESTATE_VALID) {
+                    SOKOL_VALIDATE(SG_BUFFERTYPE_STORAGEBUFFER == buf->cmn.type, _SG_VALIDATE_ABND_CS_SBUF_TYPE);
+                }
+            }
+            else {
+                SOKOL_VALIDATE(i >= stage->num_storage_buffers, _SG_VALIDATE_ABND_CS_SBUFS);
+            }
         }
         return SOKOL_VALIDATE_END();
     #endif
 }
 
+_SOKOL_PRIVATE bool _sg_validate_apply_prepared_bindings(const sg_prepared_bindings* bindings) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(bindings);
+        return true;
+    #else
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(bindings->valid, _SG_VALIDATE_APBND_VALID);
+        SOKOL_VALIDATE(_sg.cur_pipeline.id != SG_INVALID_ID, _SG_VALIDATE_ABND_PIPELINE);
+        SOKOL_VALIDATE(bindings->pipeline.id == _sg.cur_pipeline.id, _SG_VALIDATE_APBND_PIPELINE);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
 _SOKOL_PRIVATE bool _sg_validate_apply_uniforms(sg_shader_stage stage_index, int ub_index, const sg_range* data) {
     #if !defined(SOKOL_DEBUG)
         _SOKOL_UNUSED(stage_index);
@@ -14174,7 +19331,7 @@ _SOKOL_PRIVATE bool _sg_validate_apply_uniforms(sg_shader_stage stage_index, int
         _SOKOL_UNUSED(data);
         return true;
     #else
-        SOKOL_ASSERT((stage_index == SG_SHADERSTAGE_VS) || (stage_index == SG_SHADERSTAGE_FS));
+        SOKOL_ASSERT((stage_index == SG_SHADERSTAGE_VS) || (stage_index == SG_SHADERSTAGE_FS) || (stage_index == SG_SHADERSTAGE_CS));
         SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
         SOKOL_VALIDATE_BEGIN();
         SOKOL_VALIDATE(_sg.cur_pipeline.id != SG_INVALID_ID, _SG_VALIDATE_AUB_NO_PIPELINE);
@@ -14234,6 +19391,7 @@ _SOKOL_PRIVATE bool _sg_validate_update_image(const _sg_image_t* img, const sg_i
         SOKOL_VALIDATE_BEGIN();
         SOKOL_VALIDATE(img->cmn.usage != SG_USAGE_IMMUTABLE, _SG_VALIDATE_UPDIMG_USAGE);
         SOKOL_VALIDATE(img->cmn.upd_frame_index != _sg.frame_index, _SG_VALIDATE_UPDIMG_ONCE);
+        SOKOL_VALIDATE(img->cmn.rgn_frame_index != _sg.frame_index, _SG_VALIDATE_UPDIMG_AFTER_REGION);
         SOKOL_VALIDATE(!_sg_is_compressed_pixel_format(img->cmn.pixel_format), _SG_VALIDATE_UPDIMG_COMPRESSED);
         const int num_faces = (img->cmn.type == SG_IMAGETYPE_CUBE) ? 6 : 1;
         const int num_mips = img->cmn.num_mipmaps;
@@ -14251,6 +19409,106 @@ _SOKOL_PRIVATE bool _sg_validate_update_image(const _sg_image_t* img, const sg_i
     #endif
 }
 
+#if defined(SOKOL_DEBUG)
+_SOKOL_PRIVATE bool _sg_image_region_overlaps(const sg_image_region* r0, const sg_image_region* r1) {
+    return (r0->mip_level == r1->mip_level) && (r0->slice == r1->slice) &&
+           (r0->x < (r1->x + r1->width)) && (r1->x < (r0->x + r0->width)) &&
+           (r0->y < (r1->y + r1->height)) && (r1->y < (r0->y + r0->height));
+}
+
+/* remember an updated region until the end of the frame, further
+   regions are not checked for overlap when the tracker is full
+*/
+_SOKOL_PRIVATE void _sg_track_image_region(uint32_t img_id, const sg_image_region* region) {
+    _sg_image_region_tracker_t* tracker = &_sg.updated_regions;
+    if (tracker->frame_index != _sg.frame_index) {
+        tracker->frame_index = _sg.frame_index;
+        tracker->num = 0;
+    }
+    if (tracker->num < _SG_MAX_TRACKED_IMAGE_REGIONS) {
+        tracker->items[tracker->num].img_id = img_id;
+        tracker->items[tracker->num].region = *region;
+        tracker->num++;
+    }
+}
+
+_SOKOL_PRIVATE bool _sg_image_region_updated(uint32_t img_id, const sg_image_region* region) {
+    const _sg_image_region_tracker_t* tracker = &_sg.updated_regions;
+    if (tracker->frame_index != _sg.frame_index) {
+        return false;
+    }
+    for (int i = 0; i < tracker->num; i++) {
+        if ((tracker->items[i].img_id == img_id) && _sg_image_region_overlaps(&tracker->items[i].region, region)) {
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
+_SOKOL_PRIVATE bool _sg_validate_update_image_region(const _sg_image_t* img, const sg_image_region* region, const sg_range* data) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(img);
+        _SOKOL_UNUSED(region);
+        _SOKOL_UNUSED(data);
+        return true;
+    #else
+        SOKOL_ASSERT(img && region && data);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(_sg.features.image_region_update, _SG_VALIDATE_UPDIMGRGN_SUPPORT);
+        SOKOL_VALIDATE(img->cmn.usage != SG_USAGE_IMMUTABLE, _SG_VALIDATE_UPDIMGRGN_USAGE);
+        SOKOL_VALIDATE(!_sg_is_compressed_pixel_format(img->cmn.pixel_format), _SG_VALIDATE_UPDIMGRGN_COMPRESSED);
+        SOKOL_VALIDATE((region->mip_level >= 0) && (region->mip_level < img->cmn.num_mipmaps), _SG_VALIDATE_UPDIMGRGN_MIPLEVEL);
+        int num_slices = 1;
+        switch (img->cmn.type) {
+            case SG_IMAGETYPE_CUBE:     num_slices = 6; break;
+            case SG_IMAGETYPE_ARRAY:    num_slices = img->cmn.num_slices; break;
+            case SG_IMAGETYPE_3D:       num_slices = _sg_max(img->cmn.num_slices >> region->mip_level, 1); break;
+            default: break;
+        }
+        SOKOL_VALIDATE((region->slice >= 0) && (region->slice < num_slices), _SG_VALIDATE_UPDIMGRGN_SLICE);
+        const int mip_width = _sg_max(img->cmn.width >> region->mip_level, 1);
+        const int mip_height = _sg_max(img->cmn.height >> region->mip_level, 1);
+        SOKOL_VALIDATE((region->x >= 0) && (region->y >= 0) && (region->width > 0) && (region->height > 0) &&
+                       ((region->x + region->width) <= mip_width) &&
+                       ((region->y + region->height) <= mip_height), _SG_VALIDATE_UPDIMGRGN_REGION);
+        const int expected_size = _sg_surface_pitch(img->cmn.pixel_format, region->width, region->height, 1);
+        SOKOL_VALIDATE(data->ptr && (data->size == (size_t)expected_size), _SG_VALIDATE_UPDIMGRGN_DATA);
+        SOKOL_VALIDATE(!_sg_image_region_updated(img->slot.id, region), _SG_VALIDATE_UPDIMGRGN_OVERLAP);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_read_image(const _sg_image_t* img, const sg_image_region* region, sg_read_image_callback callback) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(img);
+        _SOKOL_UNUSED(region);
+        _SOKOL_UNUSED(callback);
+        return true;
+    #else
+        SOKOL_ASSERT(img && region);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(0 != callback, _SG_VALIDATE_READIMG_CALLBACK);
+        SOKOL_VALIDATE(_sg_is_valid_rendertarget_color_format(img->cmn.pixel_format), _SG_VALIDATE_READIMG_FORMAT);
+        SOKOL_VALIDATE(!img->cmn.transient, _SG_VALIDATE_READIMG_TRANSIENT);
+        SOKOL_VALIDATE((region->mip_level >= 0) && (region->mip_level < img->cmn.num_mipmaps), _SG_VALIDATE_READIMG_MIPLEVEL);
+        int num_slices = 1;
+        switch (img->cmn.type) {
+            case SG_IMAGETYPE_CUBE:     num_slices = 6; break;
+            case SG_IMAGETYPE_ARRAY:    num_slices = img->cmn.num_slices; break;
+            case SG_IMAGETYPE_3D:       num_slices = _sg_max(img->cmn.num_slices >> region->mip_level, 1); break;
+            default: break;
+        }
+        SOKOL_VALIDATE((region->slice >= 0) && (region->slice < num_slices), _SG_VALIDATE_READIMG_SLICE);
+        const int mip_width = _sg_max(img->cmn.width >> region->mip_level, 1);
+        const int mip_height = _sg_max(img->cmn.height >> region->mip_level, 1);
+        SOKOL_VALIDATE((region->x >= 0) && (region->y >= 0) && (region->width > 0) && (region->height > 0) &&
+                       ((region->x + region->width) <= mip_width) &&
+                       ((region->y + region->height) <= mip_height), _SG_VALIDATE_READIMG_REGION);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
 /*== fill in desc default values =============================================*/
 _SOKOL_PRIVATE sg_buffer_desc _sg_buffer_desc_defaults(const sg_buffer_desc* desc) {
     sg_buffer_desc def = *desc;
@@ -14295,9 +19553,11 @@ _SOKOL_PRIVATE sg_shader_desc _sg_shader_desc_defaults(const sg_shader_desc* des
     #if defined(SOKOL_METAL)
         def.vs.entry = _sg_def(def.vs.entry, "_main");
         def.fs.entry = _sg_def(def.fs.entry, "_main");
+        def.cs.entry = _sg_def(def.cs.entry, "_main");
     #else
         def.vs.entry = _sg_def(def.vs.entry, "main");
         def.fs.entry = _sg_def(def.fs.entry, "main");
+        def.cs.entry = _sg_def(def.cs.entry, "main");
     #endif
     #if defined(SOKOL_D3D11)
         if (def.vs.source) {
@@ -14307,8 +19567,8 @@ _SOKOL_PRIVATE sg_shader_desc _sg_shader_desc_defaults(const sg_shader_desc* des
             def.fs.d3d11_target = _sg_def(def.fs.d3d11_target, "ps_4_0");
         }
     #endif
-    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
-        sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS)? &def.vs : &def.fs;
+    for (int stage_index = 0; stage_index < _SG_NUM_ALL_SHADER_STAGES; stage_index++) {
+        sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS)? &def.vs : ((stage_index == SG_SHADERSTAGE_FS)? &def.fs : &def.cs);
         for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
             sg_shader_uniform_block_desc* ub_desc = &stage_desc->uniform_blocks[ub_index];
             if (0 == ub_desc->size) {
@@ -14333,6 +19593,12 @@ _SOKOL_PRIVATE sg_shader_desc _sg_shader_desc_defaults(const sg_shader_desc* des
     return def;
 }
 
+_SOKOL_PRIVATE sg_compute_pipeline_desc _sg_compute_pipeline_desc_defaults(const sg_compute_pipeline_desc* desc) {
+    /* nothing to patch in yet, but keep the same structure as the other desc types */
+    sg_compute_pipeline_desc def = *desc;
+    return def;
+}
+
 _SOKOL_PRIVATE sg_pipeline_desc _sg_pipeline_desc_defaults(const sg_pipeline_desc* desc) {
     sg_pipeline_desc def = *desc;
 
@@ -14419,25 +19685,149 @@ _SOKOL_PRIVATE sg_pass_desc _sg_pass_desc_defaults(const sg_pass_desc* desc) {
     return def;
 }
 
-/*== allocate/initialize resource private functions ==========================*/
-_SOKOL_PRIVATE sg_buffer _sg_alloc_buffer(void) {
-    sg_buffer res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.buffer_pool);
-    if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.buffer_pool, &_sg.pools.buffers[slot_index].slot, slot_index);
-    }
-    else {
-        /* pool is exhausted */
-        res.id = SG_INVALID_ID;
-    }
-    return res;
-}
-
-_SOKOL_PRIVATE sg_image _sg_alloc_image(void) {
-    sg_image res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.image_pool);
+_SOKOL_PRIVATE sg_sampler_desc _sg_sampler_desc_defaults(const sg_sampler_desc* desc) {
+    sg_sampler_desc def = *desc;
+    def.min_filter = _sg_def(def.min_filter, SG_FILTER_NEAREST);
+    def.mag_filter = _sg_def(def.mag_filter, SG_FILTER_NEAREST);
+    def.wrap_u = _sg_def(def.wrap_u, SG_WRAP_REPEAT);
+    def.wrap_v = _sg_def(def.wrap_v, SG_WRAP_REPEAT);
+    def.wrap_w = _sg_def(def.wrap_w, SG_WRAP_REPEAT);
+    def.border_color = _sg_def(def.border_color, SG_BORDERCOLOR_OPAQUE_BLACK);
+    def.max_anisotropy = _sg_def(def.max_anisotropy, 1);
+    def.max_lod = _sg_def_flt(def.max_lod, FLT_MAX);
+    return def;
+}
+
+/*== DEFERRED DESTRUCTION ====================================================*/
+_SOKOL_PRIVATE void _sg_setup_destroy_queue(const sg_desc* desc) {
+    SOKOL_ASSERT(desc);
+    _sg.destroy_queue.enabled = desc->enable_deferred_destroy;
+}
+
+_SOKOL_PRIVATE _sg_destroy_item_t* _sg_destroy_queue_push(_sg_destroy_type_t type, size_t num_bytes) {
+    _sg_destroy_queue_t* q = &_sg.destroy_queue;
+    if (q->num == q->cap) {
+        const int new_cap = (q->cap == 0) ? 16 : q->cap * 2;
+        _sg_destroy_item_t* new_items = (_sg_destroy_item_t*) SOKOL_MALLOC((size_t)new_cap * sizeof(_sg_destroy_item_t));
+        SOKOL_ASSERT(new_items);
+        if (q->items) {
+            memcpy(new_items, q->items, (size_t)q->num * sizeof(_sg_destroy_item_t));
+            SOKOL_FREE(q->items);
+        }
+        q->items = new_items;
+        q->cap = new_cap;
+    }
+    _sg_destroy_item_t* item = &q->items[q->num++];
+    memset(item, 0, sizeof(_sg_destroy_item_t));
+    item->type = type;
+    item->frame_index = _sg.frame_index;
+    item->num_bytes = num_bytes;
+    q->num_bytes += num_bytes;
+    _sg_memory_count(&_sg.memory.deferred, 1, num_bytes);
+    _sg.stats.cur.num_destroy_deferred++;
+    _sg.stats.cur.size_destroy_deferred += num_bytes;
+    return item;
+}
+
+/* move a copy of the buffer's backend objects into the destroy queue, the
+   caller resets and frees the pool slot
+*/
+_SOKOL_PRIVATE void _sg_defer_destroy_buffer(const _sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf);
+    _sg_destroy_item_t* item = _sg_destroy_queue_push(_SG_DESTROY_BUFFER, _sg_buffer_num_bytes(buf));
+    item->res.buf = *buf;
+}
+
+_SOKOL_PRIVATE void _sg_defer_destroy_image(const _sg_image_t* img) {
+    SOKOL_ASSERT(img);
+    _sg_destroy_item_t* item = _sg_destroy_queue_push(_SG_DESTROY_IMAGE, _sg_image_num_bytes(img));
+    item->res.img = *img;
+}
+
+_SOKOL_PRIVATE uint32_t _sg_destroy_item_ctx_id(const _sg_destroy_item_t* item) {
+    return (item->type == _SG_DESTROY_BUFFER) ? item->res.buf.slot.ctx_id : item->res.img.slot.ctx_id;
+}
+
+/* release the backend objects of queued resources which belong to the
+   context ctx_id and have been destroyed at least SG_NUM_INFLIGHT_FRAMES
+   frames ago (or all of them if 'force' is true), the GL backend
+   collects the released names into a single glDeleteBuffers() and
+   glDeleteTextures() call
+*/
+_SOKOL_PRIVATE void _sg_release_destroy_queue(uint32_t ctx_id, bool force) {
+    _sg_destroy_queue_t* q = &_sg.destroy_queue;
+    if (0 == q->num) {
+        return;
+    }
+    _sg_begin_destroy_buffers(q->num);
+    _sg_begin_destroy_images(q->num);
+    int num_kept = 0;
+    for (int i = 0; i < q->num; i++) {
+        _sg_destroy_item_t* item = &q->items[i];
+        const bool expired = force || ((item->frame_index + SG_NUM_INFLIGHT_FRAMES) <= _sg.frame_index);
+        if (expired && (_sg_destroy_item_ctx_id(item) == ctx_id)) {
+            if (item->type == _SG_DESTROY_BUFFER) {
+                _sg_memory_track_buffer(&item->res.buf, -1);
+                _sg_destroy_buffer(&item->res.buf);
+            }
+            else {
+                _sg_memory_track_image(&item->res.img, -1);
+                _sg_destroy_image(&item->res.img);
+            }
+            _sg_memory_count(&_sg.memory.deferred, -1, item->num_bytes);
+            q->num_bytes -= item->num_bytes;
+            _sg.stats.cur.num_destroy_released++;
+            _sg.stats.cur.size_destroy_released += item->num_bytes;
+        }
+        else {
+            /* items stay in the order they have been destroyed */
+            if (num_kept != i) {
+                q->items[num_kept] = *item;
+            }
+            num_kept++;
+        }
+    }
+    q->num = num_kept;
+    _sg_end_destroy_images();
+    _sg_end_destroy_buffers();
+}
+
+_SOKOL_PRIVATE void _sg_destroy_queue_commit(void) {
+    if (_sg.active_context.id != SG_INVALID_ID) {
+        _sg_release_destroy_queue(_sg.active_context.id, false);
+    }
+    _sg.stats.cur.size_destroy_queue = _sg.destroy_queue.num_bytes;
+}
+
+/* items of contexts which are no longer around are dropped without releasing them */
+_SOKOL_PRIVATE void _sg_discard_destroy_queue(void) {
+    if (_sg.destroy_queue.items) {
+        SOKOL_FREE(_sg.destroy_queue.items);
+    }
+    memset(&_sg.destroy_queue, 0, sizeof(_sg.destroy_queue));
+}
+
+/*== allocate/initialize resource private functions ==========================*/
+_SOKOL_PRIVATE sg_buffer _sg_alloc_buffer(void) {
+    sg_buffer res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.buffer_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        _sg_buffer_t* buf = (_sg_buffer_t*) _sg_pool_item(&_sg.pools.buffer_pool, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.buffer_pool, &buf->slot, slot_index);
+    }
+    else {
+        /* pool is exhausted */
+        res.id = SG_INVALID_ID;
+    }
+    return res;
+}
+
+_SOKOL_PRIVATE sg_image _sg_alloc_image(void) {
+    sg_image res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.image_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.image_pool, &_sg.pools.images[slot_index].slot, slot_index);
+        _sg_image_t* img = (_sg_image_t*) _sg_pool_item(&_sg.pools.image_pool, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.image_pool, &img->slot, slot_index);
     }
     else {
         /* pool is exhausted */
@@ -14450,7 +19840,8 @@ _SOKOL_PRIVATE sg_shader _sg_alloc_shader(void) {
     sg_shader res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.shader_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.shader_pool, &_sg.pools.shaders[slot_index].slot, slot_index);
+        _sg_shader_t* shd = (_sg_shader_t*) _sg_pool_item(&_sg.pools.shader_pool, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.shader_pool, &shd->slot, slot_index);
     }
     else {
         /* pool is exhausted */
@@ -14463,7 +19854,8 @@ _SOKOL_PRIVATE sg_pipeline _sg_alloc_pipeline(void) {
     sg_pipeline res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.pipeline_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id =_sg_slot_alloc(&_sg.pools.pipeline_pool, &_sg.pools.pipelines[slot_index].slot, slot_index);
+        _sg_pipeline_t* pip = (_sg_pipeline_t*) _sg_pool_item(&_sg.pools.pipeline_pool, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.pipeline_pool, &pip->slot, slot_index);
     }
     else {
         /* pool is exhausted */
@@ -14476,7 +19868,22 @@ _SOKOL_PRIVATE sg_pass _sg_alloc_pass(void) {
     sg_pass res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.pass_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.pass_pool, &_sg.pools.passes[slot_index].slot, slot_index);
+        _sg_pass_t* pass = (_sg_pass_t*) _sg_pool_item(&_sg.pools.pass_pool, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.pass_pool, &pass->slot, slot_index);
+    }
+    else {
+        /* pool is exhausted */
+        res.id = SG_INVALID_ID;
+    }
+    return res;
+}
+
+_SOKOL_PRIVATE sg_sampler _sg_alloc_sampler(void) {
+    sg_sampler res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.sampler_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        _sg_sampler_t* smp = (_sg_sampler_t*) _sg_pool_item(&_sg.pools.sampler_pool, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.sampler_pool, &smp->slot, slot_index);
     }
     else {
         /* pool is exhausted */
@@ -14525,6 +19932,14 @@ _SOKOL_PRIVATE void _sg_dealloc_pass(sg_pass pass_id) {
     _sg_pool_free_index(&_sg.pools.pass_pool, _sg_slot_index(pass_id.id));
 }
 
+_SOKOL_PRIVATE void _sg_dealloc_sampler(sg_sampler smp_id) {
+    SOKOL_ASSERT(smp_id.id != SG_INVALID_ID);
+    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
+    SOKOL_ASSERT(smp && smp->slot.state == SG_RESOURCESTATE_ALLOC);
+    _sg_reset_slot(&smp->slot);
+    _sg_pool_free_index(&_sg.pools.sampler_pool, _sg_slot_index(smp_id.id));
+}
+
 _SOKOL_PRIVATE void _sg_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc) {
     SOKOL_ASSERT(buf_id.id != SG_INVALID_ID && desc);
     _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
@@ -14532,6 +19947,9 @@ _SOKOL_PRIVATE void _sg_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc
     buf->slot.ctx_id = _sg.active_context.id;
     if (_sg_validate_buffer_desc(desc)) {
         buf->slot.state = _sg_create_buffer(buf, desc);
+        if (buf->slot.state == SG_RESOURCESTATE_VALID) {
+            _sg_memory_track_buffer(buf, 1);
+        }
     }
     else {
         buf->slot.state = SG_RESOURCESTATE_FAILED;
@@ -14546,6 +19964,9 @@ _SOKOL_PRIVATE void _sg_init_image(sg_image img_id, const sg_image_desc* desc) {
     img->slot.ctx_id = _sg.active_context.id;
     if (_sg_validate_image_desc(desc)) {
         img->slot.state = _sg_create_image(img, desc);
+        if (img->slot.state == SG_RESOURCESTATE_VALID) {
+            _sg_memory_track_image(img, 1);
+        }
     }
     else {
         img->slot.state = SG_RESOURCESTATE_FAILED;
@@ -14587,6 +20008,26 @@ _SOKOL_PRIVATE void _sg_init_pipeline(sg_pipeline pip_id, const sg_pipeline_desc
     SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID)||(pip->slot.state == SG_RESOURCESTATE_FAILED));
 }
 
+_SOKOL_PRIVATE void _sg_init_compute_pipeline(sg_pipeline pip_id, const sg_compute_pipeline_desc* desc) {
+    SOKOL_ASSERT(pip_id.id != SG_INVALID_ID && desc);
+    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    SOKOL_ASSERT(pip && pip->slot.state == SG_RESOURCESTATE_ALLOC);
+    pip->slot.ctx_id = _sg.active_context.id;
+    if (_sg_validate_compute_pipeline_desc(desc)) {
+        _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, desc->shader.id);
+        if (shd && (shd->slot.state == SG_RESOURCESTATE_VALID) && shd->cmn.compute) {
+            pip->slot.state = _sg_create_compute_pipeline(pip, shd, desc);
+        }
+        else {
+            pip->slot.state = SG_RESOURCESTATE_FAILED;
+        }
+    }
+    else {
+        pip->slot.state = SG_RESOURCESTATE_FAILED;
+    }
+    SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID)||(pip->slot.state == SG_RESOURCESTATE_FAILED));
+}
+
 _SOKOL_PRIVATE void _sg_init_pass(sg_pass pass_id, const sg_pass_desc* desc) {
     SOKOL_ASSERT(pass_id.id != SG_INVALID_ID && desc);
     _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
@@ -14622,11 +20063,34 @@ _SOKOL_PRIVATE void _sg_init_pass(sg_pass pass_id, const sg_pass_desc* desc) {
     SOKOL_ASSERT((pass->slot.state == SG_RESOURCESTATE_VALID)||(pass->slot.state == SG_RESOURCESTATE_FAILED));
 }
 
+_SOKOL_PRIVATE void _sg_init_sampler(sg_sampler smp_id, const sg_sampler_desc* desc) {
+    SOKOL_ASSERT(smp_id.id != SG_INVALID_ID && desc);
+    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
+    SOKOL_ASSERT(smp && smp->slot.state == SG_RESOURCESTATE_ALLOC);
+    smp->slot.ctx_id = _sg.active_context.id;
+    if (_sg_validate_sampler_desc(desc)) {
+        smp->slot.state = _sg_create_sampler(smp, desc);
+    }
+    else {
+        smp->slot.state = SG_RESOURCESTATE_FAILED;
+    }
+    SOKOL_ASSERT((smp->slot.state == SG_RESOURCESTATE_VALID)||(smp->slot.state == SG_RESOURCESTATE_FAILED));
+}
+
 _SOKOL_PRIVATE bool _sg_uninit_buffer(sg_buffer buf_id) {
     _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
     if (buf) {
         if (buf->slot.ctx_id == _sg.active_context.id) {
-            _sg_destroy_buffer(buf);
+            /* failed buffers may own partially created backend objects, these are released immediately */
+            if (_sg.destroy_queue.enabled && (buf->slot.state == SG_RESOURCESTATE_VALID)) {
+                _sg_defer_destroy_buffer(buf);
+            }
+            else {
+                if (buf->slot.state == SG_RESOURCESTATE_VALID) {
+                    _sg_memory_track_buffer(buf, -1);
+                }
+                _sg_destroy_buffer(buf);
+            }
             _sg_reset_buffer(buf);
             return true;
         }
@@ -14642,7 +20106,15 @@ _SOKOL_PRIVATE bool _sg_uninit_image(sg_image img_id) {
     _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
     if (img) {
         if (img->slot.ctx_id == _sg.active_context.id) {
-            _sg_destroy_image(img);
+            if (_sg.destroy_queue.enabled && (img->slot.state == SG_RESOURCESTATE_VALID)) {
+                _sg_defer_destroy_image(img);
+            }
+            else {
+                if (img->slot.state == SG_RESOURCESTATE_VALID) {
+                    _sg_memory_track_image(img, -1);
+                }
+                _sg_destroy_image(img);
+            }
             _sg_reset_image(img);
             return true;
         }
@@ -14702,159 +20174,1060 @@ _SOKOL_PRIVATE bool _sg_uninit_pass(sg_pass pass_id) {
     return false;
 }
 
-/*== PUBLIC API FUNCTIONS ====================================================*/
-
-#if defined(SOKOL_METAL)
-    // this is ARC compatible
-    #if defined(__cplusplus)
-        #define _SG_CLEAR(type, item) { item = (type) { }; }
-    #else
-        #define _SG_CLEAR(type, item) { item = (type) { 0 }; }
-    #endif
-#else
-    #define _SG_CLEAR(type, item) { memset(&item, 0, sizeof(item)); }
-#endif
+_SOKOL_PRIVATE bool _sg_uninit_sampler(sg_sampler smp_id) {
+    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
+    if (smp) {
+        if (smp->slot.ctx_id == _sg.active_context.id) {
+            _sg_destroy_sampler(smp);
+            _sg_reset_sampler(smp);
+            return true;
+        }
+        else {
+            SOKOL_LOG("_sg_uninit_sampler: active context mismatch (must be same as for creation)");
+            _SG_TRACE_NOARGS(err_context_mismatch);
+        }
+    }
+    return false;
+}
 
-SOKOL_API_IMPL void sg_setup(const sg_desc* desc) {
-    SOKOL_ASSERT(desc);
-    SOKOL_ASSERT((desc->_start_canary == 0) && (desc->_end_canary == 0));
-    _SG_CLEAR(_sg_state_t, _sg);
-    _sg.desc = *desc;
+/* check that a resolved buffer is still alive (a destroyed or reused slot has a different id) */
+_SOKOL_PRIVATE bool _sg_prepared_buffer_alive(const void* ptr, sg_buffer buf_id) {
+    const _sg_buffer_t* buf = (const _sg_buffer_t*) ptr;
+    return (buf->slot.id == buf_id.id) && (SG_RESOURCESTATE_VALID == buf->slot.state) && !buf->cmn.append_overflow;
+}
 
-    /* replace zero-init items with their default values
-        NOTE: on WebGPU, the default color pixel format MUST be provided,
-        cannot be a default compile-time constant.
-    */
-    #if defined(SOKOL_WGPU)
-        SOKOL_ASSERT(SG_PIXELFORMAT_NONE != _sg.desc.context.color_format);
-    #elif defined(SOKOL_METAL) || defined(SOKOL_D3D11)
-        _sg.desc.context.color_format = _sg_def(_sg.desc.context.color_format, SG_PIXELFORMAT_BGRA8);
-    #else
-        _sg.desc.context.color_format = _sg_def(_sg.desc.context.color_format, SG_PIXELFORMAT_RGBA8);
-    #endif
-    _sg.desc.context.depth_format = _sg_def(_sg.desc.context.depth_format, SG_PIXELFORMAT_DEPTH_STENCIL);
-    _sg.desc.context.sample_count = _sg_def(_sg.desc.context.sample_count, 1);
-    _sg.desc.buffer_pool_size = _sg_def(_sg.desc.buffer_pool_size, _SG_DEFAULT_BUFFER_POOL_SIZE);
-    _sg.desc.image_pool_size = _sg_def(_sg.desc.image_pool_size, _SG_DEFAULT_IMAGE_POOL_SIZE);
-    _sg.desc.shader_pool_size = _sg_def(_sg.desc.shader_pool_size, _SG_DEFAULT_SHADER_POOL_SIZE);
-    _sg.desc.pipeline_pool_size = _sg_def(_sg.desc.pipeline_pool_size, _SG_DEFAULT_PIPELINE_POOL_SIZE);
-    _sg.desc.pass_pool_size = _sg_def(_sg.desc.pass_pool_size, _SG_DEFAULT_PASS_POOL_SIZE);
-    _sg.desc.context_pool_size = _sg_def(_sg.desc.context_pool_size, _SG_DEFAULT_CONTEXT_POOL_SIZE);
-    _sg.desc.uniform_buffer_size = _sg_def(_sg.desc.uniform_buffer_size, _SG_DEFAULT_UB_SIZE);
-    _sg.desc.staging_buffer_size = _sg_def(_sg.desc.staging_buffer_size, _SG_DEFAULT_STAGING_SIZE);
-    _sg.desc.sampler_cache_size = _sg_def(_sg.desc.sampler_cache_size, _SG_DEFAULT_SAMPLER_CACHE_CAPACITY);
+_SOKOL_PRIVATE bool _sg_prepared_image_alive(const void* ptr, sg_image img_id) {
+    const _sg_image_t* img = (const _sg_image_t*) ptr;
+    return (img->slot.id == img_id.id) && (SG_RESOURCESTATE_VALID == img->slot.state);
+}
 
-    _sg_setup_pools(&_sg.pools, &_sg.desc);
-    _sg.frame_index = 1;
-    _sg_setup_backend(&_sg.desc);
-    _sg.valid = true;
-    sg_setup_context();
+_SOKOL_PRIVATE bool _sg_prepared_sampler_alive(const void* ptr, sg_sampler smp_id) {
+    const _sg_sampler_t* smp = (const _sg_sampler_t*) ptr;
+    return (smp->slot.id == smp_id.id) && (SG_RESOURCESTATE_VALID == smp->slot.state);
 }
 
-SOKOL_API_IMPL void sg_shutdown(void) {
-    /* can only delete resources for the currently set context here, if multiple
-    contexts are used, the app code must take care of properly releasing them
-    (since only the app code can switch between 3D-API contexts)
-    */
-    if (_sg.active_context.id != SG_INVALID_ID) {
-        _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, _sg.active_context.id);
-        if (ctx) {
-            _sg_destroy_all_resources(&_sg.pools, _sg.active_context.id);
-            _sg_destroy_context(ctx);
+/*== REDUNDANT STATE FILTER ==================================================*/
+_SOKOL_PRIVATE void _sg_filter_reset_uniforms(void) {
+    for (int stage_index = 0; stage_index < _SG_NUM_ALL_SHADER_STAGES; stage_index++) {
+        for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+            _sg.filter.uniforms[stage_index][ub_index].valid = false;
         }
     }
-    _sg_discard_backend();
-    _sg_discard_pools(&_sg.pools);
-    _sg.valid = false;
 }
 
-SOKOL_API_IMPL bool sg_isvalid(void) {
-    return _sg.valid;
+/* called whenever the backend state may have changed behind the filter's back */
+_SOKOL_PRIVATE void _sg_filter_reset(void) {
+    _sg.filter.pipeline.id = SG_INVALID_ID;
+    _sg_filter_reset_bindings();
+    _sg_filter_reset_uniforms();
 }
 
-SOKOL_API_IMPL sg_desc sg_query_desc(void) {
-    SOKOL_ASSERT(_sg.valid);
-    return _sg.desc;
+/* the following functions are called right before the backend is called,
+    they return true if the backend call is redundant and should be skipped,
+    otherwise the new state is recorded
+*/
+_SOKOL_PRIVATE bool _sg_filter_skip_pipeline(sg_pipeline pip_id) {
+    if (!_sg.filter.enabled) {
+        return false;
+    }
+    if (_sg.filter.pipeline.id == pip_id.id) {
+        _sg.filter.cur_stats.num_dropped_pipelines++;
+        return true;
+    }
+    /* bindings and uniforms depend on the pipeline */
+    _sg_filter_reset();
+    _sg.filter.pipeline = pip_id;
+    return false;
 }
 
-SOKOL_API_IMPL sg_backend sg_query_backend(void) {
-    SOKOL_ASSERT(_sg.valid);
-    return _sg.backend;
+_SOKOL_PRIVATE bool _sg_filter_skip_bindings(const sg_bindings* bindings) {
+    if (!_sg.filter.enabled) {
+        return false;
+    }
+    if (_sg.filter.bindings_valid && (0 == memcmp(&_sg.filter.bindings, bindings, sizeof(sg_bindings)))) {
+        _sg.filter.cur_stats.num_dropped_bindings++;
+        return true;
+    }
+    _sg.filter.bindings_valid = true;
+    _sg.filter.bindings = *bindings;
+    return false;
 }
 
-SOKOL_API_IMPL sg_features sg_query_features(void) {
-    SOKOL_ASSERT(_sg.valid);
-    return _sg.features;
+_SOKOL_PRIVATE bool _sg_filter_skip_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data) {
+    if (!_sg.filter.enabled) {
+        return false;
+    }
+    _sg_filter_uniforms_t* ub = &_sg.filter.uniforms[stage][ub_index];
+    if (data->size > _SG_FILTER_MAX_UB_SIZE) {
+        ub->valid = false;
+        return false;
+    }
+    if (ub->valid && (ub->size == data->size) && (0 == memcmp(ub->data, data->ptr, data->size))) {
+        _sg.filter.cur_stats.num_dropped_uniforms++;
+        return true;
+    }
+    ub->valid = true;
+    ub->size = data->size;
+    memcpy(ub->data, data->ptr, data->size);
+    return false;
 }
 
-SOKOL_API_IMPL sg_limits sg_query_limits(void) {
-    SOKOL_ASSERT(_sg.valid);
-    return _sg.limits;
+/* called when the backend dropped an apply_uniforms() call which passed the filter,
+    the recorded uniform data no longer matches what the GPU sees
+*/
+_SOKOL_PRIVATE void _sg_filter_forget_uniforms(sg_shader_stage stage, int ub_index) {
+    _sg.filter.uniforms[stage][ub_index].valid = false;
 }
 
-SOKOL_API_IMPL sg_pixelformat_info sg_query_pixelformat(sg_pixel_format fmt) {
-    SOKOL_ASSERT(_sg.valid);
-    int fmt_index = (int) fmt;
-    SOKOL_ASSERT((fmt_index > SG_PIXELFORMAT_NONE) && (fmt_index < _SG_PIXELFORMAT_NUM));
-    return _sg.formats[fmt_index];
+_SOKOL_PRIVATE void _sg_filter_commit(void) {
+    _sg.filter.prev_stats = _sg.filter.cur_stats;
+    _sg.filter.prev_stats.frame_index = _sg.frame_index;
+    memset(&_sg.filter.cur_stats, 0, sizeof(_sg.filter.cur_stats));
 }
 
-SOKOL_API_IMPL sg_context sg_setup_context(void) {
-    SOKOL_ASSERT(_sg.valid);
-    sg_context res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.context_pool);
-    if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.context_pool, &_sg.pools.contexts[slot_index].slot, slot_index);
-        _sg_context_t* ctx = _sg_context_at(&_sg.pools, res.id);
-        ctx->slot.state = _sg_create_context(ctx);
-        SOKOL_ASSERT(ctx->slot.state == SG_RESOURCESTATE_VALID);
-        _sg_activate_context(ctx);
+/*== FRAME STATISTICS ========================================================*/
+_SOKOL_PRIVATE void _sg_setup_stats(const sg_desc* desc) {
+    SOKOL_ASSERT(desc && (desc->frame_stats_history >= 0));
+    if (desc->frame_stats_history > 0) {
+        const size_t num_bytes = (size_t)desc->frame_stats_history * sizeof(sg_frame_stats);
+        _sg.stats.history = (sg_frame_stats*) SOKOL_MALLOC(num_bytes);
+        SOKOL_ASSERT(_sg.stats.history);
+        memset(_sg.stats.history, 0, num_bytes);
+        _sg.stats.history_size = desc->frame_stats_history;
     }
-    else {
-        /* pool is exhausted */
-        res.id = SG_INVALID_ID;
+}
+
+_SOKOL_PRIVATE void _sg_discard_stats(void) {
+    if (_sg.stats.history) {
+        SOKOL_FREE(_sg.stats.history);
+        _sg.stats.history = 0;
     }
-    _sg.active_context = res;
-    return res;
 }
 
-SOKOL_API_IMPL void sg_discard_context(sg_context ctx_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_destroy_all_resources(&_sg.pools, ctx_id.id);
-    _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, ctx_id.id);
-    if (ctx) {
-        _sg_destroy_context(ctx);
-        _sg_reset_context(ctx);
-        _sg_reset_slot(&ctx->slot);
-        _sg_pool_free_index(&_sg.pools.context_pool, _sg_slot_index(ctx_id.id));
+_SOKOL_PRIVATE size_t _sg_image_data_size(const sg_image_data* data) {
+    size_t size = 0;
+    for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
+        for (int mip_index = 0; mip_index < SG_MAX_MIPMAPS; mip_index++) {
+            size += data->subimage[face_index][mip_index].size;
+        }
     }
-    _sg.active_context.id = SG_INVALID_ID;
-    _sg_activate_context(0);
+    return size;
 }
 
-SOKOL_API_IMPL void sg_activate_context(sg_context ctx_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg.active_context = ctx_id;
-    _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, ctx_id.id);
-    /* NOTE: ctx can be 0 here if the context is no longer valid */
-    _sg_activate_context(ctx);
+_SOKOL_PRIVATE void _sg_stats_commit(void) {
+    _sg.stats.cur.frame_index = _sg.frame_index;
+    _sg.stats.prev = _sg.stats.cur;
+    if (_sg.stats.history_size > 0) {
+        _sg.stats.history[_sg.frame_index % (uint32_t)_sg.stats.history_size] = _sg.stats.cur;
+        if (_sg.stats.history_count < _sg.stats.history_size) {
+            _sg.stats.history_count++;
+        }
+    }
+    memset(&_sg.stats.cur, 0, sizeof(_sg.stats.cur));
 }
 
-SOKOL_API_IMPL sg_trace_hooks sg_install_trace_hooks(const sg_trace_hooks* trace_hooks) {
-    SOKOL_ASSERT(_sg.valid);
-    SOKOL_ASSERT(trace_hooks);
-    _SOKOL_UNUSED(trace_hooks);
-    #if defined(SOKOL_TRACE_HOOKS)
-        sg_trace_hooks old_hooks = _sg.hooks;
-        _sg.hooks = *trace_hooks;
-    #else
-        static sg_trace_hooks old_hooks;
-        SOKOL_LOG("sg_install_trace_hooks() called, but SG_TRACE_HOOKS is not defined!");
-    #endif
-    return old_hooks;
+/*== TRANSIENT BUFFERS =======================================================*/
+_SOKOL_PRIVATE sg_buffer _sg_make_transient_buffer(sg_buffer_type type, int size, const char* label) {
+    sg_buffer res = { SG_INVALID_ID };
+    if (size > 0) {
+        sg_buffer_desc desc;
+        memset(&desc, 0, sizeof(desc));
+        desc.size = (size_t)size;
+        desc.type = type;
+        desc.usage = SG_USAGE_STREAM;
+        desc.label = label;
+        res = sg_make_buffer(&desc);
+        SOKOL_ASSERT(sg_query_buffer_state(res) == SG_RESOURCESTATE_VALID);
+    }
+    return res;
 }
 
-SOKOL_API_IMPL sg_buffer sg_alloc_buffer(void) {
+/* needs to be called after the default context has been created */
+_SOKOL_PRIVATE void _sg_setup_transient(const sg_desc* desc) {
+    SOKOL_ASSERT(desc);
+    _sg.transient.vbuf = _sg_make_transient_buffer(SG_BUFFERTYPE_VERTEXBUFFER, desc->transient_vertex_buffer_size, "sg-transient-vertices");
+    _sg.transient.ibuf = _sg_make_transient_buffer(SG_BUFFERTYPE_INDEXBUFFER, desc->transient_index_buffer_size, "sg-transient-indices");
+}
+
+/* returns the current frame's append position in a stream buffer */
+_SOKOL_PRIVATE int _sg_transient_pos(const _sg_buffer_t* buf) {
+    return (buf->cmn.append_frame_index == _sg.frame_index) ? buf->cmn.append_pos : 0;
+}
+
+/* internal append into the transient vertex buffer which bypasses
+   sg_append_buffer(), so that it isn't counted in the append stats and
+   doesn't show up in the append_buffer trace hook, returns the offset
+   or -1 if the transient vertex buffer is exhausted
+*/
+_SOKOL_PRIVATE int _sg_transient_append_vertices(const sg_range* data) {
+    SOKOL_ASSERT(data && data->ptr && (data->size > 0));
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, _sg.transient.vbuf.id);
+    if (!buf || (buf->slot.state != SG_RESOURCESTATE_VALID)) {
+        return -1;
+    }
+    const int pos = _sg_transient_pos(buf);
+    if ((pos + _sg_roundup((int)data->size, 4)) > buf->cmn.size) {
+        if (_sg.transient.overflow_frame_index != _sg.frame_index) {
+            _sg.transient.overflow_frame_index = _sg.frame_index;
+            SOKOL_LOG("sg_alloc_transient: transient buffer exhausted (increase sg_desc.transient_vertex/index_buffer_size)");
+        }
+        return -1;
+    }
+    const bool new_frame = buf->cmn.append_frame_index != _sg.frame_index;
+    const int active_slot = buf->cmn.active_slot;
+    buf->cmn.append_pos = pos + _sg_append_buffer(buf, data, new_frame);
+    buf->cmn.append_frame_index = _sg.frame_index;
+    if (new_frame) {
+        buf->cmn.append_overflow = false;
+    }
+    if (active_slot != buf->cmn.active_slot) {
+        _sg_filter_reset_bindings();
+    }
+    return pos;
+}
+
+/*== AUTO-INSTANCING =========================================================*/
+
+/* needs to be called after the transient buffers have been created */
+_SOKOL_PRIVATE void _sg_setup_instancing(const sg_desc* desc) {
+    SOKOL_ASSERT(desc);
+    if (desc->transient_vertex_buffer_size > 0) {
+        _sg.instancing.staging_size = _sg_min(desc->transient_vertex_buffer_size, _SG_INSTANCING_STAGING_SIZE);
+        _sg.instancing.staging = (uint8_t*) SOKOL_MALLOC((size_t)_sg.instancing.staging_size);
+        SOKOL_ASSERT(_sg.instancing.staging);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_discard_instancing(void) {
+    if (_sg.instancing.staging) {
+        SOKOL_FREE(_sg.instancing.staging);
+        _sg.instancing.staging = 0;
+    }
+}
+
+/* emit the collected draws as a single instanced draw call */
+_SOKOL_PRIVATE void _sg_instancing_flush(void) {
+    _sg_instancing_t* inst = &_sg.instancing;
+    if (0 == inst->num_instances) {
+        return;
+    }
+    const int num_instances = inst->num_instances;
+    inst->num_instances = 0;
+    inst->pos = 0;
+    sg_range data;
+    data.ptr = inst->staging;
+    data.size = (size_t)(num_instances * inst->record_size);
+    const int offset = _sg_transient_append_vertices(&data);
+    if (offset < 0) {
+        /* transient vertex buffer exhausted, draws are dropped */
+        return;
+    }
+    sg_bindings b = inst->bindings;
+    b.vertex_buffers[inst->buffer_index] = _sg.transient.vbuf;
+    b.vertex_buffer_offsets[inst->buffer_index] = offset;
+
+    /* all resources are still alive, since destroying a resource flushes pending draws */
+    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, inst->pip.id);
+    SOKOL_ASSERT(pip);
+    _sg_buffer_t* vbs[SG_MAX_SHADERSTAGE_BUFFERS] = { 0 };
+    const int num_vbs = inst->buffer_index + 1;
+    for (int i = 0; i < num_vbs; i++) {
+        vbs[i] = _sg_lookup_buffer(&_sg.pools, b.vertex_buffers[i].id);
+        SOKOL_ASSERT(vbs[i]);
+    }
+    _sg_buffer_t* ib = 0;
+    if (b.index_buffer.id) {
+        ib = _sg_lookup_buffer(&_sg.pools, b.index_buffer.id);
+        SOKOL_ASSERT(ib);
+    }
+    _sg_image_t* vs_imgs[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
+    _sg_sampler_t* vs_smps[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
+    int num_vs_imgs = 0;
+    for (; (num_vs_imgs < SG_MAX_SHADERSTAGE_IMAGES) && b.vs_images[num_vs_imgs].id; num_vs_imgs++) {
+        vs_imgs[num_vs_imgs] = _sg_lookup_image(&_sg.pools, b.vs_images[num_vs_imgs].id);
+        SOKOL_ASSERT(vs_imgs[num_vs_imgs]);
+        if (b.vs_samplers[num_vs_imgs].id) {
+            vs_smps[num_vs_imgs] = _sg_lookup_sampler(&_sg.pools, b.vs_samplers[num_vs_imgs].id);
+            SOKOL_ASSERT(vs_smps[num_vs_imgs]);
+        }
+    }
+    _sg_image_t* fs_imgs[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
+    _sg_sampler_t* fs_smps[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
+    int num_fs_imgs = 0;
+    for (; (num_fs_imgs < SG_MAX_SHADERSTAGE_IMAGES) && b.fs_images[num_fs_imgs].id; num_fs_imgs++) {
+        fs_imgs[num_fs_imgs] = _sg_lookup_image(&_sg.pools, b.fs_images[num_fs_imgs].id);
+        SOKOL_ASSERT(fs_imgs[num_fs_imgs]);
+        if (b.fs_samplers[num_fs_imgs].id) {
+            fs_smps[num_fs_imgs] = _sg_lookup_sampler(&_sg.pools, b.fs_samplers[num_fs_imgs].id);
+            SOKOL_ASSERT(fs_smps[num_fs_imgs]);
+        }
+    }
+    _sg_apply_bindings(pip, vbs, b.vertex_buffer_offsets, num_vbs, ib, b.index_buffer_offset, vs_imgs, vs_smps, num_vs_imgs, fs_imgs, fs_smps, num_fs_imgs);
+    /* the backend bindings no longer match what the state filter has recorded */
+    _sg_filter_reset_bindings();
+    _sg_draw(inst->base_element, inst->num_elements, num_instances, inst->base_vertex);
+    _sg.stats.cur.num_instancing_batches++;
+}
+
+/* flush pending draws and stop collecting, called at the end of a pass */
+_SOKOL_PRIVATE void _sg_instancing_reset(void) {
+    _sg_instancing_flush();
+    _sg.instancing.active = false;
+    _sg.instancing.pip.id = SG_INVALID_ID;
+    _sg.instancing.bindings_valid = false;
+}
+
+_SOKOL_PRIVATE void _sg_instancing_apply_pipeline(const _sg_pipeline_t* pip) {
+    SOKOL_ASSERT(pip && pip->shader);
+    _sg_instancing_t* inst = &_sg.instancing;
+    if (inst->pip.id == pip->slot.id) {
+        /* same pipeline, keep collecting */
+        return;
+    }
+    _sg_instancing_reset();
+    const _sg_shader_common_t* shd_cmn = &pip->shader->cmn;
+    /* without a transient vertex buffer there's no staging memory, fall back to regular draws */
+    if (shd_cmn->instancing && (0 != inst->staging)) {
+        inst->active = true;
+        inst->pip.id = pip->slot.id;
+        inst->ub_index = shd_cmn->instancing_ub_index;
+        inst->buffer_index = shd_cmn->instancing_buffer_index;
+        inst->record_size = (int) shd_cmn->stage[SG_SHADERSTAGE_VS].uniform_blocks[inst->ub_index].size;
+        SOKOL_ASSERT((inst->record_size > 0) && (inst->record_size <= _SG_INSTANCING_MAX_RECORD_SIZE));
+        memset(inst->record, 0, sizeof(inst->record));
+    }
+}
+
+_SOKOL_PRIVATE void _sg_instancing_apply_bindings(const sg_bindings* bindings) {
+    SOKOL_ASSERT(bindings);
+    _sg_instancing_t* inst = &_sg.instancing;
+    if (inst->bindings_valid && (0 == memcmp(&inst->bindings, bindings, sizeof(sg_bindings)))) {
+        return;
+    }
+    _sg_instancing_flush();
+    inst->bindings = *bindings;
+    inst->bindings_valid = true;
+}
+
+/* returns true if the uniform data has been captured as per-instance data */
+_SOKOL_PRIVATE bool _sg_instancing_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data) {
+    _sg_instancing_t* inst = &_sg.instancing;
+    if (!inst->active || (stage != SG_SHADERSTAGE_VS) || (ub_index != inst->ub_index)) {
+        return false;
+    }
+    SOKOL_ASSERT(data->size == (size_t)inst->record_size);
+    memcpy(inst->record, data->ptr, data->size);
+    return true;
+}
+
+_SOKOL_PRIVATE void _sg_instancing_draw(int base_element, int num_elements, int num_instances, int base_vertex) {
+    _sg_instancing_t* inst = &_sg.instancing;
+    SOKOL_ASSERT(inst->active && inst->bindings_valid && inst->staging);
+    if ((base_element != inst->base_element) || (num_elements != inst->num_elements) || (base_vertex != inst->base_vertex)) {
+        _sg_instancing_flush();
+        inst->base_element = base_element;
+        inst->num_elements = num_elements;
+        inst->base_vertex = base_vertex;
+    }
+    for (int i = 0; i < num_instances; i++) {
+        if ((inst->pos + inst->record_size) > inst->staging_size) {
+            _sg_instancing_flush();
+        }
+        memcpy(inst->staging + inst->pos, inst->record, (size_t)inst->record_size);
+        inst->pos += inst->record_size;
+        inst->num_instances++;
+    }
+}
+
+/*== COMMAND LISTS ===========================================================*/
+
+/*
+    Recorded commands are stored back to back in the command list memory,
+    each command starts with an 8-byte header followed by the command
+    payload, the size of each command is rounded up to _SG_CMD_ALIGN.
+
+    NOTE: the recording functions must not access the global _sg state,
+    since they may be called from any thread!
+*/
+enum {
+    _SG_CMD_ALIGN = 8,
+};
+
+typedef enum {
+    _SG_CMD_APPLY_VIEWPORT,
+    _SG_CMD_APPLY_SCISSOR_RECT,
+    _SG_CMD_APPLY_PIPELINE,
+    _SG_CMD_APPLY_BINDINGS,
+    _SG_CMD_APPLY_UNIFORMS,
+    _SG_CMD_DRAW,
+    _SG_CMD_DRAW_BATCH,
+    _SG_CMD_APPLY_PREPARED_BINDINGS,
+    _SG_CMD_DISPATCH,
+    _SG_CMD_UPDATE_IMAGE_REGION,
+} _sg_cmd_type_t;
+
+typedef struct {
+    uint32_t type;      /* _sg_cmd_type_t */
+    uint32_t size;      /* overall size including header and alignment padding */
+} _sg_cmd_t;
+
+typedef struct {
+    int x, y, width, height;
+    bool origin_top_left;
+} _sg_cmd_rect_t;
+
+typedef struct {
+    sg_shader_stage stage;
+    int ub_index;
+    size_t size;
+    /* followed by uniform data */
+} _sg_cmd_apply_uniforms_t;
+
+typedef struct {
+    int base_element;
+    int num_elements;
+    int num_instances;
+    int base_vertex;
+} _sg_cmd_draw_t;
+
+typedef struct {
+    int count;
+    /* followed by sg_draw_range items */
+} _sg_cmd_draw_batch_t;
+
+typedef struct {
+    int num_groups_x;
+    int num_groups_y;
+    int num_groups_z;
+} _sg_cmd_dispatch_t;
+
+typedef struct {
+    sg_image img;
+    sg_image_region region;
+    size_t size;
+    /* followed by pixel data */
+} _sg_cmd_update_image_region_t;
+
+/* allocate a new command in command list, returns pointer to payload, or null on overflow */
+_SOKOL_PRIVATE void* _sg_cmd_alloc(sg_command_list* cl, _sg_cmd_type_t type, size_t payload_size) {
+    SOKOL_ASSERT(cl && cl->ptr);
+    if (cl->overflow) {
+        return 0;
+    }
+    const size_t cmd_size = (sizeof(_sg_cmd_t) + payload_size + (_SG_CMD_ALIGN - 1)) & ~((size_t)_SG_CMD_ALIGN - 1);
+    if ((cl->pos + cmd_size) > cl->size) {
+        cl->overflow = true;
+        return 0;
+    }
+    _sg_cmd_t* cmd = (_sg_cmd_t*) (cl->ptr + cl->pos);
+    cmd->type = (uint32_t) type;
+    cmd->size = (uint32_t) cmd_size;
+    cl->pos += cmd_size;
+    cl->num_commands++;
+    return cmd + 1;
+}
+
+_SOKOL_PRIVATE void _sg_cmd_record_rect(sg_command_list* cl, _sg_cmd_type_t type, int x, int y, int width, int height, bool origin_top_left) {
+    _sg_cmd_rect_t* cmd = (_sg_cmd_rect_t*) _sg_cmd_alloc(cl, type, sizeof(_sg_cmd_rect_t));
+    if (cmd) {
+        cmd->x = x;
+        cmd->y = y;
+        cmd->width = width;
+        cmd->height = height;
+        cmd->origin_top_left = origin_top_left;
+    }
+}
+
+/* replay a recorded command list through the regular public API functions */
+_SOKOL_PRIVATE void _sg_submit_command_list(const sg_command_list* cl) {
+    SOKOL_ASSERT(cl);
+    #if defined(SOKOL_DEBUG)
+        if (cl->overflow) {
+            SOKOL_LOG("sg_submit_command_lists: command list has overflown, some commands have been dropped");
+        }
+    #endif
+    size_t pos = 0;
+    while (pos < cl->pos) {
+        const _sg_cmd_t* cmd = (const _sg_cmd_t*) (cl->ptr + pos);
+        SOKOL_ASSERT((cmd->size >= sizeof(_sg_cmd_t)) && ((pos + cmd->size) <= cl->pos));
+        const void* payload = cmd + 1;
+        switch ((_sg_cmd_type_t)cmd->type) {
+            case _SG_CMD_APPLY_VIEWPORT:
+                {
+                    const _sg_cmd_rect_t* rect = (const _sg_cmd_rect_t*) payload;
+                    sg_apply_viewport(rect->x, rect->y, rect->width, rect->height, rect->origin_top_left);
+                }
+                break;
+            case _SG_CMD_APPLY_SCISSOR_RECT:
+                {
+                    const _sg_cmd_rect_t* rect = (const _sg_cmd_rect_t*) payload;
+                    sg_apply_scissor_rect(rect->x, rect->y, rect->width, rect->height, rect->origin_top_left);
+                }
+                break;
+            case _SG_CMD_APPLY_PIPELINE:
+                sg_apply_pipeline(*(const sg_pipeline*)payload);
+                break;
+            case _SG_CMD_APPLY_BINDINGS:
+                sg_apply_bindings((const sg_bindings*)payload);
+                break;
+            case _SG_CMD_APPLY_UNIFORMS:
+                {
+                    const _sg_cmd_apply_uniforms_t* ub = (const _sg_cmd_apply_uniforms_t*) payload;
+                    sg_range data;
+                    data.ptr = ub + 1;
+                    data.size = ub->size;
+                    sg_apply_uniforms(ub->stage, ub->ub_index, &data);
+                }
+                break;
+            case _SG_CMD_DRAW:
+                {
+                    const _sg_cmd_draw_t* draw = (const _sg_cmd_draw_t*) payload;
+                    sg_draw_ex(draw->base_element, draw->num_elements, draw->num_instances, draw->base_vertex);
+                }
+                break;
+            case _SG_CMD_DRAW_BATCH:
+                {
+                    const _sg_cmd_draw_batch_t* batch = (const _sg_cmd_draw_batch_t*) payload;
+                    sg_draw_batch((const sg_draw_range*)(batch + 1), batch->count);
+                }
+                break;
+            case _SG_CMD_APPLY_PREPARED_BINDINGS:
+                sg_apply_prepared_bindings((const sg_prepared_bindings*)payload);
+                break;
+            case _SG_CMD_DISPATCH:
+                {
+                    const _sg_cmd_dispatch_t* dispatch = (const _sg_cmd_dispatch_t*) payload;
+                    sg_dispatch(dispatch->num_groups_x, dispatch->num_groups_y, dispatch->num_groups_z);
+                }
+                break;
+            case _SG_CMD_UPDATE_IMAGE_REGION:
+                {
+                    const _sg_cmd_update_image_region_t* upd = (const _sg_cmd_update_image_region_t*) payload;
+                    sg_range data;
+                    data.ptr = upd + 1;
+                    data.size = upd->size;
+                    sg_update_image_region(upd->img, upd->region.mip_level, upd->region.slice, upd->region.x, upd->region.y, upd->region.width, upd->region.height, &data);
+                }
+                break;
+            default:
+                SOKOL_UNREACHABLE;
+                break;
+        }
+        pos += cmd->size;
+    }
+}
+
+/*== GPU TIMING ==============================================================*/
+_SOKOL_PRIVATE void _sg_setup_timing(const sg_desc* desc) {
+    SOKOL_ASSERT(desc);
+    _sg.timing.enabled = desc->enable_gpu_timing && _sg.features.gpu_timing;
+}
+
+_SOKOL_PRIVATE void _sg_timing_begin(const char* label, sg_pass pass) {
+    if (!_sg.timing.enabled) {
+        return;
+    }
+    if (_sg.timing.depth >= _SG_GPU_TIMING_MAX_DEPTH) {
+        _sg.timing.skipped_depth++;
+        return;
+    }
+    _sg_gpu_timing_frame_t* frame = &_sg.timing.frames[_sg.timing.cur_frame];
+    int timing_index = -1;
+    if (frame->num_timings < SG_MAX_GPU_TIMINGS) {
+        timing_index = frame->num_timings++;
+        sg_gpu_timing* timing = &frame->timings[timing_index];
+        timing->label = label;
+        timing->pass = pass;
+        timing->depth = _sg.timing.depth;
+        timing->duration_ns = 0;
+        _sg_write_timestamp(_sg.timing.cur_frame, timing_index * 2);
+    }
+    _sg.timing.stack[_sg.timing.depth++] = timing_index;
+}
+
+_SOKOL_PRIVATE void _sg_timing_end(void) {
+    if (!_sg.timing.enabled) {
+        return;
+    }
+    if (_sg.timing.skipped_depth > 0) {
+        _sg.timing.skipped_depth--;
+        return;
+    }
+    SOKOL_ASSERT(_sg.timing.depth > 0);
+    if (_sg.timing.depth > 0) {
+        const int timing_index = _sg.timing.stack[--_sg.timing.depth];
+        if (timing_index >= 0) {
+            _sg_write_timestamp(_sg.timing.cur_frame, timing_index * 2 + 1);
+        }
+    }
+}
+
+/* read back the results of the oldest pending frames without blocking, and start a new frame,
+   the frame which is committed right now is only polled from the next sg_commit() on
+*/
+_SOKOL_PRIVATE void _sg_timing_commit(void) {
+    if (!_sg.timing.enabled) {
+        return;
+    }
+    /* all timers must be closed before sg_commit() */
+    SOKOL_ASSERT((_sg.timing.depth == 0) && (_sg.timing.skipped_depth == 0));
+    _sg.timing.depth = 0;
+    _sg.timing.skipped_depth = 0;
+    _sg_gpu_timing_frame_t* cur_frame = &_sg.timing.frames[_sg.timing.cur_frame];
+    cur_frame->frame_index = (cur_frame->num_timings > 0) ? _sg.frame_index : 0;
+    for (int i = 1; i < _SG_GPU_TIMING_FRAMES; i++) {
+        const int frame_slot = (_sg.timing.cur_frame + i) % _SG_GPU_TIMING_FRAMES;
+        _sg_gpu_timing_frame_t* frame = &_sg.timing.frames[frame_slot];
+        if (0 == frame->frame_index) {
+            continue;
+        }
+        /* results become available in frame order */
+        if (!_sg_timestamps_available(frame_slot, frame->num_timings * 2)) {
+            break;
+        }
+        sg_gpu_timings* res = &_sg.timing.result;
+        res->frame_index = frame->frame_index;
+        res->num_timings = frame->num_timings;
+        uint64_t first_ts = 0;
+        uint64_t last_ts = 0;
+        for (int timing_index = 0; timing_index < frame->num_timings; timing_index++) {
+            const uint64_t begin_ts = _sg_read_timestamp(frame_slot, timing_index * 2);
+            const uint64_t end_ts = _sg_read_timestamp(frame_slot, timing_index * 2 + 1);
+            res->timings[timing_index] = frame->timings[timing_index];
+            res->timings[timing_index].duration_ns = (end_ts > begin_ts) ? (end_ts - begin_ts) : 0;
+            if ((0 == timing_index) || (begin_ts < first_ts)) {
+                first_ts = begin_ts;
+            }
+            if (end_ts > last_ts) {
+                last_ts = end_ts;
+            }
+        }
+        res->frame_duration_ns = (last_ts > first_ts) ? (last_ts - first_ts) : 0;
+        frame->frame_index = 0;
+    }
+    /* if the GPU is too far behind, the oldest pending results are dropped */
+    _sg.timing.cur_frame = (_sg.timing.cur_frame + 1) % _SG_GPU_TIMING_FRAMES;
+    _sg.timing.frames[_sg.timing.cur_frame].frame_index = 0;
+    _sg.timing.frames[_sg.timing.cur_frame].num_timings = 0;
+}
+
+/*== IMAGE READBACK ==========================================================*/
+/* replace a zero width or height with the remaining size of the mipmap */
+_SOKOL_PRIVATE sg_image_region _sg_image_region_defaults(const _sg_image_t* img, const sg_image_region* region) {
+    SOKOL_ASSERT(img);
+    sg_image_region res;
+    if (region) {
+        res = *region;
+    }
+    else {
+        memset(&res, 0, sizeof(res));
+    }
+    const int mip_level = _sg_max(res.mip_level, 0);
+    if (0 == res.width) {
+        res.width = _sg_max(img->cmn.width >> mip_level, 1) - res.x;
+    }
+    if (0 == res.height) {
+        res.height = _sg_max(img->cmn.height >> mip_level, 1) - res.y;
+    }
+    return res;
+}
+
+_SOKOL_PRIVATE bool _sg_readback_start(_sg_image_t* img, const sg_image_region* region, sg_read_image_callback callback, void* user_data) {
+    SOKOL_ASSERT(img && region && callback);
+    if (!_sg.features.image_readback) {
+        return false;
+    }
+    if (_sg.readback.num >= _SG_MAX_IMAGE_READBACKS) {
+        SOKOL_LOG("sg_read_image_async: too many pending readbacks");
+        return false;
+    }
+    const int index = (_sg.readback.head + _sg.readback.num) % _SG_MAX_IMAGE_READBACKS;
+    _sg_readback_t* rb = &_sg.readback.items[index];
+    memset(rb, 0, sizeof(_sg_readback_t));
+    rb->readback.image.id = img->slot.id;
+    rb->readback.region = *region;
+    rb->readback.user_data = user_data;
+    rb->callback = callback;
+    rb->num_bytes = _sg_surface_pitch(img->cmn.pixel_format, region->width, region->height, 1);
+    _sg_instancing_flush();
+    if (!_sg_read_image(index, img, rb)) {
+        return false;
+    }
+    _sg.readback.num++;
+    return true;
+}
+
+/* call the callbacks of all finished readbacks, readbacks started from
+   inside a callback are handled in the next frame
+*/
+_SOKOL_PRIVATE void _sg_readback_commit(void) {
+    const int num = _sg.readback.num;
+    for (int i = 0; i < num; i++) {
+        const int index = _sg.readback.head;
+        _sg_readback_t* rb = &_sg.readback.items[index];
+        /* readbacks finish in the order they have been started */
+        if (!_sg_readback_ready(index, rb)) {
+            break;
+        }
+        const void* ptr = _sg_map_readback(index, rb);
+        if (ptr) {
+            rb->readback.data.ptr = ptr;
+            rb->readback.data.size = (size_t)rb->num_bytes;
+        }
+        else {
+            SOKOL_LOG("sg_read_image_async: failed to map readback buffer");
+        }
+        rb->callback(&rb->readback);
+        if (ptr) {
+            _sg_unmap_readback(index, rb);
+        }
+        if (rb->data) {
+            SOKOL_FREE(rb->data);
+            rb->data = 0;
+        }
+        _sg.readback.head = (index + 1) % _SG_MAX_IMAGE_READBACKS;
+        _sg.readback.num--;
+    }
+}
+
+/* pending readbacks are dropped without calling their callback */
+_SOKOL_PRIVATE void _sg_discard_readbacks(void) {
+    for (int i = 0; i < _SG_MAX_IMAGE_READBACKS; i++) {
+        if (_sg.readback.items[i].data) {
+            SOKOL_FREE(_sg.readback.items[i].data);
+        }
+    }
+    memset(&_sg.readback, 0, sizeof(_sg.readback));
+}
+
+/*== ASYNC RESOURCE CREATION =================================================*/
+/* the ring buffer indices in sg_async_queue are free-running counters, each
+   index is only written by one side (see sg_async_queue), the other side
+   reads it with acquire semantics
+*/
+_SOKOL_PRIVATE uint32_t _sg_atomic_load(const uint32_t* ptr) {
+    #if defined(_MSC_VER)
+        return (uint32_t) _InterlockedCompareExchange((long volatile*)ptr, 0, 0);
+    #else
+        return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_atomic_store(uint32_t* ptr, uint32_t val) {
+    #if defined(_MSC_VER)
+        _InterlockedExchange((long volatile*)ptr, (long)val);
+    #else
+        __atomic_store_n(ptr, val, __ATOMIC_RELEASE);
+    #endif
+}
+
+/* monotonic time in milliseconds for the sg_drain_async_queue() time budget */
+_SOKOL_PRIVATE double _sg_clock_ms(void) {
+    #if defined(_WIN32)
+        /* not monotonic, but precise enough for a per-call budget without pulling in windows.h */
+        struct timespec ts;
+        timespec_get(&ts, TIME_UTC);
+        return ((double)ts.tv_sec * 1000.0) + ((double)ts.tv_nsec / 1000000.0);
+    #elif defined(__APPLE__) && defined(__MACH__)
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info(&timebase);
+        return ((double)mach_absolute_time() * (double)timebase.numer) / ((double)timebase.denom * 1000000.0);
+    #elif defined(__EMSCRIPTEN__)
+        return emscripten_get_now();
+    #elif defined(CLOCK_MONOTONIC)
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ((double)ts.tv_sec * 1000.0) + ((double)ts.tv_nsec / 1000000.0);
+    #else
+        /* strict ISO C without POSIX extensions, only process time is available */
+        return ((double)clock() * 1000.0) / (double)CLOCKS_PER_SEC;
+    #endif
+}
+
+_SOKOL_PRIVATE uint32_t _sg_async_pow2(int val) {
+    SOKOL_ASSERT(val > 0);
+    uint32_t res = 1;
+    while (res < (uint32_t)val) {
+        res <<= 1;
+    }
+    return res;
+}
+
+/* top up the pre-allocated handles of one resource type, render thread only */
+_SOKOL_PRIVATE void _sg_async_reserve(sg_async_queue* q, _sg_async_type_t type) {
+    const uint32_t head = _sg_atomic_load(&q->reserved_head[type]);
+    uint32_t tail = q->reserved_tail[type];
+    while ((tail - head) < q->num_reserved[type]) {
+        uint32_t id = (type == _SG_ASYNC_BUFFER) ? _sg_alloc_buffer().id : _sg_alloc_image().id;
+        if (SG_INVALID_ID == id) {
+            /* pool exhausted, try again in the next sg_drain_async_queue() */
+            break;
+        }
+        q->reserved[type][tail & (q->num_reserved[type] - 1)] = id;
+        tail++;
+    }
+    _sg_atomic_store(&q->reserved_tail[type], tail);
+}
+
+/* pop a pre-allocated handle and push a packet, worker thread only */
+_SOKOL_PRIVATE _sg_async_packet_t* _sg_async_begin_packet(sg_async_queue* q, _sg_async_type_t type) {
+    SOKOL_ASSERT(q && q->valid);
+    const uint32_t packet_tail = q->packet_tail;
+    if ((packet_tail - _sg_atomic_load(&q->packet_head)) >= q->num_packets) {
+        return 0;
+    }
+    const uint32_t res_head = q->reserved_head[type];
+    if (res_head == _sg_atomic_load(&q->reserved_tail[type])) {
+        return 0;
+    }
+    const uint32_t id = q->reserved[type][res_head & (q->num_reserved[type] - 1)];
+    _sg_atomic_store(&q->reserved_head[type], res_head + 1);
+    _sg_async_packet_t* packet = &((_sg_async_packet_t*)q->packets)[packet_tail & (q->num_packets - 1)];
+    memset(packet, 0, sizeof(_sg_async_packet_t));
+    packet->type = type;
+    packet->id = id;
+    return packet;
+}
+
+_SOKOL_PRIVATE void _sg_async_end_packet(sg_async_queue* q) {
+    _sg_atomic_store(&q->packet_tail, q->packet_tail + 1);
+}
+
+/* true if the packet's handle hasn't been destroyed since sg_async_make_*(), render thread only */
+_SOKOL_PRIVATE bool _sg_async_pending(const _sg_async_packet_t* packet) {
+    if (packet->type == _SG_ASYNC_BUFFER) {
+        const _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, packet->id);
+        return buf && (buf->slot.state == SG_RESOURCESTATE_ALLOC);
+    }
+    else {
+        const _sg_image_t* img = _sg_lookup_image(&_sg.pools, packet->id);
+        return img && (img->slot.state == SG_RESOURCESTATE_ALLOC);
+    }
+}
+
+/* size of the packet's label copy, zero if there's no label */
+_SOKOL_PRIVATE size_t _sg_async_label_size(const char* label) {
+    return label ? (strlen(label) + 1) : 0;
+}
+
+/* copy the label behind the initial content in the packet's memory block */
+_SOKOL_PRIVATE const char* _sg_async_copy_label(uint8_t* dst, const char* label) {
+    if (label) {
+        memcpy(dst, label, strlen(label) + 1);
+        return (const char*) dst;
+    }
+    return 0;
+}
+
+/*== DRAW HELPERS ============================================================*/
+/* indexed draws with a base vertex need backend support, in
+   non-indexed draws the base vertex is added to the base element
+*/
+_SOKOL_PRIVATE bool _sg_base_vertex_supported(int base_vertex) {
+    if ((0 == base_vertex) || _sg.features.base_vertex) {
+        return true;
+    }
+    const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
+    if (pip && (pip->cmn.index_type != SG_INDEXTYPE_NONE)) {
+        if (_sg.base_vertex_log_frame_index != _sg.frame_index) {
+            _sg.base_vertex_log_frame_index = _sg.frame_index;
+            SOKOL_LOG("base_vertex in indexed draws not supported (see sg_features.base_vertex)");
+        }
+        return false;
+    }
+    return true;
+}
+
+/*== PUBLIC API FUNCTIONS ====================================================*/
+
+#if defined(SOKOL_METAL)
+    // this is ARC compatible
+    #if defined(__cplusplus)
+        #define _SG_CLEAR(type, item) { item = (type) { }; }
+    #else
+        #define _SG_CLEAR(type, item) { item = (type) { 0 }; }
+    #endif
+#else
+    #define _SG_CLEAR(type, item) { memset(&item, 0, sizeof(item)); }
+#endif
+
+SOKOL_API_IMPL void sg_setup(const sg_desc* desc) {
+    SOKOL_ASSERT(desc);
+    SOKOL_ASSERT((desc->_start_canary == 0) && (desc->_end_canary == 0));
+    _SG_CLEAR(_sg_state_t, _sg);
+    _sg.desc = *desc;
+
+    /* replace zero-init items with their default values
+        NOTE: on WebGPU, the default color pixel format MUST be provided,
+        cannot be a default compile-time constant.
+    */
+    #if defined(SOKOL_WGPU)
+        SOKOL_ASSERT(SG_PIXELFORMAT_NONE != _sg.desc.context.color_format);
+    #elif defined(SOKOL_METAL) || defined(SOKOL_D3D11)
+        _sg.desc.context.color_format = _sg_def(_sg.desc.context.color_format, SG_PIXELFORMAT_BGRA8);
+    #else
+        _sg.desc.context.color_format = _sg_def(_sg.desc.context.color_format, SG_PIXELFORMAT_RGBA8);
+    #endif
+    _sg.desc.context.depth_format = _sg_def(_sg.desc.context.depth_format, SG_PIXELFORMAT_DEPTH_STENCIL);
+    _sg.desc.context.sample_count = _sg_def(_sg.desc.context.sample_count, 1);
+    _sg.desc.buffer_pool_size = _sg_def(_sg.desc.buffer_pool_size, _SG_DEFAULT_BUFFER_POOL_SIZE);
+    _sg.desc.image_pool_size = _sg_def(_sg.desc.image_pool_size, _SG_DEFAULT_IMAGE_POOL_SIZE);
+    _sg.desc.shader_pool_size = _sg_def(_sg.desc.shader_pool_size, _SG_DEFAULT_SHADER_POOL_SIZE);
+    _sg.desc.pipeline_pool_size = _sg_def(_sg.desc.pipeline_pool_size, _SG_DEFAULT_PIPELINE_POOL_SIZE);
+    _sg.desc.pass_pool_size = _sg_def(_sg.desc.pass_pool_size, _SG_DEFAULT_PASS_POOL_SIZE);
+    _sg.desc.context_pool_size = _sg_def(_sg.desc.context_pool_size, _SG_DEFAULT_CONTEXT_POOL_SIZE);
+    _sg.desc.sampler_pool_size = _sg_def(_sg.desc.sampler_pool_size, _SG_DEFAULT_SAMPLER_POOL_SIZE);
+    _sg.desc.uniform_buffer_size = _sg_def(_sg.desc.uniform_buffer_size, _SG_DEFAULT_UB_SIZE);
+    _sg.desc.staging_buffer_size = _sg_def(_sg.desc.staging_buffer_size, _SG_DEFAULT_STAGING_SIZE);
+    _sg.desc.sampler_cache_size = _sg_def(_sg.desc.sampler_cache_size, _SG_DEFAULT_SAMPLER_CACHE_CAPACITY);
+
+    _sg_setup_pools(&_sg.pools, &_sg.desc);
+    _sg.frame_index = 1;
+    _sg.filter.enabled = _sg.desc.enable_state_filter;
+    _sg_setup_stats(&_sg.desc);
+    _sg_setup_backend(&_sg.desc);
+    _sg.shader_cache.enabled = _sg.desc.enable_shader_cache && _sg.features.shader_cache;
+    if (_sg.shader_cache.enabled && _sg.desc.shader_cache_data.ptr) {
+        _sg_shdcache_load(&_sg.shader_cache, &_sg.desc.shader_cache_data);
+    }
+    /* the shader cache data only needs to be valid during sg_setup() */
+    _sg.desc.shader_cache_data.ptr = 0;
+    _sg.desc.shader_cache_data.size = 0;
+    _sg.valid = true;
+    sg_setup_context();
+    _sg_setup_transient(&_sg.desc);
+    _sg_setup_instancing(&_sg.desc);
+    _sg_setup_timing(&_sg.desc);
+    _sg_setup_destroy_queue(&_sg.desc);
+}
+
+SOKOL_API_IMPL void sg_shutdown(void) {
+    /* can only delete resources for the currently set context here, if multiple
+    contexts are used, the app code must take care of properly releasing them
+    (since only the app code can switch between 3D-API contexts)
+    */
+    if (_sg.active_context.id != SG_INVALID_ID) {
+        _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, _sg.active_context.id);
+        if (ctx) {
+            _sg_release_destroy_queue(_sg.active_context.id, true);
+            _sg_destroy_all_resources(&_sg.pools, _sg.active_context.id);
+            _sg_destroy_context(ctx);
+        }
+    }
+    _sg_discard_destroy_queue();
+    _sg_discard_readbacks();
+    _sg_discard_backend();
+    _sg_discard_instancing();
+    _sg_shdcache_discard(&_sg.shader_cache);
+    _sg_discard_stats();
+    _sg_discard_pools(&_sg.pools);
+    _sg.valid = false;
+}
+
+SOKOL_API_IMPL bool sg_isvalid(void) {
+    return _sg.valid;
+}
+
+SOKOL_API_IMPL sg_desc sg_query_desc(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.desc;
+}
+
+SOKOL_API_IMPL sg_backend sg_query_backend(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.backend;
+}
+
+SOKOL_API_IMPL sg_features sg_query_features(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.features;
+}
+
+SOKOL_API_IMPL sg_limits sg_query_limits(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.limits;
+}
+
+SOKOL_API_IMPL sg_pool_info sg_query_pool_info(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_pool_info info;
+    memset(&info, 0, sizeof(info));
+    info.slot_mask = _SG_SLOT_MASK;
+    info.buffer_pool_capacity = _sg.pools.buffer_pool.size;
+    info.image_pool_capacity = _sg.pools.image_pool.size;
+    info.sampler_pool_capacity = _sg.pools.sampler_pool.size;
+    info.shader_pool_capacity = _sg.pools.shader_pool.size;
+    info.pipeline_pool_capacity = _sg.pools.pipeline_pool.size;
+    info.pass_pool_capacity = _sg.pools.pass_pool.size;
+    info.context_pool_capacity = _sg.pools.context_pool.size;
+    return info;
+}
+
+SOKOL_API_IMPL sg_pixelformat_info sg_query_pixelformat(sg_pixel_format fmt) {
+    SOKOL_ASSERT(_sg.valid);
+    int fmt_index = (int) fmt;
+    SOKOL_ASSERT((fmt_index > SG_PIXELFORMAT_NONE) && (fmt_index < _SG_PIXELFORMAT_NUM));
+    return _sg.formats[fmt_index];
+}
+
+SOKOL_API_IMPL sg_context sg_setup_context(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_context res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.context_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        _sg_context_t* ctx = (_sg_context_t*) _sg_pool_item(&_sg.pools.context_pool, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.context_pool, &ctx->slot, slot_index);
+        ctx->slot.state = _sg_create_context(ctx);
+        SOKOL_ASSERT(ctx->slot.state == SG_RESOURCESTATE_VALID);
+        _sg_activate_context(ctx);
+    }
+    else {
+        /* pool is exhausted */
+        res.id = SG_INVALID_ID;
+    }
+    _sg.active_context = res;
+    return res;
+}
+
+SOKOL_API_IMPL void sg_discard_context(sg_context ctx_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_release_destroy_queue(ctx_id.id, true);
+    _sg_destroy_all_resources(&_sg.pools, ctx_id.id);
+    _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, ctx_id.id);
+    if (ctx) {
+        _sg_destroy_context(ctx);
+        _sg_reset_context(ctx);
+        _sg_reset_slot(&ctx->slot);
+        _sg_pool_free_index(&_sg.pools.context_pool, _sg_slot_index(ctx_id.id));
+    }
+    _sg.active_context.id = SG_INVALID_ID;
+    _sg_activate_context(0);
+}
+
+SOKOL_API_IMPL void sg_activate_context(sg_context ctx_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg.active_context = ctx_id;
+    _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, ctx_id.id);
+    /* NOTE: ctx can be 0 here if the context is no longer valid */
+    _sg_activate_context(ctx);
+    _sg_filter_reset();
+}
+
+SOKOL_API_IMPL sg_trace_hooks sg_install_trace_hooks(const sg_trace_hooks* trace_hooks) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(trace_hooks);
+    _SOKOL_UNUSED(trace_hooks);
+    #if defined(SOKOL_TRACE_HOOKS)
+        sg_trace_hooks old_hooks = _sg.hooks;
+        _sg.hooks = *trace_hooks;
+    #else
+        static sg_trace_hooks old_hooks;
+        SOKOL_LOG("sg_install_trace_hooks() called, but SG_TRACE_HOOKS is not defined!");
+    #endif
+    return old_hooks;
+}
+
+SOKOL_API_IMPL sg_buffer sg_alloc_buffer(void) {
     SOKOL_ASSERT(_sg.valid);
     sg_buffer res = _sg_alloc_buffer();
     _SG_TRACE_ARGS(alloc_buffer, res);
@@ -14889,6 +21262,13 @@ SOKOL_API_IMPL sg_pass sg_alloc_pass(void) {
     return res;
 }
 
+SOKOL_API_IMPL sg_sampler sg_alloc_sampler(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_sampler res = _sg_alloc_sampler();
+    _SG_TRACE_ARGS(alloc_sampler, res);
+    return res;
+}
+
 SOKOL_API_IMPL void sg_dealloc_buffer(sg_buffer buf_id) {
     SOKOL_ASSERT(_sg.valid);
     _sg_dealloc_buffer(buf_id);
@@ -14919,6 +21299,12 @@ SOKOL_API_IMPL void sg_dealloc_pass(sg_pass pass_id) {
     _SG_TRACE_ARGS(dealloc_pass, pass_id);
 }
 
+SOKOL_API_IMPL void sg_dealloc_sampler(sg_sampler smp_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_dealloc_sampler(smp_id);
+    _SG_TRACE_ARGS(dealloc_sampler, smp_id);
+}
+
 SOKOL_API_IMPL void sg_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc) {
     SOKOL_ASSERT(_sg.valid);
     sg_buffer_desc desc_def = _sg_buffer_desc_defaults(desc);
@@ -14947,6 +21333,13 @@ SOKOL_API_IMPL void sg_init_pipeline(sg_pipeline pip_id, const sg_pipeline_desc*
     _SG_TRACE_ARGS(init_pipeline, pip_id, &desc_def);
 }
 
+SOKOL_API_IMPL void sg_init_compute_pipeline(sg_pipeline pip_id, const sg_compute_pipeline_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_compute_pipeline_desc desc_def = _sg_compute_pipeline_desc_defaults(desc);
+    _sg_init_compute_pipeline(pip_id, &desc_def);
+    _SG_TRACE_ARGS(init_compute_pipeline, pip_id, &desc_def);
+}
+
 SOKOL_API_IMPL void sg_init_pass(sg_pass pass_id, const sg_pass_desc* desc) {
     SOKOL_ASSERT(_sg.valid);
     sg_pass_desc desc_def = _sg_pass_desc_defaults(desc);
@@ -14954,6 +21347,13 @@ SOKOL_API_IMPL void sg_init_pass(sg_pass pass_id, const sg_pass_desc* desc) {
     _SG_TRACE_ARGS(init_pass, pass_id, &desc_def);
 }
 
+SOKOL_API_IMPL void sg_init_sampler(sg_sampler smp_id, const sg_sampler_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_sampler_desc desc_def = _sg_sampler_desc_defaults(desc);
+    _sg_init_sampler(smp_id, &desc_def);
+    _SG_TRACE_ARGS(init_sampler, smp_id, &desc_def);
+}
+
 SOKOL_API_IMPL bool sg_uninit_buffer(sg_buffer buf_id) {
     SOKOL_ASSERT(_sg.valid);
     bool res = _sg_uninit_buffer(buf_id);
@@ -14989,6 +21389,13 @@ SOKOL_API_IMPL bool sg_uninit_pass(sg_pass pass_id) {
     return res;
 }
 
+SOKOL_API_IMPL bool sg_uninit_sampler(sg_sampler smp_id) {
+    SOKOL_ASSERT(_sg.valid);
+    bool res = _sg_uninit_sampler(smp_id);
+    _SG_TRACE_ARGS(uninit_sampler, smp_id);
+    return res;
+}
+
 /*-- set allocated resource to failed state ----------------------------------*/
 SOKOL_API_IMPL void sg_fail_buffer(sg_buffer buf_id) {
     SOKOL_ASSERT(_sg.valid);
@@ -15040,6 +21447,16 @@ SOKOL_API_IMPL void sg_fail_pass(sg_pass pass_id) {
     _SG_TRACE_ARGS(fail_pass, pass_id);
 }
 
+SOKOL_API_IMPL void sg_fail_sampler(sg_sampler smp_id) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(smp_id.id != SG_INVALID_ID);
+    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
+    SOKOL_ASSERT(smp && smp->slot.state == SG_RESOURCESTATE_ALLOC);
+    smp->slot.ctx_id = _sg.active_context.id;
+    smp->slot.state = SG_RESOURCESTATE_FAILED;
+    _SG_TRACE_ARGS(fail_sampler, smp_id);
+}
+
 /*-- get resource state */
 SOKOL_API_IMPL sg_resource_state sg_query_buffer_state(sg_buffer buf_id) {
     SOKOL_ASSERT(_sg.valid);
@@ -15055,6 +21472,15 @@ SOKOL_API_IMPL sg_resource_state sg_query_image_state(sg_image img_id) {
     return res;
 }
 
+SOKOL_API_IMPL bool sg_query_image_upload_done(sg_image img_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img && (img->slot.state == SG_RESOURCESTATE_VALID)) {
+        return _sg_image_upload_done(img);
+    }
+    return true;
+}
+
 SOKOL_API_IMPL sg_resource_state sg_query_shader_state(sg_shader shd_id) {
     SOKOL_ASSERT(_sg.valid);
     _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
@@ -15076,6 +21502,13 @@ SOKOL_API_IMPL sg_resource_state sg_query_pass_state(sg_pass pass_id) {
     return res;
 }
 
+SOKOL_API_IMPL sg_resource_state sg_query_sampler_state(sg_sampler smp_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
+    sg_resource_state res = smp ? smp->slot.state : SG_RESOURCESTATE_INVALID;
+    return res;
+}
+
 /*-- allocate and initialize resource ----------------------------------------*/
 SOKOL_API_IMPL sg_buffer sg_make_buffer(const sg_buffer_desc* desc) {
     SOKOL_ASSERT(_sg.valid);
@@ -15141,6 +21574,22 @@ SOKOL_API_IMPL sg_pipeline sg_make_pipeline(const sg_pipeline_desc* desc) {
     return pip_id;
 }
 
+SOKOL_API_IMPL sg_pipeline sg_make_compute_pipeline(const sg_compute_pipeline_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    sg_compute_pipeline_desc desc_def = _sg_compute_pipeline_desc_defaults(desc);
+    sg_pipeline pip_id = _sg_alloc_pipeline();
+    if (pip_id.id != SG_INVALID_ID) {
+        _sg_init_compute_pipeline(pip_id, &desc_def);
+    }
+    else {
+        SOKOL_LOG("pipeline pool exhausted!");
+        _SG_TRACE_NOARGS(err_pipeline_pool_exhausted);
+    }
+    _SG_TRACE_ARGS(make_compute_pipeline, &desc_def, pip_id);
+    return pip_id;
+}
+
 SOKOL_API_IMPL sg_pass sg_make_pass(const sg_pass_desc* desc) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(desc);
@@ -15157,11 +21606,33 @@ SOKOL_API_IMPL sg_pass sg_make_pass(const sg_pass_desc* desc) {
     return pass_id;
 }
 
+SOKOL_API_IMPL sg_sampler sg_make_sampler(const sg_sampler_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    sg_sampler_desc desc_def = _sg_sampler_desc_defaults(desc);
+    sg_sampler smp_id = _sg_alloc_sampler();
+    if (smp_id.id != SG_INVALID_ID) {
+        _sg_init_sampler(smp_id, &desc_def);
+    }
+    else {
+        SOKOL_LOG("sampler pool exhausted!");
+        _SG_TRACE_NOARGS(err_sampler_pool_exhausted);
+    }
+    _SG_TRACE_ARGS(make_sampler, &desc_def, smp_id);
+    return smp_id;
+}
+
 /*-- destroy resource --------------------------------------------------------*/
 SOKOL_API_IMPL void sg_destroy_buffer(sg_buffer buf_id) {
     SOKOL_ASSERT(_sg.valid);
     _SG_TRACE_ARGS(destroy_buffer, buf_id);
-    if (_sg_uninit_buffer(buf_id)) {
+    _sg_instancing_flush();
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    if (buf && (buf->slot.state == SG_RESOURCESTATE_ALLOC)) {
+        /* allocated but not initialized yet (e.g. pending in an sg_async_queue) */
+        _sg_dealloc_buffer(buf_id);
+    }
+    else if (_sg_uninit_buffer(buf_id)) {
         _sg_dealloc_buffer(buf_id);
     }
 }
@@ -15169,7 +21640,13 @@ SOKOL_API_IMPL void sg_destroy_buffer(sg_buffer buf_id) {
 SOKOL_API_IMPL void sg_destroy_image(sg_image img_id) {
     SOKOL_ASSERT(_sg.valid);
     _SG_TRACE_ARGS(destroy_image, img_id);
-    if (_sg_uninit_image(img_id)) {
+    _sg_instancing_flush();
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img && (img->slot.state == SG_RESOURCESTATE_ALLOC)) {
+        /* allocated but not initialized yet (e.g. pending in an sg_async_queue) */
+        _sg_dealloc_image(img_id);
+    }
+    else if (_sg_uninit_image(img_id)) {
         _sg_dealloc_image(img_id);
     }
 }
@@ -15177,6 +21654,7 @@ SOKOL_API_IMPL void sg_destroy_image(sg_image img_id) {
 SOKOL_API_IMPL void sg_destroy_shader(sg_shader shd_id) {
     SOKOL_ASSERT(_sg.valid);
     _SG_TRACE_ARGS(destroy_shader, shd_id);
+    _sg_instancing_flush();
     if (_sg_uninit_shader(shd_id)) {
         _sg_dealloc_shader(shd_id);
     }
@@ -15185,6 +21663,7 @@ SOKOL_API_IMPL void sg_destroy_shader(sg_shader shd_id) {
 SOKOL_API_IMPL void sg_destroy_pipeline(sg_pipeline pip_id) {
     SOKOL_ASSERT(_sg.valid);
     _SG_TRACE_ARGS(destroy_pipeline, pip_id);
+    _sg_instancing_flush();
     if (_sg_uninit_pipeline(pip_id)) {
         _sg_dealloc_pipeline(pip_id);
     }
@@ -15198,14 +21677,132 @@ SOKOL_API_IMPL void sg_destroy_pass(sg_pass pass_id) {
     }
 }
 
+SOKOL_API_IMPL void sg_destroy_sampler(sg_sampler smp_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _SG_TRACE_ARGS(destroy_sampler, smp_id);
+    _sg_instancing_flush();
+    if (_sg_uninit_sampler(smp_id)) {
+        _sg_dealloc_sampler(smp_id);
+    }
+}
+
+/*-- batched resource creation and destruction -------------------------------*/
+SOKOL_API_IMPL void sg_make_buffers(const sg_buffer_desc* descs, int count, sg_buffer* out_bufs) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((count >= 0) && ((0 == count) || (descs && out_bufs)));
+    _sg_begin_make_buffers(descs, count);
+    for (int i = 0; i < count; i++) {
+        out_bufs[i] = sg_make_buffer(&descs[i]);
+    }
+    _sg_end_make_buffers();
+}
+
+SOKOL_API_IMPL void sg_make_images(const sg_image_desc* descs, int count, sg_image* out_imgs) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((count >= 0) && ((0 == count) || (descs && out_imgs)));
+    _sg_begin_make_images(descs, count);
+    for (int i = 0; i < count; i++) {
+        out_imgs[i] = sg_make_image(&descs[i]);
+    }
+    _sg_end_make_images();
+}
+
+SOKOL_API_IMPL void sg_make_shaders(const sg_shader_desc* descs, int count, sg_shader* out_shds) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((count >= 0) && ((0 == count) || (descs && out_shds)));
+    for (int i = 0; i < count; i++) {
+        out_shds[i] = sg_make_shader(&descs[i]);
+    }
+}
+
+SOKOL_API_IMPL void sg_make_pipelines(const sg_pipeline_desc* descs, int count, sg_pipeline* out_pips) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((count >= 0) && ((0 == count) || (descs && out_pips)));
+    for (int i = 0; i < count; i++) {
+        out_pips[i] = sg_make_pipeline(&descs[i]);
+    }
+}
+
+SOKOL_API_IMPL void sg_make_passes(const sg_pass_desc* descs, int count, sg_pass* out_passes) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((count >= 0) && ((0 == count) || (descs && out_passes)));
+    for (int i = 0; i < count; i++) {
+        out_passes[i] = sg_make_pass(&descs[i]);
+    }
+}
+
+SOKOL_API_IMPL void sg_make_samplers(const sg_sampler_desc* descs, int count, sg_sampler* out_smps) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((count >= 0) && ((0 == count) || (descs && out_smps)));
+    for (int i = 0; i < count; i++) {
+        out_smps[i] = sg_make_sampler(&descs[i]);
+    }
+}
+
+SOKOL_API_IMPL void sg_destroy_buffers(const sg_buffer* bufs, int count) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((count >= 0) && ((0 == count) || bufs));
+    _sg_begin_destroy_buffers(count);
+    for (int i = 0; i < count; i++) {
+        sg_destroy_buffer(bufs[i]);
+    }
+    _sg_end_destroy_buffers();
+}
+
+SOKOL_API_IMPL void sg_destroy_images(const sg_image* imgs, int count) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((count >= 0) && ((0 == count) || imgs));
+    _sg_begin_destroy_images(count);
+    for (int i = 0; i < count; i++) {
+        sg_destroy_image(imgs[i]);
+    }
+    _sg_end_destroy_images();
+}
+
+SOKOL_API_IMPL void sg_destroy_shaders(const sg_shader* shds, int count) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((count >= 0) && ((0 == count) || shds));
+    for (int i = 0; i < count; i++) {
+        sg_destroy_shader(shds[i]);
+    }
+}
+
+SOKOL_API_IMPL void sg_destroy_pipelines(const sg_pipeline* pips, int count) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((count >= 0) && ((0 == count) || pips));
+    for (int i = 0; i < count; i++) {
+        sg_destroy_pipeline(pips[i]);
+    }
+}
+
+SOKOL_API_IMPL void sg_destroy_passes(const sg_pass* passes, int count) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((count >= 0) && ((0 == count) || passes));
+    for (int i = 0; i < count; i++) {
+        sg_destroy_pass(passes[i]);
+    }
+}
+
+SOKOL_API_IMPL void sg_destroy_samplers(const sg_sampler* smps, int count) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((count >= 0) && ((0 == count) || smps));
+    for (int i = 0; i < count; i++) {
+        sg_destroy_sampler(smps[i]);
+    }
+}
+
 SOKOL_API_IMPL void sg_begin_default_pass(const sg_pass_action* pass_action, int width, int height) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(pass_action);
     SOKOL_ASSERT((pass_action->_start_canary == 0) && (pass_action->_end_canary == 0));
     sg_pass_action pa;
-    _sg_resolve_default_pass_action(pass_action, &pa);
+    _sg_resolve_default_pass_action(0, pass_action, &pa);
     _sg.cur_pass.id = SG_INVALID_ID;
     _sg.pass_valid = true;
+    _sg_filter_reset();
+    _sg_instancing_reset();
+    _sg.stats.cur.num_passes++;
+    _sg_timing_begin(0, _sg.cur_pass);
     _sg_begin_pass(0, &pa, width, height);
     _SG_TRACE_ARGS(begin_default_pass, pass_action, width, height);
 }
@@ -15220,14 +21817,18 @@ SOKOL_API_IMPL void sg_begin_pass(sg_pass pass_id, const sg_pass_action* pass_ac
     SOKOL_ASSERT((pass_action->_start_canary == 0) && (pass_action->_end_canary == 0));
     _sg.cur_pass = pass_id;
     _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
-    if (pass && _sg_validate_begin_pass(pass)) {
+    if (pass && _sg_validate_begin_pass(pass, pass_action)) {
         _sg.pass_valid = true;
         sg_pass_action pa;
-        _sg_resolve_default_pass_action(pass_action, &pa);
+        _sg_resolve_default_pass_action(pass, pass_action, &pa);
         const _sg_image_t* img = _sg_pass_color_image(pass, 0);
         SOKOL_ASSERT(img);
         const int w = img->cmn.width;
         const int h = img->cmn.height;
+        _sg_filter_reset();
+        _sg_instancing_reset();
+        _sg.stats.cur.num_passes++;
+        _sg_timing_begin(0, pass_id);
         _sg_begin_pass(pass, &pa, w, h);
         _SG_TRACE_ARGS(begin_pass, pass_id, pass_action);
     }
@@ -15237,12 +21838,31 @@ SOKOL_API_IMPL void sg_begin_pass(sg_pass pass_id, const sg_pass_action* pass_ac
     }
 }
 
+SOKOL_API_IMPL void sg_begin_compute_pass(void) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg.cur_pass.id = SG_INVALID_ID;
+    if (!_sg.features.compute) {
+        SOKOL_LOG("sg_begin_compute_pass: compute shaders not supported (sg_features.compute)");
+        _sg.pass_valid = false;
+        _SG_TRACE_NOARGS(err_pass_invalid);
+        return;
+    }
+    _sg.pass_valid = true;
+    _sg.compute_pass = true;
+    _sg_filter_reset();
+    _sg_instancing_reset();
+    _sg.stats.cur.num_passes++;
+    _sg_begin_compute_pass();
+    _SG_TRACE_NOARGS(begin_compute_pass);
+}
+
 SOKOL_API_IMPL void sg_apply_viewport(int x, int y, int width, int height, bool origin_top_left) {
     SOKOL_ASSERT(_sg.valid);
     if (!_sg.pass_valid) {
         _SG_TRACE_NOARGS(err_pass_invalid);
         return;
     }
+    _sg_instancing_flush();
     _sg_apply_viewport(x, y, width, height, origin_top_left);
     _SG_TRACE_ARGS(apply_viewport, x, y, width, height, origin_top_left);
 }
@@ -15257,6 +21877,7 @@ SOKOL_API_IMPL void sg_apply_scissor_rect(int x, int y, int width, int height, b
         _SG_TRACE_NOARGS(err_pass_invalid);
         return;
     }
+    _sg_instancing_flush();
     _sg_apply_scissor_rect(x, y, width, height, origin_top_left);
     _SG_TRACE_ARGS(apply_scissor_rect, x, y, width, height, origin_top_left);
 }
@@ -15281,8 +21902,13 @@ SOKOL_API_IMPL void sg_apply_pipeline(sg_pipeline pip_id) {
     _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
     SOKOL_ASSERT(pip);
     _sg.next_draw_valid = (SG_RESOURCESTATE_VALID == pip->slot.state);
+    _sg.next_draw_valid &= (pip->cmn.compute == _sg.compute_pass);
     SOKOL_ASSERT(pip->shader && (pip->shader->slot.id == pip->cmn.shader_id.id));
-    _sg_apply_pipeline(pip);
+    _sg_instancing_apply_pipeline(pip);
+    if (!_sg_filter_skip_pipeline(pip_id)) {
+        _sg_apply_pipeline(pip);
+    }
+    _sg.stats.cur.num_apply_pipeline++;
     _SG_TRACE_ARGS(apply_pipeline, pip_id);
 }
 
@@ -15290,7 +21916,7 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(bindings);
     SOKOL_ASSERT((bindings->_start_canary == 0) && (bindings->_end_canary==0));
-    if (!_sg_validate_apply_bindings(bindings)) {
+    if (!_sg_validate_apply_bindings(_sg.cur_pipeline, bindings)) {
         _sg.next_draw_valid = false;
         _SG_TRACE_NOARGS(err_draw_invalid);
         return;
@@ -15300,6 +21926,33 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
     _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
     SOKOL_ASSERT(pip);
 
+    if (pip->cmn.compute) {
+        /* compute pipelines only have storage buffer bindings */
+        _sg_buffer_t* sbufs[SG_MAX_SHADERSTAGE_STORAGE_BUFFERS] = { 0 };
+        int num_sbufs = 0;
+        for (int i = 0; i < SG_MAX_SHADERSTAGE_STORAGE_BUFFERS; i++, num_sbufs++) {
+            if (bindings->cs_storage_buffers[i].id) {
+                sbufs[i] = _sg_lookup_buffer(&_sg.pools, bindings->cs_storage_buffers[i].id);
+                SOKOL_ASSERT(sbufs[i]);
+                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == sbufs[i]->slot.state);
+            }
+            else {
+                break;
+            }
+        }
+        if (_sg.next_draw_valid) {
+            if (!_sg_filter_skip_bindings(bindings)) {
+                _sg_apply_compute_bindings(pip, sbufs, num_sbufs);
+            }
+            _sg.stats.cur.num_apply_bindings++;
+            _SG_TRACE_ARGS(apply_bindings, bindings);
+        }
+        else {
+            _SG_TRACE_NOARGS(err_draw_invalid);
+        }
+        return;
+    }
+
     _sg_buffer_t* vbs[SG_MAX_SHADERSTAGE_BUFFERS] = { 0 };
     int num_vbs = 0;
     for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++, num_vbs++) {
@@ -15323,12 +21976,18 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
     }
 
     _sg_image_t* vs_imgs[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
+    _sg_sampler_t* vs_smps[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
     int num_vs_imgs = 0;
     for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++, num_vs_imgs++) {
         if (bindings->vs_images[i].id) {
             vs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->vs_images[i].id);
             SOKOL_ASSERT(vs_imgs[i]);
             _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == vs_imgs[i]->slot.state);
+            if (bindings->vs_samplers[i].id) {
+                vs_smps[i] = _sg_lookup_sampler(&_sg.pools, bindings->vs_samplers[i].id);
+                SOKOL_ASSERT(vs_smps[i]);
+                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == vs_smps[i]->slot.state);
+            }
         }
         else {
             break;
@@ -15336,22 +21995,159 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
     }
 
     _sg_image_t* fs_imgs[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
+    _sg_sampler_t* fs_smps[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
     int num_fs_imgs = 0;
     for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++, num_fs_imgs++) {
         if (bindings->fs_images[i].id) {
             fs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->fs_images[i].id);
             SOKOL_ASSERT(fs_imgs[i]);
             _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == fs_imgs[i]->slot.state);
+            if (bindings->fs_samplers[i].id) {
+                fs_smps[i] = _sg_lookup_sampler(&_sg.pools, bindings->fs_samplers[i].id);
+                SOKOL_ASSERT(fs_smps[i]);
+                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == fs_smps[i]->slot.state);
+            }
         }
         else {
             break;
         }
     }
     if (_sg.next_draw_valid) {
-        const int* vb_offsets = bindings->vertex_buffer_offsets;
-        int ib_offset = bindings->index_buffer_offset;
-        _sg_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
-        _SG_TRACE_ARGS(apply_bindings, bindings);
+        const int* vb_offsets = bindings->vertex_buffer_offsets;
+        int ib_offset = bindings->index_buffer_offset;
+        if (_sg.instancing.active) {
+            _sg_instancing_apply_bindings(bindings);
+        }
+        else if (!_sg_filter_skip_bindings(bindings)) {
+            _sg_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, vs_smps, num_vs_imgs, fs_imgs, fs_smps, num_fs_imgs);
+        }
+        _sg.stats.cur.num_apply_bindings++;
+        _SG_TRACE_ARGS(apply_bindings, bindings);
+    }
+    else {
+        _SG_TRACE_NOARGS(err_draw_invalid);
+    }
+}
+
+SOKOL_API_IMPL sg_prepared_bindings sg_prepare_bindings(sg_pipeline pip_id, const sg_bindings* bindings) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(bindings);
+    SOKOL_ASSERT((bindings->_start_canary == 0) && (bindings->_end_canary==0));
+    sg_prepared_bindings res;
+    memset(&res, 0, sizeof(res));
+    res.bindings = *bindings;
+    res.pipeline = pip_id;
+    if (!_sg_validate_apply_bindings(pip_id, bindings)) {
+        return res;
+    }
+    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    if (0 == pip) {
+        return res;
+    }
+    res._pip = pip;
+    bool valid = true;
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++, res._num_vbs++) {
+        if (bindings->vertex_buffers[i].id) {
+            res._vbs[i] = _sg_lookup_buffer(&_sg.pools, bindings->vertex_buffers[i].id);
+            valid &= (0 != res._vbs[i]);
+        }
+        else {
+            break;
+        }
+    }
+    if (bindings->index_buffer.id) {
+        res._ib = _sg_lookup_buffer(&_sg.pools, bindings->index_buffer.id);
+        valid &= (0 != res._ib);
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++, res._num_vs_imgs++) {
+        if (bindings->vs_images[i].id) {
+            res._vs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->vs_images[i].id);
+            valid &= (0 != res._vs_imgs[i]);
+            if (bindings->vs_samplers[i].id) {
+                res._vs_smps[i] = _sg_lookup_sampler(&_sg.pools, bindings->vs_samplers[i].id);
+                valid &= (0 != res._vs_smps[i]);
+            }
+        }
+        else {
+            break;
+        }
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++, res._num_fs_imgs++) {
+        if (bindings->fs_images[i].id) {
+            res._fs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->fs_images[i].id);
+            valid &= (0 != res._fs_imgs[i]);
+            if (bindings->fs_samplers[i].id) {
+                res._fs_smps[i] = _sg_lookup_sampler(&_sg.pools, bindings->fs_samplers[i].id);
+                valid &= (0 != res._fs_smps[i]);
+            }
+        }
+        else {
+            break;
+        }
+    }
+    res.valid = valid;
+    return res;
+}
+
+SOKOL_API_IMPL void sg_apply_prepared_bindings(const sg_prepared_bindings* bindings) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(bindings);
+    if (!_sg_validate_apply_prepared_bindings(bindings)) {
+        _sg.next_draw_valid = false;
+        _SG_TRACE_NOARGS(err_draw_invalid);
+        return;
+    }
+    if (!bindings->valid || (bindings->pipeline.id != _sg.cur_pipeline.id)) {
+        _sg.next_draw_valid = false;
+        _SG_TRACE_NOARGS(err_draw_invalid);
+        return;
+    }
+    if (_sg.instancing.active || _sg.compute_pass) {
+        /* auto-instancing and compute pipelines need to look at the bindings, take the regular path */
+        sg_apply_bindings(&bindings->bindings);
+        return;
+    }
+    _sg.bindings_valid = true;
+
+    /* the pipeline is alive, since sg_apply_pipeline() was called with the same id */
+    _sg_pipeline_t* pip = (_sg_pipeline_t*) bindings->_pip;
+    SOKOL_ASSERT(pip && (pip->slot.id == _sg.cur_pipeline.id));
+    const sg_bindings* b = &bindings->bindings;
+    _sg_buffer_t* vbs[SG_MAX_SHADERSTAGE_BUFFERS] = { 0 };
+    for (int i = 0; i < bindings->_num_vbs; i++) {
+        vbs[i] = (_sg_buffer_t*) bindings->_vbs[i];
+        _sg.next_draw_valid &= _sg_prepared_buffer_alive(vbs[i], b->vertex_buffers[i]);
+    }
+    _sg_buffer_t* ib = (_sg_buffer_t*) bindings->_ib;
+    if (ib) {
+        _sg.next_draw_valid &= _sg_prepared_buffer_alive(ib, b->index_buffer);
+    }
+    _sg_image_t* vs_imgs[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
+    _sg_sampler_t* vs_smps[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
+    for (int i = 0; i < bindings->_num_vs_imgs; i++) {
+        vs_imgs[i] = (_sg_image_t*) bindings->_vs_imgs[i];
+        _sg.next_draw_valid &= _sg_prepared_image_alive(vs_imgs[i], b->vs_images[i]);
+        if (bindings->_vs_smps[i]) {
+            vs_smps[i] = (_sg_sampler_t*) bindings->_vs_smps[i];
+            _sg.next_draw_valid &= _sg_prepared_sampler_alive(vs_smps[i], b->vs_samplers[i]);
+        }
+    }
+    _sg_image_t* fs_imgs[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
+    _sg_sampler_t* fs_smps[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
+    for (int i = 0; i < bindings->_num_fs_imgs; i++) {
+        fs_imgs[i] = (_sg_image_t*) bindings->_fs_imgs[i];
+        _sg.next_draw_valid &= _sg_prepared_image_alive(fs_imgs[i], b->fs_images[i]);
+        if (bindings->_fs_smps[i]) {
+            fs_smps[i] = (_sg_sampler_t*) bindings->_fs_smps[i];
+            _sg.next_draw_valid &= _sg_prepared_sampler_alive(fs_smps[i], b->fs_samplers[i]);
+        }
+    }
+    if (_sg.next_draw_valid) {
+        if (!_sg_filter_skip_bindings(b)) {
+            _sg_apply_bindings(pip, vbs, b->vertex_buffer_offsets, bindings->_num_vbs, ib, b->index_buffer_offset, vs_imgs, vs_smps, bindings->_num_vs_imgs, fs_imgs, fs_smps, bindings->_num_fs_imgs);
+        }
+        _sg.stats.cur.num_apply_bindings++;
+        _SG_TRACE_ARGS(apply_bindings, b);
     }
     else {
         _SG_TRACE_NOARGS(err_draw_invalid);
@@ -15360,7 +22156,7 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
 
 SOKOL_API_IMPL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data) {
     SOKOL_ASSERT(_sg.valid);
-    SOKOL_ASSERT((stage == SG_SHADERSTAGE_VS) || (stage == SG_SHADERSTAGE_FS));
+    SOKOL_ASSERT((stage == SG_SHADERSTAGE_VS) || (stage == SG_SHADERSTAGE_FS) || (stage == SG_SHADERSTAGE_CS));
     SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
     SOKOL_ASSERT(data && data->ptr && (data->size > 0));
     if (!_sg_validate_apply_uniforms(stage, ub_index, data)) {
@@ -15375,11 +22171,24 @@ SOKOL_API_IMPL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const
     if (!_sg.next_draw_valid) {
         _SG_TRACE_NOARGS(err_draw_invalid);
     }
-    _sg_apply_uniforms(stage, ub_index, data);
+    if (!_sg_instancing_apply_uniforms(stage, ub_index, data) && !_sg_filter_skip_uniforms(stage, ub_index, data)) {
+        _sg_instancing_flush();
+        const int num_overflows = _sg.stats.cur.num_uniform_buffer_overflows;
+        _sg_apply_uniforms(stage, ub_index, data);
+        if (num_overflows != _sg.stats.cur.num_uniform_buffer_overflows) {
+            _sg_filter_forget_uniforms(stage, ub_index);
+        }
+    }
+    _sg.stats.cur.num_apply_uniforms++;
+    _sg.stats.cur.size_apply_uniforms += data->size;
     _SG_TRACE_ARGS(apply_uniforms, stage, ub_index, data);
 }
 
 SOKOL_API_IMPL void sg_draw(int base_element, int num_elements, int num_instances) {
+    sg_draw_ex(base_element, num_elements, num_instances, 0);
+}
+
+SOKOL_API_IMPL void sg_draw_ex(int base_element, int num_elements, int num_instances, int base_vertex) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(base_element >= 0);
     SOKOL_ASSERT(num_elements >= 0);
@@ -15389,7 +22198,7 @@ SOKOL_API_IMPL void sg_draw(int base_element, int num_elements, int num_instance
             SOKOL_LOG("attempting to draw without resource bindings");
         }
     #endif
-    if (!_sg.pass_valid) {
+    if (!_sg.pass_valid || _sg.compute_pass) {
         _SG_TRACE_NOARGS(err_pass_invalid);
         return;
     }
@@ -15408,17 +22217,123 @@ SOKOL_API_IMPL void sg_draw(int base_element, int num_elements, int num_instance
         _SG_TRACE_NOARGS(err_draw_invalid);
         return;
     }
-    _sg_draw(base_element, num_elements, num_instances);
+    if (!_sg_base_vertex_supported(base_vertex)) {
+        _SG_TRACE_NOARGS(err_draw_invalid);
+        return;
+    }
+    if (_sg.instancing.active) {
+        _sg_instancing_draw(base_element, num_elements, num_instances, base_vertex);
+    }
+    else {
+        _sg_draw(base_element, num_elements, num_instances, base_vertex);
+    }
+    _sg.stats.cur.num_draw++;
+    _sg.stats.cur.num_elements += (uint64_t)num_elements * (uint64_t)num_instances;
     _SG_TRACE_ARGS(draw, base_element, num_elements, num_instances);
 }
 
+SOKOL_API_IMPL void sg_draw_batch(const sg_draw_range* ranges, int count) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(ranges && (count >= 0));
+    #if defined(SOKOL_DEBUG)
+        /* check all ranges before anything is submitted to the backend */
+        for (int i = 0; i < count; i++) {
+            SOKOL_ASSERT(ranges[i].base_element >= 0);
+            SOKOL_ASSERT(ranges[i].num_elements >= 0);
+            SOKOL_ASSERT(ranges[i].num_instances >= 0);
+        }
+        if (!_sg.bindings_valid) {
+            SOKOL_LOG("attempting to draw without resource bindings");
+        }
+    #endif
+    if (!_sg.pass_valid || _sg.compute_pass) {
+        _SG_TRACE_NOARGS(err_pass_invalid);
+        return;
+    }
+    if (!_sg.next_draw_valid) {
+        _SG_TRACE_NOARGS(err_draw_invalid);
+        return;
+    }
+    if (!_sg.bindings_valid) {
+        _SG_TRACE_NOARGS(err_bindings_invalid);
+        return;
+    }
+    if (0 == count) {
+        return;
+    }
+    if (!_sg.features.base_vertex) {
+        for (int i = 0; i < count; i++) {
+            if (!_sg_base_vertex_supported(ranges[i].base_vertex)) {
+                _SG_TRACE_NOARGS(err_draw_invalid);
+                return;
+            }
+        }
+    }
+    if (_sg.instancing.active) {
+        for (int i = 0; i < count; i++) {
+            if (ranges[i].num_elements > 0) {
+                _sg_instancing_draw(ranges[i].base_element, ranges[i].num_elements, _sg_def(ranges[i].num_instances, 1), ranges[i].base_vertex);
+            }
+        }
+    }
+    else {
+        _sg_draw_batch(ranges, count);
+    }
+    for (int i = 0; i < count; i++) {
+        if (ranges[i].num_elements > 0) {
+            const int num_instances = _sg_def(ranges[i].num_instances, 1);
+            _sg.stats.cur.num_draw++;
+            _sg.stats.cur.num_elements += (uint64_t)ranges[i].num_elements * (uint64_t)num_instances;
+            _SG_TRACE_ARGS(draw, ranges[i].base_element, ranges[i].num_elements, num_instances);
+        }
+    }
+}
+
+SOKOL_API_IMPL void sg_dispatch(int num_groups_x, int num_groups_y, int num_groups_z) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((num_groups_x >= 0) && (num_groups_y >= 0) && (num_groups_z >= 0));
+    #if defined(SOKOL_DEBUG)
+        if (!_sg.bindings_valid) {
+            SOKOL_LOG("attempting to dispatch without resource bindings");
+        }
+    #endif
+    if (!_sg.pass_valid || !_sg.compute_pass) {
+        _SG_TRACE_NOARGS(err_pass_invalid);
+        return;
+    }
+    if (!_sg.next_draw_valid) {
+        _SG_TRACE_NOARGS(err_draw_invalid);
+        return;
+    }
+    if (!_sg.bindings_valid) {
+        _SG_TRACE_NOARGS(err_bindings_invalid);
+        return;
+    }
+    if ((0 == num_groups_x) || (0 == num_groups_y) || (0 == num_groups_z)) {
+        _SG_TRACE_NOARGS(err_draw_invalid);
+        return;
+    }
+    _sg_dispatch(num_groups_x, num_groups_y, num_groups_z);
+    _sg.stats.cur.num_dispatch++;
+    _SG_TRACE_ARGS(dispatch, num_groups_x, num_groups_y, num_groups_z);
+}
+
 SOKOL_API_IMPL void sg_end_pass(void) {
     SOKOL_ASSERT(_sg.valid);
     if (!_sg.pass_valid) {
         _SG_TRACE_NOARGS(err_pass_invalid);
         return;
     }
-    _sg_end_pass();
+    _sg_instancing_reset();
+    if (_sg.compute_pass) {
+        _sg_end_compute_pass();
+        _sg.compute_pass = false;
+    }
+    else {
+        _sg_end_pass();
+        _sg_timing_end();
+    }
+    _sg_filter_reset();
     _sg.cur_pass.id = SG_INVALID_ID;
     _sg.cur_pipeline.id = SG_INVALID_ID;
     _sg.pass_valid = false;
@@ -15428,13 +22343,319 @@ SOKOL_API_IMPL void sg_end_pass(void) {
 SOKOL_API_IMPL void sg_commit(void) {
     SOKOL_ASSERT(_sg.valid);
     _sg_commit();
+    _sg_filter_commit();
+    _sg_destroy_queue_commit();
+    _sg_memory_commit();
+    _sg_stats_commit();
+    _sg_timing_commit();
+    _sg_readback_commit();
     _SG_TRACE_NOARGS(commit);
     _sg.frame_index++;
 }
 
+SOKOL_API_IMPL void sg_init_command_list(sg_command_list* cl, void* ptr, size_t size) {
+    SOKOL_ASSERT(cl);
+    SOKOL_ASSERT(ptr && (size > 0));
+    SOKOL_ASSERT(0 == (((uintptr_t)ptr) & (_SG_CMD_ALIGN - 1)));
+    memset(cl, 0, sizeof(sg_command_list));
+    cl->ptr = (uint8_t*) ptr;
+    cl->size = size;
+}
+
+SOKOL_API_IMPL void sg_reset_command_list(sg_command_list* cl) {
+    SOKOL_ASSERT(cl && cl->ptr);
+    cl->pos = 0;
+    cl->num_commands = 0;
+    cl->overflow = false;
+}
+
+SOKOL_API_IMPL bool sg_command_list_overflow(const sg_command_list* cl) {
+    SOKOL_ASSERT(cl);
+    return cl->overflow;
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_viewport(sg_command_list* cl, int x, int y, int width, int height, bool origin_top_left) {
+    _sg_cmd_record_rect(cl, _SG_CMD_APPLY_VIEWPORT, x, y, width, height, origin_top_left);
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_scissor_rect(sg_command_list* cl, int x, int y, int width, int height, bool origin_top_left) {
+    _sg_cmd_record_rect(cl, _SG_CMD_APPLY_SCISSOR_RECT, x, y, width, height, origin_top_left);
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_pipeline(sg_command_list* cl, sg_pipeline pip_id) {
+    sg_pipeline* cmd = (sg_pipeline*) _sg_cmd_alloc(cl, _SG_CMD_APPLY_PIPELINE, sizeof(sg_pipeline));
+    if (cmd) {
+        *cmd = pip_id;
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_bindings(sg_command_list* cl, const sg_bindings* bindings) {
+    SOKOL_ASSERT(bindings);
+    SOKOL_ASSERT((bindings->_start_canary == 0) && (bindings->_end_canary==0));
+    sg_bindings* cmd = (sg_bindings*) _sg_cmd_alloc(cl, _SG_CMD_APPLY_BINDINGS, sizeof(sg_bindings));
+    if (cmd) {
+        *cmd = *bindings;
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_prepared_bindings(sg_command_list* cl, const sg_prepared_bindings* bindings) {
+    SOKOL_ASSERT(bindings);
+    sg_prepared_bindings* cmd = (sg_prepared_bindings*) _sg_cmd_alloc(cl, _SG_CMD_APPLY_PREPARED_BINDINGS, sizeof(sg_prepared_bindings));
+    if (cmd) {
+        *cmd = *bindings;
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_uniforms(sg_command_list* cl, sg_shader_stage stage, int ub_index, const sg_range* data) {
+    SOKOL_ASSERT((stage == SG_SHADERSTAGE_VS) || (stage == SG_SHADERSTAGE_FS) || (stage == SG_SHADERSTAGE_CS));
+    SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
+    SOKOL_ASSERT(data && data->ptr && (data->size > 0));
+    _sg_cmd_apply_uniforms_t* cmd = (_sg_cmd_apply_uniforms_t*) _sg_cmd_alloc(cl, _SG_CMD_APPLY_UNIFORMS, sizeof(_sg_cmd_apply_uniforms_t) + data->size);
+    if (cmd) {
+        cmd->stage = stage;
+        cmd->ub_index = ub_index;
+        cmd->size = data->size;
+        memcpy(cmd + 1, data->ptr, data->size);
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_draw(sg_command_list* cl, int base_element, int num_elements, int num_instances) {
+    sg_cmd_draw_ex(cl, base_element, num_elements, num_instances, 0);
+}
+
+SOKOL_API_IMPL void sg_cmd_draw_ex(sg_command_list* cl, int base_element, int num_elements, int num_instances, int base_vertex) {
+    SOKOL_ASSERT(base_element >= 0);
+    SOKOL_ASSERT(num_elements >= 0);
+    SOKOL_ASSERT(num_instances >= 0);
+    _sg_cmd_draw_t* cmd = (_sg_cmd_draw_t*) _sg_cmd_alloc(cl, _SG_CMD_DRAW, sizeof(_sg_cmd_draw_t));
+    if (cmd) {
+        cmd->base_element = base_element;
+        cmd->num_elements = num_elements;
+        cmd->num_instances = num_instances;
+        cmd->base_vertex = base_vertex;
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_draw_batch(sg_command_list* cl, const sg_draw_range* ranges, int count) {
+    SOKOL_ASSERT((count >= 0) && ((0 == count) || ranges));
+    const size_t ranges_size = (size_t)count * sizeof(sg_draw_range);
+    _sg_cmd_draw_batch_t* cmd = (_sg_cmd_draw_batch_t*) _sg_cmd_alloc(cl, _SG_CMD_DRAW_BATCH, sizeof(_sg_cmd_draw_batch_t) + ranges_size);
+    if (cmd) {
+        cmd->count = count;
+        if (ranges_size > 0) {
+            memcpy(cmd + 1, ranges, ranges_size);
+        }
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_dispatch(sg_command_list* cl, int num_groups_x, int num_groups_y, int num_groups_z) {
+    SOKOL_ASSERT((num_groups_x >= 0) && (num_groups_y >= 0) && (num_groups_z >= 0));
+    _sg_cmd_dispatch_t* cmd = (_sg_cmd_dispatch_t*) _sg_cmd_alloc(cl, _SG_CMD_DISPATCH, sizeof(_sg_cmd_dispatch_t));
+    if (cmd) {
+        cmd->num_groups_x = num_groups_x;
+        cmd->num_groups_y = num_groups_y;
+        cmd->num_groups_z = num_groups_z;
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_update_image_region(sg_command_list* cl, sg_image img_id, int mip_level, int slice, int x, int y, int width, int height, const sg_range* data) {
+    SOKOL_ASSERT(data && data->ptr && (data->size > 0));
+    _sg_cmd_update_image_region_t* cmd = (_sg_cmd_update_image_region_t*) _sg_cmd_alloc(cl, _SG_CMD_UPDATE_IMAGE_REGION, sizeof(_sg_cmd_update_image_region_t) + data->size);
+    if (cmd) {
+        cmd->img = img_id;
+        cmd->region.mip_level = mip_level;
+        cmd->region.slice = slice;
+        cmd->region.x = x;
+        cmd->region.y = y;
+        cmd->region.width = width;
+        cmd->region.height = height;
+        cmd->size = data->size;
+        memcpy(cmd + 1, data->ptr, data->size);
+    }
+}
+
+SOKOL_API_IMPL void sg_submit_command_lists(const sg_command_list* lists, int num_lists) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(lists && (num_lists >= 0));
+    for (int i = 0; i < num_lists; i++) {
+        _sg_submit_command_list(&lists[i]);
+    }
+}
+
+SOKOL_API_IMPL void sg_init_async_queue(sg_async_queue* q, const sg_async_queue_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(q && desc);
+    memset(q, 0, sizeof(sg_async_queue));
+    q->num_packets = _sg_async_pow2(_sg_def(desc->max_packets, _SG_DEFAULT_ASYNC_MAX_PACKETS));
+    q->num_reserved[_SG_ASYNC_BUFFER] = _sg_async_pow2(_sg_def(desc->num_reserved_buffers, _SG_DEFAULT_ASYNC_NUM_RESERVED));
+    q->num_reserved[_SG_ASYNC_IMAGE] = _sg_async_pow2(_sg_def(desc->num_reserved_images, _SG_DEFAULT_ASYNC_NUM_RESERVED));
+    q->packets = SOKOL_MALLOC(sizeof(_sg_async_packet_t) * q->num_packets);
+    SOKOL_ASSERT(q->packets);
+    for (int type = 0; type < _SG_ASYNC_NUM_TYPES; type++) {
+        q->reserved[type] = (uint32_t*) SOKOL_MALLOC(sizeof(uint32_t) * q->num_reserved[type]);
+        SOKOL_ASSERT(q->reserved[type]);
+        _sg_async_reserve(q, (_sg_async_type_t)type);
+    }
+    q->valid = true;
+}
+
+SOKOL_API_IMPL void sg_discard_async_queue(sg_async_queue* q) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(q && q->valid);
+    /* drop pending creation requests, their handles are still in the ALLOC state
+       unless they have been destroyed in the meantime
+    */
+    const uint32_t packet_tail = _sg_atomic_load(&q->packet_tail);
+    for (uint32_t i = q->packet_head; i != packet_tail; i++) {
+        _sg_async_packet_t* packet = &((_sg_async_packet_t*)q->packets)[i & (q->num_packets - 1)];
+        if (_sg_async_pending(packet)) {
+            if (packet->type == _SG_ASYNC_BUFFER) {
+                sg_buffer buf_id = { packet->id };
+                sg_dealloc_buffer(buf_id);
+            }
+            else {
+                sg_image img_id = { packet->id };
+                sg_dealloc_image(img_id);
+            }
+        }
+        if (packet->data) {
+            SOKOL_FREE(packet->data);
+        }
+    }
+    for (int type = 0; type < _SG_ASYNC_NUM_TYPES; type++) {
+        const uint32_t res_head = _sg_atomic_load(&q->reserved_head[type]);
+        for (uint32_t i = res_head; i != q->reserved_tail[type]; i++) {
+            const uint32_t id = q->reserved[type][i & (q->num_reserved[type] - 1)];
+            if (type == _SG_ASYNC_BUFFER) {
+                sg_buffer buf_id = { id };
+                sg_dealloc_buffer(buf_id);
+            }
+            else {
+                sg_image img_id = { id };
+                sg_dealloc_image(img_id);
+            }
+        }
+        SOKOL_FREE(q->reserved[type]);
+    }
+    SOKOL_FREE(q->packets);
+    memset(q, 0, sizeof(sg_async_queue));
+}
+
+/* the desc defaults are applied by sg_init_buffer()/sg_init_image() on the render thread */
+SOKOL_API_IMPL sg_buffer sg_async_make_buffer(sg_async_queue* q, const sg_buffer_desc* desc) {
+    SOKOL_ASSERT(q && desc);
+    SOKOL_ASSERT((desc->_start_canary == 0) && (desc->_end_canary == 0));
+    sg_buffer res = { SG_INVALID_ID };
+    _sg_async_packet_t* packet = _sg_async_begin_packet(q, _SG_ASYNC_BUFFER);
+    if (0 == packet) {
+        return res;
+    }
+    sg_buffer_desc copy = *desc;
+    const size_t data_size = (copy.data.ptr && (copy.data.size > 0)) ? copy.data.size : 0;
+    const size_t num_bytes = data_size + _sg_async_label_size(copy.label);
+    if (num_bytes > 0) {
+        packet->data = SOKOL_MALLOC(num_bytes);
+        SOKOL_ASSERT(packet->data);
+        uint8_t* dst = (uint8_t*) packet->data;
+        if (data_size > 0) {
+            memcpy(dst, copy.data.ptr, data_size);
+            copy.data.ptr = dst;
+        }
+        copy.label = _sg_async_copy_label(dst + data_size, copy.label);
+    }
+    packet->desc.buf = copy;
+    res.id = packet->id;
+    _sg_async_end_packet(q);
+    return res;
+}
+
+SOKOL_API_IMPL sg_image sg_async_make_image(sg_async_queue* q, const sg_image_desc* desc) {
+    SOKOL_ASSERT(q && desc);
+    SOKOL_ASSERT((desc->_start_canary == 0) && (desc->_end_canary == 0));
+    sg_image res = { SG_INVALID_ID };
+    _sg_async_packet_t* packet = _sg_async_begin_packet(q, _SG_ASYNC_IMAGE);
+    if (0 == packet) {
+        return res;
+    }
+    sg_image_desc copy = *desc;
+    /* copy all subimages and the label into one memory block */
+    size_t data_size = 0;
+    for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
+        for (int mip_index = 0; mip_index < SG_MAX_MIPMAPS; mip_index++) {
+            if (copy.data.subimage[face_index][mip_index].ptr) {
+                data_size += copy.data.subimage[face_index][mip_index].size;
+            }
+        }
+    }
+    const size_t num_bytes = data_size + _sg_async_label_size(copy.label);
+    if (num_bytes > 0) {
+        packet->data = SOKOL_MALLOC(num_bytes);
+        SOKOL_ASSERT(packet->data);
+        uint8_t* dst = (uint8_t*) packet->data;
+        for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
+            for (int mip_index = 0; mip_index < SG_MAX_MIPMAPS; mip_index++) {
+                sg_range* sub = &copy.data.subimage[face_index][mip_index];
+                if (sub->ptr) {
+                    memcpy(dst, sub->ptr, sub->size);
+                    sub->ptr = dst;
+                    dst += sub->size;
+                }
+            }
+        }
+        copy.label = _sg_async_copy_label(dst, copy.label);
+    }
+    packet->desc.img = copy;
+    res.id = packet->id;
+    _sg_async_end_packet(q);
+    return res;
+}
+
+SOKOL_API_IMPL int sg_drain_async_queue(sg_async_queue* q, double budget_ms) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(q && q->valid);
+    const double start_ms = _sg_clock_ms();
+    int num_created = 0;
+    uint32_t packet_head = q->packet_head;
+    const uint32_t packet_tail = _sg_atomic_load(&q->packet_tail);
+    /* at least one request is processed per call, so that the queue can't get stuck */
+    while (packet_head != packet_tail) {
+        _sg_async_packet_t* packet = &((_sg_async_packet_t*)q->packets)[packet_head & (q->num_packets - 1)];
+        /* the handle may have been destroyed before its creation request arrived */
+        const bool pending = _sg_async_pending(packet);
+        if (pending) {
+            if (packet->type == _SG_ASYNC_BUFFER) {
+                sg_buffer buf_id = { packet->id };
+                sg_init_buffer(buf_id, &packet->desc.buf);
+            }
+            else {
+                sg_image img_id = { packet->id };
+                sg_init_image(img_id, &packet->desc.img);
+            }
+        }
+        if (packet->data) {
+            SOKOL_FREE(packet->data);
+            packet->data = 0;
+        }
+        packet_head++;
+        _sg_atomic_store(&q->packet_head, packet_head);
+        if (pending) {
+            num_created++;
+        }
+        if ((budget_ms > 0.0) && ((_sg_clock_ms() - start_ms) >= budget_ms)) {
+            break;
+        }
+    }
+    _sg.stats.cur.num_async_created += num_created;
+    for (int type = 0; type < _SG_ASYNC_NUM_TYPES; type++) {
+        _sg_async_reserve(q, (_sg_async_type_t)type);
+    }
+    return num_created;
+}
+
 SOKOL_API_IMPL void sg_reset_state_cache(void) {
     SOKOL_ASSERT(_sg.valid);
     _sg_reset_state_cache();
+    _sg_filter_reset();
     _SG_TRACE_NOARGS(reset_state_cache);
 }
 
@@ -15445,12 +22666,19 @@ SOKOL_API_IMPL void sg_update_buffer(sg_buffer buf_id, const sg_range* data) {
     if ((data->size > 0) && buf && (buf->slot.state == SG_RESOURCESTATE_VALID)) {
         if (_sg_validate_update_buffer(buf, data)) {
             SOKOL_ASSERT(data->size <= (size_t)buf->cmn.size);
+            _sg_instancing_flush();
             /* only one update allowed per buffer and frame */
             SOKOL_ASSERT(buf->cmn.update_frame_index != _sg.frame_index);
             /* update and append on same buffer in same frame not allowed */
             SOKOL_ASSERT(buf->cmn.append_frame_index != _sg.frame_index);
+            const int active_slot = buf->cmn.active_slot;
             _sg_update_buffer(buf, data);
             buf->cmn.update_frame_index = _sg.frame_index;
+            if (active_slot != buf->cmn.active_slot) {
+                _sg_filter_reset_bindings();
+            }
+            _sg.stats.cur.num_update_buffer++;
+            _sg.stats.cur.size_update_buffer += data->size;
         }
     }
     _SG_TRACE_ARGS(update_buffer, buf_id, data);
@@ -15459,6 +22687,8 @@ SOKOL_API_IMPL void sg_update_buffer(sg_buffer buf_id, const sg_range* data) {
 SOKOL_API_IMPL int sg_append_buffer(sg_buffer buf_id, const sg_range* data) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(data && data->ptr);
+    /* pending auto-instancing draws may append to the same buffer */
+    _sg_instancing_flush();
     _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
     int result;
     if (buf) {
@@ -15476,9 +22706,15 @@ SOKOL_API_IMPL int sg_append_buffer(sg_buffer buf_id, const sg_range* data) {
                 if (!buf->cmn.append_overflow && (data->size > 0)) {
                     /* update and append on same buffer in same frame not allowed */
                     SOKOL_ASSERT(buf->cmn.update_frame_index != _sg.frame_index);
+                    const int active_slot = buf->cmn.active_slot;
                     int copied_num_bytes = _sg_append_buffer(buf, data, buf->cmn.append_frame_index != _sg.frame_index);
                     buf->cmn.append_pos += copied_num_bytes;
                     buf->cmn.append_frame_index = _sg.frame_index;
+                    if (active_slot != buf->cmn.active_slot) {
+                        _sg_filter_reset_bindings();
+                    }
+                    _sg.stats.cur.num_append_buffer++;
+                    _sg.stats.cur.size_append_buffer += (size_t)copied_num_bytes;
                 }
             }
         }
@@ -15499,19 +22735,118 @@ SOKOL_API_IMPL bool sg_query_buffer_overflow(sg_buffer buf_id) {
     return result;
 }
 
+SOKOL_API_IMPL sg_transient_range sg_alloc_transient(sg_buffer_type type, const sg_range* data) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((type == SG_BUFFERTYPE_VERTEXBUFFER) || (type == SG_BUFFERTYPE_INDEXBUFFER));
+    SOKOL_ASSERT(data && data->ptr && (data->size > 0));
+    sg_transient_range res;
+    memset(&res, 0, sizeof(res));
+    if ((type != SG_BUFFERTYPE_VERTEXBUFFER) && (type != SG_BUFFERTYPE_INDEXBUFFER)) {
+        return res;
+    }
+    _sg_instancing_flush();
+    const sg_buffer buf_id = (type == SG_BUFFERTYPE_INDEXBUFFER) ? _sg.transient.ibuf : _sg.transient.vbuf;
+    const _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    if (buf) {
+        /* check for space before appending, so that a failed allocation
+           doesn't put the buffer into the overflow state for the rest of the frame
+        */
+        if ((_sg_transient_pos(buf) + _sg_roundup((int)data->size, 4)) <= buf->cmn.size) {
+            res.offset = sg_append_buffer(buf_id, data);
+            res.buffer = buf_id;
+        }
+        else if (_sg.transient.overflow_frame_index != _sg.frame_index) {
+            _sg.transient.overflow_frame_index = _sg.frame_index;
+            SOKOL_LOG("sg_alloc_transient: transient buffer exhausted (increase sg_desc.transient_vertex/index_buffer_size)");
+        }
+    }
+    return res;
+}
+
 SOKOL_API_IMPL void sg_update_image(sg_image img_id, const sg_image_data* data) {
     SOKOL_ASSERT(_sg.valid);
     _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
     if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
         if (_sg_validate_update_image(img, data)) {
             SOKOL_ASSERT(img->cmn.upd_frame_index != _sg.frame_index);
+            _sg_instancing_flush();
+            const int active_slot = img->cmn.active_slot;
             _sg_update_image(img, data);
             img->cmn.upd_frame_index = _sg.frame_index;
+            if (active_slot != img->cmn.active_slot) {
+                _sg_filter_reset_bindings();
+            }
+            _sg.stats.cur.num_update_image++;
+            _sg.stats.cur.size_update_image += _sg_image_data_size(data);
         }
     }
     _SG_TRACE_ARGS(update_image, img_id, data);
 }
 
+SOKOL_API_IMPL void sg_update_image_region(sg_image img_id, int mip_level, int slice, int x, int y, int width, int height, const sg_range* data) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(data);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
+        sg_image_region region;
+        region.mip_level = mip_level;
+        region.slice = slice;
+        region.x = x;
+        region.y = y;
+        region.width = width;
+        region.height = height;
+        if (_sg_validate_update_image_region(img, &region, data)) {
+            if (!_sg.features.image_region_update) {
+                SOKOL_LOG("sg_update_image_region: not supported (see sg_features.image_region_update)");
+            }
+            else {
+                _sg_instancing_flush();
+                _sg_update_image_region(img, &region, data);
+                img->cmn.rgn_frame_index = _sg.frame_index;
+                #if defined(SOKOL_DEBUG)
+                _sg_track_image_region(img->slot.id, &region);
+                #endif
+                _sg.stats.cur.num_update_image_region++;
+                _sg.stats.cur.size_update_image_region += data->size;
+            }
+        }
+    }
+    _SG_TRACE_ARGS(update_image_region, img_id, mip_level, slice, x, y, width, height, data);
+}
+
+SOKOL_API_IMPL bool sg_read_image_async(sg_image img_id, const sg_image_region* region, sg_read_image_callback callback, void* user_data) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
+        const sg_image_region def_region = _sg_image_region_defaults(img, region);
+        if (_sg_validate_read_image(img, &def_region, callback)) {
+            return _sg_readback_start(img, &def_region, callback, user_data);
+        }
+    }
+    return false;
+}
+
+SOKOL_API_IMPL bool sg_read_pass_attachment_async(sg_pass pass_id, int color_index, const sg_image_region* region, sg_read_image_callback callback, void* user_data) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((color_index >= 0) && (color_index < SG_MAX_COLOR_ATTACHMENTS));
+    const _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
+    if (pass && (pass->slot.state == SG_RESOURCESTATE_VALID) && (color_index < pass->cmn.num_color_atts)) {
+        /* mip level and slice are taken from the pass attachment */
+        const _sg_pass_attachment_t* att = &pass->cmn.color_atts[color_index];
+        sg_image_region att_region;
+        if (region) {
+            att_region = *region;
+        }
+        else {
+            memset(&att_region, 0, sizeof(att_region));
+        }
+        att_region.mip_level = att->mip_level;
+        att_region.slice = att->slice;
+        return sg_read_image_async(att->image_id, &att_region, callback, user_data);
+    }
+    return false;
+}
+
 SOKOL_API_IMPL void sg_push_debug_group(const char* name) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(name);
@@ -15524,6 +22859,17 @@ SOKOL_API_IMPL void sg_pop_debug_group(void) {
     _SG_TRACE_NOARGS(pop_debug_group);
 }
 
+SOKOL_API_IMPL void sg_begin_timer(const char* label) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_pass pass = { SG_INVALID_ID };
+    _sg_timing_begin(label, pass);
+}
+
+SOKOL_API_IMPL void sg_end_timer(void) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_timing_end();
+}
+
 SOKOL_API_IMPL sg_buffer_info sg_query_buffer_info(sg_buffer buf_id) {
     SOKOL_ASSERT(_sg.valid);
     sg_buffer_info info;
@@ -15544,6 +22890,7 @@ SOKOL_API_IMPL sg_buffer_info sg_query_buffer_info(sg_buffer buf_id) {
         info.num_slots = buf->cmn.num_slots;
         info.active_slot = buf->cmn.active_slot;
         #endif
+        info.num_bytes = _sg_buffer_num_bytes(buf);
     }
     return info;
 }
@@ -15566,6 +22913,7 @@ SOKOL_API_IMPL sg_image_info sg_query_image_info(sg_image img_id) {
         #endif
         info.width = img->cmn.width;
         info.height = img->cmn.height;
+        info.num_bytes = _sg_image_num_bytes(img);
     }
     return info;
 }
@@ -15609,6 +22957,68 @@ SOKOL_API_IMPL sg_pass_info sg_query_pass_info(sg_pass pass_id) {
     return info;
 }
 
+SOKOL_API_IMPL sg_sampler_info sg_query_sampler_info(sg_sampler smp_id) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_sampler_info info;
+    memset(&info, 0, sizeof(info));
+    const _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
+    if (smp) {
+        info.slot.state = smp->slot.state;
+        info.slot.res_id = smp->slot.id;
+        info.slot.ctx_id = smp->slot.ctx_id;
+    }
+    return info;
+}
+
+SOKOL_API_IMPL sg_state_filter_stats sg_query_state_filter_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.filter.prev_stats;
+}
+
+SOKOL_API_IMPL sg_frame_stats sg_query_frame_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.stats.prev;
+}
+
+SOKOL_API_IMPL sg_memory_stats sg_query_memory_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.memory;
+}
+
+SOKOL_API_IMPL sg_gpu_timings sg_query_gpu_timings(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.timing.result;
+}
+
+SOKOL_API_IMPL int sg_query_frame_stats_history(sg_frame_stats* stats, int max_frames) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(stats && (max_frames >= 0));
+    const int num_frames = _sg_min(max_frames, _sg.stats.history_count);
+    /* the most recently committed frame has frame index _sg.frame_index - 1 */
+    for (int i = 0; i < num_frames; i++) {
+        const uint32_t frame_index = _sg.frame_index - 1 - (uint32_t)i;
+        stats[i] = _sg.stats.history[frame_index % (uint32_t)_sg.stats.history_size];
+    }
+    return num_frames;
+}
+
+SOKOL_API_IMPL size_t sg_query_shader_cache_size(void) {
+    SOKOL_ASSERT(_sg.valid);
+    if (!_sg.shader_cache.enabled) {
+        return 0;
+    }
+    return _sg_shdcache_serialized_size(&_sg.shader_cache);
+}
+
+SOKOL_API_IMPL size_t sg_save_shader_cache(void* ptr, size_t size) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(ptr && (size > 0));
+    if (!_sg.shader_cache.enabled) {
+        return 0;
+    }
+    return _sg_shdcache_save(&_sg.shader_cache, ptr, size);
+}
+
 SOKOL_API_IMPL sg_buffer_desc sg_query_buffer_defaults(const sg_buffer_desc* desc) {
     SOKOL_ASSERT(_sg.valid && desc);
     return _sg_buffer_desc_defaults(desc);
@@ -15629,11 +23039,21 @@ SOKOL_API_IMPL sg_pipeline_desc sg_query_pipeline_defaults(const sg_pipeline_des
     return _sg_pipeline_desc_defaults(desc);
 }
 
+SOKOL_API_IMPL sg_compute_pipeline_desc sg_query_compute_pipeline_defaults(const sg_compute_pipeline_desc* desc) {
+    SOKOL_ASSERT(_sg.valid && desc);
+    return _sg_compute_pipeline_desc_defaults(desc);
+}
+
 SOKOL_API_IMPL sg_pass_desc sg_query_pass_defaults(const sg_pass_desc* desc) {
     SOKOL_ASSERT(_sg.valid && desc);
     return _sg_pass_desc_defaults(desc);
 }
 
+SOKOL_API_IMPL sg_sampler_desc sg_query_sampler_defaults(const sg_sampler_desc* desc) {
+    SOKOL_ASSERT(_sg.valid && desc);
+    return _sg_sampler_desc_defaults(desc);
+}
+
 SOKOL_API_IMPL const void* sg_d3d11_device(void) {
 #if defined(SOKOL_D3D11)
     return (const void*) _sg.d3d11.dev;
@@ -0,0 +1,282 @@
+//------------------------------------------------------------------------------
+//  sokol_gfx_api_test.c
+//
+//  Checks GPU timers, asynchronous image readbacks and compute pass
+//  validation on the dummy backend.
+//
+//  Build and run from the tests directory:
+//
+//      cc -std=c99 -o sokol_gfx_api_test sokol_gfx_api_test.c && ./sokol_gfx_api_test
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#define SOKOL_DUMMY_BACKEND
+#define SOKOL_VALIDATE_NON_FATAL
+#include "../sokol_gfx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int num_failed;
+
+#define T(b) do { if (!(b)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #b); num_failed++; } } while (0)
+
+static sg_image make_render_target(void) {
+    return sg_make_image(&(sg_image_desc){ .render_target = true, .width = 16, .height = 8, .pixel_format = SG_PIXELFORMAT_RGBA8 });
+}
+
+static void test_gpu_timers(void) {
+    // timings are only recorded if enabled in sg_setup()
+    sg_setup(&(sg_desc){0});
+    T(sg_query_features().gpu_timing);
+    sg_begin_timer("timer");
+    sg_end_timer();
+    sg_commit();
+    sg_commit();
+    T(sg_query_gpu_timings().frame_index == 0);
+    T(sg_query_gpu_timings().num_timings == 0);
+    sg_shutdown();
+
+    sg_setup(&(sg_desc){ .enable_gpu_timing = true });
+    sg_pass pass = sg_make_pass(&(sg_pass_desc){ .color_attachments[0].image = make_render_target() });
+    T(sg_query_pass_state(pass) == SG_RESOURCESTATE_VALID);
+    // frame 1: nested timers and per-pass timers
+    sg_begin_timer("frame");
+    sg_begin_default_pass(&(sg_pass_action){0}, 64, 32);
+    sg_begin_timer("draw");
+    sg_end_timer();
+    sg_end_pass();
+    sg_begin_pass(pass, &(sg_pass_action){0});
+    sg_end_pass();
+    sg_end_timer();
+    sg_commit();
+
+    // the results of a frame are not available in its own sg_commit()...
+    sg_gpu_timings res = sg_query_gpu_timings();
+    T(res.frame_index == 0);
+    T(res.num_timings == 0);
+
+    // ...but only in the sg_commit() of the next frame
+    sg_commit();
+    res = sg_query_gpu_timings();
+    T(res.frame_index == 1);
+    T(res.num_timings == 4);
+    T(res.frame_duration_ns == 0);
+    T((res.timings[0].label != 0) && (0 == strcmp(res.timings[0].label, "frame")));
+    T(res.timings[0].pass.id == SG_INVALID_ID);
+    T(res.timings[0].depth == 0);
+    T(res.timings[1].label == 0);
+    T(res.timings[1].pass.id == SG_INVALID_ID);
+    T(res.timings[1].depth == 1);
+    T((res.timings[2].label != 0) && (0 == strcmp(res.timings[2].label, "draw")));
+    T(res.timings[2].depth == 2);
+    T(res.timings[3].label == 0);
+    T(res.timings[3].pass.id == pass.id);
+    T(res.timings[3].depth == 1);
+    // the dummy backend reports zero durations
+    for (int i = 0; i < res.num_timings; i++) {
+        T(res.timings[i].duration_ns == 0);
+    }
+
+    // frames without timers don't replace the last results
+    sg_commit();
+    sg_commit();
+    res = sg_query_gpu_timings();
+    T(res.frame_index == 1);
+    T(res.num_timings == 4);
+
+    // a frame with timers replaces them one frame later
+    sg_begin_timer("single");
+    sg_end_timer();
+    sg_commit();
+    T(sg_query_gpu_timings().frame_index == 1);
+    sg_commit();
+    res = sg_query_gpu_timings();
+    T(res.frame_index == 5);
+    T(res.num_timings == 1);
+    T(res.timings[0].depth == 0);
+    T(res.timings[0].duration_ns == 0);
+    sg_shutdown();
+}
+
+static struct {
+    int num_callbacks;
+    sg_image image;
+    sg_image_region region;
+    size_t size;
+    bool zeroed;
+    void* user_data;
+} readback;
+
+static void readback_callback(const sg_image_readback* rb) {
+    readback.num_callbacks++;
+    readback.image = rb->image;
+    readback.region = rb->region;
+    readback.size = rb->data.size;
+    readback.zeroed = (rb->data.ptr != 0);
+    for (size_t i = 0; readback.zeroed && (i < rb->data.size); i++) {
+        readback.zeroed = (((const uint8_t*)rb->data.ptr)[i] == 0);
+    }
+    readback.user_data = rb->user_data;
+}
+
+static void test_image_readback(void) {
+    memset(&readback, 0, sizeof(readback));
+    sg_setup(&(sg_desc){0});
+    T(sg_query_features().image_readback);
+    sg_image img = make_render_target();
+    sg_pass pass = sg_make_pass(&(sg_pass_desc){ .color_attachments[0].image = img });
+    T(sg_query_pass_state(pass) == SG_RESOURCESTATE_VALID);
+    int user_data = 0;
+
+    // the callback is only called in the next sg_commit(), a null region
+    // reads the whole image
+    T(sg_read_image_async(img, 0, readback_callback, &user_data));
+    T(readback.num_callbacks == 0);
+    sg_commit();
+    T(readback.num_callbacks == 1);
+    T(readback.image.id == img.id);
+    T((readback.region.x == 0) && (readback.region.y == 0));
+    T((readback.region.width == 16) && (readback.region.height == 8));
+    T(readback.size == 16 * 8 * 4);
+    T(readback.zeroed);
+    T(readback.user_data == &user_data);
+
+    // a zero width or height extends the region to the border
+    T(sg_read_image_async(img, &(sg_image_region){ .x = 4, .y = 2 }, readback_callback, 0));
+    sg_commit();
+    T(readback.num_callbacks == 2);
+    T((readback.region.x == 4) && (readback.region.y == 2));
+    T((readback.region.width == 12) && (readback.region.height == 6));
+    T(readback.size == 12 * 6 * 4);
+    T(readback.zeroed);
+    T(readback.user_data == 0);
+
+    // same for pass attachments
+    T(sg_read_pass_attachment_async(pass, 0, &(sg_image_region){ .x = 8, .width = 4 }, readback_callback, 0));
+    sg_commit();
+    T(readback.num_callbacks == 3);
+    T(readback.image.id == img.id);
+    T((readback.region.x == 8) && (readback.region.width == 4) && (readback.region.height == 8));
+    T(readback.size == 4 * 8 * 4);
+    T(readback.zeroed);
+
+    // invalid regions and attachments are rejected
+    T(!sg_read_image_async(img, &(sg_image_region){ .x = 12, .width = 8 }, readback_callback, 0));
+    T(!sg_read_pass_attachment_async(pass, 1, 0, readback_callback, 0));
+
+    // only a limited number of readbacks can be pending
+    int num_started = 0;
+    while (sg_read_image_async(img, 0, readback_callback, 0)) {
+        num_started++;
+        if (num_started > 64) {
+            break;
+        }
+    }
+    T((num_started > 0) && (num_started <= 64));
+    T(!sg_read_pass_attachment_async(pass, 0, 0, readback_callback, 0));
+    sg_commit();
+    T(readback.num_callbacks == 3 + num_started);
+    // ...and the slots become available again after the callbacks
+    T(sg_read_image_async(img, 0, readback_callback, 0));
+    sg_commit();
+    T(readback.num_callbacks == 4 + num_started);
+
+    // pending readbacks are dropped in sg_shutdown() without calling the callback
+    T(sg_read_image_async(img, 0, readback_callback, 0));
+    T(sg_read_pass_attachment_async(pass, 0, 0, readback_callback, 0));
+    sg_shutdown();
+    T(readback.num_callbacks == 4 + num_started);
+}
+
+static void test_compute_validation(void) {
+    sg_setup(&(sg_desc){0});
+    T(sg_query_features().compute);
+    sg_buffer sbuf = sg_make_buffer(&(sg_buffer_desc){ .type = SG_BUFFERTYPE_STORAGEBUFFER, .usage = SG_USAGE_DYNAMIC, .size = 256 });
+    sg_shader cs = sg_make_shader(&(sg_shader_desc){ .cs = { .source = "cs", .storage_buffers[0].used = true } });
+    sg_pipeline cpip = sg_make_compute_pipeline(&(sg_compute_pipeline_desc){ .shader = cs });
+    T(sg_query_pipeline_state(cpip) == SG_RESOURCESTATE_VALID);
+    const float vertices[9] = { 0 };
+    sg_buffer vbuf = sg_make_buffer(&(sg_buffer_desc){ .data = SG_RANGE(vertices) });
+    sg_shader shd = sg_make_shader(&(sg_shader_desc){ .vs.source = "vs", .fs.source = "fs" });
+    sg_pipeline pip = sg_make_pipeline(&(sg_pipeline_desc){
+        .shader = shd,
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+    });
+    T(sg_query_pipeline_state(pip) == SG_RESOURCESTATE_VALID);
+
+    // compute shaders can't be used in render pipelines
+    sg_pipeline bad_pip = sg_make_pipeline(&(sg_pipeline_desc){
+        .shader = cs,
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+    });
+    T(sg_query_pipeline_state(bad_pip) == SG_RESOURCESTATE_FAILED);
+
+    // sg_dispatch() is rejected outside compute passes...
+    sg_dispatch(1, 1, 1);
+    sg_begin_default_pass(&(sg_pass_action){0}, 64, 32);
+    sg_apply_pipeline(cpip);
+    T(!_sg.next_draw_valid);
+    sg_dispatch(1, 1, 1);
+    sg_end_pass();
+    sg_commit();
+    sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_apply_pipeline == 0);
+    T(stats.num_dispatch == 0);
+
+    // ...and with zero work groups
+    sg_begin_compute_pass();
+    sg_apply_pipeline(cpip);
+    sg_apply_bindings(&(sg_bindings){ .cs_storage_buffers[0] = sbuf });
+    sg_dispatch(0, 1, 1);
+    sg_dispatch(4, 0, 1);
+    sg_dispatch(4, 1, 0);
+    // sg_draw() is rejected in compute passes
+    sg_draw(0, 3, 1);
+    sg_dispatch(4, 2, 1);
+    sg_end_pass();
+    sg_commit();
+    stats = sg_query_frame_stats();
+    T(stats.num_apply_pipeline == 1);
+    T(stats.num_apply_bindings == 1);
+    T(stats.num_draw == 0);
+    T(stats.num_dispatch == 1);
+
+    // render pipelines can't be applied in compute passes
+    sg_begin_compute_pass();
+    sg_apply_pipeline(pip);
+    T(!_sg.next_draw_valid);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_draw(0, 3, 1);
+    sg_dispatch(1, 1, 1);
+    sg_end_pass();
+    sg_commit();
+    stats = sg_query_frame_stats();
+    T(stats.num_apply_pipeline == 0);
+    T(stats.num_apply_bindings == 0);
+    T(stats.num_draw == 0);
+    T(stats.num_dispatch == 0);
+
+    // ...but still work in the following render pass
+    sg_begin_default_pass(&(sg_pass_action){0}, 64, 32);
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_draw(0, 3, 1);
+    sg_end_pass();
+    sg_commit();
+    stats = sg_query_frame_stats();
+    T(stats.num_apply_pipeline == 1);
+    T(stats.num_draw == 1);
+    sg_shutdown();
+}
+
+int main(void) {
+    test_gpu_timers();
+    test_image_readback();
+    test_compute_validation();
+    if (num_failed > 0) {
+        printf("sokol_gfx_api_test: %d checks failed\n", num_failed);
+        return EXIT_FAILURE;
+    }
+    printf("sokol_gfx_api_test: ok\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,372 @@
+//------------------------------------------------------------------------------
+//  sokol_gfx_cmdlist_test.c
+//
+//  Records every command type into sg_command_lists, replays them
+//  on the dummy backend and checks the result via trace hooks and
+//  frame stats, and checks that the state filter drops redundant
+//  recorded state.
+//
+//  Build and run from the tests directory:
+//
+//      cc -std=c99 -o sokol_gfx_cmdlist_test sokol_gfx_cmdlist_test.c && ./sokol_gfx_cmdlist_test
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#define SOKOL_DUMMY_BACKEND
+#define SOKOL_TRACE_HOOKS
+#define SOKOL_VALIDATE_NON_FATAL
+#include "../sokol_gfx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int num_failed;
+
+#define T(b) do { if (!(b)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #b); num_failed++; } } while (0)
+
+static struct {
+    int num_apply_viewport;
+    int num_apply_scissor_rect;
+    int num_apply_pipeline;
+    int num_apply_bindings;
+    int num_apply_uniforms;
+    int num_draw;
+    int num_dispatch;
+    int num_err_draw_invalid;
+    float last_uniforms[4];
+    int last_dispatch[3];
+} trace;
+
+static void trace_apply_viewport(int x, int y, int width, int height, bool origin_top_left, void* user_data) {
+    (void)x; (void)y; (void)width; (void)height; (void)origin_top_left; (void)user_data;
+    trace.num_apply_viewport++;
+}
+
+static void trace_apply_scissor_rect(int x, int y, int width, int height, bool origin_top_left, void* user_data) {
+    (void)x; (void)y; (void)width; (void)height; (void)origin_top_left; (void)user_data;
+    trace.num_apply_scissor_rect++;
+}
+
+static void trace_apply_pipeline(sg_pipeline pip, void* user_data) {
+    (void)pip; (void)user_data;
+    trace.num_apply_pipeline++;
+}
+
+static void trace_apply_bindings(const sg_bindings* bindings, void* user_data) {
+    (void)bindings; (void)user_data;
+    trace.num_apply_bindings++;
+}
+
+static void trace_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data, void* user_data) {
+    (void)stage; (void)ub_index; (void)user_data;
+    if (data->size == sizeof(trace.last_uniforms)) {
+        memcpy(trace.last_uniforms, data->ptr, data->size);
+    }
+    trace.num_apply_uniforms++;
+}
+
+static void trace_draw(int base_element, int num_elements, int num_instances, void* user_data) {
+    (void)base_element; (void)num_elements; (void)num_instances; (void)user_data;
+    trace.num_draw++;
+}
+
+static void trace_dispatch(int num_groups_x, int num_groups_y, int num_groups_z, void* user_data) {
+    (void)user_data;
+    trace.last_dispatch[0] = num_groups_x;
+    trace.last_dispatch[1] = num_groups_y;
+    trace.last_dispatch[2] = num_groups_z;
+    trace.num_dispatch++;
+}
+
+static void trace_err_draw_invalid(void* user_data) {
+    (void)user_data;
+    trace.num_err_draw_invalid++;
+}
+
+static void setup_desc(const sg_desc* desc) {
+    memset(&trace, 0, sizeof(trace));
+    sg_setup(desc);
+    sg_trace_hooks hooks = {0};
+    hooks.apply_viewport = trace_apply_viewport;
+    hooks.apply_scissor_rect = trace_apply_scissor_rect;
+    hooks.apply_pipeline = trace_apply_pipeline;
+    hooks.apply_bindings = trace_apply_bindings;
+    hooks.apply_uniforms = trace_apply_uniforms;
+    hooks.draw = trace_draw;
+    hooks.dispatch = trace_dispatch;
+    hooks.err_draw_invalid = trace_err_draw_invalid;
+    sg_install_trace_hooks(&hooks);
+}
+
+static void setup(void) {
+    setup_desc(&(sg_desc){0});
+}
+
+static sg_pipeline make_render_pipeline(sg_index_type index_type) {
+    sg_shader shd = sg_make_shader(&(sg_shader_desc){
+        .vs = { .source = "vs", .uniform_blocks[0].size = 16 },
+        .fs = { .source = "fs" },
+    });
+    return sg_make_pipeline(&(sg_pipeline_desc){
+        .shader = shd,
+        .index_type = index_type,
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+    });
+}
+
+static void test_render_commands(void) {
+    setup();
+    float vertices[9] = { 0 };
+    uint16_t indices[3] = { 0, 1, 2 };
+    sg_buffer vbuf = sg_make_buffer(&(sg_buffer_desc){ .data = SG_RANGE(vertices) });
+    sg_buffer ibuf = sg_make_buffer(&(sg_buffer_desc){ .type = SG_BUFFERTYPE_INDEXBUFFER, .data = SG_RANGE(indices) });
+    sg_pipeline pip = make_render_pipeline(SG_INDEXTYPE_NONE);
+    sg_pipeline ipip = make_render_pipeline(SG_INDEXTYPE_UINT16);
+    sg_image img = sg_make_image(&(sg_image_desc){ .width = 16, .height = 16, .usage = SG_USAGE_DYNAMIC });
+    const sg_bindings bnd = { .vertex_buffers[0] = vbuf };
+    const sg_bindings ibnd = { .vertex_buffers[0] = vbuf, .index_buffer = ibuf };
+    sg_prepared_bindings pbnd = sg_prepare_bindings(ipip, &ibnd);
+    T(pbnd.valid);
+
+    static uint64_t mem[1024];
+    sg_command_list cl;
+    sg_init_command_list(&cl, mem, sizeof(mem));
+    {
+        // everything recorded here lives on the stack and goes out of scope
+        // before the command list is submitted
+        float uniforms[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+        sg_draw_range ranges[3] = {
+            { .base_element = 0, .num_elements = 3, .num_instances = 1 },
+            { .base_element = 0, .num_elements = 3, .num_instances = 2, .base_vertex = 3 },
+            { .base_element = 0, .num_elements = 3, .num_instances = 1 },
+        };
+        uint8_t pixels[8*8*4];
+        memset(pixels, 0xFF, sizeof(pixels));
+        sg_bindings tmp_bnd = bnd;
+        sg_prepared_bindings tmp_pbnd = pbnd;
+
+        sg_cmd_update_image_region(&cl, img, 0, 0, 8, 8, 8, 8, &SG_RANGE(pixels));
+        sg_cmd_apply_viewport(&cl, 0, 0, 100, 100, true);
+        sg_cmd_apply_scissor_rect(&cl, 0, 0, 50, 50, true);
+        sg_cmd_apply_pipeline(&cl, pip);
+        sg_cmd_apply_bindings(&cl, &tmp_bnd);
+        sg_cmd_apply_uniforms(&cl, SG_SHADERSTAGE_VS, 0, &SG_RANGE(uniforms));
+        sg_cmd_draw(&cl, 0, 3, 1);
+        sg_cmd_draw_ex(&cl, 0, 3, 4, 0);
+        sg_cmd_apply_pipeline(&cl, ipip);
+        sg_cmd_apply_prepared_bindings(&cl, &tmp_pbnd);
+        sg_cmd_draw_ex(&cl, 0, 3, 1, 5);
+        sg_cmd_draw_batch(&cl, ranges, 3);
+        memset(uniforms, 0, sizeof(uniforms));
+        memset(ranges, 0, sizeof(ranges));
+        memset(pixels, 0, sizeof(pixels));
+        memset(&tmp_bnd, 0, sizeof(tmp_bnd));
+        memset(&tmp_pbnd, 0, sizeof(tmp_pbnd));
+    }
+    T(!sg_command_list_overflow(&cl));
+    T(cl.num_commands == 12);
+
+    sg_begin_default_pass(&(sg_pass_action){0}, 100, 100);
+    sg_submit_command_lists(&cl, 1);
+    sg_end_pass();
+    sg_commit();
+
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(trace.num_apply_viewport == 1);
+    T(trace.num_apply_scissor_rect == 1);
+    T(trace.num_apply_pipeline == 2);
+    T(trace.num_apply_bindings == 2);
+    T(trace.num_apply_uniforms == 1);
+    T(trace.last_uniforms[0] == 1.0f && trace.last_uniforms[3] == 4.0f);
+    T(stats.num_apply_bindings == 2);
+    T(stats.num_update_image_region == 1);
+    T(stats.size_update_image_region == 8*8*4);
+    T(stats.num_draw == 6);
+    T(trace.num_draw == 6);
+    T(stats.num_elements == (3 + 3*4 + 3 + (3 + 3*2 + 3)));
+    T(trace.num_err_draw_invalid == 0);
+
+    // without base-vertex support, the recorded base_vertex must reach
+    // sg_draw_ex() and reject the indexed draw
+    _sg.features.base_vertex = false;
+    sg_reset_command_list(&cl);
+    sg_cmd_apply_pipeline(&cl, ipip);
+    sg_cmd_apply_prepared_bindings(&cl, &pbnd);
+    sg_cmd_draw_ex(&cl, 0, 3, 1, 5);
+    sg_cmd_draw_ex(&cl, 0, 3, 1, 0);
+    sg_begin_default_pass(&(sg_pass_action){0}, 100, 100);
+    sg_submit_command_lists(&cl, 1);
+    sg_end_pass();
+    sg_commit();
+    T(sg_query_frame_stats().num_draw == 1);
+    T(trace.num_err_draw_invalid == 1);
+    sg_shutdown();
+}
+
+static void test_compute_commands(void) {
+    setup();
+    T(sg_query_features().compute);
+    float data[64] = { 0 };
+    sg_buffer sbuf = sg_make_buffer(&(sg_buffer_desc){ .type = SG_BUFFERTYPE_STORAGEBUFFER, .usage = SG_USAGE_DYNAMIC, .size = sizeof(data) });
+    sg_shader cs = sg_make_shader(&(sg_shader_desc){
+        .cs = { .source = "cs", .uniform_blocks[0].size = 16, .storage_buffers[0].used = true },
+    });
+    sg_pipeline cpip = sg_make_compute_pipeline(&(sg_compute_pipeline_desc){ .shader = cs });
+    T(sg_query_pipeline_state(cpip) == SG_RESOURCESTATE_VALID);
+
+    static uint64_t mem[256];
+    sg_command_list cl;
+    sg_init_command_list(&cl, mem, sizeof(mem));
+    const float uniforms[4] = { 5.0f, 6.0f, 7.0f, 8.0f };
+    sg_cmd_apply_pipeline(&cl, cpip);
+    sg_cmd_apply_bindings(&cl, &(sg_bindings){ .cs_storage_buffers[0] = sbuf });
+    sg_cmd_apply_uniforms(&cl, SG_SHADERSTAGE_CS, 0, &SG_RANGE(uniforms));
+    sg_cmd_dispatch(&cl, 4, 1, 1);
+    sg_cmd_dispatch(&cl, 1, 2, 3);
+    T(!sg_command_list_overflow(&cl));
+
+    sg_begin_compute_pass();
+    sg_submit_command_lists(&cl, 1);
+    sg_end_pass();
+    sg_commit();
+
+    T(sg_query_frame_stats().num_dispatch == 2);
+    T(trace.num_dispatch == 2);
+    T(trace.last_dispatch[0] == 1 && trace.last_dispatch[1] == 2 && trace.last_dispatch[2] == 3);
+    T(trace.num_apply_uniforms == 1);
+    T(trace.last_uniforms[0] == 5.0f && trace.last_uniforms[3] == 8.0f);
+    sg_shutdown();
+}
+
+static void test_overflow(void) {
+    setup();
+    uint64_t mem[8];
+    sg_command_list cl;
+    sg_init_command_list(&cl, mem, sizeof(mem));
+    const uint8_t pixels[256] = { 0 };
+    sg_cmd_update_image_region(&cl, (sg_image){0}, 0, 0, 0, 0, 8, 8, &SG_RANGE(pixels));
+    T(sg_command_list_overflow(&cl));
+    T(cl.num_commands == 0);
+    sg_reset_command_list(&cl);
+    sg_cmd_dispatch(&cl, 1, 1, 1);
+    T(!sg_command_list_overflow(&cl));
+    T(cl.num_commands == 1);
+    sg_shutdown();
+}
+
+static void record_redundant_state(sg_command_list* cl, sg_pipeline pip, sg_buffer vbuf) {
+    const float uniforms0[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    const float uniforms1[4] = { 5.0f, 6.0f, 7.0f, 8.0f };
+    sg_reset_command_list(cl);
+    sg_cmd_apply_pipeline(cl, pip);
+    sg_cmd_apply_bindings(cl, &(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_cmd_apply_uniforms(cl, SG_SHADERSTAGE_VS, 0, &SG_RANGE(uniforms0));
+    sg_cmd_draw(cl, 0, 3, 1);
+    sg_cmd_apply_pipeline(cl, pip);
+    sg_cmd_apply_bindings(cl, &(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_cmd_apply_uniforms(cl, SG_SHADERSTAGE_VS, 0, &SG_RANGE(uniforms0));
+    sg_cmd_draw(cl, 0, 3, 1);
+    sg_cmd_apply_uniforms(cl, SG_SHADERSTAGE_VS, 0, &SG_RANGE(uniforms1));
+    sg_cmd_draw(cl, 0, 3, 1);
+}
+
+static void test_state_filter(void) {
+    static uint64_t mem[256];
+    sg_command_list cl;
+    sg_init_command_list(&cl, mem, sizeof(mem));
+    float vertices[9] = { 0 };
+
+    // the state filter is opt-in, by default nothing is dropped
+    setup();
+    sg_buffer vbuf = sg_make_buffer(&(sg_buffer_desc){ .data = SG_RANGE(vertices) });
+    sg_pipeline pip = make_render_pipeline(SG_INDEXTYPE_NONE);
+    record_redundant_state(&cl, pip, vbuf);
+    sg_begin_default_pass(&(sg_pass_action){0}, 100, 100);
+    sg_submit_command_lists(&cl, 1);
+    sg_end_pass();
+    sg_commit();
+    sg_state_filter_stats fstats = sg_query_state_filter_stats();
+    T(fstats.num_dropped_pipelines == 0);
+    T(fstats.num_dropped_bindings == 0);
+    T(fstats.num_dropped_uniforms == 0);
+    sg_shutdown();
+
+    setup_desc(&(sg_desc){ .enable_state_filter = true });
+    vbuf = sg_make_buffer(&(sg_buffer_desc){ .data = SG_RANGE(vertices) });
+    pip = make_render_pipeline(SG_INDEXTYPE_NONE);
+    record_redundant_state(&cl, pip, vbuf);
+    sg_begin_default_pass(&(sg_pass_action){0}, 100, 100);
+    sg_submit_command_lists(&cl, 1);
+    // after a state cache reset, the same state is applied again
+    sg_reset_state_cache();
+    sg_apply_pipeline(pip);
+    sg_end_pass();
+    sg_commit();
+    fstats = sg_query_state_filter_stats();
+    T(fstats.num_dropped_pipelines == 1);
+    T(fstats.num_dropped_bindings == 1);
+    T(fstats.num_dropped_uniforms == 1);
+    // trace hooks still see every call
+    T(trace.num_apply_pipeline == 3);
+    T(trace.num_apply_bindings == 2);
+    T(trace.num_apply_uniforms == 3);
+    T(trace.last_uniforms[0] == 5.0f);
+
+    // the counters only cover the previous frame
+    sg_commit();
+    fstats = sg_query_state_filter_stats();
+    T(fstats.num_dropped_pipelines == 0);
+    T(fstats.num_dropped_bindings == 0);
+    T(fstats.num_dropped_uniforms == 0);
+    sg_shutdown();
+}
+
+// index buffer updates between sg_apply_bindings() and sg_draw() must
+// neither invalidate the draw nor leave stale bindings in the state filter
+static void test_index_buffer_update_mid_pass(void) {
+    setup_desc(&(sg_desc){ .enable_state_filter = true });
+    float vertices[9] = { 0 };
+    uint16_t indices[3] = { 0, 1, 2 };
+    sg_buffer vbuf = sg_make_buffer(&(sg_buffer_desc){ .data = SG_RANGE(vertices) });
+    sg_buffer ibuf = sg_make_buffer(&(sg_buffer_desc){ .type = SG_BUFFERTYPE_INDEXBUFFER, .usage = SG_USAGE_DYNAMIC, .size = sizeof(indices) });
+    sg_buffer sibuf = sg_make_buffer(&(sg_buffer_desc){ .type = SG_BUFFERTYPE_INDEXBUFFER, .usage = SG_USAGE_STREAM, .size = 4 * sizeof(indices) });
+    sg_pipeline pip = make_render_pipeline(SG_INDEXTYPE_UINT16);
+    const sg_bindings bnd = { .vertex_buffers[0] = vbuf, .index_buffer = ibuf };
+    const sg_bindings sbnd = { .vertex_buffers[0] = vbuf, .index_buffer = sibuf };
+
+    sg_begin_default_pass(&(sg_pass_action){0}, 100, 100);
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&bnd);
+    sg_update_buffer(ibuf, &SG_RANGE(indices));
+    sg_draw(0, 3, 1);
+    sg_apply_bindings(&bnd);
+    sg_draw(0, 3, 1);
+    sg_apply_bindings(&sbnd);
+    const int offset = sg_append_buffer(sibuf, &SG_RANGE(indices));
+    sg_draw(offset / 2, 3, 1);
+    // creating an index buffer mid-pass binds it too
+    sg_buffer tmp_ibuf = sg_make_buffer(&(sg_buffer_desc){ .type = SG_BUFFERTYPE_INDEXBUFFER, .data = SG_RANGE(indices) });
+    sg_draw(0, 3, 1);
+    sg_end_pass();
+    sg_commit();
+
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_draw == 4);
+    T(trace.num_err_draw_invalid == 0);
+    T(sg_query_state_filter_stats().num_dropped_bindings == 0);
+    T(sg_query_buffer_state(tmp_ibuf) == SG_RESOURCESTATE_VALID);
+    sg_shutdown();
+}
+
+int main(void) {
+    test_render_commands();
+    test_compute_commands();
+    test_overflow();
+    test_state_filter();
+    test_index_buffer_update_mid_pass();
+    if (num_failed > 0) {
+        printf("sokol_gfx_cmdlist_test: %d checks failed\n", num_failed);
+        return EXIT_FAILURE;
+    }
+    printf("sokol_gfx_cmdlist_test: ok\n");
+    return EXIT_SUCCESS;
+}
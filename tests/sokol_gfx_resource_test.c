@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+//  sokol_gfx_resource_test.c
+//
+//  Checks resource lifetime handling (growable pools, asynchronous
+//  creation, deferred destruction) on the dummy backend.
+//
+//  Build and run from the tests directory:
+//
+//      cc -std=c99 -o sokol_gfx_resource_test sokol_gfx_resource_test.c && ./sokol_gfx_resource_test
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#define SOKOL_DUMMY_BACKEND
+#include "../sokol_gfx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int num_failed;
+
+#define T(b) do { if (!(b)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #b); num_failed++; } } while (0)
+
+static void test_growable_pools(void) {
+    static uint8_t data[16 * 32];
+    sg_buffer bufs[20];
+
+    // fixed size pools fail when exhausted
+    sg_setup(&(sg_desc){ .buffer_pool_size = 2 });
+    T(sg_make_buffer(&(sg_buffer_desc){ .data = { data, 16 } }).id != SG_INVALID_ID);
+    T(sg_make_buffer(&(sg_buffer_desc){ .data = { data, 16 } }).id != SG_INVALID_ID);
+    T(sg_make_buffer(&(sg_buffer_desc){ .data = { data, 16 } }).id == SG_INVALID_ID);
+    T(sg_query_pool_info().buffer_pool_capacity == 3);
+    sg_shutdown();
+
+    // growable pools double their capacity (3, 6, 12, 24 slots), the
+    // buffers end up in four chunks of 3, 3, 6 and 12 items
+    sg_setup(&(sg_desc){ .buffer_pool_size = 2, .growable_pools = true });
+    bufs[0] = sg_make_buffer(&(sg_buffer_desc){ .data = { data, 16 } });
+    const _sg_buffer_t* first = _sg_lookup_buffer(&_sg.pools, bufs[0].id);
+    T(first);
+    for (int i = 1; i < 20; i++) {
+        bufs[i] = sg_make_buffer(&(sg_buffer_desc){ .data = { data, (size_t)(16 * (i + 1)) } });
+    }
+    T(sg_query_pool_info().buffer_pool_capacity == 24);
+    T(_sg.pools.buffer_pool.num_chunks == 4);
+    // existing items are not moved when the pool grows
+    T(first == _sg_lookup_buffer(&_sg.pools, bufs[0].id));
+    // items in different chunks don't overlap
+    for (int i = 0; i < 20; i++) {
+        T(sg_query_buffer_state(bufs[i]) == SG_RESOURCESTATE_VALID);
+        T(sg_query_buffer_info(bufs[i]).num_bytes == (size_t)(16 * (i + 1)));
+        for (int j = 0; j < i; j++) {
+            T(_sg_lookup_buffer(&_sg.pools, bufs[i].id) != _sg_lookup_buffer(&_sg.pools, bufs[j].id));
+        }
+    }
+    // freed slots are reused before the pool grows again
+    sg_destroy_buffer(bufs[19]);
+    bufs[19] = sg_make_buffer(&(sg_buffer_desc){ .data = { data, 16 } });
+    T(sg_query_buffer_state(bufs[19]) == SG_RESOURCESTATE_VALID);
+    T(sg_query_pool_info().buffer_pool_capacity == 24);
+    sg_shutdown();
+}
+
+static void test_async_destroy_before_drain(void) {
+    sg_setup(&(sg_desc){0});
+    sg_async_queue q;
+    sg_init_async_queue(&q, &(sg_async_queue_desc){0});
+    const float vertices[9] = { 0 };
+    const uint8_t pixels[4*4*4] = { 0 };
+    sg_buffer buf0 = sg_async_make_buffer(&q, &(sg_buffer_desc){ .data = SG_RANGE(vertices), .label = "buf0" });
+    sg_buffer buf1 = sg_async_make_buffer(&q, &(sg_buffer_desc){ .data = SG_RANGE(vertices) });
+    sg_image img0 = sg_async_make_image(&q, &(sg_image_desc){ .width = 4, .height = 4, .data.subimage[0][0] = SG_RANGE(pixels) });
+    T(sg_query_buffer_state(buf0) == SG_RESOURCESTATE_ALLOC);
+    T(sg_query_image_state(img0) == SG_RESOURCESTATE_ALLOC);
+
+    // destroy pending handles before their creation requests are drained
+    sg_destroy_buffer(buf0);
+    sg_destroy_image(img0);
+    T(sg_query_buffer_state(buf0) == SG_RESOURCESTATE_INVALID);
+    T(sg_query_image_state(img0) == SG_RESOURCESTATE_INVALID);
+
+    // ...the freed slots may be reused by other resources in the meantime
+    sg_buffer other_buf = sg_make_buffer(&(sg_buffer_desc){ .data = SG_RANGE(vertices) });
+    sg_image other_img = sg_make_image(&(sg_image_desc){ .width = 4, .height = 4, .data.subimage[0][0] = SG_RANGE(pixels) });
+
+    T(sg_drain_async_queue(&q, 0.0) == 1);
+    T(sg_query_buffer_state(buf0) == SG_RESOURCESTATE_INVALID);
+    T(sg_query_image_state(img0) == SG_RESOURCESTATE_INVALID);
+    T(sg_query_buffer_state(buf1) == SG_RESOURCESTATE_VALID);
+    T(sg_query_buffer_state(other_buf) == SG_RESOURCESTATE_VALID);
+    T(sg_query_image_state(other_img) == SG_RESOURCESTATE_VALID);
+
+    // same when the queue is discarded with pending requests
+    sg_buffer buf2 = sg_async_make_buffer(&q, &(sg_buffer_desc){ .data = SG_RANGE(vertices) });
+    sg_image img1 = sg_async_make_image(&q, &(sg_image_desc){ .width = 4, .height = 4, .data.subimage[0][0] = SG_RANGE(pixels) });
+    sg_destroy_buffer(buf2);
+    sg_discard_async_queue(&q);
+    T(sg_query_buffer_state(buf2) == SG_RESOURCESTATE_INVALID);
+    T(sg_query_image_state(img1) == SG_RESOURCESTATE_INVALID);
+    T(sg_query_buffer_state(other_buf) == SG_RESOURCESTATE_VALID);
+    sg_shutdown();
+}
+
+static void test_deferred_destroy(void) {
+    sg_setup(&(sg_desc){ .enable_deferred_destroy = true });
+    const float vertices[16] = { 0 };
+    sg_buffer buf = sg_make_buffer(&(sg_buffer_desc){ .data = SG_RANGE(vertices) });
+    sg_image img = sg_make_image(&(sg_image_desc){ .width = 4, .height = 4, .usage = SG_USAGE_DYNAMIC });
+    const size_t num_bytes = sg_query_buffer_info(buf).num_bytes + sg_query_image_info(img).num_bytes;
+    T(num_bytes > 0);
+    sg_commit();
+
+    // handles become invalid right away...
+    sg_destroy_buffer(buf);
+    sg_destroy_image(img);
+    T(sg_query_buffer_state(buf) == SG_RESOURCESTATE_INVALID);
+    T(sg_query_image_state(img) == SG_RESOURCESTATE_INVALID);
+    sg_memory_stats mem = sg_query_memory_stats();
+    T(mem.deferred.num == 2);
+    T(mem.deferred.bytes == num_bytes);
+    T(mem.total.num == 2);
+    sg_commit();
+    sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_destroy_deferred == 2);
+    T(stats.size_destroy_deferred == num_bytes);
+    T(stats.num_destroy_released == 0);
+    T(stats.size_destroy_queue == num_bytes);
+
+    // ...but the backend objects are only released SG_NUM_INFLIGHT_FRAMES commits later
+    for (int i = 1; i < SG_NUM_INFLIGHT_FRAMES; i++) {
+        sg_commit();
+        stats = sg_query_frame_stats();
+        T(stats.num_destroy_released == 0);
+        T(stats.size_destroy_queue == num_bytes);
+        T(sg_query_memory_stats().deferred.num == 2);
+    }
+    sg_commit();
+    stats = sg_query_frame_stats();
+    T(stats.num_destroy_released == 2);
+    T(stats.size_destroy_released == num_bytes);
+    T(stats.size_destroy_queue == 0);
+    mem = sg_query_memory_stats();
+    T(mem.deferred.num == 0);
+    T(mem.deferred.bytes == 0);
+    T(mem.total.num == 0);
+
+    // the queue is flushed in sg_shutdown()
+    buf = sg_make_buffer(&(sg_buffer_desc){ .data = SG_RANGE(vertices) });
+    sg_destroy_buffer(buf);
+    T(sg_query_memory_stats().deferred.num == 1);
+    sg_shutdown();
+}
+
+int main(void) {
+    test_growable_pools();
+    test_async_destroy_before_drain();
+    test_deferred_destroy();
+    if (num_failed > 0) {
+        printf("sokol_gfx_resource_test: %d checks failed\n", num_failed);
+        return EXIT_FAILURE;
+    }
+    printf("sokol_gfx_resource_test: ok\n");
+    return EXIT_SUCCESS;
+}
@@ -618,6 +618,7 @@ typedef struct {
 
 typedef struct {
     uint32_t init_tag;
+    uint32_t slot_mask;     /* resource id slot index mask from sg_query_pool_info() */
     sg_imgui_buffers_t buffers;
     sg_imgui_images_t images;
     sg_imgui_shaders_t shaders;
@@ -695,7 +696,6 @@ SOKOL_GFX_IMGUI_API_DECL void sg_imgui_draw_capabilities_window(sg_imgui_t* ctx)
 #include <string.h>
 #include <stdio.h>      /* snprintf */
 
-#define _SG_IMGUI_SLOT_MASK (0xFFFF)
 #define _SG_IMGUI_LIST_WIDTH (192)
 #define _SG_IMGUI_COLOR_OTHER 0xFFCCCCCC
 #define _SG_IMGUI_COLOR_RSRC 0xFF00FFFF
@@ -785,8 +785,8 @@ _SOKOL_PRIVATE void igEnd() {
 #endif
 
 /*--- UTILS ------------------------------------------------------------------*/
-_SOKOL_PRIVATE int _sg_imgui_slot_index(uint32_t id) {
-    int slot_index = (int) (id & _SG_IMGUI_SLOT_MASK);
+_SOKOL_PRIVATE int _sg_imgui_slot_index(const sg_imgui_t* ctx, uint32_t id) {
+    int slot_index = (int) (id & ctx->slot_mask);
     SOKOL_ASSERT(0 != slot_index);
     return slot_index;
 }
@@ -1224,7 +1224,7 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_res_id_string(uint32_t res_id, const cha
 
 _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_buffer_id_string(sg_imgui_t* ctx, sg_buffer buf_id) {
     if (buf_id.id != SG_INVALID_ID) {
-        const sg_imgui_buffer_t* buf_ui = &ctx->buffers.slots[_sg_imgui_slot_index(buf_id.id)];
+        const sg_imgui_buffer_t* buf_ui = &ctx->buffers.slots[_sg_imgui_slot_index(ctx, buf_id.id)];
         return _sg_imgui_res_id_string(buf_id.id, buf_ui->label.buf);
     }
     else {
@@ -1234,7 +1234,7 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_buffer_id_string(sg_imgui_t* ctx, sg_buf
 
 _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_image_id_string(sg_imgui_t* ctx, sg_image img_id) {
     if (img_id.id != SG_INVALID_ID) {
-        const sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_slot_index(img_id.id)];
+        const sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_slot_index(ctx, img_id.id)];
         return _sg_imgui_res_id_string(img_id.id, img_ui->label.buf);
     }
     else {
@@ -1244,7 +1244,7 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_image_id_string(sg_imgui_t* ctx, sg_imag
 
 _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_shader_id_string(sg_imgui_t* ctx, sg_shader shd_id) {
     if (shd_id.id != SG_INVALID_ID) {
-        const sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_slot_index(shd_id.id)];
+        const sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_slot_index(ctx, shd_id.id)];
         return _sg_imgui_res_id_string(shd_id.id, shd_ui->label.buf);
     }
     else {
@@ -1254,7 +1254,7 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_shader_id_string(sg_imgui_t* ctx, sg_sha
 
 _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_pipeline_id_string(sg_imgui_t* ctx, sg_pipeline pip_id) {
     if (pip_id.id != SG_INVALID_ID) {
-        const sg_imgui_pipeline_t* pip_ui = &ctx->pipelines.slots[_sg_imgui_slot_index(pip_id.id)];
+        const sg_imgui_pipeline_t* pip_ui = &ctx->pipelines.slots[_sg_imgui_slot_index(ctx, pip_id.id)];
         return _sg_imgui_res_id_string(pip_id.id, pip_ui->label.buf);
     }
     else {
@@ -1264,7 +1264,7 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_pipeline_id_string(sg_imgui_t* ctx, sg_p
 
 _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_pass_id_string(sg_imgui_t* ctx, sg_pass pass_id) {
     if (pass_id.id != SG_INVALID_ID) {
-        const sg_imgui_pass_t* pass_ui = &ctx->passes.slots[_sg_imgui_slot_index(pass_id.id)];
+        const sg_imgui_pass_t* pass_ui = &ctx->passes.slots[_sg_imgui_slot_index(ctx, pass_id.id)];
         return _sg_imgui_res_id_string(pass_id.id, pass_ui->label.buf);
     }
     else {
@@ -1273,7 +1273,85 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_pass_id_string(sg_imgui_t* ctx, sg_pass
 }
 
 /*--- RESOURCE HELPERS -------------------------------------------------------*/
+/* re-point the desc strings into the slot's own string buffers after the slot has been moved in memory */
+_SOKOL_PRIVATE void _sg_imgui_shader_fixup_strings(sg_imgui_shader_t* shd) {
+    if (shd->desc.vs.entry) {
+        shd->desc.vs.entry = shd->vs_entry.buf;
+    }
+    if (shd->desc.fs.entry) {
+        shd->desc.fs.entry = shd->fs_entry.buf;
+    }
+    if (shd->desc.vs.d3d11_target) {
+        shd->desc.vs.d3d11_target = shd->vs_d3d11_target.buf;
+    }
+    if (shd->desc.fs.d3d11_target) {
+        shd->desc.fs.d3d11_target = shd->fs_d3d11_target.buf;
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_UBS; i++) {
+        for (int j = 0; j < SG_MAX_UB_MEMBERS; j++) {
+            if (shd->desc.vs.uniform_blocks[i].uniforms[j].name) {
+                shd->desc.vs.uniform_blocks[i].uniforms[j].name = shd->vs_uniform_name[i][j].buf;
+            }
+            if (shd->desc.fs.uniform_blocks[i].uniforms[j].name) {
+                shd->desc.fs.uniform_blocks[i].uniforms[j].name = shd->fs_uniform_name[i][j].buf;
+            }
+        }
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+        if (shd->desc.vs.images[i].name) {
+            shd->desc.vs.images[i].name = shd->vs_image_name[i].buf;
+        }
+        if (shd->desc.fs.images[i].name) {
+            shd->desc.fs.images[i].name = shd->fs_image_name[i].buf;
+        }
+    }
+    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+        if (shd->desc.attrs[i].name) {
+            shd->desc.attrs[i].name = shd->attr_name[i].buf;
+        }
+        if (shd->desc.attrs[i].sem_name) {
+            shd->desc.attrs[i].sem_name = shd->attr_sem_name[i].buf;
+        }
+    }
+}
+
+_SOKOL_PRIVATE void* _sg_imgui_grow_slots(void* slots, int* num_slots, int new_num_slots, size_t slot_size) {
+    SOKOL_ASSERT(new_num_slots > *num_slots);
+    const size_t old_size = (size_t)*num_slots * slot_size;
+    const size_t new_size = (size_t)new_num_slots * slot_size;
+    uint8_t* new_slots = (uint8_t*) _sg_imgui_realloc(slots, old_size, new_size);
+    memset(new_slots + old_size, 0, new_size - old_size);
+    *num_slots = new_num_slots;
+    return new_slots;
+}
+
+/* resource pools grow at runtime when sg_desc.growable_pools is set, keep the debug-info slots in sync */
+_SOKOL_PRIVATE void _sg_imgui_sync_slots(sg_imgui_t* ctx) {
+    const sg_pool_info info = sg_query_pool_info();
+    if (info.buffer_pool_capacity > ctx->buffers.num_slots) {
+        ctx->buffers.slots = (sg_imgui_buffer_t*) _sg_imgui_grow_slots(ctx->buffers.slots, &ctx->buffers.num_slots, info.buffer_pool_capacity, sizeof(sg_imgui_buffer_t));
+    }
+    if (info.image_pool_capacity > ctx->images.num_slots) {
+        ctx->images.slots = (sg_imgui_image_t*) _sg_imgui_grow_slots(ctx->images.slots, &ctx->images.num_slots, info.image_pool_capacity, sizeof(sg_imgui_image_t));
+    }
+    if (info.shader_pool_capacity > ctx->shaders.num_slots) {
+        ctx->shaders.slots = (sg_imgui_shader_t*) _sg_imgui_grow_slots(ctx->shaders.slots, &ctx->shaders.num_slots, info.shader_pool_capacity, sizeof(sg_imgui_shader_t));
+        for (int i = 0; i < ctx->shaders.num_slots; i++) {
+            if (ctx->shaders.slots[i].res_id.id != SG_INVALID_ID) {
+                _sg_imgui_shader_fixup_strings(&ctx->shaders.slots[i]);
+            }
+        }
+    }
+    if (info.pipeline_pool_capacity > ctx->pipelines.num_slots) {
+        ctx->pipelines.slots = (sg_imgui_pipeline_t*) _sg_imgui_grow_slots(ctx->pipelines.slots, &ctx->pipelines.num_slots, info.pipeline_pool_capacity, sizeof(sg_imgui_pipeline_t));
+    }
+    if (info.pass_pool_capacity > ctx->passes.num_slots) {
+        ctx->passes.slots = (sg_imgui_pass_t*) _sg_imgui_grow_slots(ctx->passes.slots, &ctx->passes.num_slots, info.pass_pool_capacity, sizeof(sg_imgui_pass_t));
+    }
+}
+
 _SOKOL_PRIVATE void _sg_imgui_buffer_created(sg_imgui_t* ctx, sg_buffer res_id, int slot_index, const sg_buffer_desc* desc) {
+    _sg_imgui_sync_slots(ctx);
     SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->buffers.num_slots));
     sg_imgui_buffer_t* buf = &ctx->buffers.slots[slot_index];
     buf->res_id = res_id;
@@ -1288,6 +1366,7 @@ _SOKOL_PRIVATE void _sg_imgui_buffer_destroyed(sg_imgui_t* ctx, int slot_index)
 }
 
 _SOKOL_PRIVATE void _sg_imgui_image_created(sg_imgui_t* ctx, sg_image res_id, int slot_index, const sg_image_desc* desc) {
+    _sg_imgui_sync_slots(ctx);
     SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->images.num_slots));
     sg_imgui_image_t* img = &ctx->images.slots[slot_index];
     img->res_id = res_id;
@@ -1303,6 +1382,7 @@ _SOKOL_PRIVATE void _sg_imgui_image_destroyed(sg_imgui_t* ctx, int slot_index) {
 }
 
 _SOKOL_PRIVATE void _sg_imgui_shader_created(sg_imgui_t* ctx, sg_shader res_id, int slot_index, const sg_shader_desc* desc) {
+    _sg_imgui_sync_slots(ctx);
     SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->shaders.num_slots));
     sg_imgui_shader_t* shd = &ctx->shaders.slots[slot_index];
     shd->res_id = res_id;
@@ -1318,7 +1398,7 @@ _SOKOL_PRIVATE void _sg_imgui_shader_created(sg_imgui_t* ctx, sg_shader res_id,
     }
     if (shd->desc.vs.d3d11_target) {
         shd->vs_d3d11_target = _sg_imgui_make_str(shd->desc.vs.d3d11_target);
-        shd->desc.fs.d3d11_target = shd->vs_d3d11_target.buf;
+        shd->desc.vs.d3d11_target = shd->vs_d3d11_target.buf;
     }
     if (shd->desc.fs.d3d11_target) {
         shd->fs_d3d11_target = _sg_imgui_make_str(shd->desc.fs.d3d11_target);
@@ -1402,6 +1482,7 @@ _SOKOL_PRIVATE void _sg_imgui_shader_destroyed(sg_imgui_t* ctx, int slot_index)
 }
 
 _SOKOL_PRIVATE void _sg_imgui_pipeline_created(sg_imgui_t* ctx, sg_pipeline res_id, int slot_index, const sg_pipeline_desc* desc) {
+    _sg_imgui_sync_slots(ctx);
     SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->pipelines.num_slots));
     sg_imgui_pipeline_t* pip = &ctx->pipelines.slots[slot_index];
     pip->res_id = res_id;
@@ -1417,6 +1498,7 @@ _SOKOL_PRIVATE void _sg_imgui_pipeline_destroyed(sg_imgui_t* ctx, int slot_index
 }
 
 _SOKOL_PRIVATE void _sg_imgui_pass_created(sg_imgui_t* ctx, sg_pass res_id, int slot_index, const sg_pass_desc* desc) {
+    _sg_imgui_sync_slots(ctx);
     SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->passes.num_slots));
     sg_imgui_pass_t* pass = &ctx->passes.slots[slot_index];
     pass->res_id = res_id;
@@ -1940,7 +2022,7 @@ _SOKOL_PRIVATE void _sg_imgui_make_buffer(const sg_buffer_desc* desc, sg_buffer
         ctx->hooks.make_buffer(desc, buf_id, ctx->hooks.user_data);
     }
     if (buf_id.id != SG_INVALID_ID) {
-        _sg_imgui_buffer_created(ctx, buf_id, _sg_imgui_slot_index(buf_id.id), desc);
+        _sg_imgui_buffer_created(ctx, buf_id, _sg_imgui_slot_index(ctx, buf_id.id), desc);
     }
 }
 
@@ -1957,7 +2039,7 @@ _SOKOL_PRIVATE void _sg_imgui_make_image(const sg_image_desc* desc, sg_image img
         ctx->hooks.make_image(desc, img_id, ctx->hooks.user_data);
     }
     if (img_id.id != SG_INVALID_ID) {
-        _sg_imgui_image_created(ctx, img_id, _sg_imgui_slot_index(img_id.id), desc);
+        _sg_imgui_image_created(ctx, img_id, _sg_imgui_slot_index(ctx, img_id.id), desc);
     }
 }
 
@@ -1974,7 +2056,7 @@ _SOKOL_PRIVATE void _sg_imgui_make_shader(const sg_shader_desc* desc, sg_shader
         ctx->hooks.make_shader(desc, shd_id, ctx->hooks.user_data);
     }
     if (shd_id.id != SG_INVALID_ID) {
-        _sg_imgui_shader_created(ctx, shd_id, _sg_imgui_slot_index(shd_id.id), desc);
+        _sg_imgui_shader_created(ctx, shd_id, _sg_imgui_slot_index(ctx, shd_id.id), desc);
     }
 }
 
@@ -1991,7 +2073,7 @@ _SOKOL_PRIVATE void _sg_imgui_make_pipeline(const sg_pipeline_desc* desc, sg_pip
         ctx->hooks.make_pipeline(desc, pip_id, ctx->hooks.user_data);
     }
     if (pip_id.id != SG_INVALID_ID) {
-        _sg_imgui_pipeline_created(ctx, pip_id, _sg_imgui_slot_index(pip_id.id), desc);
+        _sg_imgui_pipeline_created(ctx, pip_id, _sg_imgui_slot_index(ctx, pip_id.id), desc);
     }
 }
 
@@ -2008,7 +2090,7 @@ _SOKOL_PRIVATE void _sg_imgui_make_pass(const sg_pass_desc* desc, sg_pass pass_i
         ctx->hooks.make_pass(desc, pass_id, ctx->hooks.user_data);
     }
     if (pass_id.id != SG_INVALID_ID) {
-        _sg_imgui_pass_created(ctx, pass_id, _sg_imgui_slot_index(pass_id.id), desc);
+        _sg_imgui_pass_created(ctx, pass_id, _sg_imgui_slot_index(ctx, pass_id.id), desc);
     }
 }
 
@@ -2025,7 +2107,7 @@ _SOKOL_PRIVATE void _sg_imgui_destroy_buffer(sg_buffer buf, void* user_data) {
         ctx->hooks.destroy_buffer(buf, ctx->hooks.user_data);
     }
     if (buf.id != SG_INVALID_ID) {
-        _sg_imgui_buffer_destroyed(ctx, _sg_imgui_slot_index(buf.id));
+        _sg_imgui_buffer_destroyed(ctx, _sg_imgui_slot_index(ctx, buf.id));
     }
 }
 
@@ -2042,7 +2124,7 @@ _SOKOL_PRIVATE void _sg_imgui_destroy_image(sg_image img, void* user_data) {
         ctx->hooks.destroy_image(img, ctx->hooks.user_data);
     }
     if (img.id != SG_INVALID_ID) {
-        _sg_imgui_image_destroyed(ctx, _sg_imgui_slot_index(img.id));
+        _sg_imgui_image_destroyed(ctx, _sg_imgui_slot_index(ctx, img.id));
     }
 }
 
@@ -2059,7 +2141,7 @@ _SOKOL_PRIVATE void _sg_imgui_destroy_shader(sg_shader shd, void* user_data) {
         ctx->hooks.destroy_shader(shd, ctx->hooks.user_data);
     }
     if (shd.id != SG_INVALID_ID) {
-        _sg_imgui_shader_destroyed(ctx, _sg_imgui_slot_index(shd.id));
+        _sg_imgui_shader_destroyed(ctx, _sg_imgui_slot_index(ctx, shd.id));
     }
 }
 
@@ -2076,7 +2158,7 @@ _SOKOL_PRIVATE void _sg_imgui_destroy_pipeline(sg_pipeline pip, void* user_data)
         ctx->hooks.destroy_pipeline(pip, ctx->hooks.user_data);
     }
     if (pip.id != SG_INVALID_ID) {
-        _sg_imgui_pipeline_destroyed(ctx, _sg_imgui_slot_index(pip.id));
+        _sg_imgui_pipeline_destroyed(ctx, _sg_imgui_slot_index(ctx, pip.id));
     }
 }
 
@@ -2093,7 +2175,7 @@ _SOKOL_PRIVATE void _sg_imgui_destroy_pass(sg_pass pass, void* user_data) {
         ctx->hooks.destroy_pass(pass, ctx->hooks.user_data);
     }
     if (pass.id != SG_INVALID_ID) {
-        _sg_imgui_pass_destroyed(ctx, _sg_imgui_slot_index(pass.id));
+        _sg_imgui_pass_destroyed(ctx, _sg_imgui_slot_index(ctx, pass.id));
     }
 }
 
@@ -2458,7 +2540,7 @@ _SOKOL_PRIVATE void _sg_imgui_init_buffer(sg_buffer buf_id, const sg_buffer_desc
         ctx->hooks.init_buffer(buf_id, desc, ctx->hooks.user_data);
     }
     if (buf_id.id != SG_INVALID_ID) {
-        _sg_imgui_buffer_created(ctx, buf_id, _sg_imgui_slot_index(buf_id.id), desc);
+        _sg_imgui_buffer_created(ctx, buf_id, _sg_imgui_slot_index(ctx, buf_id.id), desc);
     }
 }
 
@@ -2475,7 +2557,7 @@ _SOKOL_PRIVATE void _sg_imgui_init_image(sg_image img_id, const sg_image_desc* d
         ctx->hooks.init_image(img_id, desc, ctx->hooks.user_data);
     }
     if (img_id.id != SG_INVALID_ID) {
-        _sg_imgui_image_created(ctx, img_id, _sg_imgui_slot_index(img_id.id), desc);
+        _sg_imgui_image_created(ctx, img_id, _sg_imgui_slot_index(ctx, img_id.id), desc);
     }
 }
 
@@ -2492,7 +2574,7 @@ _SOKOL_PRIVATE void _sg_imgui_init_shader(sg_shader shd_id, const sg_shader_desc
         ctx->hooks.init_shader(shd_id, desc, ctx->hooks.user_data);
     }
     if (shd_id.id != SG_INVALID_ID) {
-        _sg_imgui_shader_created(ctx, shd_id, _sg_imgui_slot_index(shd_id.id), desc);
+        _sg_imgui_shader_created(ctx, shd_id, _sg_imgui_slot_index(ctx, shd_id.id), desc);
     }
 }
 
@@ -2509,7 +2591,7 @@ _SOKOL_PRIVATE void _sg_imgui_init_pipeline(sg_pipeline pip_id, const sg_pipelin
         ctx->hooks.init_pipeline(pip_id, desc, ctx->hooks.user_data);
     }
     if (pip_id.id != SG_INVALID_ID) {
-        _sg_imgui_pipeline_created(ctx, pip_id, _sg_imgui_slot_index(pip_id.id), desc);
+        _sg_imgui_pipeline_created(ctx, pip_id, _sg_imgui_slot_index(ctx, pip_id.id), desc);
     }
 }
 
@@ -2526,7 +2608,7 @@ _SOKOL_PRIVATE void _sg_imgui_init_pass(sg_pass pass_id, const sg_pass_desc* des
         ctx->hooks.init_pass(pass_id, desc, ctx->hooks.user_data);
     }
     if (pass_id.id != SG_INVALID_ID) {
-        _sg_imgui_pass_created(ctx, pass_id, _sg_imgui_slot_index(pass_id.id), desc);
+        _sg_imgui_pass_created(ctx, pass_id, _sg_imgui_slot_index(ctx, pass_id.id), desc);
     }
 }
 
@@ -2543,7 +2625,7 @@ _SOKOL_PRIVATE void _sg_imgui_uninit_buffer(sg_buffer buf, void* user_data) {
         ctx->hooks.uninit_buffer(buf, ctx->hooks.user_data);
     }
     if (buf.id != SG_INVALID_ID) {
-        _sg_imgui_buffer_destroyed(ctx, _sg_imgui_slot_index(buf.id));
+        _sg_imgui_buffer_destroyed(ctx, _sg_imgui_slot_index(ctx, buf.id));
     }
 }
 
@@ -2560,7 +2642,7 @@ _SOKOL_PRIVATE void _sg_imgui_uninit_image(sg_image img, void* user_data) {
         ctx->hooks.uninit_image(img, ctx->hooks.user_data);
     }
     if (img.id != SG_INVALID_ID) {
-        _sg_imgui_image_destroyed(ctx, _sg_imgui_slot_index(img.id));
+        _sg_imgui_image_destroyed(ctx, _sg_imgui_slot_index(ctx, img.id));
     }
 }
 
@@ -2577,7 +2659,7 @@ _SOKOL_PRIVATE void _sg_imgui_uninit_shader(sg_shader shd, void* user_data) {
         ctx->hooks.uninit_shader(shd, ctx->hooks.user_data);
     }
     if (shd.id != SG_INVALID_ID) {
-        _sg_imgui_shader_destroyed(ctx, _sg_imgui_slot_index(shd.id));
+        _sg_imgui_shader_destroyed(ctx, _sg_imgui_slot_index(ctx, shd.id));
     }
 }
 
@@ -2594,7 +2676,7 @@ _SOKOL_PRIVATE void _sg_imgui_uninit_pipeline(sg_pipeline pip, void* user_data)
         ctx->hooks.uninit_pipeline(pip, ctx->hooks.user_data);
     }
     if (pip.id != SG_INVALID_ID) {
-        _sg_imgui_pipeline_destroyed(ctx, _sg_imgui_slot_index(pip.id));
+        _sg_imgui_pipeline_destroyed(ctx, _sg_imgui_slot_index(ctx, pip.id));
     }
 }
 
@@ -2611,7 +2693,7 @@ _SOKOL_PRIVATE void _sg_imgui_uninit_pass(sg_pass pass, void* user_data) {
         ctx->hooks.uninit_pass(pass, ctx->hooks.user_data);
     }
     if (pass.id != SG_INVALID_ID) {
-        _sg_imgui_pass_destroyed(ctx, _sg_imgui_slot_index(pass.id));
+        _sg_imgui_pass_destroyed(ctx, _sg_imgui_slot_index(ctx, pass.id));
     }
 }
 
@@ -2865,7 +2947,7 @@ _SOKOL_PRIVATE bool _sg_imgui_draw_resid_link(uint32_t res_type, uint32_t res_id
 _SOKOL_PRIVATE bool _sg_imgui_draw_buffer_link(sg_imgui_t* ctx, sg_buffer buf) {
     bool retval = false;
     if (buf.id != SG_INVALID_ID) {
-        const sg_imgui_buffer_t* buf_ui = &ctx->buffers.slots[_sg_imgui_slot_index(buf.id)];
+        const sg_imgui_buffer_t* buf_ui = &ctx->buffers.slots[_sg_imgui_slot_index(ctx, buf.id)];
         retval = _sg_imgui_draw_resid_link(1, buf.id, buf_ui->label.buf);
     }
     return retval;
@@ -2874,7 +2956,7 @@ _SOKOL_PRIVATE bool _sg_imgui_draw_buffer_link(sg_imgui_t* ctx, sg_buffer buf) {
 _SOKOL_PRIVATE bool _sg_imgui_draw_image_link(sg_imgui_t* ctx, sg_image img) {
     bool retval = false;
     if (img.id != SG_INVALID_ID) {
-        const sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_slot_index(img.id)];
+        const sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_slot_index(ctx, img.id)];
         retval = _sg_imgui_draw_resid_link(2, img.id, img_ui->label.buf);
     }
     return retval;
@@ -2883,7 +2965,7 @@ _SOKOL_PRIVATE bool _sg_imgui_draw_image_link(sg_imgui_t* ctx, sg_image img) {
 _SOKOL_PRIVATE bool _sg_imgui_draw_shader_link(sg_imgui_t* ctx, sg_shader shd) {
     bool retval = false;
     if (shd.id != SG_INVALID_ID) {
-        const sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_slot_index(shd.id)];
+        const sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_slot_index(ctx, shd.id)];
         retval = _sg_imgui_draw_resid_link(3, shd.id, shd_ui->label.buf);
     }
     return retval;
@@ -3025,7 +3107,7 @@ _SOKOL_PRIVATE void _sg_imgui_draw_buffer_panel(sg_imgui_t* ctx, sg_buffer buf)
         igBeginChildStr("buffer", IMVEC2(0,0), false, 0);
         sg_buffer_info info = sg_query_buffer_info(buf);
         if (info.slot.state == SG_RESOURCESTATE_VALID) {
-            const sg_imgui_buffer_t* buf_ui = &ctx->buffers.slots[_sg_imgui_slot_index(buf.id)];
+            const sg_imgui_buffer_t* buf_ui = &ctx->buffers.slots[_sg_imgui_slot_index(ctx, buf.id)];
             igText("Label: %s", buf_ui->label.buf[0] ? buf_ui->label.buf : "---");
             _sg_imgui_draw_resource_slot(&info.slot);
             igSeparator();
@@ -3055,7 +3137,7 @@ _SOKOL_PRIVATE bool _sg_imgui_image_renderable(sg_image_type type, sg_pixel_form
 
 _SOKOL_PRIVATE void _sg_imgui_draw_embedded_image(sg_imgui_t* ctx, sg_image img, float* scale) {
     if (sg_query_image_state(img) == SG_RESOURCESTATE_VALID) {
-        sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_slot_index(img.id)];
+        sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_slot_index(ctx, img.id)];
         if (_sg_imgui_image_renderable(img_ui->desc.type, img_ui->desc.pixel_format)) {
             igPushIDInt((int)img.id);
             igSliderFloat("Scale", scale, 0.125f, 8.0f, "%.3f", ImGuiSliderFlags_Logarithmic);
@@ -3075,7 +3157,7 @@ _SOKOL_PRIVATE void _sg_imgui_draw_image_panel(sg_imgui_t* ctx, sg_image img) {
         igBeginChildStr("image", IMVEC2(0,0), false, 0);
         sg_image_info info = sg_query_image_info(img);
         if (info.slot.state == SG_RESOURCESTATE_VALID) {
-            sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_slot_index(img.id)];
+            sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_slot_index(ctx, img.id)];
             const sg_image_desc* desc = &img_ui->desc;
             igText("Label: %s", img_ui->label.buf[0] ? img_ui->label.buf : "---");
             _sg_imgui_draw_resource_slot(&info.slot);
@@ -3197,7 +3279,7 @@ _SOKOL_PRIVATE void _sg_imgui_draw_shader_panel(sg_imgui_t* ctx, sg_shader shd)
         igBeginChildStr("shader", IMVEC2(0,0), false, ImGuiWindowFlags_HorizontalScrollbar);
         sg_shader_info info = sg_query_shader_info(shd);
         if (info.slot.state == SG_RESOURCESTATE_VALID) {
-            const sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_slot_index(shd.id)];
+            const sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_slot_index(ctx, shd.id)];
             igText("Label: %s", shd_ui->label.buf[0] ? shd_ui->label.buf : "---");
             _sg_imgui_draw_resource_slot(&info.slot);
             igSeparator();
@@ -3311,7 +3393,7 @@ _SOKOL_PRIVATE void _sg_imgui_draw_pipeline_panel(sg_imgui_t* ctx, sg_pipeline p
         igBeginChildStr("pipeline", IMVEC2(0,0), false, 0);
         sg_pipeline_info info = sg_query_pipeline_info(pip);
         if (info.slot.state == SG_RESOURCESTATE_VALID) {
-            const sg_imgui_pipeline_t* pip_ui = &ctx->pipelines.slots[_sg_imgui_slot_index(pip.id)];
+            const sg_imgui_pipeline_t* pip_ui = &ctx->pipelines.slots[_sg_imgui_slot_index(ctx, pip.id)];
             igText("Label: %s", pip_ui->label.buf[0] ? pip_ui->label.buf : "---");
             _sg_imgui_draw_resource_slot(&info.slot);
             igSeparator();
@@ -3371,7 +3453,7 @@ _SOKOL_PRIVATE void _sg_imgui_draw_pass_panel(sg_imgui_t* ctx, sg_pass pass) {
         igBeginChildStr("pass", IMVEC2(0,0), false, 0);
         sg_pass_info info = sg_query_pass_info(pass);
         if (info.slot.state == SG_RESOURCESTATE_VALID) {
-            sg_imgui_pass_t* pass_ui = &ctx->passes.slots[_sg_imgui_slot_index(pass.id)];
+            sg_imgui_pass_t* pass_ui = &ctx->passes.slots[_sg_imgui_slot_index(ctx, pass.id)];
             igText("Label: %s", pass_ui->label.buf[0] ? pass_ui->label.buf : "---");
             _sg_imgui_draw_resource_slot(&info.slot);
             for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
@@ -3460,12 +3542,12 @@ _SOKOL_PRIVATE void _sg_imgui_draw_uniforms_panel(sg_imgui_t* ctx, const sg_imgu
         igText("Pipeline object not valid!");
         return;
    }
-    sg_imgui_pipeline_t* pip_ui = &ctx->pipelines.slots[_sg_imgui_slot_index(args->pipeline.id)];
+    sg_imgui_pipeline_t* pip_ui = &ctx->pipelines.slots[_sg_imgui_slot_index(ctx, args->pipeline.id)];
     if (sg_query_shader_state(pip_ui->desc.shader) != SG_RESOURCESTATE_VALID) {
         igText("Shader object not valid!");
         return;
     }
-    sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_slot_index(pip_ui->desc.shader.id)];
+    sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_slot_index(ctx, pip_ui->desc.shader.id)];
     SOKOL_ASSERT(shd_ui->res_id.id == pip_ui->desc.shader.id);
     const sg_shader_uniform_block_desc* ub_desc = (args->stage == SG_SHADERSTAGE_VS) ?
         &shd_ui->desc.vs.uniform_blocks[args->ub_index] :
@@ -3543,7 +3625,7 @@ _SOKOL_PRIVATE void _sg_imgui_draw_passaction_panel(sg_imgui_t* ctx, sg_pass pas
         num_color_atts = 1;
     }
     else {
-        const sg_imgui_pass_t* pass_ui = &ctx->passes.slots[_sg_imgui_slot_index(pass.id)];
+        const sg_imgui_pass_t* pass_ui = &ctx->passes.slots[_sg_imgui_slot_index(ctx, pass.id)];
         for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
             if (pass_ui->desc.color_attachments[i].image.id != SG_INVALID_ID) {
                 num_color_atts++;
@@ -3823,12 +3905,13 @@ SOKOL_API_IMPL void sg_imgui_init(sg_imgui_t* ctx) {
     ctx->hooks = sg_install_trace_hooks(&hooks);
 
     /* allocate resource debug-info slots */
-    sg_desc desc = sg_query_desc();
-    ctx->buffers.num_slots = desc.buffer_pool_size;
-    ctx->images.num_slots = desc.image_pool_size;
-    ctx->shaders.num_slots = desc.shader_pool_size;
-    ctx->pipelines.num_slots = desc.pipeline_pool_size;
-    ctx->passes.num_slots = desc.pass_pool_size;
+    const sg_pool_info pool_info = sg_query_pool_info();
+    ctx->slot_mask = pool_info.slot_mask;
+    ctx->buffers.num_slots = pool_info.buffer_pool_capacity;
+    ctx->images.num_slots = pool_info.image_pool_capacity;
+    ctx->shaders.num_slots = pool_info.shader_pool_capacity;
+    ctx->pipelines.num_slots = pool_info.pipeline_pool_capacity;
+    ctx->passes.num_slots = pool_info.pass_pool_capacity;
 
     const size_t buffer_pool_size = (size_t)ctx->buffers.num_slots * sizeof(sg_imgui_buffer_t);
     ctx->buffers.slots = (sg_imgui_buffer_t*) _sg_imgui_alloc(buffer_pool_size);